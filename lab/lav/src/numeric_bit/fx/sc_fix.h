@@ -486,7 +486,7 @@ public:
 inline
 sc_fix::sc_fix( sc_fxnum_observer* observer_ )
 : sc_fxnum( sc_fxtype_params(),
-	    SC_TC,
+	    SC_TC_,
 	    sc_fxcast_switch(),
 	    observer_ )
 {}
@@ -495,7 +495,7 @@ inline
 sc_fix::sc_fix( int wl_, int iwl_,
 		sc_fxnum_observer* observer_ )
 : sc_fxnum( sc_fxtype_params( wl_, iwl_ ),
-	    SC_TC,
+	    SC_TC_,
 	    sc_fxcast_switch(),
 	    observer_ )
 {}
@@ -504,7 +504,7 @@ inline
 sc_fix::sc_fix( sc_q_mode qm, sc_o_mode om,
 		sc_fxnum_observer* observer_ )
 : sc_fxnum( sc_fxtype_params( qm, om ),
-	    SC_TC,
+	    SC_TC_,
 	    sc_fxcast_switch(),
 	    observer_ )
 {}
@@ -513,7 +513,7 @@ inline
 sc_fix::sc_fix( sc_q_mode qm, sc_o_mode om, int nb,
 		sc_fxnum_observer* observer_ )
 : sc_fxnum( sc_fxtype_params( qm, om, nb ),
-	    SC_TC,
+	    SC_TC_,
 	    sc_fxcast_switch(),
 	    observer_ )
 {}
@@ -522,7 +522,7 @@ inline
 sc_fix::sc_fix( int wl_, int iwl_, sc_q_mode qm, sc_o_mode om,
 		sc_fxnum_observer* observer_ )
 : sc_fxnum( sc_fxtype_params( wl_, iwl_, qm, om ),
-	    SC_TC,
+	    SC_TC_,
 	    sc_fxcast_switch(),
 	    observer_ )
 {}
@@ -531,7 +531,7 @@ inline
 sc_fix::sc_fix( int wl_, int iwl_, sc_q_mode qm, sc_o_mode om, int nb,
 		sc_fxnum_observer* observer_ )
 : sc_fxnum( sc_fxtype_params( wl_, iwl_, qm, om, nb ),
-	    SC_TC,
+	    SC_TC_,
 	    sc_fxcast_switch(),
 	    observer_ )
 {}
@@ -540,7 +540,7 @@ inline
 sc_fix::sc_fix( const sc_fxcast_switch& cast_sw,
 		sc_fxnum_observer* observer_ )
 : sc_fxnum( sc_fxtype_params(),
-	    SC_TC,
+	    SC_TC_,
 	    cast_sw,
 	    observer_ )
 {}
@@ -550,7 +550,7 @@ sc_fix::sc_fix( int wl_, int iwl_,
 		const sc_fxcast_switch& cast_sw,
 		sc_fxnum_observer* observer_ )
 : sc_fxnum( sc_fxtype_params( wl_, iwl_ ),
-	    SC_TC,
+	    SC_TC_,
 	    cast_sw,
 	    observer_ )
 {}
@@ -560,7 +560,7 @@ sc_fix::sc_fix( sc_q_mode qm, sc_o_mode om,
 		const sc_fxcast_switch& cast_sw,
 		sc_fxnum_observer* observer_ )
 : sc_fxnum( sc_fxtype_params( qm, om ),
-	    SC_TC,
+	    SC_TC_,
 	    cast_sw,
 	    observer_ )
 {}
@@ -570,7 +570,7 @@ sc_fix::sc_fix( sc_q_mode qm, sc_o_mode om, int nb,
 		const sc_fxcast_switch& cast_sw,
 		sc_fxnum_observer* observer_ )
 : sc_fxnum( sc_fxtype_params( qm, om, nb ),
-	    SC_TC,
+	    SC_TC_,
 	    cast_sw,
 	    observer_ )
 {}
@@ -580,7 +580,7 @@ sc_fix::sc_fix( int wl_, int iwl_, sc_q_mode qm, sc_o_mode om,
 		const sc_fxcast_switch& cast_sw,
 		sc_fxnum_observer* observer_ )
 : sc_fxnum( sc_fxtype_params( wl_, iwl_, qm, om ),
-	    SC_TC,
+	    SC_TC_,
 	    cast_sw,
 	    observer_ )
 {}
@@ -590,7 +590,7 @@ sc_fix::sc_fix( int wl_, int iwl_, sc_q_mode qm, sc_o_mode om, int nb,
 		const sc_fxcast_switch& cast_sw,
 		sc_fxnum_observer* observer_ )
 : sc_fxnum( sc_fxtype_params( wl_, iwl_, qm, om, nb ),
-	    SC_TC,
+	    SC_TC_,
 	    cast_sw,
 	    observer_ )
 {}
@@ -599,7 +599,7 @@ inline
 sc_fix::sc_fix( const sc_fxtype_params& type_params,
 		sc_fxnum_observer* observer_ )
 : sc_fxnum( type_params,
-	    SC_TC,
+	    SC_TC_,
 	    sc_fxcast_switch(),
 	    observer_ )
 {}
@@ -609,7 +609,7 @@ sc_fix::sc_fix( const sc_fxtype_params& type_params,
 		const sc_fxcast_switch& cast_sw,
 		sc_fxnum_observer* observer_ )
 : sc_fxnum( type_params,
-	    SC_TC,
+	    SC_TC_,
 	    cast_sw,
 	    observer_ )
 {}
@@ -620,7 +620,7 @@ sc_fix::sc_fix( tp a,                                                         \
 		sc_fxnum_observer* observer_ )                                \
 : sc_fxnum( a,                                                                \
 	    sc_fxtype_params(),                                               \
-	    SC_TC,                                                            \
+	    SC_TC_,                                                            \
 	    sc_fxcast_switch(),                                               \
 	    observer_ )                                                       \
 {}                                                                            \
@@ -631,7 +631,7 @@ sc_fix::sc_fix( tp a,                                                         \
 		sc_fxnum_observer* observer_ )                                \
 : sc_fxnum( a,                                                                \
 	    sc_fxtype_params( wl_, iwl_ ),                                    \
-	    SC_TC,                                                            \
+	    SC_TC_,                                                            \
 	    sc_fxcast_switch(),                                               \
 	    observer_ )                                                       \
 {}                                                                            \
@@ -642,7 +642,7 @@ sc_fix::sc_fix( tp a,                                                         \
 		sc_fxnum_observer* observer_ )                                \
 : sc_fxnum( a,                                                                \
 	    sc_fxtype_params( qm, om ),                                       \
-	    SC_TC,                                                            \
+	    SC_TC_,                                                            \
 	    sc_fxcast_switch(),                                               \
 	    observer_ )                                                       \
 {}                                                                            \
@@ -653,7 +653,7 @@ sc_fix::sc_fix( tp a,                                                         \
 		sc_fxnum_observer* observer_ )                                \
 : sc_fxnum( a,                                                                \
 	    sc_fxtype_params( qm, om, nb ),                                   \
-	    SC_TC,                                                            \
+	    SC_TC_,                                                            \
 	    sc_fxcast_switch(),                                               \
 	    observer_ )                                                       \
 {}                                                                            \
@@ -664,7 +664,7 @@ sc_fix::sc_fix( tp a,                                                         \
 		sc_fxnum_observer* observer_ )                                \
 : sc_fxnum( a,                                                                \
 	    sc_fxtype_params( wl_, iwl_, qm, om ),                            \
-	    SC_TC,                                                            \
+	    SC_TC_,                                                            \
 	    sc_fxcast_switch(),                                               \
 	    observer_ )                                                       \
 {}                                                                            \
@@ -675,7 +675,7 @@ sc_fix::sc_fix( tp a,                                                         \
 		sc_fxnum_observer* observer_ )                                \
 : sc_fxnum( a,                                                                \
 	    sc_fxtype_params( wl_, iwl_, qm, om, nb ),                        \
-	    SC_TC,                                                            \
+	    SC_TC_,                                                            \
 	    sc_fxcast_switch(),                                               \
 	    observer_ )                                                       \
 {}                                                                            \
@@ -686,7 +686,7 @@ sc_fix::sc_fix( tp a,                                                         \
 		sc_fxnum_observer* observer_ )                                \
 : sc_fxnum( a,                                                                \
 	    sc_fxtype_params(),                                               \
-	    SC_TC,                                                            \
+	    SC_TC_,                                                            \
 	    cast_sw,                                                          \
 	    observer_ )                                                       \
 {}                                                                            \
@@ -698,7 +698,7 @@ sc_fix::sc_fix( tp a,                                                         \
 		sc_fxnum_observer* observer_ )                                \
 : sc_fxnum( a,                                                                \
 	    sc_fxtype_params( wl_, iwl_ ),                                    \
-	    SC_TC,                                                            \
+	    SC_TC_,                                                            \
 	    cast_sw,                                                          \
 	    observer_ )                                                       \
 {}                                                                            \
@@ -710,7 +710,7 @@ sc_fix::sc_fix( tp a,                                                         \
 		sc_fxnum_observer* observer_ )                                \
 : sc_fxnum( a,                                                                \
 	    sc_fxtype_params( qm, om ),                                       \
-	    SC_TC,                                                            \
+	    SC_TC_,                                                            \
 	    cast_sw,                                                          \
 	    observer_ )                                                       \
 {}                                                                            \
@@ -722,7 +722,7 @@ sc_fix::sc_fix( tp a,                                                         \
 		sc_fxnum_observer* observer_ )                                \
 : sc_fxnum( a,                                                                \
 	    sc_fxtype_params( qm, om, nb ),                                   \
-	    SC_TC,                                                            \
+	    SC_TC_,                                                            \
 	    cast_sw,                                                          \
 	    observer_ )                                                       \
 {}                                                                            \
@@ -734,7 +734,7 @@ sc_fix::sc_fix( tp a,                                                         \
 		sc_fxnum_observer* observer_ )                                \
 : sc_fxnum( a,                                                                \
 	    sc_fxtype_params( wl_, iwl_, qm, om ),                            \
-	    SC_TC,                                                            \
+	    SC_TC_,                                                            \
 	    cast_sw,                                                          \
 	    observer_ )                                                       \
 {}                                                                            \
@@ -746,7 +746,7 @@ sc_fix::sc_fix( tp a,                                                         \
 		sc_fxnum_observer* observer_ )                                \
 : sc_fxnum( a,                                                                \
 	    sc_fxtype_params( wl_, iwl_, qm, om, nb ),                        \
-	    SC_TC,                                                            \
+	    SC_TC_,                                                            \
 	    cast_sw,                                                          \
 	    observer_ )                                                       \
 {}                                                                            \
@@ -757,7 +757,7 @@ sc_fix::sc_fix( tp a,                                                         \
 		sc_fxnum_observer* observer_ )                                \
 : sc_fxnum( a,                                                                \
 	    type_params,                                                      \
-	    SC_TC,                                                            \
+	    SC_TC_,                                                            \
 	    sc_fxcast_switch(),                                               \
 	    observer_ )                                                       \
 {}                                                                            \
@@ -769,7 +769,7 @@ sc_fix::sc_fix( tp a,                                                         \
 		sc_fxnum_observer* observer_ )                                \
 : sc_fxnum( a,                                                                \
 	    type_params,                                                      \
-	    SC_TC,                                                            \
+	    SC_TC_,                                                            \
 	    cast_sw,                                                          \
 	    observer_ )                                                       \
 {}
@@ -802,7 +802,7 @@ inline
 sc_fix::sc_fix( const sc_fix& a )
 : sc_fxnum( a,
 	    sc_fxtype_params(),
-	    SC_TC,
+	    SC_TC_,
 	    sc_fxcast_switch(),
 	    0 )
 {}
@@ -898,7 +898,7 @@ sc_fix::operator -- ()
 inline
 sc_fix_fast::sc_fix_fast( sc_fxnum_fast_observer* observer_ )
 : sc_fxnum_fast( sc_fxtype_params(),
-		 SC_TC,
+		 SC_TC_,
 		 sc_fxcast_switch(),
 		 observer_ )
 {}
@@ -907,7 +907,7 @@ inline
 sc_fix_fast::sc_fix_fast( int wl_, int iwl_,
 			  sc_fxnum_fast_observer* observer_ )
 : sc_fxnum_fast( sc_fxtype_params( wl_, iwl_ ),
-		 SC_TC,
+		 SC_TC_,
 		 sc_fxcast_switch(),
 		 observer_ )
 {}
@@ -916,7 +916,7 @@ inline
 sc_fix_fast::sc_fix_fast( sc_q_mode qm, sc_o_mode om,
 			  sc_fxnum_fast_observer* observer_ )
 : sc_fxnum_fast( sc_fxtype_params( qm, om ),
-		 SC_TC,
+		 SC_TC_,
 		 sc_fxcast_switch(),
 		 observer_ )
 {}
@@ -925,7 +925,7 @@ inline
 sc_fix_fast::sc_fix_fast( sc_q_mode qm, sc_o_mode om, int nb,
 			  sc_fxnum_fast_observer* observer_ )
 : sc_fxnum_fast( sc_fxtype_params( qm, om, nb ),
-		 SC_TC,
+		 SC_TC_,
 		 sc_fxcast_switch(),
 		 observer_ )
 {}
@@ -934,7 +934,7 @@ inline
 sc_fix_fast::sc_fix_fast( int wl_, int iwl_, sc_q_mode qm, sc_o_mode om,
 			  sc_fxnum_fast_observer* observer_ )
 : sc_fxnum_fast( sc_fxtype_params( wl_, iwl_, qm, om ),
-		 SC_TC,
+		 SC_TC_,
 		 sc_fxcast_switch(),
 		 observer_ )
 {}
@@ -944,7 +944,7 @@ sc_fix_fast::sc_fix_fast( int wl_, int iwl_,
 			  sc_q_mode qm, sc_o_mode om, int nb,
 			  sc_fxnum_fast_observer* observer_ )
 : sc_fxnum_fast( sc_fxtype_params( wl_, iwl_, qm, om, nb ),
-		 SC_TC,
+		 SC_TC_,
 		 sc_fxcast_switch(),
 		 observer_ )
 {}
@@ -953,7 +953,7 @@ inline
 sc_fix_fast::sc_fix_fast( const sc_fxcast_switch& cast_sw,
 			  sc_fxnum_fast_observer* observer_ )
 : sc_fxnum_fast( sc_fxtype_params(),
-		 SC_TC,
+		 SC_TC_,
 		 cast_sw,
 		 observer_ )
 {}
@@ -963,7 +963,7 @@ sc_fix_fast::sc_fix_fast( int wl_, int iwl_,
 			  const sc_fxcast_switch& cast_sw,
 			  sc_fxnum_fast_observer* observer_ )
 : sc_fxnum_fast( sc_fxtype_params( wl_, iwl_ ),
-		 SC_TC,
+		 SC_TC_,
 		 cast_sw,
 		 observer_ )
 {}
@@ -973,7 +973,7 @@ sc_fix_fast::sc_fix_fast( sc_q_mode qm, sc_o_mode om,
 			  const sc_fxcast_switch& cast_sw,
 			  sc_fxnum_fast_observer* observer_ )
 : sc_fxnum_fast( sc_fxtype_params( qm, om ),
-		 SC_TC,
+		 SC_TC_,
 		 cast_sw,
 		 observer_ )
 {}
@@ -983,7 +983,7 @@ sc_fix_fast::sc_fix_fast( sc_q_mode qm, sc_o_mode om, int nb,
 			  const sc_fxcast_switch& cast_sw,
 			  sc_fxnum_fast_observer* observer_ )
 : sc_fxnum_fast( sc_fxtype_params( qm, om, nb ),
-		 SC_TC,
+		 SC_TC_,
 		 cast_sw,
 		 observer_ )
 {}
@@ -993,7 +993,7 @@ sc_fix_fast::sc_fix_fast( int wl_, int iwl_, sc_q_mode qm, sc_o_mode om,
 			  const sc_fxcast_switch& cast_sw,
 			  sc_fxnum_fast_observer* observer_ )
 : sc_fxnum_fast( sc_fxtype_params( wl_, iwl_, qm, om ),
-		 SC_TC,
+		 SC_TC_,
 		 cast_sw,
 		 observer_ )
 {}
@@ -1004,7 +1004,7 @@ sc_fix_fast::sc_fix_fast( int wl_, int iwl_,
 			  const sc_fxcast_switch& cast_sw,
 			  sc_fxnum_fast_observer* observer_ )
 : sc_fxnum_fast( sc_fxtype_params( wl_, iwl_, qm, om, nb ),
-		 SC_TC,
+		 SC_TC_,
 		 cast_sw,
 		 observer_ )
 {}
@@ -1013,7 +1013,7 @@ inline
 sc_fix_fast::sc_fix_fast( const sc_fxtype_params& type_params,
 			  sc_fxnum_fast_observer* observer_ )
 : sc_fxnum_fast( type_params,
-		 SC_TC,
+		 SC_TC_,
 		 sc_fxcast_switch(),
 		 observer_ )
 {}
@@ -1023,7 +1023,7 @@ sc_fix_fast::sc_fix_fast( const sc_fxtype_params& type_params,
 			  const sc_fxcast_switch& cast_sw,
 			  sc_fxnum_fast_observer* observer_ )
 : sc_fxnum_fast( type_params,
-		 SC_TC,
+		 SC_TC_,
 		 cast_sw,
 		 observer_ )
 {}
@@ -1034,7 +1034,7 @@ sc_fix_fast::sc_fix_fast( tp a,                                               \
 			  sc_fxnum_fast_observer* observer_ )                 \
 : sc_fxnum_fast( a,                                                           \
 		 sc_fxtype_params(),                                          \
-		 SC_TC,                                                       \
+		 SC_TC_,                                                       \
 		 sc_fxcast_switch(),                                          \
 		 observer_ )                                                  \
 {}                                                                            \
@@ -1045,7 +1045,7 @@ sc_fix_fast::sc_fix_fast( tp a,                                               \
 			  sc_fxnum_fast_observer* observer_ )                 \
 : sc_fxnum_fast( a,                                                           \
 		 sc_fxtype_params( wl_, iwl_ ),                               \
-		 SC_TC,                                                       \
+		 SC_TC_,                                                       \
 		 sc_fxcast_switch(),                                          \
 		 observer_ )                                                  \
 {}                                                                            \
@@ -1056,7 +1056,7 @@ sc_fix_fast::sc_fix_fast( tp a,                                               \
 			  sc_fxnum_fast_observer* observer_ )                 \
 : sc_fxnum_fast( a,                                                           \
 		 sc_fxtype_params( qm, om ),                                  \
-		 SC_TC,                                                       \
+		 SC_TC_,                                                       \
 		 sc_fxcast_switch(),                                          \
 		 observer_ )                                                  \
 {}                                                                            \
@@ -1067,7 +1067,7 @@ sc_fix_fast::sc_fix_fast( tp a,                                               \
 			  sc_fxnum_fast_observer* observer_ )                 \
 : sc_fxnum_fast( a,                                                           \
 		 sc_fxtype_params( qm, om, nb ),                              \
-		 SC_TC,                                                       \
+		 SC_TC_,                                                       \
 		 sc_fxcast_switch(),                                          \
 		 observer_ )                                                  \
 {}                                                                            \
@@ -1078,7 +1078,7 @@ sc_fix_fast::sc_fix_fast( tp a,                                               \
 			  sc_fxnum_fast_observer* observer_ )                 \
 : sc_fxnum_fast( a,                                                           \
 		 sc_fxtype_params( wl_, iwl_, qm, om ),                       \
-		 SC_TC,                                                       \
+		 SC_TC_,                                                       \
 		 sc_fxcast_switch(),                                          \
 		 observer_ )                                                  \
 {}                                                                            \
@@ -1090,7 +1090,7 @@ sc_fix_fast::sc_fix_fast( tp a,                                               \
 			  sc_fxnum_fast_observer* observer_ )                 \
 : sc_fxnum_fast( a,                                                           \
 		 sc_fxtype_params( wl_, iwl_, qm, om, nb ),                   \
-		 SC_TC,                                                       \
+		 SC_TC_,                                                       \
 		 sc_fxcast_switch(),                                          \
 		 observer_ )                                                  \
 {}                                                                            \
@@ -1101,7 +1101,7 @@ sc_fix_fast::sc_fix_fast( tp a,                                               \
 			  sc_fxnum_fast_observer* observer_ )                 \
 : sc_fxnum_fast( a,                                                           \
 		 sc_fxtype_params(),                                          \
-		 SC_TC,                                                       \
+		 SC_TC_,                                                       \
 		 cast_sw,                                                     \
 		 observer_ )                                                  \
 {}                                                                            \
@@ -1113,7 +1113,7 @@ sc_fix_fast::sc_fix_fast( tp a,                                               \
 			  sc_fxnum_fast_observer* observer_ )                 \
 : sc_fxnum_fast( a,                                                           \
 		 sc_fxtype_params( wl_, iwl_ ),                               \
-		 SC_TC,                                                       \
+		 SC_TC_,                                                       \
 		 cast_sw,                                                     \
 		 observer_ )                                                  \
 {}                                                                            \
@@ -1125,7 +1125,7 @@ sc_fix_fast::sc_fix_fast( tp a,                                               \
 			  sc_fxnum_fast_observer* observer_ )                 \
 : sc_fxnum_fast( a,                                                           \
 		 sc_fxtype_params( qm, om ),                                  \
-		 SC_TC,                                                       \
+		 SC_TC_,                                                       \
 		 cast_sw,                                                     \
 		 observer_ )                                                  \
 {}                                                                            \
@@ -1137,7 +1137,7 @@ sc_fix_fast::sc_fix_fast( tp a,                                               \
 			  sc_fxnum_fast_observer* observer_ )                 \
 : sc_fxnum_fast( a,                                                           \
 		 sc_fxtype_params( qm, om, nb ),                              \
-		 SC_TC,                                                       \
+		 SC_TC_,                                                       \
 		 cast_sw,                                                     \
 		 observer_ )                                                  \
 {}                                                                            \
@@ -1149,7 +1149,7 @@ sc_fix_fast::sc_fix_fast( tp a,                                               \
 			  sc_fxnum_fast_observer* observer_ )                 \
 : sc_fxnum_fast( a,                                                           \
 		 sc_fxtype_params( wl_, iwl_, qm, om ),                       \
-		 SC_TC,                                                       \
+		 SC_TC_,                                                       \
 		 cast_sw,                                                     \
 		 observer_ )                                                  \
 {}                                                                            \
@@ -1162,7 +1162,7 @@ sc_fix_fast::sc_fix_fast( tp a,                                               \
 			  sc_fxnum_fast_observer* observer_ )                 \
 : sc_fxnum_fast( a,                                                           \
 		 sc_fxtype_params( wl_, iwl_, qm, om, nb ),                   \
-		 SC_TC,                                                       \
+		 SC_TC_,                                                       \
 		 cast_sw,                                                     \
 		 observer_ )                                                  \
 {}                                                                            \
@@ -1173,7 +1173,7 @@ sc_fix_fast::sc_fix_fast( tp a,                                               \
 			  sc_fxnum_fast_observer* observer_ )                 \
 : sc_fxnum_fast( a,                                                           \
 		 type_params,                                                 \
-		 SC_TC,                                                       \
+		 SC_TC_,                                                       \
 		 sc_fxcast_switch(),                                          \
 		 observer_ )                                                  \
 {}                                                                            \
@@ -1185,7 +1185,7 @@ sc_fix_fast::sc_fix_fast( tp a,                                               \
 			  sc_fxnum_fast_observer* observer_ )                 \
 : sc_fxnum_fast( a,                                                           \
 		 type_params,                                                 \
-		 SC_TC,                                                       \
+		 SC_TC_,                                                       \
 		 cast_sw,                                                     \
 		 observer_ )                                                  \
 {}
@@ -1218,7 +1218,7 @@ inline
 sc_fix_fast::sc_fix_fast( const sc_fix_fast& a )
 : sc_fxnum_fast( a,
 		 sc_fxtype_params(),
-		 SC_TC,
+		 SC_TC_,
 		 sc_fxcast_switch(),
 		 0 )
 {}
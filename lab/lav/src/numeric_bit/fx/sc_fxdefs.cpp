@@ -47,10 +47,10 @@ to_string( sc_enc enc )
 {
     switch( enc )
     {
-        case SC_TC:
-            return sc_string( "SC_TC" );
-        case SC_US:
-            return sc_string( "SC_US" );
+        case SC_TC_:
+            return sc_string( "SC_TC_" );
+        case SC_US_:
+            return sc_string( "SC_US_" );
 	default:
 	    return sc_string( "unknown" );
     }
@@ -101,8 +101,15 @@ public:                                                                       \
 
 enum sc_enc
 {
-    SC_TC,	// two's complement
-    SC_US	// unsigned
+    SC_TC_,	// two's complement
+    SC_US_,	// unsigned
+
+    // the former names; SC_US is also a time unit (see sc_time_base.h)
+    // unless SC_FX_OLD_ENC_NAMES is defined
+    SC_TC = SC_TC_
+#ifdef SC_FX_OLD_ENC_NAMES
+    , SC_US = SC_US_
+#endif
 };
 
 
@@ -658,7 +658,7 @@ print_other( scfx_string& s, const scfx_ieee_double& id,
 	msb = params->iwl() - 1;
 	lsb = params->iwl() - params->wl();
 
-	if( params->enc() == SC_TC &&
+	if( params->enc() == SC_TC_ &&
 	    ( numrep == SC_BIN_US ||
 	      numrep == SC_OCT_US ||
 	      numrep == SC_HEX_US ) &&
@@ -1272,7 +1272,7 @@ overflow( sc_fxval_fast& c, const scfx_params& params, bool& o_flag )
     double full_circle = scfx_pow2( iwl );
     double resolution = scfx_pow2( -fwl );
     double low, high;
-    if( params.enc() == SC_TC )
+    if( params.enc() == SC_TC_ )
     {
 	high = full_circle / 2.0 - resolution;
 	if( params.o_mode() == SC_SAT_SYM )
@@ -1321,7 +1321,7 @@ overflow( sc_fxval_fast& c, const scfx_params& params, bool& o_flag )
 		        val += low;
 		    else
 		    {
-		        if( params.enc() == SC_TC )
+		        if( params.enc() == SC_TC_ )
 			    val += full_circle / 2.0 - X;
 			else
 			    val += full_circle - X;
@@ -1353,7 +1353,7 @@ overflow( sc_fxval_fast& c, const scfx_params& params, bool& o_flag )
 	    }
             case SC_WRAP_SM:			// sign magnitude wrap-around
 	    {
-		_SC_ASSERT( params.enc() == SC_TC,
+		_SC_ASSERT( params.enc() == SC_TC_,
 			    "SC_WRAP_SM not defined for unsigned numbers" );
 	
 		int n_bits = params.n_bits();
@@ -1548,7 +1548,7 @@ sc_fxval_fast::set( int i, const scfx_params& params )
     if( get_bit( i ) )
         return true;
 
-    if( params.enc() == SC_TC && i == params.iwl() - 1 )
+    if( params.enc() == SC_TC_ && i == params.iwl() - 1 )
         _val -= scfx_pow2( i );
     else
         _val += scfx_pow2( i );
@@ -1566,7 +1566,7 @@ sc_fxval_fast::clear( int i, const scfx_params& params )
     if( ! get_bit( i ) )
         return true;
 
-    if( params.enc() == SC_TC && i == params.iwl() - 1 )
+    if( params.enc() == SC_TC_ && i == params.iwl() - 1 )
         _val += scfx_pow2( i );
     else
         _val -= scfx_pow2( i );
@@ -1644,7 +1644,7 @@ sc_fxval_fast::set_slice( int i, int j, const scfx_params& params,
 	{
 	    if( ! get_bit( l ) )
 	    {
-		if( params.enc() == SC_TC && l == params.iwl() - 1 )
+		if( params.enc() == SC_TC_ && l == params.iwl() - 1 )
 		    _val -= scfx_pow2( l );
 		else
 		    _val += scfx_pow2( l );
@@ -1654,7 +1654,7 @@ sc_fxval_fast::set_slice( int i, int j, const scfx_params& params,
 	{
 	    if( get_bit( l ) )
 	    {
-		if( params.enc() == SC_TC && l == params.iwl() - 1 )
+		if( params.enc() == SC_TC_ && l == params.iwl() - 1 )
 		    _val += scfx_pow2( l );
 		else
 		    _val -= scfx_pow2( l );
@@ -489,7 +489,7 @@ public:
 inline
 sc_ufix::sc_ufix( sc_fxnum_observer* observer_ )
 : sc_fxnum( sc_fxtype_params(),
-	    SC_US,
+	    SC_US_,
 	    sc_fxcast_switch(),
 	    observer_ )
 {}
@@ -498,7 +498,7 @@ inline
 sc_ufix::sc_ufix( int wl_, int iwl_,
 		  sc_fxnum_observer* observer_ )
 : sc_fxnum( sc_fxtype_params( wl_, iwl_ ),
-	    SC_US,
+	    SC_US_,
 	    sc_fxcast_switch(),
 	    observer_ )
 {}
@@ -507,7 +507,7 @@ inline
 sc_ufix::sc_ufix( sc_q_mode qm, sc_o_mode om,
 		  sc_fxnum_observer* observer_ )
 : sc_fxnum( sc_fxtype_params( qm, om ),
-	    SC_US,
+	    SC_US_,
 	    sc_fxcast_switch(),
 	    observer_ )
 {}
@@ -516,7 +516,7 @@ inline
 sc_ufix::sc_ufix( sc_q_mode qm, sc_o_mode om, int nb,
 		  sc_fxnum_observer* observer_ )
 : sc_fxnum( sc_fxtype_params( qm, om, nb ),
-	    SC_US,
+	    SC_US_,
 	    sc_fxcast_switch(),
 	    observer_ )
 {}
@@ -525,7 +525,7 @@ inline
 sc_ufix::sc_ufix( int wl_, int iwl_, sc_q_mode qm, sc_o_mode om,
 		  sc_fxnum_observer* observer_ )
 : sc_fxnum( sc_fxtype_params( wl_, iwl_, qm, om ),
-	    SC_US,
+	    SC_US_,
 	    sc_fxcast_switch(),
 	    observer_ )
 {}
@@ -534,7 +534,7 @@ inline
 sc_ufix::sc_ufix( int wl_, int iwl_, sc_q_mode qm, sc_o_mode om, int nb,
 		  sc_fxnum_observer* observer_ )
 : sc_fxnum( sc_fxtype_params( wl_, iwl_, qm, om, nb ),
-	    SC_US,
+	    SC_US_,
 	    sc_fxcast_switch(),
 	    observer_ )
 {}
@@ -543,7 +543,7 @@ inline
 sc_ufix::sc_ufix( const sc_fxcast_switch& cast_sw,
 		  sc_fxnum_observer* observer_ )
 : sc_fxnum( sc_fxtype_params(),
-	    SC_US,
+	    SC_US_,
 	    cast_sw,
 	    observer_ )
 {}
@@ -553,7 +553,7 @@ sc_ufix::sc_ufix( int wl_, int iwl_,
 		  const sc_fxcast_switch& cast_sw,
 		  sc_fxnum_observer* observer_ )
 : sc_fxnum( sc_fxtype_params( wl_, iwl_ ),
-	    SC_US,
+	    SC_US_,
 	    cast_sw,
 	    observer_ )
 {}
@@ -563,7 +563,7 @@ sc_ufix::sc_ufix( sc_q_mode qm, sc_o_mode om,
 		  const sc_fxcast_switch& cast_sw,
 		  sc_fxnum_observer* observer_ )
 : sc_fxnum( sc_fxtype_params( qm, om ),
-	    SC_US,
+	    SC_US_,
 	    cast_sw,
 	    observer_ )
 {}
@@ -573,7 +573,7 @@ sc_ufix::sc_ufix( sc_q_mode qm, sc_o_mode om, int nb,
 		  const sc_fxcast_switch& cast_sw,
 		  sc_fxnum_observer* observer_ )
 : sc_fxnum( sc_fxtype_params( qm, om, nb ),
-	    SC_US,
+	    SC_US_,
 	    cast_sw,
 	    observer_ )
 {}
@@ -583,7 +583,7 @@ sc_ufix::sc_ufix( int wl_, int iwl_, sc_q_mode qm, sc_o_mode om,
 		  const sc_fxcast_switch& cast_sw,
 		  sc_fxnum_observer* observer_ )
 : sc_fxnum( sc_fxtype_params( wl_, iwl_, qm, om ),
-	    SC_US,
+	    SC_US_,
 	    cast_sw,
 	    observer_ )
 {}
@@ -593,7 +593,7 @@ sc_ufix::sc_ufix( int wl_, int iwl_, sc_q_mode qm, sc_o_mode om, int nb,
 		  const sc_fxcast_switch& cast_sw,
 		  sc_fxnum_observer* observer_ )
 : sc_fxnum( sc_fxtype_params( wl_, iwl_, qm, om, nb ),
-	    SC_US,
+	    SC_US_,
 	    cast_sw,
 	    observer_ )
 {}
@@ -602,7 +602,7 @@ inline
 sc_ufix::sc_ufix( const sc_fxtype_params& type_params,
 		  sc_fxnum_observer* observer_ )
 : sc_fxnum( type_params,
-	    SC_US,
+	    SC_US_,
 	    sc_fxcast_switch(),
 	    observer_ )
 {}
@@ -612,7 +612,7 @@ sc_ufix::sc_ufix( const sc_fxtype_params& type_params,
 		  const sc_fxcast_switch& cast_sw,
 		  sc_fxnum_observer* observer_ )
 : sc_fxnum( type_params,
-	    SC_US,
+	    SC_US_,
 	    cast_sw,
 	    observer_ )
 {}
@@ -623,7 +623,7 @@ sc_ufix::sc_ufix( tp a,                                                       \
 		  sc_fxnum_observer* observer_ )                              \
 : sc_fxnum( a,                                                                \
 	    sc_fxtype_params(),                                               \
-	    SC_US,                                                            \
+	    SC_US_,                                                            \
 	    sc_fxcast_switch(),                                               \
 	    observer_ )                                                       \
 {}                                                                            \
@@ -634,7 +634,7 @@ sc_ufix::sc_ufix( tp a,                                                       \
 		  sc_fxnum_observer* observer_ )                              \
 : sc_fxnum( a,                                                                \
 	    sc_fxtype_params( wl_, iwl_ ),                                    \
-	    SC_US,                                                            \
+	    SC_US_,                                                            \
 	    sc_fxcast_switch(),                                               \
 	    observer_ )                                                       \
 {}                                                                            \
@@ -645,7 +645,7 @@ sc_ufix::sc_ufix( tp a,                                                       \
 		  sc_fxnum_observer* observer_ )                              \
 : sc_fxnum( a,                                                                \
 	    sc_fxtype_params( qm, om ),                                       \
-	    SC_US,                                                            \
+	    SC_US_,                                                            \
 	    sc_fxcast_switch(),                                               \
 	    observer_ )                                                       \
 {}                                                                            \
@@ -656,7 +656,7 @@ sc_ufix::sc_ufix( tp a,                                                       \
 		  sc_fxnum_observer* observer_ )                              \
 : sc_fxnum( a,                                                                \
 	    sc_fxtype_params( qm, om, nb ),                                   \
-	    SC_US,                                                            \
+	    SC_US_,                                                            \
 	    sc_fxcast_switch(),                                               \
 	    observer_ )                                                       \
 {}                                                                            \
@@ -667,7 +667,7 @@ sc_ufix::sc_ufix( tp a,                                                       \
 		  sc_fxnum_observer* observer_ )                              \
 : sc_fxnum( a,                                                                \
 	    sc_fxtype_params( wl_, iwl_, qm, om ),                            \
-	    SC_US,                                                            \
+	    SC_US_,                                                            \
 	    sc_fxcast_switch(),                                               \
 	    observer_ )                                                       \
 {}                                                                            \
@@ -678,7 +678,7 @@ sc_ufix::sc_ufix( tp a,                                                       \
 		  sc_fxnum_observer* observer_ )                              \
 : sc_fxnum( a,                                                                \
 	    sc_fxtype_params( wl_, iwl_, qm, om, nb ),                        \
-	    SC_US,                                                            \
+	    SC_US_,                                                            \
 	    sc_fxcast_switch(),                                               \
 	    observer_ )                                                       \
 {}                                                                            \
@@ -689,7 +689,7 @@ sc_ufix::sc_ufix( tp a,                                                       \
 		  sc_fxnum_observer* observer_ )                              \
 : sc_fxnum( a,                                                                \
 	    sc_fxtype_params(),                                               \
-	    SC_US,                                                            \
+	    SC_US_,                                                            \
 	    cast_sw,                                                          \
 	    observer_ )                                                       \
 {}                                                                            \
@@ -701,7 +701,7 @@ sc_ufix::sc_ufix( tp a,                                                       \
 		  sc_fxnum_observer* observer_ )                              \
 : sc_fxnum( a,                                                                \
 	    sc_fxtype_params( wl_, iwl_ ),                                    \
-	    SC_US,                                                            \
+	    SC_US_,                                                            \
 	    cast_sw,                                                          \
 	    observer_ )                                                       \
 {}                                                                            \
@@ -713,7 +713,7 @@ sc_ufix::sc_ufix( tp a,                                                       \
 		  sc_fxnum_observer* observer_ )                              \
 : sc_fxnum( a,                                                                \
 	    sc_fxtype_params( qm, om ),                                       \
-	    SC_US,                                                            \
+	    SC_US_,                                                            \
 	    cast_sw,                                                          \
 	    observer_ )                                                       \
 {}                                                                            \
@@ -725,7 +725,7 @@ sc_ufix::sc_ufix( tp a,                                                       \
 		  sc_fxnum_observer* observer_ )                              \
 : sc_fxnum( a,                                                                \
 	    sc_fxtype_params( qm, om, nb ),                                   \
-	    SC_US,                                                            \
+	    SC_US_,                                                            \
 	    cast_sw,                                                          \
 	    observer_ )                                                       \
 {}                                                                            \
@@ -737,7 +737,7 @@ sc_ufix::sc_ufix( tp a,                                                       \
 		  sc_fxnum_observer* observer_ )                              \
 : sc_fxnum( a,                                                                \
 	    sc_fxtype_params( wl_, iwl_, qm, om ),                            \
-	    SC_US,                                                            \
+	    SC_US_,                                                            \
 	    cast_sw,                                                          \
 	    observer_ )                                                       \
 {}                                                                            \
@@ -749,7 +749,7 @@ sc_ufix::sc_ufix( tp a,                                                       \
 		  sc_fxnum_observer* observer_ )                              \
 : sc_fxnum( a,                                                                \
 	    sc_fxtype_params( wl_, iwl_, qm, om, nb ),                        \
-	    SC_US,                                                            \
+	    SC_US_,                                                            \
 	    cast_sw,                                                          \
 	    observer_ )                                                       \
 {}                                                                            \
@@ -760,7 +760,7 @@ sc_ufix::sc_ufix( tp a,                                                       \
 		  sc_fxnum_observer* observer_ )                              \
 : sc_fxnum( a,                                                                \
 	    type_params,                                                      \
-	    SC_US,                                                            \
+	    SC_US_,                                                            \
 	    sc_fxcast_switch(),                                               \
 	    observer_ )                                                       \
 {}                                                                            \
@@ -772,7 +772,7 @@ sc_ufix::sc_ufix( tp a,                                                       \
 		  sc_fxnum_observer* observer_ )                              \
 : sc_fxnum( a,                                                                \
 	    type_params,                                                      \
-	    SC_US,                                                            \
+	    SC_US_,                                                            \
 	    cast_sw,                                                          \
 	    observer_ )                                                       \
 {}
@@ -805,7 +805,7 @@ inline
 sc_ufix::sc_ufix( const sc_ufix& a )
 : sc_fxnum( a,
 	    sc_fxtype_params(),
-	    SC_US,
+	    SC_US_,
 	    sc_fxcast_switch(),
 	    0 )
 {}
@@ -901,7 +901,7 @@ sc_ufix::operator -- ()
 inline
 sc_ufix_fast::sc_ufix_fast( sc_fxnum_fast_observer* observer_ )
 : sc_fxnum_fast( sc_fxtype_params(),
-		 SC_US,
+		 SC_US_,
 		 sc_fxcast_switch(),
 		 observer_ )
 {}
@@ -910,7 +910,7 @@ inline
 sc_ufix_fast::sc_ufix_fast( int wl_, int iwl_,
 			    sc_fxnum_fast_observer* observer_ )
 : sc_fxnum_fast( sc_fxtype_params( wl_, iwl_ ),
-		 SC_US,
+		 SC_US_,
 		 sc_fxcast_switch(),
 		 observer_ )
 {}
@@ -919,7 +919,7 @@ inline
 sc_ufix_fast::sc_ufix_fast( sc_q_mode qm, sc_o_mode om,
 			    sc_fxnum_fast_observer* observer_ )
 : sc_fxnum_fast( sc_fxtype_params( qm, om ),
-		 SC_US,
+		 SC_US_,
 		 sc_fxcast_switch(),
 		 observer_ )
 {}
@@ -928,7 +928,7 @@ inline
 sc_ufix_fast::sc_ufix_fast( sc_q_mode qm, sc_o_mode om, int nb,
 			    sc_fxnum_fast_observer* observer_ )
 : sc_fxnum_fast( sc_fxtype_params( qm, om, nb ),
-		 SC_US,
+		 SC_US_,
 		 sc_fxcast_switch(),
 		 observer_ )
 {}
@@ -937,7 +937,7 @@ inline
 sc_ufix_fast::sc_ufix_fast( int wl_, int iwl_, sc_q_mode qm, sc_o_mode om,
 			    sc_fxnum_fast_observer* observer_ )
 : sc_fxnum_fast( sc_fxtype_params( wl_, iwl_, qm, om ),
-		 SC_US,
+		 SC_US_,
 		 sc_fxcast_switch(),
 		 observer_ )
 {}
@@ -947,7 +947,7 @@ sc_ufix_fast::sc_ufix_fast( int wl_, int iwl_,
 			    sc_q_mode qm, sc_o_mode om, int nb,
 			    sc_fxnum_fast_observer* observer_ )
 : sc_fxnum_fast( sc_fxtype_params( wl_, iwl_, qm, om, nb ),
-		 SC_US,
+		 SC_US_,
 		 sc_fxcast_switch(),
 		 observer_ )
 {}
@@ -956,7 +956,7 @@ inline
 sc_ufix_fast::sc_ufix_fast( const sc_fxcast_switch& cast_sw,
 			    sc_fxnum_fast_observer* observer_ )
 : sc_fxnum_fast( sc_fxtype_params(),
-		 SC_US,
+		 SC_US_,
 		 cast_sw,
 		 observer_ )
 {}
@@ -966,7 +966,7 @@ sc_ufix_fast::sc_ufix_fast( int wl_, int iwl_,
 			    const sc_fxcast_switch& cast_sw,
 			    sc_fxnum_fast_observer* observer_ )
 : sc_fxnum_fast( sc_fxtype_params( wl_, iwl_ ),
-		 SC_US,
+		 SC_US_,
 		 cast_sw,
 		 observer_ )
 {}
@@ -976,7 +976,7 @@ sc_ufix_fast::sc_ufix_fast( sc_q_mode qm, sc_o_mode om,
 			    const sc_fxcast_switch& cast_sw,
 			    sc_fxnum_fast_observer* observer_ )
 : sc_fxnum_fast( sc_fxtype_params( qm, om ),
-		 SC_US,
+		 SC_US_,
 		 cast_sw,
 		 observer_ )
 {}
@@ -986,7 +986,7 @@ sc_ufix_fast::sc_ufix_fast( sc_q_mode qm, sc_o_mode om, int nb,
 			    const sc_fxcast_switch& cast_sw,
 			    sc_fxnum_fast_observer* observer_ )
 : sc_fxnum_fast( sc_fxtype_params( qm, om, nb ),
-		 SC_US,
+		 SC_US_,
 		 cast_sw,
 		 observer_ )
 {}
@@ -996,7 +996,7 @@ sc_ufix_fast::sc_ufix_fast( int wl_, int iwl_, sc_q_mode qm, sc_o_mode om,
 			    const sc_fxcast_switch& cast_sw,
 			    sc_fxnum_fast_observer* observer_ )
 : sc_fxnum_fast( sc_fxtype_params( wl_, iwl_, qm, om ),
-		 SC_US,
+		 SC_US_,
 		 cast_sw,
 		 observer_ )
 {}
@@ -1007,7 +1007,7 @@ sc_ufix_fast::sc_ufix_fast( int wl_, int iwl_,
 			    const sc_fxcast_switch& cast_sw,
 			    sc_fxnum_fast_observer* observer_ )
 : sc_fxnum_fast( sc_fxtype_params( wl_, iwl_, qm, om, nb ),
-		 SC_US,
+		 SC_US_,
 		 cast_sw,
 		 observer_ )
 {}
@@ -1016,7 +1016,7 @@ inline
 sc_ufix_fast::sc_ufix_fast( const sc_fxtype_params& type_params,
 			    sc_fxnum_fast_observer* observer_ )
 : sc_fxnum_fast( type_params,
-		 SC_US,
+		 SC_US_,
 		 sc_fxcast_switch(),
 		 observer_ )
 {}
@@ -1026,7 +1026,7 @@ sc_ufix_fast::sc_ufix_fast( const sc_fxtype_params& type_params,
 			    const sc_fxcast_switch& cast_sw,
 			    sc_fxnum_fast_observer* observer_ )
 : sc_fxnum_fast( type_params,
-		 SC_US,
+		 SC_US_,
 		 cast_sw,
 		 observer_ )
 {}
@@ -1037,7 +1037,7 @@ sc_ufix_fast::sc_ufix_fast( tp a,                                             \
 			    sc_fxnum_fast_observer* observer_ )               \
 : sc_fxnum_fast( a,                                                           \
 		 sc_fxtype_params(),                                          \
-		 SC_US,                                                       \
+		 SC_US_,                                                       \
 		 sc_fxcast_switch(),                                          \
 		 observer_ )                                                  \
 {}                                                                            \
@@ -1048,7 +1048,7 @@ sc_ufix_fast::sc_ufix_fast( tp a,                                             \
 			    sc_fxnum_fast_observer* observer_ )               \
 : sc_fxnum_fast( a,                                                           \
 		 sc_fxtype_params( wl_, iwl_ ),                               \
-		 SC_US,                                                       \
+		 SC_US_,                                                       \
 		 sc_fxcast_switch(),                                          \
 		 observer_ )                                                  \
 {}                                                                            \
@@ -1059,7 +1059,7 @@ sc_ufix_fast::sc_ufix_fast( tp a,                                             \
 			    sc_fxnum_fast_observer* observer_ )               \
 : sc_fxnum_fast( a,                                                           \
 		 sc_fxtype_params( qm, om ),                                  \
-		 SC_US,                                                       \
+		 SC_US_,                                                       \
 		 sc_fxcast_switch(),                                          \
 		 observer_ )                                                  \
 {}                                                                            \
@@ -1070,7 +1070,7 @@ sc_ufix_fast::sc_ufix_fast( tp a,                                             \
 			    sc_fxnum_fast_observer* observer_ )               \
 : sc_fxnum_fast( a,                                                           \
 		 sc_fxtype_params( qm, om, nb ),                              \
-		 SC_US,                                                       \
+		 SC_US_,                                                       \
 		 sc_fxcast_switch(),                                          \
 		 observer_ )                                                  \
 {}                                                                            \
@@ -1081,7 +1081,7 @@ sc_ufix_fast::sc_ufix_fast( tp a,                                             \
 			    sc_fxnum_fast_observer* observer_ )               \
 : sc_fxnum_fast( a,                                                           \
 		 sc_fxtype_params( wl_, iwl_, qm, om ),                       \
-		 SC_US,                                                       \
+		 SC_US_,                                                       \
 		 sc_fxcast_switch(),                                          \
 		 observer_ )                                                  \
 {}                                                                            \
@@ -1093,7 +1093,7 @@ sc_ufix_fast::sc_ufix_fast( tp a,                                             \
 			    sc_fxnum_fast_observer* observer_ )               \
 : sc_fxnum_fast( a,                                                           \
 		 sc_fxtype_params( wl_, iwl_, qm, om, nb ),                   \
-		 SC_US,                                                       \
+		 SC_US_,                                                       \
 		 sc_fxcast_switch(),                                          \
 		 observer_ )                                                  \
 {}                                                                            \
@@ -1104,7 +1104,7 @@ sc_ufix_fast::sc_ufix_fast( tp a,                                             \
 			    sc_fxnum_fast_observer* observer_ )               \
 : sc_fxnum_fast( a,                                                           \
 		 sc_fxtype_params(),                                          \
-		 SC_US,                                                       \
+		 SC_US_,                                                       \
 		 cast_sw,                                                     \
 		 observer_ )                                                  \
 {}                                                                            \
@@ -1116,7 +1116,7 @@ sc_ufix_fast::sc_ufix_fast( tp a,                                             \
 			    sc_fxnum_fast_observer* observer_ )               \
 : sc_fxnum_fast( a,                                                           \
 		 sc_fxtype_params( wl_, iwl_ ),                               \
-		 SC_US,                                                       \
+		 SC_US_,                                                       \
 		 cast_sw,                                                     \
 		 observer_ )                                                  \
 {}                                                                            \
@@ -1128,7 +1128,7 @@ sc_ufix_fast::sc_ufix_fast( tp a,                                             \
 			    sc_fxnum_fast_observer* observer_ )               \
 : sc_fxnum_fast( a,                                                           \
 		 sc_fxtype_params( qm, om ),                                  \
-		 SC_US,                                                       \
+		 SC_US_,                                                       \
 		 cast_sw,                                                     \
 		 observer_ )                                                  \
 {}                                                                            \
@@ -1140,7 +1140,7 @@ sc_ufix_fast::sc_ufix_fast( tp a,                                             \
 			    sc_fxnum_fast_observer* observer_ )               \
 : sc_fxnum_fast( a,                                                           \
 		 sc_fxtype_params( qm, om, nb ),                              \
-		 SC_US,                                                       \
+		 SC_US_,                                                       \
 		 cast_sw,                                                     \
 		 observer_ )                                                  \
 {}                                                                            \
@@ -1152,7 +1152,7 @@ sc_ufix_fast::sc_ufix_fast( tp a,                                             \
 			    sc_fxnum_fast_observer* observer_ )               \
 : sc_fxnum_fast( a,                                                           \
 		 sc_fxtype_params( wl_, iwl_, qm, om ),                       \
-		 SC_US,                                                       \
+		 SC_US_,                                                       \
 		 cast_sw,                                                     \
 		 observer_ )                                                  \
 {}                                                                            \
@@ -1165,7 +1165,7 @@ sc_ufix_fast::sc_ufix_fast( tp a,                                             \
 			    sc_fxnum_fast_observer* observer_ )               \
 : sc_fxnum_fast( a,                                                           \
 		 sc_fxtype_params( wl_, iwl_, qm, om, nb ),                   \
-		 SC_US,                                                       \
+		 SC_US_,                                                       \
 		 cast_sw,                                                     \
 		 observer_ )                                                  \
 {}                                                                            \
@@ -1176,7 +1176,7 @@ sc_ufix_fast::sc_ufix_fast( tp a,                                             \
 			    sc_fxnum_fast_observer* observer_ )               \
 : sc_fxnum_fast( a,                                                           \
 		 type_params,                                                 \
-		 SC_US,                                                       \
+		 SC_US_,                                                       \
 		 sc_fxcast_switch(),                                          \
 		 observer_ )                                                  \
 {}                                                                            \
@@ -1188,7 +1188,7 @@ sc_ufix_fast::sc_ufix_fast( tp a,                                             \
 			    sc_fxnum_fast_observer* observer_ )               \
 : sc_fxnum_fast( a,                                                           \
 		 type_params,                                                 \
-		 SC_US,                                                       \
+		 SC_US_,                                                       \
 		 cast_sw,                                                     \
 		 observer_ )                                                  \
 {}
@@ -1221,7 +1221,7 @@ inline
 sc_ufix_fast::sc_ufix_fast( const sc_ufix_fast& a )
 : sc_fxnum_fast( a,
 		 sc_fxtype_params(),
-		 SC_US,
+		 SC_US_,
 		 sc_fxcast_switch(),
 		 0 )
 {}
@@ -106,7 +106,7 @@ scfx_params::scfx_params( const sc_fxtype_params& type_params_,
   _enc( enc_ ),
   _cast_switch( cast_sw )
 {
-    if( _enc == SC_US && _type_params.o_mode() == SC_WRAP_SM )
+    if( _enc == SC_US_ && _type_params.o_mode() == SC_WRAP_SM )
     {
 	sc_report::error( _SC_ID_INVALID_O_MODE,
 			  "SC_WRAP_SM not defined for unsigned numbers" );
@@ -39,6 +39,7 @@
 #include "scfx_ieee.h"
 #include "scfx_pow10.h"
 #include "scfx_utils.h"
+#include "../../sc_mempool.h"
 
 #include "sc_bv.h"
 
@@ -563,50 +564,16 @@ scfx_rep::scfx_rep( const sc_unsigned& a )
 //  memory management of scfx_rep
 // ----------------------------------------------------------------------------
 
-union scfx_rep_node
-{
-    char           data[sizeof( scfx_rep )];
-    scfx_rep_node* next;
-};
-
-
-static scfx_rep_node* list = 0;
-
-
 void*
 scfx_rep::operator new( size_t size )
 {
-    const int ALLOC_SIZE = 1024;
-
-    if( size != sizeof( scfx_rep ) )
-	return ::operator new( size );
-
-    if( ! list )
-    {
-	list = new scfx_rep_node[ALLOC_SIZE];
-	for( int i = 0; i < ALLOC_SIZE - 1; i ++ )
-	    list[i].next = list + i + 1;
-	list[ALLOC_SIZE - 1].next = 0;
-    }
-
-    scfx_rep* ptr = reinterpret_cast<scfx_rep*>( list->data );
-    list = list->next;
-
-    return ptr;
+    return sc_mempool::allocate( size );
 }
 
 
 void scfx_rep::operator delete( void* ptr, size_t size )
 {
-    if( size != sizeof( scfx_rep ) )
-    {
-	::operator delete( ptr );
-	return;
-    }
-
-    scfx_rep_node* node = static_cast<scfx_rep_node*>( ptr );
-    node->next = list;
-    list = node;
+    sc_mempool::release( ptr, size );
 }
 
 
@@ -919,7 +886,7 @@ print_other( scfx_string& s, const scfx_rep& a, sc_numrep numrep, sc_fmt fmt,
 	msb = params->iwl() - 1;
 	lsb = params->iwl() - params->wl();
 
-	if( params->enc() == SC_TC &&
+	if( params->enc() == SC_TC_ &&
 	    ( numrep == SC_BIN_US ||
 	      numrep == SC_OCT_US ||
 	      numrep == SC_HEX_US ) &&
@@ -2146,7 +2113,7 @@ scfx_rep::overflow( const scfx_params& params, bool& o_flag )
 
     sc_enc enc = params.enc();
 
-    if( enc == SC_TC )
+    if( enc == SC_TC_ )
     {
 	if( is_neg() )
 	{
@@ -2225,10 +2192,10 @@ scfx_rep::overflow( const scfx_params& params, bool& o_flag )
 	    {
 		if( under )
 		{
-		    if( enc == SC_TC )
-			o_set_high( x, x2, SC_TC, -1 );
+		    if( enc == SC_TC_ )
+			o_set_high( x, x2, SC_TC_, -1 );
 		    else
-			o_set_low( x, SC_US );
+			o_set_low( x, SC_US_ );
 		}
 		else
 		    o_set_high( x, x2, enc );
@@ -2241,7 +2208,7 @@ scfx_rep::overflow( const scfx_params& params, bool& o_flag )
 	    }
             case SC_WRAP_SM:			// sign magnitude wrap-around
 	    {
-		_SC_ASSERT( enc == SC_TC,
+		_SC_ASSERT( enc == SC_TC_,
 			    "SC_WRAP_SM not defined for unsigned numbers" );
 
 		int n_bits = params.n_bits();
@@ -2256,7 +2223,7 @@ scfx_rep::overflow( const scfx_params& params, bool& o_flag )
 		    toggle_tc();
 		    if( o_bit_at( x4 ) != o_bit_at( x ) )
 			o_invert( x2 );
-		    o_extend( x, SC_TC );
+		    o_extend( x, SC_TC_ );
 		    toggle_tc();
 		}
 		else if( n_bits == 1 )
@@ -2264,7 +2231,7 @@ scfx_rep::overflow( const scfx_params& params, bool& o_flag )
 		    toggle_tc();
 		    if( is_neg() != o_bit_at( x ) )
 			o_invert( x2 );
-		    o_extend( x, SC_TC );
+		    o_extend( x, SC_TC_ );
 		    toggle_tc();
 		}
 		else if( n_bits < params.wl() )
@@ -2277,16 +2244,16 @@ scfx_rep::overflow( const scfx_params& params, bool& o_flag )
 		    toggle_tc();
 		    if( is_neg() == o_bit_at( x4 ) )
 			o_invert( x2 );
-		    o_set( x, x3, SC_TC, under );
-		    o_extend( x, SC_TC );
+		    o_set( x, x3, SC_TC_, under );
+		    o_extend( x, SC_TC_ );
 		    toggle_tc();
 		}
 		else
 		{
 		    if( under )
-			o_set_low( x, SC_TC );
+			o_set_low( x, SC_TC_ );
 		    else
-			o_set_high( x, x2, SC_TC );
+			o_set_high( x, x2, SC_TC_ );
 		}
 		break;
 	    }
@@ -2789,7 +2756,7 @@ scfx_rep::set( int i, const scfx_params& params )
 
     _mant[x.wi()] |= 1 << x.bi();
 
-    if( params.enc() == SC_TC && i == params.iwl() - 1 )
+    if( params.enc() == SC_TC_ && i == params.iwl() - 1 )
 	_sign = -1;
 
     toggle_tc();
@@ -2826,7 +2793,7 @@ scfx_rep::clear( int i, const scfx_params& params )
 
     _mant[x.wi()] &= ~( 1 << x.bi() );
 
-    if( params.enc() == SC_TC && i == params.iwl() - 1 )
+    if( params.enc() == SC_TC_ && i == params.iwl() - 1 )
 	_sign = 1;
 
     toggle_tc();
@@ -2956,7 +2923,7 @@ scfx_rep::get_type( int& wl, int& iwl, sc_enc& enc ) const
     {
         wl  = 0;
         iwl = 0;
-        enc = SC_TC;
+        enc = SC_TC_;
         return;
     }
 
@@ -2964,7 +2931,7 @@ scfx_rep::get_type( int& wl, int& iwl, sc_enc& enc ) const
     {
         wl  = 1;
         iwl = 1;
-        enc = SC_US;
+        enc = SC_US_;
         return;
     }
 
@@ -2982,13 +2949,13 @@ scfx_rep::get_type( int& wl, int& iwl, sc_enc& enc ) const
     {
         wl  = msb - lsb + 1;
         iwl = msb + 1;
-        enc = SC_TC;
+        enc = SC_TC_;
     }
     else
     {
         wl  = msb - lsb;
         iwl = msb;
-        enc = SC_US;
+        enc = SC_US_;
     }
 }
 
@@ -622,7 +622,7 @@ scfx_rep::o_extend( const scfx_index& x, sc_enc enc )
 
     _SC_ASSERT( wi >= 0 && wi < size(), "word index out of range" );
     
-    if( enc == SC_US || ( _mant[wi] & ( 1 << bi ) ) == 0 )
+    if( enc == SC_US_ || ( _mant[wi] & ( 1 << bi ) ) == 0 )
     {
         if( bi != bits_in_word - 1 )
 	    _mant[wi] &= ~( -1 << ( bi + 1 ) );
@@ -697,7 +697,7 @@ scfx_rep::o_set_low( const scfx_index& x, sc_enc enc )
 
     _mant.clear();
 
-    if( enc == SC_TC )
+    if( enc == SC_TC_ )
     {
 	_mant[wi] |= ( 1 << bi );
 	_sign = -1;
@@ -732,7 +732,7 @@ scfx_rep::o_set_high( const scfx_index& x, const scfx_index& x2,
     for( i = wi2 - 1; i >= 0; -- i )
 	_mant[i] = 0;
     
-    if( enc == SC_TC )
+    if( enc == SC_TC_ )
 	_sign = sign;
     else
     {
@@ -769,7 +769,7 @@ scfx_rep::o_set( const scfx_index& x, const scfx_index& x3,
 	    _mant[i] = static_cast<word>( -1 );
     }
 	
-    if( enc == SC_TC )
+    if( enc == SC_TC_ )
     {
 	if( under )
 	    _mant[wi] |= ( 1 << bi );
@@ -3119,6 +3119,24 @@ CLASS_TYPE::get_packed_rep(digit_type *buf) const
 }
 
 
+// Get the bits of the number in 2's complement, a digit at a time.
+void
+CLASS_TYPE::get_2c_digits(digit_type *buf) const
+{
+
+  if (sgn == SC_ZERO) {
+    vec_zero(ndigits, buf);
+    return;
+  }
+
+  vec_copy(ndigits, buf, digit);
+
+  if (sgn == SC_NEG)
+    vec_complement(ndigits, buf);
+
+}
+
+
 // Set a packed bit representation of the number.
 void 
 CLASS_TYPE::set_packed_rep(digit_type *buf)
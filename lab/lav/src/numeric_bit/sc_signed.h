@@ -318,6 +318,11 @@ public:
   void get_packed_rep(digit_type *buf) const;
   void set_packed_rep(digit_type *buf);
 
+  // Get the bits in 2's complement, BITS_PER_DIGIT of them per digit
+  // and the least significant digit first, for the trace files. buf
+  // must hold DIV_CEIL(length() + 1) digits.
+  void get_2c_digits(digit_type *buf) const;
+
   /*
     The comparison of the old and new semantics are as follows:
 
@@ -0,0 +1,81 @@
+/******************************************************************************
+    Copyright (c) 1996-2000 Synopsys, Inc.    ALL RIGHTS RESERVED
+
+  The contents of this file are subject to the restrictions and limitations
+  set forth in the SystemC(TM) Open Community License Software Download and
+  Use License Version 1.1 (the "License"); you may not use this file except
+  in compliance with such restrictions and limitations. You may obtain
+  instructions on how to receive a copy of the License at
+  http://www.systemc.org/. Software distributed by Original Contributor
+  under the License is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+  ANY KIND, either express or implied. See the License for the specific
+  language governing rights and limitations under the License.
+
+******************************************************************************/
+
+
+/******************************************************************************
+
+    qt.h -- native coroutine switching for x86-64 and AArch64, with the
+            QuickThreads interface used by the kernel.
+
+******************************************************************************/
+
+/******************************************************************************
+
+    MODIFICATION LOG - modifiers, enter your name, affliation and
+    changes you are making here:
+
+    Modifier Name & Affiliation:
+    Description of Modification:
+
+
+******************************************************************************/
+
+#ifndef QT_H
+#define QT_H
+
+//
+//  A suspended coroutine is represented by its stack pointer (qt_t*).
+//  The callee-saved registers of the suspended coroutine, and the
+//  address to resume at, are stored at the top of its stack.
+//
+//  QT_BLOCK(helper, a0, a1, new) saves the current coroutine, switches
+//  to the stack of `new', and calls helper(old_sp, a0, a1) there before
+//  resuming `new'.  The helper typically stores old_sp somewhere so that
+//  the old coroutine can be resumed later; whatever it returns becomes
+//  the return value of the QT_BLOCK that suspended `new'.  QT_ABORT is
+//  the same, except that the current coroutine is abandoned.
+//
+//  QT_ARGS prepares a fresh stack so that, when it is first switched
+//  to, only(pu, pt, userf) is called.  `only' must never return.
+//
+
+struct qt_t;
+
+typedef unsigned long qt_word_t;
+
+extern "C" {
+    typedef void* (qt_helper_t)( qt_t* old_sp, void* a0, void* a1 );
+    typedef void* (qt_userf_t)( void* pu );
+    typedef void  (qt_only_t)( void* pu, void* pt, qt_userf_t* userf );
+
+    void* qt_block( qt_helper_t* helper, void* a0, void* a1, qt_t* sp );
+    void  qt_abort( qt_helper_t* helper, void* a0, void* a1, qt_t* sp );
+    qt_t* qt_args( qt_t* sp, void* pu, void* pt,
+                   qt_userf_t* userf, qt_only_t* only );
+}
+
+#define QT_STKALIGN 16
+
+    // Initial stack pointer of a stack of `size' bytes starting at `sto'
+#define QT_SP(sto, size) \
+    ((qt_t*) (((qt_word_t) (sto) + (size)) & ~(qt_word_t) (QT_STKALIGN - 1)))
+
+#define QT_ARGS(sp, pu, pt, userf, only) \
+    qt_args( (sp), (pu), (pt), (userf), (only) )
+
+#define QT_BLOCK qt_block
+#define QT_ABORT qt_abort
+
+#endif
@@ -0,0 +1,206 @@
+/******************************************************************************
+    Copyright (c) 1996-2000 Synopsys, Inc.    ALL RIGHTS RESERVED
+
+  The contents of this file are subject to the restrictions and limitations
+  set forth in the SystemC(TM) Open Community License Software Download and
+  Use License Version 1.1 (the "License"); you may not use this file except
+  in compliance with such restrictions and limitations. You may obtain
+  instructions on how to receive a copy of the License at
+  http://www.systemc.org/. Software distributed by Original Contributor
+  under the License is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+  ANY KIND, either express or implied. See the License for the specific
+  language governing rights and limitations under the License.
+
+******************************************************************************/
+
+
+/******************************************************************************
+
+    qt_native.cpp -- native coroutine switching for x86-64 and AArch64.
+
+******************************************************************************/
+
+/******************************************************************************
+
+    MODIFICATION LOG - modifiers, enter your name, affliation and
+    changes you are making here:
+
+    Modifier Name & Affiliation:
+    Description of Modification:
+
+
+******************************************************************************/
+
+#ifndef WIN32
+
+#include "qt.h"
+
+/*
+   Only the registers the calling convention requires a callee to
+   preserve are saved; everything else is already saved by the caller of
+   qt_block(), which is an ordinary function call as far as the compiler
+   is concerned.
+
+   Saved frame, from the saved stack pointer upwards:
+
+     x86-64:  mxcsr, x87 control word (8 bytes), r15, r14, r13, r12,
+              rbx, rbp, return address                     -- 64 bytes
+     AArch64: x19 .. x28, x29, x30 (return address), d8 .. d15
+                                                           -- 160 bytes
+
+   A fresh stack gets a frame whose return address is qt_start, with the
+   arguments of `only' in the first saved registers.
+*/
+
+#if defined(__x86_64__)
+
+__asm__ (
+    ".text\n"
+    ".globl qt_block\n"
+    ".type qt_block, @function\n"
+    ".p2align 4\n"
+"qt_block:\n"
+    "pushq %rbp\n"
+    "pushq %rbx\n"
+    "pushq %r12\n"
+    "pushq %r13\n"
+    "pushq %r14\n"
+    "pushq %r15\n"
+    "subq $8, %rsp\n"
+    "stmxcsr (%rsp)\n"
+    "fnstcw 4(%rsp)\n"
+".Lqt_switch:\n"
+    "movq %rdi, %rax\n"         /* helper */
+    "movq %rsp, %rdi\n"         /* old sp is the helper's first argument */
+    "movq %rcx, %rsp\n"
+    "call *%rax\n"              /* helper(old, a0, a1), on the new stack */
+    "ldmxcsr (%rsp)\n"
+    "fldcw 4(%rsp)\n"
+    "addq $8, %rsp\n"
+    "popq %r15\n"
+    "popq %r14\n"
+    "popq %r13\n"
+    "popq %r12\n"
+    "popq %rbx\n"
+    "popq %rbp\n"
+    "ret\n"                     /* the helper's value is still in %rax */
+    ".size qt_block, .-qt_block\n"
+
+    ".globl qt_abort\n"
+    ".type qt_abort, @function\n"
+    ".p2align 4\n"
+"qt_abort:\n"
+    "jmp .Lqt_switch\n"
+    ".size qt_abort, .-qt_abort\n"
+
+    ".type qt_start, @function\n"
+    ".p2align 4\n"
+"qt_start:\n"
+    "movq %r12, %rdi\n"
+    "movq %r13, %rsi\n"
+    "movq %r14, %rdx\n"
+    "call *%r15\n"
+    "ud2\n"                     /* `only' must not return */
+    ".size qt_start, .-qt_start\n"
+);
+
+extern "C" void qt_start();
+
+static const int qt_frame_words = 8;
+
+qt_t*
+qt_args( qt_t* sp, void* pu, void* pt, qt_userf_t* userf, qt_only_t* only )
+{
+    qt_word_t* top = (qt_word_t*) ((qt_word_t) sp & ~(qt_word_t) (QT_STKALIGN - 1));
+    qt_word_t* f = top - qt_frame_words;
+    f[0] = 0x037f00001f80UL;    /* default mxcsr and x87 control word */
+    f[1] = (qt_word_t) only;    /* r15 */
+    f[2] = (qt_word_t) userf;   /* r14 */
+    f[3] = (qt_word_t) pt;      /* r13 */
+    f[4] = (qt_word_t) pu;      /* r12 */
+    f[5] = 0;                   /* rbx */
+    f[6] = 0;                   /* rbp */
+    f[7] = (qt_word_t) qt_start;
+    return (qt_t*) f;
+}
+
+#elif defined(__aarch64__)
+
+__asm__ (
+    ".text\n"
+    ".globl qt_block\n"
+    ".type qt_block, %function\n"
+    ".p2align 4\n"
+"qt_block:\n"
+    "sub sp, sp, #160\n"
+    "stp x19, x20, [sp, #0]\n"
+    "stp x21, x22, [sp, #16]\n"
+    "stp x23, x24, [sp, #32]\n"
+    "stp x25, x26, [sp, #48]\n"
+    "stp x27, x28, [sp, #64]\n"
+    "stp x29, x30, [sp, #80]\n"
+    "stp d8, d9, [sp, #96]\n"
+    "stp d10, d11, [sp, #112]\n"
+    "stp d12, d13, [sp, #128]\n"
+    "stp d14, d15, [sp, #144]\n"
+".Lqt_switch:\n"
+    "mov x4, x0\n"              /* helper */
+    "mov x0, sp\n"              /* old sp is the helper's first argument */
+    "mov sp, x3\n"
+    "blr x4\n"                  /* helper(old, a0, a1), on the new stack */
+    "ldp x19, x20, [sp, #0]\n"
+    "ldp x21, x22, [sp, #16]\n"
+    "ldp x23, x24, [sp, #32]\n"
+    "ldp x25, x26, [sp, #48]\n"
+    "ldp x27, x28, [sp, #64]\n"
+    "ldp x29, x30, [sp, #80]\n"
+    "ldp d8, d9, [sp, #96]\n"
+    "ldp d10, d11, [sp, #112]\n"
+    "ldp d12, d13, [sp, #128]\n"
+    "ldp d14, d15, [sp, #144]\n"
+    "add sp, sp, #160\n"
+    "ret\n"                     /* the helper's value is still in x0 */
+    ".size qt_block, .-qt_block\n"
+
+    ".globl qt_abort\n"
+    ".type qt_abort, %function\n"
+    ".p2align 4\n"
+"qt_abort:\n"
+    "b .Lqt_switch\n"
+    ".size qt_abort, .-qt_abort\n"
+
+    ".type qt_start, %function\n"
+    ".p2align 4\n"
+"qt_start:\n"
+    "mov x0, x19\n"
+    "mov x1, x20\n"
+    "mov x2, x21\n"
+    "blr x22\n"
+    "brk #0\n"                  /* `only' must not return */
+    ".size qt_start, .-qt_start\n"
+);
+
+extern "C" void qt_start();
+
+static const int qt_frame_words = 20;
+
+qt_t*
+qt_args( qt_t* sp, void* pu, void* pt, qt_userf_t* userf, qt_only_t* only )
+{
+    qt_word_t* top = (qt_word_t*) ((qt_word_t) sp & ~(qt_word_t) (QT_STKALIGN - 1));
+    qt_word_t* f = top - qt_frame_words;
+    for (int i = 0; i < qt_frame_words; ++i)
+        f[i] = 0;
+    f[0]  = (qt_word_t) pu;     /* x19 */
+    f[1]  = (qt_word_t) pt;     /* x20 */
+    f[2]  = (qt_word_t) userf;  /* x21 */
+    f[3]  = (qt_word_t) only;   /* x22 */
+    f[11] = (qt_word_t) qt_start;   /* x30 */
+    return (qt_t*) f;
+}
+
+#else
+#error "No native coroutine switching for this architecture"
+#endif
+
+#endif
@@ -60,7 +60,7 @@ protected:
     void decl_output( const sc_signal_base& );
     void decl_output( const sc_signal_array_base& );
 
-    void wait()       { sc_module::wait(); }
+    void wait()       { (void) sc_module::wait(); }
 
 private:
     void init( size_t stack_size );
@@ -63,6 +63,7 @@ using std::size_t;
 #include "sc_signal.h"
 #include "sc_signal_array.h"
 #include "sc_module.h"
+#include "sc_stack_pool.h"
 
 #include "sc_bool_vector.h"
 
@@ -94,14 +95,16 @@ sc_aproc_process::sc_aproc_process(const char* nm,
 #else
     pFiber          = (PVOID)0;
 #endif
+    co              = 0;
 
     next_handle = 0;
 }
 
 sc_aproc_process::~sc_aproc_process()
 {
+    sc_co_helpers::destroy( co );
 #ifndef WIN32
-    delete[] (char*)stack;
+    sc_stack_pool::release( stack, stack_size );
 #else
     if ((PVOID) 0 != pFiber)
         DeleteFiber( pFiber );
@@ -117,11 +120,14 @@ sc_aproc_process::set_stack_size(size_t size)
 void
 sc_aproc_process::prepare_for_simulation()
 {
+    if (co != 0) {
+        /* A stackless process needs nothing but its coroutine frame */
+        sc_co_helpers::start( co, module );
+        return;
+    }
 #ifndef WIN32
-    stack = new char[stack_size];
-    assert( stack != 0 );
-    void* sto = stack_align( stack, QT_STKALIGN, &stack_size );
-    sp = QT_SP( sto, stack_size - QT_STKALIGN );
+    stack = sc_stack_pool::allocate( &stack_size );
+    sp = QT_SP( stack, stack_size );
     sp = QT_ARGS( sp, this, this, 0, sc_aproc_process_only );
 #else
     // forward declare fiber function
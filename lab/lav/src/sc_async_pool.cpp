@@ -0,0 +1,316 @@
+/******************************************************************************
+    Copyright (c) 1996-2000 Synopsys, Inc.    ALL RIGHTS RESERVED
+
+  The contents of this file are subject to the restrictions and limitations
+  set forth in the SystemC(TM) Open Community License Software Download and
+  Use License Version 1.1 (the "License"); you may not use this file except
+  in compliance with such restrictions and limitations. You may obtain
+  instructions on how to receive a copy of the License at
+  http://www.systemc.org/. Software distributed by Original Contributor
+  under the License is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+  ANY KIND, either express or implied. See the License for the specific
+  language governing rights and limitations under the License.
+
+******************************************************************************/
+
+/******************************************************************************
+
+    sc_async_pool.cpp -- worker pool for evaluating the ready sc_async
+                         processes of a delta cycle on several threads.
+
+******************************************************************************/
+
+/******************************************************************************
+
+    MODIFICATION LOG - modifiers, enter your name, affliation and
+    changes you are making here:
+
+    Modifier Name & Affiliation:
+    Description of Modification:
+
+
+******************************************************************************/
+
+#include <assert.h>
+
+#ifdef WIN32
+#include "sc_cmnhdr.h"
+#include <Windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#include "sc_async_pool.h"
+#include "sc_mempool.h"
+#include "sc_process_int.h"
+#include "sc_simcontext.h"
+
+#ifdef _MSC_VER
+#define SC_THREAD_LOCAL __declspec(thread)
+#else
+#define SC_THREAD_LOCAL __thread
+#endif
+
+struct sc_async_worker {
+    sc_async_pool*   pool;
+    int              index;
+    int              seen_generation;
+
+    /* Signals submitted by the processes run on this worker */
+    sc_signal_base** queue;
+    int              lastof_queue;
+
+    /* The process this worker is running; see sc_simcontext::set_curr_proc() */
+    sc_curr_proc_info proc_info;
+
+#ifdef WIN32
+    HANDLE           thread;
+    HANDLE           start_event;
+#else
+    pthread_t        thread;
+#endif
+};
+
+struct sc_async_pool_sync {
+#ifdef WIN32
+    HANDLE          done_event;
+    LONG            num_running;
+#else
+    pthread_mutex_t mutex;
+    pthread_cond_t  start_cond;
+    pthread_cond_t  done_cond;
+    int             num_running;
+#endif
+};
+
+/* The worker the current thread is running as; 0 outside of execute() */
+static SC_THREAD_LOCAL sc_async_worker* curr_worker = 0;
+
+
+sc_async_pool::sc_async_pool( int num_threads, int num_signals )
+{
+    assert( num_threads > 1 );
+
+    nthreads      = num_threads;
+    curr_asyncs   = 0;
+    curr_count    = 0;
+    generation    = 0;
+    shutting_down = false;
+
+    sync = new sc_async_pool_sync;
+#ifdef WIN32
+    sync->done_event  = CreateEvent( NULL, FALSE, FALSE, NULL );
+    sync->num_running = 0;
+#else
+    pthread_mutex_init( &sync->mutex, 0 );
+    pthread_cond_init( &sync->start_cond, 0 );
+    pthread_cond_init( &sync->done_cond, 0 );
+    sync->num_running = 0;
+#endif
+
+    workers = new sc_async_worker[nthreads];
+    for (int k = 0; k < nthreads; ++k) {
+        sc_async_worker* w = &workers[k];
+        w->pool            = this;
+        w->index           = k;
+        w->seen_generation = 0;
+        w->queue           = new sc_signal_base*[num_signals > 0 ? num_signals : 1];
+        w->lastof_queue    = -1;
+        w->proc_info.process_handle = 0;
+        w->proc_info.kind           = SC_CURR_PROC_NONE;
+    }
+
+    /* Worker 0 is the simulation thread itself */
+    for (int k = 1; k < nthreads; ++k) {
+        sc_async_worker* w = &workers[k];
+#ifdef WIN32
+        w->start_event = CreateEvent( NULL, FALSE, FALSE, NULL );
+        w->thread = CreateThread( NULL, 0, worker_main, w, 0, NULL );
+#else
+        pthread_create( &w->thread, 0, worker_main, w );
+#endif
+    }
+}
+
+sc_async_pool::~sc_async_pool()
+{
+#ifdef WIN32
+    shutting_down = true;
+    for (int k = 1; k < nthreads; ++k) {
+        SetEvent( workers[k].start_event );
+    }
+    for (int k = 1; k < nthreads; ++k) {
+        WaitForSingleObject( workers[k].thread, INFINITE );
+        CloseHandle( workers[k].thread );
+        CloseHandle( workers[k].start_event );
+    }
+    CloseHandle( sync->done_event );
+#else
+    pthread_mutex_lock( &sync->mutex );
+    shutting_down = true;
+    pthread_cond_broadcast( &sync->start_cond );
+    pthread_mutex_unlock( &sync->mutex );
+    for (int k = 1; k < nthreads; ++k) {
+        pthread_join( workers[k].thread, 0 );
+    }
+    pthread_cond_destroy( &sync->done_cond );
+    pthread_cond_destroy( &sync->start_cond );
+    pthread_mutex_destroy( &sync->mutex );
+#endif
+
+    for (int k = 0; k < nthreads; ++k) {
+        delete[] workers[k].queue;
+    }
+    delete[] workers;
+    delete sync;
+}
+
+void
+sc_async_pool::execute( sc_async_process_handle* asyncs, int count,
+                        sc_signal_base** signals_to_update, int* lastof )
+{
+    curr_asyncs = asyncs;
+    curr_count  = count;
+
+    /* Wake up the helpers */
+#ifdef WIN32
+    ++generation;
+    sync->num_running = nthreads - 1;
+    for (int k = 1; k < nthreads; ++k) {
+        SetEvent( workers[k].start_event );
+    }
+#else
+    pthread_mutex_lock( &sync->mutex );
+    ++generation;
+    sync->num_running = nthreads - 1;
+    pthread_cond_broadcast( &sync->start_cond );
+    pthread_mutex_unlock( &sync->mutex );
+#endif
+
+    /* ... and do our share of the work in the meantime */
+    curr_worker = &workers[0];
+    run_chunk( 0 );
+    curr_worker = 0;
+
+#ifdef WIN32
+    WaitForSingleObject( sync->done_event, INFINITE );
+#else
+    pthread_mutex_lock( &sync->mutex );
+    while (sync->num_running > 0) {
+        pthread_cond_wait( &sync->done_cond, &sync->mutex );
+    }
+    pthread_mutex_unlock( &sync->mutex );
+#endif
+
+    /* The serial loop runs asyncs_to_execute from the back; the last
+       chunk therefore comes first.  Merging the queues in this order
+       gives the same update order as the serial loop. */
+    int l_lastof = *lastof;
+    for (int k = nthreads - 1; k >= 0; --k) {
+        sc_async_worker* w = &workers[k];
+        for (int j = 0; j <= w->lastof_queue; ++j) {
+            signals_to_update[++l_lastof] = w->queue[j];
+        }
+        w->lastof_queue = -1;
+    }
+    *lastof = l_lastof;
+}
+
+void
+sc_async_pool::submit_update( sc_signal_base* sig )
+{
+    sc_async_worker* w = curr_worker;
+    assert( w != 0 );
+    w->queue[++w->lastof_queue] = sig;
+}
+
+void
+sc_async_pool::run_chunk( int k )
+{
+    int chunk = (curr_count + nthreads - 1) / nthreads;
+    int lo = k * chunk;
+    int hi = lo + chunk;
+    if (hi > curr_count)
+        hi = curr_count;
+
+    sc_async_process_handle* const l_asyncs = curr_asyncs;
+    sc_curr_proc_info* const info = &workers[k].proc_info;
+    info->kind = SC_CURR_PROC_ASYNC;
+    for (int i = hi - 1; i >= lo; --i) {
+        sc_async_process_handle async = l_asyncs[i];
+        info->process_handle = async;
+        async->set_in_updateq( false );
+        async->execute();
+    }
+    info->process_handle = 0;
+    info->kind           = SC_CURR_PROC_NONE;
+}
+
+const sc_curr_proc_info*
+sc_async_pool::curr_proc_info()
+{
+    sc_async_worker* w = curr_worker;
+    assert( w != 0 );
+    return &w->proc_info;
+}
+
+void
+sc_async_pool::wait_for_start( sc_async_worker* w )
+{
+#ifdef WIN32
+    WaitForSingleObject( w->start_event, INFINITE );
+    w->seen_generation = generation;
+#else
+    pthread_mutex_lock( &sync->mutex );
+    while (! shutting_down && w->seen_generation == generation) {
+        pthread_cond_wait( &sync->start_cond, &sync->mutex );
+    }
+    w->seen_generation = generation;
+    pthread_mutex_unlock( &sync->mutex );
+#endif
+}
+
+void
+sc_async_pool::signal_done()
+{
+#ifdef WIN32
+    if (InterlockedDecrement( &sync->num_running ) == 0) {
+        SetEvent( sync->done_event );
+    }
+#else
+    pthread_mutex_lock( &sync->mutex );
+    if (--sync->num_running == 0) {
+        pthread_cond_signal( &sync->done_cond );
+    }
+    pthread_mutex_unlock( &sync->mutex );
+#endif
+}
+
+#ifdef WIN32
+unsigned long __stdcall
+sc_async_pool::worker_main( void* arg )
+#else
+void*
+sc_async_pool::worker_main( void* arg )
+#endif
+{
+    sc_async_worker* w = (sc_async_worker*) arg;
+    sc_async_pool* pool = w->pool;
+    curr_worker = w;
+
+    while (true) {
+        pool->wait_for_start( w );
+        if (pool->shutting_down)
+            break;
+        pool->run_chunk( w->index );
+        pool->signal_done();
+    }
+    sc_mempool::flush_thread_cache();
+    return 0;
+}
+
+void
+sc_set_async_threads( int num_threads )
+{
+    sc_get_curr_simcontext()->set_async_threads( num_threads );
+}
@@ -0,0 +1,112 @@
+/******************************************************************************
+    Copyright (c) 1996-2000 Synopsys, Inc.    ALL RIGHTS RESERVED
+
+  The contents of this file are subject to the restrictions and limitations
+  set forth in the SystemC(TM) Open Community License Software Download and
+  Use License Version 1.1 (the "License"); you may not use this file except
+  in compliance with such restrictions and limitations. You may obtain
+  instructions on how to receive a copy of the License at
+  http://www.systemc.org/. Software distributed by Original Contributor
+  under the License is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+  ANY KIND, either express or implied. See the License for the specific
+  language governing rights and limitations under the License.
+
+******************************************************************************/
+
+/******************************************************************************
+
+    sc_async_pool.h -- worker pool for evaluating the ready sc_async
+                       processes of a delta cycle on several threads.
+
+******************************************************************************/
+
+/******************************************************************************
+
+    MODIFICATION LOG - modifiers, enter your name, affliation and
+    changes you are making here:
+
+    Modifier Name & Affiliation:
+    Description of Modification:
+
+
+******************************************************************************/
+
+#ifndef SC_ASYNC_POOL_H
+#define SC_ASYNC_POOL_H
+
+#include "sc_process.h"
+
+class sc_signal_base;
+struct sc_async_worker;
+struct sc_curr_proc_info;
+
+//
+//  <summary> Parallel evaluation of sc_async processes </summary>
+//
+//  During the evaluation phase of a delta cycle every signal read by an
+//  sc_async process is frozen, so the ready processes may run in any
+//  order.  sc_async_pool splits asyncs_to_execute into contiguous chunks,
+//  one per worker, and each worker collects the signals it submits in a
+//  private update queue.  The queues are appended to the simulation
+//  context's queue in chunk order, which reproduces exactly the update
+//  order of the serial loop in sc_simcontext::crunch().
+//
+//  The pool is opt-in (see sc_set_async_threads()).  It requires that a
+//  signal is written by at most one process per delta cycle, and that
+//  processes do not share unprotected state other than signals.  Each
+//  worker keeps its own current process, so sc_get_curr_process_handle()
+//  and the checks built on it see the async that the worker runs.
+//
+class sc_async_pool {
+public:
+        // Creates a pool of `num_threads' workers, the calling thread
+        // being worker 0.  `num_signals' bounds the size of each
+        // private update queue.
+    sc_async_pool( int num_threads, int num_signals );
+    ~sc_async_pool();
+
+    int num_threads() const { return nthreads; }
+
+        // Executes asyncs[0..count-1] on all workers and blocks until
+        // every one of them has finished.  The signals submitted by the
+        // processes are appended to `signals_to_update', starting after
+        // index `*lastof'.
+    void execute( sc_async_process_handle* asyncs, int count,
+                  sc_signal_base** signals_to_update, int* lastof );
+
+        // Called by sc_simcontext::submit_update() while the pool is
+        // executing; puts the signal on the calling worker's queue.
+    static void submit_update( sc_signal_base* sig );
+
+        // Called by sc_simcontext::get_curr_proc_info() while the pool
+        // is executing; the process run by the calling worker.
+    static const sc_curr_proc_info* curr_proc_info();
+
+private:
+    void run_chunk( int k );
+    void wait_for_start( sc_async_worker* w );
+    void signal_done();
+
+#ifdef WIN32
+    static unsigned long __stdcall worker_main( void* arg );
+#else
+    static void* worker_main( void* arg );
+#endif
+
+private:
+    int                      nthreads;
+    sc_async_worker*         workers;
+
+    /* The work of the current delta cycle */
+    sc_async_process_handle* curr_asyncs;
+    int                      curr_count;
+
+    int                      generation;   /* bumped for every execute() */
+    bool                     shutting_down;
+
+    struct sc_async_pool_sync* sync;       /* platform-dependent */
+};
+
+extern void sc_set_async_threads( int num_threads );
+
+#endif
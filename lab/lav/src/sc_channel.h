@@ -118,6 +118,7 @@ public:
 #endif
 
   void trace( sc_trace_file* tf ) const;
+  void checkpoint( sc_checkpoint& cp );
 
 protected:
   // Stores the value in the channel buffers
@@ -129,7 +130,6 @@ protected:
   virtual sc_signal_base::UPDATE_FUNC* update_funcs_array() const;
   virtual void update();
   void update_nonv();
-  virtual void update_old();
 
 private:
   // Got to have this function here so that we assert
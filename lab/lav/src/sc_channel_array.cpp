@@ -112,11 +112,3 @@ sc_channel_array_base::update()
         indiv_channels[i]->update();
     }
 }
-
-void
-sc_channel_array_base::update_old()
-{
-    for (int i = 0; i < _length; ++i) {
-        indiv_channels[i]->update_old();
-    }
-}
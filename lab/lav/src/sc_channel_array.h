@@ -65,6 +65,9 @@ public:
     void decl_sensitive_aproc( sc_aproc_process_handle aproc ) const;
     int length() const { return _length; }
 
+        // Nothing to save: the elements are signals of their own
+    void checkpoint( sc_checkpoint& ) { }
+
 protected:
     sc_channel_array_base( sc_object* from );
     sc_channel_array_base( const char* nm, sc_object* from );
@@ -73,7 +76,6 @@ protected:
     // atomic channels only
     virtual sc_signal_base::UPDATE_FUNC* update_funcs_array() const;
     virtual void update();
-    virtual void update_old();
 
     int _length;
     sc_signal_base** indiv_channels;
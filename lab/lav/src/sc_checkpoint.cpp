@@ -0,0 +1,659 @@
+/******************************************************************************
+    Copyright (c) 1996-2000 Synopsys, Inc.    ALL RIGHTS RESERVED
+
+  The contents of this file are subject to the restrictions and limitations
+  set forth in the SystemC(TM) Open Community License Software Download and
+  Use License Version 1.1 (the "License"); you may not use this file except
+  in compliance with such restrictions and limitations. You may obtain
+  instructions on how to receive a copy of the License at
+  http://www.systemc.org/. Software distributed by Original Contributor
+  under the License is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+  ANY KIND, either express or implied. See the License for the specific
+  language governing rights and limitations under the License.
+
+******************************************************************************/
+
+/******************************************************************************
+
+    sc_checkpoint.cpp -- saving and restoring the state of a simulation.
+
+******************************************************************************/
+
+/******************************************************************************
+
+    MODIFICATION LOG - modifiers, enter your name, affliation and
+    changes you are making here:
+
+    Modifier Name & Affiliation:
+    Description of Modification:
+
+
+******************************************************************************/
+
+
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+#ifndef _MSC_VER
+#include <iostream>
+using std::cerr;
+using std::endl;
+#else
+#include <iostream.h>
+#endif
+
+#include "sc_pq.h"
+#include "sc_edge_calendar.h"
+#include "sc_simcontext.h"
+#include "sc_signal.h"
+#include "sc_clock.h"
+#include "sc_signal_delay.h"
+#include "sc_lambda.h"
+#include "sc_module.h"
+#include "sc_process_int.h"
+#include "sc_checkpoint.h"
+
+/* The file starts with this, followed by the time and the delta cycle.
+   Then come records, each of which is a name, the length of its
+   payload and the payload: one for each clock edge, one for each slot
+   of the list of signals, and one for each other object with state,
+   the last of these followed by a record with an empty name.  Values
+   are in the byte order of the machine. */
+static const char checkpoint_magic[] = "SystemC checkpoint 1\n";
+
+sc_checkpoint::sc_checkpoint( sc_simcontext* s, bool restore )
+{
+    simc = s;
+    is_restore = restore;
+    failed = false;
+    curr_name = "";
+
+    buf = 0;
+    buf_len = 0;
+    buf_alloc = 0;
+    pos = 0;
+    limit = 0;
+}
+
+sc_checkpoint::~sc_checkpoint()
+{
+    delete[] buf;
+}
+
+void
+sc_checkpoint::put( const void* p, size_t n )
+{
+    if (buf_len + n > buf_alloc) {
+        size_t new_alloc = buf_alloc ? 2 * buf_alloc : 65536;
+        while (new_alloc < buf_len + n)
+            new_alloc *= 2;
+        char* new_buf = new char[new_alloc];
+        if (buf_len > 0)
+            memcpy( new_buf, buf, buf_len );
+        delete[] buf;
+        buf = new_buf;
+        buf_alloc = new_alloc;
+    }
+    memcpy( buf + buf_len, p, n );
+    buf_len += n;
+}
+
+bool
+sc_checkpoint::get_ok( size_t n )
+{
+    if (pos + n > limit) {
+        if (! failed)
+            cerr << "SystemC error: checkpoint data for `" << curr_name
+                 << "' is shorter than expected." << endl;
+        failed = true;
+        return false;
+    }
+    return true;
+}
+
+void
+sc_checkpoint::get( void* p, size_t n )
+{
+    if (! get_ok( n )) {
+        memset( p, 0, n );
+        return;
+    }
+    memcpy( p, buf + pos, n );
+    pos += n;
+}
+
+void
+sc_checkpoint::put_string( const char* s )
+{
+    size_t n = strlen( s ) + 1;
+    put( &n, sizeof(n) );
+    put( s, n );
+}
+
+const char*
+sc_checkpoint::get_string()
+{
+    size_t n = 0;
+    get( &n, sizeof(n) );
+    if (n == 0 || ! get_ok( n ) || buf[pos + n - 1] != '\0') {
+        failed = true;
+        return "";
+    }
+    const char* s = buf + pos;
+    pos += n;
+    return s;
+}
+
+void
+sc_checkpoint::io_bytes( void* p, size_t n )
+{
+    if (is_restore)
+        get( p, n );
+    else
+        put( p, n );
+}
+
+void
+sc_checkpoint::io_object( sc_object*& obj )
+{
+    if (! is_restore) {
+        put_string( obj ? obj->name() : "" );
+        return;
+    }
+    const char* name = get_string();
+    obj = 0;
+    if (name[0]) {
+        obj = simc->find_object( name );
+        if (obj == 0) {
+            cerr << "SystemC error: checkpoint data for `" << curr_name
+                 << "' refers to `" << name << "', which does not exist."
+                 << endl;
+            failed = true;
+        }
+    }
+}
+
+void
+sc_checkpoint::io_process( sc_process_b*& proc )
+{
+    sc_object* obj = proc;
+    io_object( obj );
+    proc = is_restore ? DCAST( sc_process_b*, obj ) : proc;
+}
+
+void
+sc_checkpoint::unsupported()
+{
+    cerr << "SystemC error: the state of `" << curr_name
+         << "' cannot be checkpointed." << endl;
+    failed = true;
+}
+
+/*****************************************************************************/
+
+/* Each record: the name, the length of the payload and the payload */
+size_t
+sc_checkpoint::begin_record( const char* name )
+{
+    curr_name = name;
+    put_string( name );
+    size_t len = 0;
+    put( &len, sizeof(len) );
+    return buf_len;
+}
+
+void
+sc_checkpoint::end_record( size_t start )
+{
+    size_t len = buf_len - start;
+    memcpy( buf + start - sizeof(len), &len, sizeof(len) );
+}
+
+/* Reads the header of the next record, and limits reading to its
+   payload until end_of_record() */
+const char*
+sc_checkpoint::next_record()
+{
+    limit = buf_len;
+    const char* name = get_string();
+    size_t len = 0;
+    get( &len, sizeof(len) );
+    if (failed || ! get_ok( len ))
+        return 0;
+    limit = pos + len;
+    curr_name = name;
+    return name;
+}
+
+void
+sc_checkpoint::end_of_record()
+{
+    if (pos != limit && ! failed) {
+        cerr << "SystemC error: checkpoint data for `" << curr_name
+             << "' is longer than expected." << endl;
+        failed = true;
+    }
+    pos = limit;
+    limit = buf_len;
+}
+
+/*****************************************************************************/
+
+void
+sc_checkpoint::save_edge( sc_clock_edge* edge )
+{
+    int phase = edge->phase();
+    put( &phase, sizeof(phase) );
+    put( &edge->next_time, sizeof(edge->next_time) );
+    put( &edge->cycle, sizeof(edge->cycle) );
+    put( &edge->delay_seq, sizeof(edge->delay_seq) );
+
+    /* The pending delayed writes: those in the wheel in the order of
+       their slots, then those in the queue in the order they come
+       due.  The queue is emptied and refilled to get at them. */
+    sc_pvector<sc_signal_delay_base*> pending;
+    int n_wheel = 0;
+    if (edge->delay_wheel != 0) {
+        for (int i = 0; i < SYSTEMC_DELAY_WHEEL_SIZE; ++i) {
+            for (sc_signal_delay_base* sd = edge->delay_wheel[i];
+                 sd != 0; sd = sd->get_next())
+                pending.push_back( sd );
+        }
+        n_wheel = pending.size();
+        while (! edge->delay_overflow->empty())
+            pending.push_back( edge->delay_overflow->extract_top() );
+        for (int i = n_wheel; i < pending.size(); ++i)
+            edge->delay_overflow->insert( pending[i] );
+    }
+
+    /* A write to a signal array is saved as the writes to its elements,
+       which are restored as delayed writes of their own. */
+    sc_pvector<sc_signal_delay_base*> parts;
+    sc_pvector<sc_signal_delay_base*> owners;
+    int n_wheel_parts = 0;
+    for (int i = 0; i < pending.size(); ++i) {
+        sc_signal_delay_base* sd = pending[i];
+        sd->split( parts );
+        while (owners.size() < parts.size())
+            owners.push_back( sd );
+        if (i < n_wheel)
+            n_wheel_parts = parts.size();
+    }
+
+    int n = parts.size();
+    put( &n, sizeof(n) );
+    for (int i = 0; i < n; ++i) {
+        sc_signal_delay_base* sd = parts[i];
+        sc_signal_delay_base* owner = owners[i];
+        int in_wheel = (i < n_wheel_parts);
+        put( &in_wheel, sizeof(in_wheel) );
+        put( &owner->due, sizeof(owner->due) );
+        put( &owner->seq, sizeof(owner->seq) );
+        put( &sd->dest->sig_index, sizeof(sd->dest->sig_index) );
+        sc_object* proc = (sc_object*) sd->proc;
+        io_object( proc );
+        curr_name = sd->dest->name();
+        sd->checkpoint_value( *this );
+        if (sd != owner)
+            delete sd;
+    }
+}
+
+void
+sc_checkpoint::restore_edge( sc_clock_edge* edge )
+{
+    int phase = 0;
+    get( &phase, sizeof(phase) );
+    if (phase != edge->phase()) {
+        cerr << "SystemC error: checkpoint does not match the edges of `"
+             << edge->name() << "'." << endl;
+        failed = true;
+        return;
+    }
+    get( &edge->next_time, sizeof(edge->next_time) );
+    get( &edge->cycle, sizeof(edge->cycle) );
+    get( &edge->delay_seq, sizeof(edge->delay_seq) );
+
+    int n = 0;
+    get( &n, sizeof(n) );
+    for (int i = 0; i < n && ! failed; ++i) {
+        int in_wheel = 0;
+        unsigned due = 0;
+        unsigned seq = 0;
+        int dest = -1;
+        get( &in_wheel, sizeof(in_wheel) );
+        get( &due, sizeof(due) );
+        get( &seq, sizeof(seq) );
+        get( &dest, sizeof(dest) );
+        sc_object* proc = 0;
+        io_object( proc );
+        if (failed)
+            return;
+        if (dest < 0 || dest >= simc->signal_list.size() ||
+            simc->signal_list[dest] == 0) {
+            cerr << "SystemC error: checkpoint holds a delayed write to "
+                 << "a signal that does not exist." << endl;
+            failed = true;
+            return;
+        }
+        sc_signal_delay_base* sd =
+            simc->signal_list[dest]->new_delayed( (const sc_module*) proc );
+        if (sd == 0) {
+            curr_name = simc->signal_list[dest]->name();
+            unsupported();
+            return;
+        }
+        sd->checkpoint_value( *this );
+        sd->due = due;
+        sd->seq = seq;
+        edge->file_delayed( sd, in_wheel != 0 );
+    }
+}
+
+/*****************************************************************************/
+
+/* Deletes the delayed writes that restore_edge() has filed on `edge' */
+void
+sc_checkpoint::discard_delayed( sc_clock_edge* edge )
+{
+    if (edge->delay_wheel == 0)
+        return;
+    for (int i = 0; i < SYSTEMC_DELAY_WHEEL_SIZE; ++i) {
+        sc_signal_delay_base* sd = edge->delay_wheel[i];
+        while (sd != 0) {
+            sc_signal_delay_base* next = sd->get_next();
+            delete sd;
+            sd = next;
+        }
+        edge->delay_wheel[i] = 0;
+        edge->delay_wheel_last[i] = 0;
+    }
+    while (! edge->delay_overflow->empty())
+        delete edge->delay_overflow->extract_top();
+}
+
+/*****************************************************************************/
+
+/* The records of the edges, the signals and the other objects */
+void
+sc_checkpoint::save_state()
+{
+    int i;
+    int n = simc->clock_edge_list.size();
+    put( &n, sizeof(n) );
+    for (i = 0; i < n; ++i) {
+        sc_clock_edge* edge = simc->clock_edge_list[i];
+        size_t start = begin_record( edge->name() );
+        save_edge( edge );
+        end_record( start );
+    }
+
+    n = simc->signal_list.size();
+    put( &n, sizeof(n) );
+    for (i = 0; i < n; ++i) {
+        sc_signal_base* sig = simc->signal_list[i];
+        size_t start = begin_record( sig ? sig->name() : "" );
+        if (sig != 0)
+            sig->checkpoint( *this );
+        end_record( start );
+    }
+
+    /* Objects that save nothing get no record */
+    for (sc_object* obj = simc->first_object(); obj != 0;
+         obj = simc->next_object()) {
+        if (dynamic_cast<sc_signal_base*>( obj ) != 0)
+            continue;
+        size_t mark = buf_len;
+        size_t start = begin_record( obj->name() );
+        obj->checkpoint( *this );
+        if (buf_len == start)
+            buf_len = mark;
+        else
+            end_record( start );
+    }
+    (void) begin_record( "" );
+}
+
+/* Reads back what save_state() wrote; check_design() has matched the
+   records up with the design */
+void
+sc_checkpoint::restore_state()
+{
+    int i, n = 0;
+    get( &n, sizeof(n) );
+    for (i = 0; i < n && ! failed; ++i) {
+        (void) next_record();
+        restore_edge( simc->clock_edge_list[i] );
+        end_of_record();
+    }
+
+    get( &n, sizeof(n) );
+    for (i = 0; i < n && ! failed; ++i) {
+        (void) next_record();
+        sc_signal_base* sig = simc->signal_list[i];
+        if (sig != 0)
+            sig->checkpoint( *this );
+        end_of_record();
+    }
+
+    const char* name;
+    while (! failed && (name = next_record()) != 0 && name[0] != '\0') {
+        simc->find_object( name )->checkpoint( *this );
+        end_of_record();
+    }
+}
+
+/* The state of a thread process is in its stack or its coroutine
+   frame, which cannot be saved; see sc_checkpoint.h */
+bool
+sc_checkpoint::check_processes()
+{
+    for (sc_object* obj = simc->first_object(); obj != 0;
+         obj = simc->next_object()) {
+        if (dynamic_cast<sc_sync_process*>( obj ) != 0 ||
+            dynamic_cast<sc_aproc_process*>( obj ) != 0) {
+            cerr << "SystemC error: `" << obj->name() << "' is a thread "
+                 << "process, whose state cannot be checkpointed." << endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool
+sc_checkpoint::save( const char* file_name )
+{
+    if (! simc->ready_to_simulate ||
+        simc->curr_proc_info.kind != SC_CURR_PROC_NONE ||
+        simc->lastof_signals_to_update >= 0 || simc->pool_writes_pending) {
+        cerr << "SystemC error: a checkpoint may only be taken between "
+             << "calls of sc_start() or sc_step()." << endl;
+        return false;
+    }
+    if (! check_processes())
+        return false;
+
+    put( checkpoint_magic, sizeof(checkpoint_magic) );
+    put( &simc->curr_time, sizeof(simc->curr_time) );
+    put( &simc->curr_delta, sizeof(simc->curr_delta) );
+    save_state();
+    if (failed)
+        return false;
+
+    FILE* fp = fopen( file_name, "wb" );
+    if (fp == 0) {
+        cerr << "SystemC error: cannot write checkpoint " << file_name << endl;
+        return false;
+    }
+    bool ok = (fwrite( buf, 1, buf_len, fp ) == buf_len);
+    if (fclose( fp ) != 0)
+        ok = false;
+    if (! ok)
+        cerr << "SystemC error: cannot write checkpoint " << file_name << endl;
+    return ok;
+}
+
+/* Goes over the records without restoring anything, so that a
+   checkpoint of another design is turned down before the state of
+   this one is touched. */
+bool
+sc_checkpoint::check_design()
+{
+    int i, n = 0;
+
+    get( &n, sizeof(n) );
+    if (n != simc->clock_edge_list.size())
+        return false;
+    for (i = 0; i < n; ++i) {
+        const char* name = next_record();
+        if (name == 0 || strcmp( name, simc->clock_edge_list[i]->name() ) != 0)
+            return false;
+        pos = limit;
+    }
+
+    get( &n, sizeof(n) );
+    if (n != simc->signal_list.size())
+        return false;
+    for (i = 0; i < n; ++i) {
+        const char* name = next_record();
+        sc_signal_base* sig = simc->signal_list[i];
+        if (name == 0 || strcmp( name, sig ? sig->name() : "" ) != 0)
+            return false;
+        pos = limit;
+    }
+
+    const char* name;
+    while ((name = next_record()) != 0 && name[0] != '\0') {
+        if (simc->find_object( name ) == 0)
+            return false;
+        pos = limit;
+    }
+    return name != 0 && ! failed;
+}
+
+/* The state is loaded before the simulation is initialized, in place
+   of the initial crunch.  What it overwrites is saved first, so that
+   a checkpoint that turns out to be damaged halfway through can be
+   undone. */
+bool
+sc_checkpoint::restore( const char* file_name )
+{
+    if (simc->ready_to_simulate) {
+        cerr << "SystemC error: a checkpoint may only be restored before "
+             << "the simulation is initialized." << endl;
+        return false;
+    }
+    if (! check_processes())
+        return false;
+
+    FILE* fp = fopen( file_name, "rb" );
+    if (fp == 0) {
+        cerr << "SystemC error: cannot read checkpoint " << file_name << endl;
+        return false;
+    }
+    fseek( fp, 0, SEEK_END );
+    long size = ftell( fp );
+    fseek( fp, 0, SEEK_SET );
+    buf_alloc = (size > 0) ? (size_t) size : 1;
+    buf = new char[buf_alloc];
+    buf_len = fread( buf, 1, buf_alloc, fp );
+    fclose( fp );
+    limit = buf_len;
+
+    char magic[sizeof(checkpoint_magic)];
+    sc_ticks time = 0;
+    sc_delta_stamp delta = 0;
+    get( magic, sizeof(magic) );
+    get( &time, sizeof(time) );
+    get( &delta, sizeof(delta) );
+    if (failed || memcmp( magic, checkpoint_magic, sizeof(magic) ) != 0) {
+        cerr << "SystemC error: " << file_name << " is not a checkpoint."
+             << endl;
+        return false;
+    }
+    size_t body = pos;
+    if (! check_design()) {
+        cerr << "SystemC error: checkpoint " << file_name
+             << " was taken of another design." << endl;
+        return false;
+    }
+    pos = body;
+
+    sc_checkpoint undo( simc, false );
+    undo.save_state();
+    if (undo.failed)
+        return false;
+
+    int i;
+    restore_state();
+    if (failed) {
+        for (i = 0; i < simc->clock_edge_list.size(); ++i)
+            discard_delayed( simc->clock_edge_list[i] );
+        undo.is_restore = true;
+        undo.limit = undo.buf_len;
+        undo.restore_state();
+        assert( ! undo.failed );
+        cerr << "SystemC error: checkpoint " << file_name
+             << " cannot be restored; the simulation is left as it was."
+             << endl;
+        return false;
+    }
+
+    simc->initialize( /* crunch */ false );
+    for (i = 0; i < simc->signal_list.size(); ++i) {
+        if (simc->signal_list[i] != 0)
+            simc->signal_list[i]->notify_watchers();
+    }
+    simc->curr_time = time;
+    simc->curr_delta = delta;
+    simc->curr_edge = 0;
+    simc->trace_cycle( /* is not delta cycle */ false );
+    return true;
+}
+
+/*****************************************************************************/
+
+/* The specializations of sc_signal, whose members are not templates */
+
+void
+sc_signal<bool>::checkpoint( sc_checkpoint& cp )
+{
+    cp.io( values.cur() );
+    cp.io( values.nxt() );
+    cp.io( changed_in_delta );
+}
+
+sc_signal_delay_base*
+sc_signal<bool>::new_delayed( const sc_module* proc )
+{
+    return new sc_signal_delay<bool>( proc, this, false );
+}
+
+void
+sc_signal<unsigned>::checkpoint( sc_checkpoint& cp )
+{
+    cp.io( cur_value );
+    cp.io( new_value );
+    cp.io( changed_in_delta );
+}
+
+sc_signal_delay_base*
+sc_signal<unsigned>::new_delayed( const sc_module* proc )
+{
+    return new sc_signal_delay<unsigned>( proc, this, 0 );
+}
+
+void
+sc_signal<sc_logic>::checkpoint( sc_checkpoint& cp )
+{
+    cp.io( cur_value );
+    cp.io( new_value );
+    cp.io( changed_in_delta );
+}
+
+sc_signal_delay_base*
+sc_signal<sc_logic>::new_delayed( const sc_module* proc )
+{
+    return new sc_signal_delay<sc_logic>( proc, this, sc_logic() );
+}
@@ -0,0 +1,220 @@
+/******************************************************************************
+    Copyright (c) 1996-2000 Synopsys, Inc.    ALL RIGHTS RESERVED
+
+  The contents of this file are subject to the restrictions and limitations
+  set forth in the SystemC(TM) Open Community License Software Download and
+  Use License Version 1.1 (the "License"); you may not use this file except
+  in compliance with such restrictions and limitations. You may obtain
+  instructions on how to receive a copy of the License at
+  http://www.systemc.org/. Software distributed by Original Contributor
+  under the License is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+  ANY KIND, either express or implied. See the License for the specific
+  language governing rights and limitations under the License.
+
+******************************************************************************/
+
+/******************************************************************************
+
+    sc_checkpoint.h -- saving and restoring the state of a simulation.
+
+******************************************************************************/
+
+/******************************************************************************
+
+    MODIFICATION LOG - modifiers, enter your name, affliation and
+    changes you are making here:
+
+    Modifier Name & Affiliation:
+    Description of Modification:
+
+
+******************************************************************************/
+
+/* Included by sc_signal.h, after sc_signal_pool.h. */
+
+#ifndef SC_CHECKPOINT_H
+#define SC_CHECKPOINT_H
+
+#include <stddef.h>
+#include "sc_time_base.h"
+#include "sc_simcontext.h"
+
+class sc_object;
+class sc_simcontext;
+class sc_signal_base;
+class sc_clock_edge;
+class sc_process_b;
+class sc_logic;
+template<class T> struct sc_signal_poolable;
+namespace sc_bv_ns {
+    template<int W> class sc_bv;
+    template<int W> class sc_lv;
+}
+
+//
+//  <summary> Simulation checkpoint </summary>
+//
+//  sc_save_checkpoint() writes the state of the simulation to a file,
+//  and sc_restore_checkpoint() loads it into a freshly elaborated
+//  instance of the same design, before the simulation is initialized.
+//  The loaded values take the place of the initial crunch, and the
+//  traces start out with them, at the time of the checkpoint.  A
+//  checkpoint of another design, or one that cannot be read in full,
+//  is turned down and the simulation is left as it was.  A checkpoint
+//  holds
+//
+//    - the time and the delta cycle count;
+//    - for each clock edge, the time of its next occurrence, its edge
+//      count and the delayed writes (write_d()) that are pending on it;
+//    - for each signal, its current and new values and the delta cycle
+//      of its last change, from which its old value and event() follow;
+//      for each channel, the contents of its buffer;
+//    - whatever the modules save in their checkpoint() functions.
+//
+//  Every object saves and restores its state in checkpoint(), which
+//  serves both directions: io() copies a value into the checkpoint
+//  when saving, and out of it when restoring.  Signals are matched up
+//  by their order of creation and checked by name, the other objects
+//  by name.
+//
+//  Only designs whose processes are all asyncs (SC_METHOD) can be
+//  checkpointed.  A thread process (SC_THREAD or SC_CTHREAD, with a
+//  stack or stackless) keeps its place in the stack or the coroutine
+//  frame, which could not be reloaded into another run of the program,
+//  and restarting it would lose that place; saving and restoring both
+//  fail if the design has one.
+//
+//  A checkpoint may only be taken between calls of sc_start() or
+//  sc_step(), when no update is pending.  Values of T are copied
+//  byte for byte if T qualifies for the signal pool (see
+//  sc_signal_pool.h); other types need a specialization of
+//  sc_checkpoint_traits, and saving fails for the signals whose type
+//  has none.
+//
+class sc_checkpoint {
+    friend class sc_simcontext;
+
+public:
+    bool restoring() const { return is_restore; }
+
+        // Copies `n' bytes at `p' into the checkpoint, or out of it
+    void io_bytes( void* p, size_t n );
+    template<class T> void io( T& v );
+
+        // An object, by name (0 for none)
+    void io_object( sc_object*& obj );
+    void io_process( sc_process_b*& proc );
+
+        // Called by an object whose state cannot be saved; the
+        // checkpoint then fails
+    void unsupported();
+
+private:
+    sc_checkpoint( sc_simcontext* simc, bool restore );
+    ~sc_checkpoint();
+
+    bool save( const char* file_name );
+    bool restore( const char* file_name );
+
+    size_t      begin_record( const char* name );
+    void        end_record( size_t start );
+    const char* next_record();
+    void        end_of_record();
+
+    void save_edge( sc_clock_edge* edge );
+    void restore_edge( sc_clock_edge* edge );
+    void discard_delayed( sc_clock_edge* edge );
+    void save_state();
+    void restore_state();
+    bool check_design();
+    bool check_processes();
+
+    void put( const void* p, size_t n );
+    void get( void* p, size_t n );
+    void put_string( const char* s );
+    const char* get_string();
+    bool get_ok( size_t n );
+
+    sc_simcontext* simc;
+    bool           is_restore;
+    bool           failed;
+    const char*    curr_name;  /* of the object being saved */
+
+    char*  buf;
+    size_t buf_len;     /* bytes written, or readable */
+    size_t buf_alloc;
+    size_t pos;         /* read position */
+    size_t limit;       /* end of the record being read */
+};
+
+//
+//  <summary> How values of T are checkpointed </summary>
+//
+template<class T>
+struct sc_checkpoint_traits
+{
+    enum { supported = sc_signal_poolable<T>::value };
+    static void io( sc_checkpoint& cp, T& v )
+    {
+        if (supported)
+            cp.io_bytes( &v, sizeof(T) );
+        else
+            cp.unsupported();
+    }
+};
+
+/* Types whose values are copied byte for byte */
+template<class T>
+struct sc_checkpoint_bytes
+{
+    enum { supported = 1 };
+    static void io( sc_checkpoint& cp, T& v )
+    {
+        cp.io_bytes( &v, sizeof(T) );
+    }
+};
+
+template<> struct sc_checkpoint_traits<sc_logic>
+    : sc_checkpoint_bytes<sc_logic> { };
+template<> struct sc_checkpoint_traits<unsigned>
+    : sc_checkpoint_bytes<unsigned> { };
+template<> struct sc_checkpoint_traits<sc_ticks>
+    : sc_checkpoint_bytes<sc_ticks> { };
+template<> struct sc_checkpoint_traits<sc_delta_stamp>
+    : sc_checkpoint_bytes<sc_delta_stamp> { };
+
+/* Bit and logic vectors go through their string forms */
+template<class V, int W>
+struct sc_checkpoint_vector_traits
+{
+    enum { supported = 1 };
+    static void io( sc_checkpoint& cp, V& v )
+    {
+        char s[W + 1];
+        if (cp.restoring()) {
+            cp.io_bytes( s, W );
+            s[W] = '\0';
+            v = V( s );
+        } else {
+            v.to_string( s );
+            cp.io_bytes( s, W );
+        }
+    }
+};
+
+template<int W>
+struct sc_checkpoint_traits< sc_bv_ns::sc_bv<W> >
+    : sc_checkpoint_vector_traits< sc_bv_ns::sc_bv<W>, W > { };
+
+template<int W>
+struct sc_checkpoint_traits< sc_bv_ns::sc_lv<W> >
+    : sc_checkpoint_vector_traits< sc_bv_ns::sc_lv<W>, W > { };
+
+template<class T>
+inline void
+sc_checkpoint::io( T& v )
+{
+    sc_checkpoint_traits<T>::io( *this, v );
+}
+
+#endif
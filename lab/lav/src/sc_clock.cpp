@@ -46,6 +46,7 @@ using std::endl;
 #include <iostream.h>
 #endif
 #include <assert.h>
+#include <stdlib.h>
 
 #ifndef WIN32
 #include "qt/qt.h"
@@ -66,6 +67,7 @@ using std::endl;
 #include "sc_signal_delay.h"
 #include "sc_simcontext.h"
 #include "sc_dump.h"
+#include "sc_pq.h"
 
 #include "sc_context_switch.h"
 #include "sc_measure.h"
@@ -92,7 +94,7 @@ const char* sc_clock::kind_string = "sc_clock";
     created with the sc_clock accordingly.
 ******************************************************************************/
 sc_clock_edge::sc_clock_edge( sc_clock& ck )
-    : clk(ck), faze(PHASE_POS), init_time(-1.0)
+    : clk(ck), faze(PHASE_POS), init_time(-1)
 {
     eid = -1;                   // implicitly converted, no real eid
 
@@ -100,18 +102,51 @@ sc_clock_edge::sc_clock_edge( sc_clock& ck )
     sp = 0;                     // Necessary only for QT
 #endif
 
-    per = clk.period();
-    next_time = -1.0;
+    per = sc_seconds_to_ticks( clk.period() );
+    next_time = -1;
     signals_to_update = 0;
     lastof_signals_to_update = -1;
     sync_runnable = 0;
     sync_defunct  = 0;
     total_number_of_syncs = 0;
+    total_number_of_co_syncs = 0;
+    prof_index = -1;
+    cycle = 0;
+    wheel = 0;
+    poll = 0;
+    lastof_poll = -1;
+    ready = 0;
+    lastof_ready = -1;
+    next_ready = 0;
+    delay_wheel = 0;
+    delay_wheel_last = 0;
+    delay_overflow = 0;
+    delay_seq = 0;
 }
 
 sc_clock_edge::~sc_clock_edge()
 {
     delete[] signals_to_update;
+    delete[] wheel;
+    delete[] poll;
+    delete[] ready;
+
+    /* Delayed writes that never came due */
+    if (delay_wheel != 0) {
+        for (int i = 0; i < SYSTEMC_DELAY_WHEEL_SIZE; ++i) {
+            sc_signal_delay_base* sd = delay_wheel[i];
+            while (sd != 0) {
+                sc_signal_delay_base* next_sd = sd->get_next();
+                delete sd;
+                sd = next_sd;
+            }
+        }
+        while (! delay_overflow->empty())
+            delete delay_overflow->extract_top();
+        delete[] delay_wheel;
+        delete[] delay_wheel_last;
+        delete delay_overflow;
+    }
 
     sc_sync_process_handle curr_handle, next_handle;
     for (curr_handle = sync_runnable;
@@ -142,65 +177,312 @@ sc_clock_edge_yieldhelp( qt_t* sp, void* clk_edge, void* )
 }
 #endif
 
-#if 0
+/******************************************************************************
+    submit_update_d() files a delayed write in the slot of the edge count
+    at which it is due, at the end of the slot's chain so that writes due
+    on the same edge take effect in the order they were made.  Because
+    only writes due less than SYSTEMC_DELAY_WHEEL_SIZE edges ahead go into
+    the wheel, a slot never holds writes of different laps.  Writes due
+    later go into delay_overflow, ordered by due edge and then by
+    submission; do_delayed_writes() performs those first, since they were
+    all made before any write in the wheel for the same edge.
+******************************************************************************/
+/* Edge counts and sequence numbers wrap around, but two of them that
+   are in the queue together are less than 2^31 apart; the one that
+   the other is less than 2^31 ahead of comes first. */
+static int
+wrapping_order( unsigned x1, unsigned x2 )
+{
+    if (x1 == x2)
+        return 0;
+    return (x2 - x1 < 0x80000000U) ? 1 : -1;
+}
+
+int
+sc_clock_edge::delay_order( const void* a, const void* b )
+{
+    const sc_signal_delay_base* sd1 = (const sc_signal_delay_base*) a;
+    const sc_signal_delay_base* sd2 = (const sc_signal_delay_base*) b;
+    if (sd1->due != sd2->due)
+        return wrapping_order( sd1->due, sd2->due );
+    return wrapping_order( sd1->seq, sd2->seq );
+}
+
 void
 sc_clock_edge::submit_update_d( sc_signal_delay_base* sd, int delay )
 {
-    sc_plist<da_elem*>::iterator dit( delayed_assignments );
-    while (!dit.empty()) {
-        da_elem* de = *dit;
-        if (de->delay > delay)
-            break;
-        else if (de->delay == delay) {
-            sd->set_next(de->first);
-            de->first = sd;
-            return;
+    assert( delay > 0 );
+    sd->due = cycle + delay;
+    sd->seq = delay_seq++;
+    file_delayed( sd, delay < SYSTEMC_DELAY_WHEEL_SIZE );
+}
+
+/* Files `sd', whose due (and seq) are set, in the wheel or the queue;
+   also used when restoring a checkpoint. */
+void
+sc_clock_edge::file_delayed( sc_signal_delay_base* sd, bool in_wheel )
+{
+    if (delay_wheel == 0) {
+        delay_wheel = new sc_signal_delay_base*[SYSTEMC_DELAY_WHEEL_SIZE];
+        delay_wheel_last = new sc_signal_delay_base*[SYSTEMC_DELAY_WHEEL_SIZE];
+        for (int i = 0; i < SYSTEMC_DELAY_WHEEL_SIZE; ++i) {
+            delay_wheel[i] = 0;
+            delay_wheel_last[i] = 0;
         }
-        dit++;
+        delay_overflow = new sc_ppq<sc_signal_delay_base*>( 16, delay_order );
+    }
+
+    sd->set_next( 0 );
+    if (in_wheel) {
+        int slot = sd->due & (SYSTEMC_DELAY_WHEEL_SIZE - 1);
+        if (delay_wheel[slot] == 0)
+            delay_wheel[slot] = sd;
+        else
+            delay_wheel_last[slot]->set_next( sd );
+        delay_wheel_last[slot] = sd;
+    } else {
+        delay_overflow->insert( sd );
+    }
+}
+
+void
+sc_clock_edge::submit_update_d_curr( sc_signal_delay_base* sd, int delay )
+{
+    const sc_curr_proc_info* info =
+        sc_get_curr_simcontext()->get_curr_proc_info();
+    if (info->kind != SC_CURR_PROC_SYNC) {
+        cerr << "SystemC error: write_d() can only be called from a "
+             << "clocked thread process" << endl;
+        delete sd;
+        assert( false );
+        return;
+    }
+    sc_sync_process_handle handle = (sc_sync_process_handle) info->process_handle;
+    handle->clock_edge->submit_update_d( sd, delay );
+}
+
+/* Performs the delayed writes due on this edge, before any process
+   runs; the updates land in this edge's signals_to_update like those of
+   the processes. */
+void
+sc_clock_edge::do_delayed_writes()
+{
+    sc_signal_delay_base* sd;
+
+    while (! delay_overflow->empty() && delay_overflow->top()->due == cycle) {
+        sd = delay_overflow->extract_top();
+        sd->do_write();
+        delete sd;
+    }
+
+    int slot = cycle & (SYSTEMC_DELAY_WHEEL_SIZE - 1);
+    sd = delay_wheel[slot];
+    delay_wheel[slot] = 0;
+    delay_wheel_last[slot] = 0;
+    while (sd != 0) {
+        sc_signal_delay_base* next_sd = sd->get_next();
+        sd->do_write();
+        delete sd;
+        sd = next_sd;
     }
-    da_elem* new_da = new da_elem;
-    new_da->delay = delay;
-    new_da->first = sd;
-    delayed_assignments.insert_before( dit.get_handle(), new_da );
-    return;
 }
-#endif
 
 /******************************************************************************
-    advance() finds the first process in the list that's ready to wake up, i.e.
-    when its waiting time is up, its lambda evals to true, or some lambda on
-    its watchlist evals to true.Since we trace both positive and negative clock
-    edges, we have to keep the edge alive even if no proc is depending on it
-    (i.e. when the runnable queue is empty ).
+    advance() wakes up the processes of this edge whose waiting time is up,
+    whose lambda evals to true, or some lambda on whose watchlist evals to
+    true.  Since we trace both positive and negative clock edges, we have to
+    keep the edge alive even if no proc is depending on it (i.e. when the
+    runnable queue is empty ).
+
+    A process blocked in wait(n) sits in the timing wheel, in the bucket
+    of the edge count at which it wakes up.  The processes on the poll
+    list are examined with ready_to_wakeup(), or only with
+    eval_watchlist() if they are also in the wheel.  One that is not
+    ready and waits only on compiled lambdas then leaves the list: the
+    lambdas keep their value until an operand changes, and
+    sc_lambda_notify() puts it back on the list for the next edge when
+    that happens.  The others stay on the list and are examined on every
+    edge.  So a process is looked at only on the edge its wait(n) is
+    over, or after something it waits for or watches has changed.  The
+    processes
+    that wake up are run in the order of the runnable list: the stackless
+    ones (see sc_co_process.h) with plain calls, then the stackful ones
+    chained by next_qt().  Afterwards each of them is filed again according
+    to what it is now waiting for.  Delayed writes due on this edge are
+    performed before any of this happens.
 ******************************************************************************/
+int
+sc_clock_edge::runnable_order( const void* a, const void* b )
+{
+    return (*(const sc_sync_process_handle*) a)->runnable_seq -
+           (*(const sc_sync_process_handle*) b)->runnable_seq;
+}
+
 void
 sc_clock_edge::advance()
 {
     sc_simcontext* simc = clk.simcontext();
-    sc_sync_process_handle handle = sync_runnable;
+    sc_sync_process_handle handle;
+    sc_sync_process_handle* const l_ready = ready;
+    int l_lastof_ready = -1;
+    bool in_order = true;
+    int i;
+
+    ++cycle;
+    if (simc->profiler != 0 && prof_index >= 0)
+        simc->profiler->edge_advanced( prof_index );
+
+    if (delay_wheel != 0)
+        do_delayed_writes();
+
+    /* Drain this edge's bucket; processes due on a later lap stay */
+    sc_sync_process_handle* const bucket = &wheel[cycle & (SYSTEMC_SYNC_WHEEL_SIZE - 1)];
+    handle = *bucket;
+    *bucket = 0;
+    while (NIL(sc_sync_process_handle) != handle) {
+        sc_sync_process_handle next_h = handle->wheel_next;
+        if (handle->wake_cycle == cycle) {
+            /* what ready_to_wakeup() would have left behind */
+            handle->wait_cycles = 0;
+            if (handle->has_watching()) {
+                handle->queued = false;
+                handle->stop_waiting_on_lambdas();
+                (void) handle->eval_watchlist();
+            } else {
+                handle->exception_level = -1;
+            }
+            if (l_lastof_ready >= 0 &&
+                l_ready[l_lastof_ready]->runnable_seq > handle->runnable_seq)
+                in_order = false;
+            l_ready[++l_lastof_ready] = handle;
+        } else {
+            handle->wheel_next = *bucket;
+            *bucket = handle;
+        }
+        handle = next_h;
+    }
+
+    const int l_lastof_poll = lastof_poll;
+    lastof_poll = -1;
+    for (i = 0; i <= l_lastof_poll; ++i) {
+        handle = poll[i];
+        if (! handle->queued)
+            continue;       /* woken up from the wheel above */
+        handle->queued = false;
+        /* before any lambda is evaluated, since a watched one is
+           released once it fires */
+        handle->stop_waiting_on_lambdas();
+        bool woken;
+        if (sc_sync_process::WAIT_CLOCK == handle->wait_state) {
+            woken = handle->eval_watchlist();
+            if (woken)
+                remove_from_wheel( handle );
+        } else {
+            woken = handle->ready_to_wakeup();
+        }
+        if (woken) {
+            if (l_lastof_ready >= 0 &&
+                l_ready[l_lastof_ready]->runnable_seq > handle->runnable_seq)
+                in_order = false;
+            l_ready[++l_lastof_ready] = handle;
+        } else if (! handle->wait_on_lambdas()) {
+            handle->queued = true;
+            poll[++lastof_poll] = handle;
+        }
+    }
 
-    while (true) {
-        if (NIL(sc_sync_process_handle) == handle) return;
-        if (handle->ready_to_wakeup()) {
-            (void) simc->set_curr_proc( handle );
+    if (l_lastof_ready < 0)
+        return;
+    if (! in_order)
+        qsort( l_ready, l_lastof_ready + 1, sizeof(sc_sync_process_handle),
+               runnable_order );
+    lastof_ready = l_lastof_ready;
+
+    if (total_number_of_co_syncs > 0) {
+        for (i = 0; i <= l_lastof_ready; ++i) {
+            handle = l_ready[i];
+            if (0 != handle->co) {
+                (void) simc->set_curr_proc( handle );
+                sc_co_helpers::resume( handle );
+            }
+        }
+        (void) simc->reset_curr_proc();
+    }
+
+    next_ready = 0;
+    handle = next_ready_process();
+    if (NIL(sc_sync_process_handle) != handle) {
+        if (simc->profiler != 0 && prof_index >= 0) {
+            /* into each stackful process, and back to the kernel */
+            int n = 1;
+            for (i = 0; i <= l_lastof_ready; ++i)
+                n += (0 == l_ready[i]->co);
+            simc->profiler->edge_context_switches( prof_index, n );
+        }
+        (void) simc->set_curr_proc( handle );
 
 #ifndef WIN32
-            context_switch( sc_clock_edge_yieldhelp, this, 0, handle->sp );
+        context_switch( sc_clock_edge_yieldhelp, this, 0, handle->sp );
 #else
-            /* Save the current fiber and then context switch */
-	    pFiber = GetCurrentFiber();
-            if(handle->pFiber)
-              context_switch( handle->pFiber );
-            else
-	      throw "trying to switch to non-existent fiber";
+        /* Save the current fiber and then context switch */
+	pFiber = GetCurrentFiber();
+        if(handle->pFiber)
+          context_switch( handle->pFiber );
+        else
+	  throw "trying to switch to non-existent fiber";
 #endif
-            break;
-        }
-        else {
-            handle = handle->next_handle;
-        }
     }
-    return;
+
+    for (i = 0; i <= l_lastof_ready; ++i) {
+        handle = l_ready[i];
+        if (! handle->terminated)
+            file_for_wakeup( handle );
+    }
+    lastof_ready = -1;
+}
+
+/* Returns the next stackful process woken up on this edge, if any */
+sc_sync_process_handle
+sc_clock_edge::next_ready_process()
+{
+    while (next_ready <= lastof_ready) {
+        sc_sync_process_handle handle = ready[next_ready++];
+        if (0 == handle->co)
+            return handle;
+    }
+    return 0;
+}
+
+/* Puts a process that has just blocked into the timing wheel, if it
+   waits for a number of edges, and on the poll list if it waits for or
+   watches a lambda.  It is examined on the next edge whatever lambda it
+   waits for, since the lambdas may have become true while it ran. */
+void
+sc_clock_edge::file_for_wakeup( sc_sync_process_handle handle )
+{
+    if (sc_sync_process::WAIT_CLOCK == handle->wait_state) {
+        handle->wake_cycle = cycle + (unsigned) handle->wait_cycles;
+        sc_sync_process_handle* const bucket =
+            &wheel[handle->wake_cycle & (SYSTEMC_SYNC_WHEEL_SIZE - 1)];
+        handle->wheel_next = *bucket;
+        *bucket = handle;
+        if (! handle->has_watching())
+            return;
+    }
+    handle->queued = true;
+    poll[++lastof_poll] = handle;
+}
+
+/* Takes a process whose watching fired before its wait(n) was over out
+   of its bucket */
+void
+sc_clock_edge::remove_from_wheel( sc_sync_process_handle handle )
+{
+    sc_sync_process_handle* p =
+        &wheel[handle->wake_cycle & (SYSTEMC_SYNC_WHEEL_SIZE - 1)];
+    while (*p != handle)
+        p = &(*p)->wheel_next;
+    *p = handle->wheel_next;
 }
 
 void
@@ -221,6 +503,10 @@ sc_clock_helpers::remove_from_runnable( sc_clock_edge* p_edge,
         }
     }
 
+    if (0 != sync_handle->co)
+        --(p_edge->total_number_of_co_syncs);
+    sync_handle->terminated = true;
+
     /* mark this as defunct */
     sync_handle->entry_fn = SC_DEFUNCT_PROCESS_FUNCTION;
     if (NIL(sc_sync_process_handle) == p_edge->sync_defunct) {
@@ -237,7 +523,7 @@ sc_clock_helpers::remove_from_runnable( sc_clock_edge* p_edge,
     }
 }
 
-sc_clock_edge::sc_clock_edge( sc_clock& ck, phase_t ph, double p, double s )
+sc_clock_edge::sc_clock_edge( sc_clock& ck, phase_t ph, sc_ticks p, sc_ticks s )
     : clk(ck), faze(ph), init_time(s)
 {
     eid = num_clock_edges++;
@@ -255,6 +541,19 @@ sc_clock_edge::sc_clock_edge( sc_clock& ck, phase_t ph, double p, double s )
     sync_runnable = 0;
     sync_defunct  = 0;
     total_number_of_syncs = 0;
+    total_number_of_co_syncs = 0;
+    prof_index = -1;
+    cycle = 0;
+    wheel = 0;
+    poll = 0;
+    lastof_poll = -1;
+    ready = 0;
+    lastof_ready = -1;
+    next_ready = 0;
+    delay_wheel = 0;
+    delay_wheel_last = 0;
+    delay_overflow = 0;
+    delay_seq = 0;
 
     signals_to_update = 0;
     lastof_signals_to_update = -1;
@@ -321,7 +620,7 @@ new_clock_name()
     edge (s).  Default values are specified in "sc_clock.h"
 ******************************************************************************/
 sc_clock::sc_clock( const char* nm, double p, double d, double s, bool posedge_first )
-    : sc_signal<bool>( nm ? nm : new_clock_name() )
+    : sc_signal<bool>( nm ? nm : new_clock_name(), /* poolable */ false )
 {
     init( p, d, s, posedge_first );
 }
@@ -341,16 +640,27 @@ sc_clock::init( double p, double d, double s, bool posedge_first )
 
     // sig = new sc_signal<bool>( (sc_object*) this );   /* make signal anonymous */
 
+    /* Both edges get the same period in ticks, so that they never drift
+       apart; the start times are rounded independently. */
+    sc_ticks p_ticks = sc_seconds_to_ticks( p );
+    if (p > 0 && p_ticks == 0) {
+        cerr << "SystemC error: the period " << p << " sec of clock `"
+             << name() << "' is below the time resolution "
+             << sc_get_time_resolution() << " sec.  Use "
+             << "sc_set_time_resolution() to make it finer." << endl;
+        assert( false );
+    }
+    sc_ticks s_ticks = sc_seconds_to_ticks( s );
+    sc_ticks d_ticks = sc_seconds_to_ticks( s + d * p );
+
     if (posedge_first) {
-        edges[1] = new sc_clock_edge( *this, PHASE_POS, p, s );
-        edges[0] = new sc_clock_edge( *this, PHASE_NEG, p, s + d * p );
-        set_old_value(false);
+        edges[1] = new sc_clock_edge( *this, PHASE_POS, p_ticks, s_ticks );
+        edges[0] = new sc_clock_edge( *this, PHASE_NEG, p_ticks, d_ticks );
         set_cur_value(false);
         set_new_value(false);
     } else {
-        edges[0] = new sc_clock_edge( *this, PHASE_NEG, p, s );
-        edges[1] = new sc_clock_edge( *this, PHASE_POS, p, s + d * p );
-        set_old_value(true);
+        edges[0] = new sc_clock_edge( *this, PHASE_NEG, p_ticks, s_ticks );
+        edges[1] = new sc_clock_edge( *this, PHASE_POS, p_ticks, d_ticks );
         set_cur_value(true);
         set_new_value(true);
     }
@@ -387,6 +697,7 @@ sc_clock::dump(ostream& os) const
 void
 sc_clock::trace( sc_trace_file* tf ) const
 {
+    sc_trace_signal_scope scope( tf, this );
     ::sc_trace( tf, *(this->get_data_ptr()), name() );
 }
 
@@ -448,10 +759,12 @@ sc_clock::update_funcs_array() const
 sc_sync_process_handle
 sc_clock_edge::register_sc_sync_process(const char* name,
                                         SC_ENTRY_FUNC entry_fn,
-                                        sc_module* module)
+                                        sc_module* module,
+                                        sc_co_state* co)
 {
     sc_sync_process_handle handle;
     handle = new sc_sync_process(name, entry_fn, module, this);
+    handle->co = co;
     sc_clock_helpers::bind_sync_to_clock_edge_back(this, handle);
     clock().simcontext()->set_curr_proc( handle );
     return handle;
@@ -463,6 +776,8 @@ sc_clock_helpers::bind_sync_to_clock_edge_back(sc_clock_edge* clk_edge,
                                                sc_sync_process_handle handle)
 {
     ++(clk_edge->total_number_of_syncs);
+    if (0 != handle->co)
+        ++(clk_edge->total_number_of_co_syncs);
     if (NIL(sc_sync_process_handle) == clk_edge->sync_runnable) {
         clk_edge->sync_runnable = handle;
         /* Use the head's `prev_handle' to point to last */
@@ -483,6 +798,8 @@ sc_clock_helpers::bind_sync_to_clock_edge_front(sc_clock_edge* clk_edge,
                                                 sc_sync_process_handle handle)
 {
     ++(clk_edge->total_number_of_syncs);
+    if (0 != handle->co)
+        ++(clk_edge->total_number_of_co_syncs);
     if (NIL(sc_sync_process_handle) == clk_edge->sync_runnable) {
         clk_edge->sync_runnable = handle;
         clk_edge->sync_runnable->prev_handle = handle;
@@ -520,11 +837,28 @@ sc_clock_helpers::prepare_for_simulation(sc_clock_edge* p_edge,
     /* Go through each sc_sync_process_handle, and call
        prepare_for_simulation on each. */
 
+    int n = 0;
     sc_sync_process_handle handle;
     for (handle = p_edge->sync_runnable;
          NIL(sc_sync_process_handle) != handle;
          handle = handle->next_handle) {
         handle->prepare_for_simulation();
+        handle->runnable_seq = n++;
+    }
+
+    /* Every process starts out on the poll list, since it has to run
+       on the first edge */
+    p_edge->wheel = new sc_sync_process_handle[SYSTEMC_SYNC_WHEEL_SIZE];
+    for (int i = 0; i < SYSTEMC_SYNC_WHEEL_SIZE; ++i)
+        p_edge->wheel[i] = 0;
+    p_edge->poll  = new sc_sync_process_handle[n > 0 ? n : 1];
+    p_edge->ready = new sc_sync_process_handle[n > 0 ? n : 1];
+    p_edge->lastof_poll = -1;
+    for (handle = p_edge->sync_runnable;
+         NIL(sc_sync_process_handle) != handle;
+         handle = handle->next_handle) {
+        handle->queued = true;
+        p_edge->poll[++p_edge->lastof_poll] = handle;
     }
     sc_signal_optimize::optimize_clock(&(p_edge->clock()));
 }
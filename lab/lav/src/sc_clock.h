@@ -48,13 +48,16 @@
 #include "sc_logic.h"
 #include "sc_object.h"
 #include "sc_signal.h"
+#include "sc_time_base.h"
 
 class sc_signal_base;
 template<class T> class sc_signal;
 class sc_signal_delay_base;
+template<class T> class sc_ppq;
 
 struct qt_t;
 class sc_sync;
+struct sc_co_state;
 
 enum phase_t { PHASE_NEG = 0, PHASE_POS };
 
@@ -123,8 +126,8 @@ public:
 
 	sc_clock_virt_ret_type& write( bool nv )
     {
-        new_value = nv;
-        if (cur_value != nv)
+        values.nxt() = nv;
+        if (values.cur() != nv)
             submit_update();
         return *this;
     }
@@ -135,16 +138,16 @@ public:
     }
     virtual sc_clock_virt_ret_type& operator=( bool nv )
     {
-        new_value = nv;
-        if (cur_value != nv)
+        values.nxt() = nv;
+        if (values.cur() != nv)
             submit_update();
         return *this;
     }
     virtual sc_clock_virt_ret_type& operator=( const sc_clock& nv )
     {
         bool nn = nv.read();
-        new_value = nn;
-        if (cur_value != nn)
+        values.nxt() = nn;
+        if (values.cur() != nn)
             submit_update();
         return *this;
     }
@@ -175,7 +178,6 @@ protected:
     virtual sc_signal_base::UPDATE_FUNC* update_funcs_array() const;
 
     virtual void update();
-    // void update_old(); -- inherited from sc_signal<bool>
 
     /* The decl_sensitive_* functions are all virtual in sc_signal_edgy. */
     // no longer necessary - because we derive from sc_signal<bool>
@@ -208,11 +210,6 @@ private:
 
 /*****************************************************************************/
 
-struct da_elem {
-    int delay;
-    sc_signal_delay_base* first;
-};
-
 class sc_clock_edge {
     /* Note: a part of the interface (private) for sc_clock_edge is
        defined in sc_clock_helpers, in sc_clock_int.h, which
@@ -222,6 +219,7 @@ class sc_clock_edge {
     friend class sc_simcontext;
     friend class sc_sync;
     friend class sc_sync_process;
+    friend class sc_checkpoint;
 public:
         // Constructor - public used as an implicit type convertor
     sc_clock_edge( sc_clock& );
@@ -237,12 +235,17 @@ public:
 
     const char* name() const { return clk.name(); }
         // Returns the period of the clock.
-    double period() const { return per; }
+    double period() const { return sc_ticks_to_seconds( per ); }
         // Returns the time instant of the edge that just occured.
-    double prev_edge() const { return next_time - per; }
+    double prev_edge() const { return sc_ticks_to_seconds( next_time - per ); }
         // Returns the time instant of the next edge.
-    double next_edge() const { return next_time; }
-    double time_stamp() const { return next_time - per; }
+    double next_edge() const { return sc_ticks_to_seconds( next_time ); }
+    double time_stamp() const { return sc_ticks_to_seconds( next_time - per ); }
+
+        // The same, in ticks of the time resolution
+    sc_ticks period_ticks() const { return per; }
+    sc_ticks next_edge_ticks() const { return next_time; }
+    sc_ticks time_stamp_ticks() const { return next_time - per; }
 
         // Update the value of the clock signal, as well as advancing
         // time.
@@ -250,10 +253,10 @@ public:
 
         // Sets the period of the clock.  Used if period not specified during
         // clock creation.
-    void set_period( double p ) { per = p; }
+    void set_period( double p ) { per = sc_seconds_to_ticks( p ); }
         // Set the start time of the clock. Used if start time not
         // specified during clock creation.
-    void set_start_time( double s ) { next_time = s; }
+    void set_start_time( double s ) { next_time = sc_seconds_to_ticks( s ); }
 
         // Advances the clock by switching into the first ready process
         // in the clock's process-list.  Returns false if there are no
@@ -263,9 +266,15 @@ public:
         // Submits a signal update request to the clock's update-list.
 #if 0
     void submit_update( sc_signal_base* sig );
-    void submit_update_d( sc_signal_delay_base* sd, int delay );
 #endif
 
+        // Makes the delayed write `sd' take effect `delay' (> 0) edges
+        // from now, and takes ownership of it.
+    void submit_update_d( sc_signal_delay_base* sd, int delay );
+
+        // The same, on the clock edge of the calling sc_sync_process.
+    static void submit_update_d_curr( sc_signal_delay_base* sd, int delay );
+
 /******************************************************************************
                         NO PEEKING BEYOND THIS POINT
 ******************************************************************************/
@@ -275,7 +284,7 @@ private:
     static sc_plist<sc_clock_edge*> list_of_clock_edges;
 
 private:
-    sc_clock_edge( sc_clock&, phase_t, double p, double s );
+    sc_clock_edge( sc_clock&, phase_t, sc_ticks p, sc_ticks s );
 #ifndef WIN32
     qt_t* qt() const { return sp; }
     friend void* sc_clock_edge_yieldhelp( qt_t*, void*, void* );
@@ -288,7 +297,8 @@ private:
 public:
     sc_sync_process_handle register_sc_sync_process(const char* name,
                                                     SC_ENTRY_FUNC entry_fn,
-                                                    sc_module*);
+                                                    sc_module*,
+                                                    sc_co_state* co = 0);
 private:
     int eid;
     sc_clock& clk;
@@ -298,19 +308,47 @@ private:
 #else
     PVOID pFiber;               // Fibers handle
 #endif
-    double per;                 // the period of this clock
-    const double init_time;     // this should never change
-    double next_time;           // the time when the next edge will occur
+    sc_ticks per;               // the period of this clock
+    const sc_ticks init_time;   // this should never change
+    sc_ticks next_time;         // the time when the next edge will occur
 
     /* Signals tied to this edge -- updated a delta cycle after the edge */
     sc_signal_base** signals_to_update;
     int              lastof_signals_to_update;
 
-    sc_plist<sc_clock_edge*>::handle_t handle;
+    int handle;                 /* index in the simcontext's list */
 
     int  total_number_of_syncs;
+    int  total_number_of_co_syncs;  /* stackless ones among the runnable */
+    int  prof_index;                /* see sc_profiler.h */
     sc_sync_process_handle sync_runnable;
     sc_sync_process_handle sync_defunct;
+
+    /* Wakeup bookkeeping of advance() */
+    unsigned                cycle;        /* number of edges so far */
+    sc_sync_process_handle* wheel;        /* SYSTEMC_SYNC_WHEEL_SIZE buckets */
+    sc_sync_process_handle* poll;         /* examined on the next edge */
+    int                     lastof_poll;
+    sc_sync_process_handle* ready;        /* woken up on this edge */
+    int                     lastof_ready;
+    int                     next_ready;   /* next one for next_qt() */
+
+    sc_sync_process_handle next_ready_process();
+    static int runnable_order( const void* a, const void* b );
+    void file_for_wakeup( sc_sync_process_handle handle );
+    void remove_from_wheel( sc_sync_process_handle handle );
+
+    /* Delayed writes, by the edge count at which they are due; those
+       due SYSTEMC_DELAY_WHEEL_SIZE or more edges ahead wait in the
+       queue.  Allocated by the first submit_update_d(). */
+    sc_signal_delay_base** delay_wheel;       /* first of each slot */
+    sc_signal_delay_base** delay_wheel_last;  /* last of each slot */
+    sc_ppq<sc_signal_delay_base*>* delay_overflow;
+    unsigned delay_seq;
+
+    void file_delayed( sc_signal_delay_base* sd, bool in_wheel );
+    void do_delayed_writes();
+    static int delay_order( const void* a, const void* b );
 };
 
 /*****************************************************************************/
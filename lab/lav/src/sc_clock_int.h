@@ -67,7 +67,7 @@ public:
        clock generation when there's only one clock. */
     static void clock_write(sc_clock* p_clk, bool nv)
     {
-        p_clk->new_value = nv;
+        p_clk->values.nxt() = nv;
         p_clk->submit_update();
     }
 };
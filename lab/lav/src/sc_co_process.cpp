@@ -0,0 +1,189 @@
+/******************************************************************************
+    Copyright (c) 1996-2000 Synopsys, Inc.    ALL RIGHTS RESERVED
+
+  The contents of this file are subject to the restrictions and limitations
+  set forth in the SystemC(TM) Open Community License Software Download and
+  Use License Version 1.1 (the "License"); you may not use this file except
+  in compliance with such restrictions and limitations. You may obtain
+  instructions on how to receive a copy of the License at
+  http://www.systemc.org/. Software distributed by Original Contributor
+  under the License is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+  ANY KIND, either express or implied. See the License for the specific
+  language governing rights and limitations under the License.
+
+******************************************************************************/
+
+
+/******************************************************************************
+
+    sc_co_process.cpp -- stackless (C++20 coroutine) processes.
+
+******************************************************************************/
+
+/******************************************************************************
+
+    MODIFICATION LOG - modifiers, enter your name, affliation and
+    changes you are making here:
+
+    Modifier Name & Affiliation:
+    Description of Modification:
+
+
+******************************************************************************/
+
+#ifndef _MSC_VER
+#include <iostream>
+using std::cerr;
+using std::endl;
+#else
+#include <iostream.h>
+#endif
+#include <assert.h>
+
+#include "sc_process.h"
+#include "sc_simcontext.h"
+#include "sc_process_int.h"
+#include "sc_simcontext_int.h"
+#include "sc_clock.h"
+#include "sc_clock_int.h"
+#include "sc_except.h"
+#include "sc_module.h"
+#include "sc_co_process.h"
+
+#ifdef SC_HAS_COROUTINES
+
+sc_co_state*
+sc_co_helpers::create( SC_CO_ENTRY_FUNC fn )
+{
+    sc_co_state* co = new sc_co_state;
+    co->entry = fn;
+    return co;
+}
+
+void
+sc_co_helpers::destroy( sc_co_state* co )
+{
+    delete co;
+}
+
+void
+sc_co_helpers::start( sc_co_state* co, sc_module* mod )
+{
+    co->task = (mod->*(co->entry))();
+}
+
+void
+sc_co_helpers::resume( sc_sync_process_handle handle )
+{
+    sc_co_state* co = handle->co;
+
+    while (true) {
+        co->task.resume();
+        if (! co->task.done())
+            return;
+
+        std::exception_ptr e = co->task.exception();
+        if (! e)
+            break;
+        try {
+            std::rethrow_exception( e );
+        }
+        catch (sc_user) {
+            assert( 0 == handle->watch_level );
+            start( co, handle->module );
+            continue;
+        }
+        catch (sc_halt) {
+            cerr << "Terminating process " << handle->name() << endl;
+            break;
+        }
+    }
+
+    /* The process has finished; free its frame right away */
+    co->task = sc_co_task();
+    sc_clock_helpers::remove_from_runnable( handle->clock_edge, handle );
+}
+
+void
+sc_co_helpers::resume( sc_aproc_process_handle handle )
+{
+    sc_co_state* co = handle->co;
+
+    co->task.resume();
+    if (! co->task.done())
+        return;
+
+    std::exception_ptr e = co->task.exception();
+    co->task = sc_co_task();
+    handle->remove_from_trigger_signals();
+    handle->remove_from_trigger_signals_neg();
+    handle->entry_fn = SC_DEFUNCT_PROCESS_FUNCTION;
+    if (e)
+        std::rethrow_exception( e );
+}
+
+#else
+
+sc_co_state*
+sc_co_helpers::create( SC_CO_ENTRY_FUNC )
+{
+    cerr << "SystemC error: stackless processes require a C++20 compiler" << endl;
+    assert( false );
+    return 0;
+}
+
+void
+sc_co_helpers::destroy( sc_co_state* co )
+{
+    assert( co == 0 );
+}
+
+void
+sc_co_helpers::start( sc_co_state*, sc_module* )
+{
+    assert( false );
+}
+
+void
+sc_co_helpers::resume( sc_sync_process_handle )
+{
+    assert( false );
+}
+
+void
+sc_co_helpers::resume( sc_aproc_process_handle )
+{
+    assert( false );
+}
+
+#endif
+
+bool
+sc_co_helpers::is_stackless( sc_sync_process_handle handle )
+{
+    return 0 != handle->co;
+}
+
+/* Completes a wait() that suspended a stackless process.  This mirrors
+   what the stackful versions in sc_wait.cpp do after context_switch()
+   returns. */
+void
+sc_co_wait_resume( const sc_wait_awaiter& w )
+{
+    if (w.co_proc == 0 || ! w.co_sync)
+        return;
+
+    if (w.co_halt) {
+        throw sc_halt();
+    }
+
+    sc_sync_process_handle handle = (sc_sync_process_handle) w.co_proc;
+    handle->wait_state = sc_sync_process::WAIT_UNKNOWN;
+    int exception_level = handle->exception_level;
+    if (0 == exception_level) {
+        throw sc_user();
+    }
+    else if (exception_level > 0) {
+        throw exception_level;
+    }
+}
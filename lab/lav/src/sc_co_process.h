@@ -0,0 +1,165 @@
+/******************************************************************************
+    Copyright (c) 1996-2000 Synopsys, Inc.    ALL RIGHTS RESERVED
+
+  The contents of this file are subject to the restrictions and limitations
+  set forth in the SystemC(TM) Open Community License Software Download and
+  Use License Version 1.1 (the "License"); you may not use this file except
+  in compliance with such restrictions and limitations. You may obtain
+  instructions on how to receive a copy of the License at
+  http://www.systemc.org/. Software distributed by Original Contributor
+  under the License is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+  ANY KIND, either express or implied. See the License for the specific
+  language governing rights and limitations under the License.
+
+******************************************************************************/
+
+
+/******************************************************************************
+
+    sc_co_process.h -- stackless (C++20 coroutine) processes.
+
+******************************************************************************/
+
+/******************************************************************************
+
+    MODIFICATION LOG - modifiers, enter your name, affliation and
+    changes you are making here:
+
+    Modifier Name & Affiliation:
+    Description of Modification:
+
+
+******************************************************************************/
+
+#ifndef SC_CO_PROCESS_H
+#define SC_CO_PROCESS_H
+
+#include "sc_process.h"
+
+#if defined(__cpp_impl_coroutine) || (defined(_MSVC_LANG) && _MSVC_LANG >= 202002L)
+#define SC_HAS_COROUTINES
+#endif
+
+class sc_module;
+class sc_co_task;
+struct sc_co_state;
+
+typedef sc_co_task (sc_module::*SC_CO_ENTRY_FUNC)();
+
+//
+//  <summary> Stackless processes </summary>
+//
+//  A stackless process is an sc_sync_process or sc_aproc_process whose
+//  body is a C++20 coroutine returning sc_co_task, rather than a plain
+//  member function running on a stack of its own.  The body suspends
+//  with `co_await wait()', `co_await wait(n)', `co_await wait_until(...)'
+//  or `co_await halt()'; its frame comes from sc_mempool, and the
+//  kernel resumes it with an ordinary call from sc_clock_edge::advance()
+//  (syncs) or sc_simcontext::crunch() (aprocs).
+//
+//  Only the process body itself may suspend: a function it calls
+//  cannot wait() on its behalf.  at_posedge() and at_negedge() are not
+//  available; use wait_until() instead.
+//
+//  sc_co_helpers is the kernel's side of the arrangement.  Without
+//  compiler support the helpers are stubs that are never called, since
+//  no stackless process can then be declared.
+//
+class sc_co_helpers {
+public:
+    static sc_co_state* create( SC_CO_ENTRY_FUNC fn );
+    static void destroy( sc_co_state* co );
+
+        // Creates the coroutine frame, suspended before its first statement
+    static void start( sc_co_state* co, sc_module* mod );
+
+        // Runs the process up to its next wait; deals with restarting,
+        // halting and termination the way sc_sync_process_only() and
+        // sc_aproc_process_only() do for stackful processes.
+    static void resume( sc_sync_process_handle handle );
+    static void resume( sc_aproc_process_handle handle );
+
+    static bool is_stackless( sc_sync_process_handle handle );
+};
+
+#ifdef SC_HAS_COROUTINES
+
+#include <coroutine>
+#include <exception>
+#include "sc_mempool.h"
+
+class sc_co_task {
+public:
+    struct promise_type {
+        std::exception_ptr exception;
+
+        sc_co_task get_return_object()
+            { return sc_co_task( handle_type::from_promise( *this ) ); }
+        std::suspend_always initial_suspend() noexcept { return std::suspend_always(); }
+        std::suspend_always final_suspend() noexcept   { return std::suspend_always(); }
+        void return_void() { }
+        void unhandled_exception() { exception = std::current_exception(); }
+
+        static void* operator new( size_t sz )          { return sc_mempool::allocate( sz ); }
+        static void operator delete( void* p, size_t sz ) { sc_mempool::release( p, sz ); }
+    };
+    typedef std::coroutine_handle<promise_type> handle_type;
+
+    sc_co_task() : h() { }
+    sc_co_task( sc_co_task&& t ) noexcept : h( t.h ) { t.h = handle_type(); }
+    sc_co_task& operator=( sc_co_task&& t ) noexcept
+    {
+        if (this != &t) {
+            if (h)
+                h.destroy();
+            h = t.h;
+            t.h = handle_type();
+        }
+        return *this;
+    }
+    ~sc_co_task()
+    {
+        if (h)
+            h.destroy();
+    }
+
+    bool valid() const { return bool(h); }
+    bool done() const  { return h.done(); }
+    void resume()      { h.resume(); }
+    std::exception_ptr exception() const { return h.promise().exception; }
+
+private:
+    explicit sc_co_task( handle_type hh ) : h( hh ) { }
+    sc_co_task( const sc_co_task& );
+    sc_co_task& operator=( const sc_co_task& );
+
+    handle_type h;
+};
+
+struct sc_co_state {
+    SC_CO_ENTRY_FUNC entry;
+    sc_co_task       task;
+};
+
+#define declare_sc_co_sync_process(handle, name, clock_edge, module_tag, func) \
+    sc_sync_process_handle handle; \
+    {   \
+        handle = simcontext()->register_sc_co_sync_process(name, \
+                     static_cast<SC_CO_ENTRY_FUNC>(&module_tag::func), \
+                     this, clock_edge); \
+    }
+
+#define declare_sc_co_aproc_process(handle, name, module_tag, func) \
+    sc_aproc_process_handle handle; \
+    {   \
+        handle = simcontext()->register_sc_co_aproc_process(name, \
+                     static_cast<SC_CO_ENTRY_FUNC>(&module_tag::func), \
+                     this); \
+        sc_module::sensitive << handle; \
+        sc_module::sensitive_pos << handle; \
+        sc_module::sensitive_neg << handle; \
+    }
+
+#endif  // SC_HAS_COROUTINES
+
+#endif
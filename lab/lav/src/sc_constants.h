@@ -46,4 +46,22 @@
 const int SYSTEMC_DEFAULT_STACK_SIZE = 0x10000;
 const int SYSTEMC_MAX_WATCH_LEVEL    = 16;
 
+// Minimum number of ready sc_asyncs in a delta cycle for the parallel
+// evaluation to be worth waking up the worker pool.
+const int SYSTEMC_MIN_PARALLEL_ASYNCS = 64;
+
+// Maximum number of clock edges in one hyperperiod for which the edge
+// schedule is precomputed; beyond that the priority queue is used.
+const int SYSTEMC_MAX_CALENDAR_EDGES = 65536;
+
+// Number of buckets in the timing wheel of each clock edge, in which
+// processes blocked in wait(n) sleep; must be a power of two.  Waits
+// longer than this simply go round the wheel more than once.
+const int SYSTEMC_SYNC_WHEEL_SIZE = 256;
+
+// Number of slots in the wheel of delayed writes (write_d()) of each clock
+// edge; must be a power of two.  Writes delayed by this many edges or more
+// wait in a priority queue instead.
+const int SYSTEMC_DELAY_WHEEL_SIZE = 64;
+
 #endif
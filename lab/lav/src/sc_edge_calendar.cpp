@@ -0,0 +1,181 @@
+/******************************************************************************
+    Copyright (c) 1996-2000 Synopsys, Inc.    ALL RIGHTS RESERVED
+
+  The contents of this file are subject to the restrictions and limitations
+  set forth in the SystemC(TM) Open Community License Software Download and
+  Use License Version 1.1 (the "License"); you may not use this file except
+  in compliance with such restrictions and limitations. You may obtain
+  instructions on how to receive a copy of the License at
+  http://www.systemc.org/. Software distributed by Original Contributor
+  under the License is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+  ANY KIND, either express or implied. See the License for the specific
+  language governing rights and limitations under the License.
+
+******************************************************************************/
+
+/******************************************************************************
+
+    sc_edge_calendar.cpp -- precomputed schedule of periodic clock edges.
+
+******************************************************************************/
+
+/******************************************************************************
+
+    MODIFICATION LOG - modifiers, enter your name, affliation and
+    changes you are making here:
+
+    Modifier Name & Affiliation:
+    Description of Modification:
+
+
+******************************************************************************/
+
+#include <stdlib.h>
+
+#include "sc_constants.h"
+#include "sc_clock.h"
+#include "sc_edge_calendar.h"
+
+/* Bound on the hyperperiod, in ticks, to stay clear of overflow */
+static const double max_hyperperiod = 1e18;
+
+struct cal_event {
+    sc_ticks       time;
+    int            id;
+    sc_clock_edge* edge;
+};
+
+static int
+cal_event_compare( const void* a, const void* b )
+{
+    const cal_event* e1 = (const cal_event*) a;
+    const cal_event* e2 = (const cal_event*) b;
+    if (e1->time < e2->time)
+        return -1;
+    if (e1->time > e2->time)
+        return 1;
+    return e1->id - e2->id;
+}
+
+static sc_ticks
+gcd( sc_ticks a, sc_ticks b )
+{
+    while (b != 0) {
+        sc_ticks t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+sc_edge_calendar::sc_edge_calendar( int n_edges, int n_slots )
+{
+    slot_edges = new sc_clock_edge*[n_edges];
+    slot_begin = new int[n_slots + 1];
+    num_slots  = n_slots;
+    curr_slot  = 0;
+}
+
+sc_edge_calendar::~sc_edge_calendar()
+{
+    delete[] slot_edges;
+    delete[] slot_begin;
+}
+
+sc_ticks
+sc_edge_calendar::upcoming_time() const
+{
+    return upcoming()[0]->next_edge_ticks();
+}
+
+sc_edge_calendar*
+sc_edge_calendar::build( const sc_pvector<sc_clock_edge*>& edges )
+{
+    /* Collect the automatically generated edges, and the earliest
+       upcoming edge time */
+    int n = 0;
+    sc_ticks t0 = 0;
+    int k;
+    for (k = 0; k < edges.size(); ++k) {
+        sc_clock_edge* e = edges[k];
+        if (e->period_ticks() > 0) {
+            if (n == 0 || e->next_edge_ticks() < t0)
+                t0 = e->next_edge_ticks();
+            ++n;
+        }
+    }
+    if (n == 0)
+        return 0;
+
+    sc_clock_edge** ce  = new sc_clock_edge*[n];
+    sc_ticks* per       = new sc_ticks[n];
+    sc_ticks* phase     = new sc_ticks[n];
+    int i = 0;
+    for (k = 0; k < edges.size(); ++k) {
+        if (edges[k]->period_ticks() > 0)
+            ce[i++] = edges[k];
+    }
+
+    /* Every clock must be in its steady state */
+    bool found = true;
+    for (i = 0; i < n && found; ++i) {
+        per[i]   = ce[i]->period_ticks();
+        phase[i] = ce[i]->next_edge_ticks() - t0;
+        found = phase[i] < per[i];
+    }
+
+    /* The hyperperiod, in ticks, and the number of edges in it */
+    sc_ticks hyper = 1;
+    sc_ticks total = 0;
+    for (i = 0; i < n && found; ++i) {
+        sc_ticks g = gcd( hyper, per[i] );
+        if ((double) (hyper / g) * (double) per[i] > max_hyperperiod) {
+            found = false;
+            break;
+        }
+        hyper = (hyper / g) * per[i];
+    }
+    for (i = 0; i < n && found; ++i) {
+        total += hyper / per[i];
+        if (total > SYSTEMC_MAX_CALENDAR_EDGES)
+            found = false;
+    }
+
+    sc_edge_calendar* cal = 0;
+    if (found) {
+        int n_events = (int) total;
+        cal_event* events = new cal_event[n_events];
+        int j = 0;
+        for (i = 0; i < n; ++i) {
+            for (sc_ticks t = phase[i]; t < hyper; t += per[i]) {
+                events[j].time = t;
+                events[j].id   = ce[i]->id();
+                events[j].edge = ce[i];
+                ++j;
+            }
+        }
+        qsort( events, n_events, sizeof(cal_event), cal_event_compare );
+
+        int n_slots = 1;
+        for (j = 1; j < n_events; ++j) {
+            if (events[j].time != events[j - 1].time)
+                ++n_slots;
+        }
+
+        cal = new sc_edge_calendar( n_events, n_slots );
+        int s = 0;
+        cal->slot_begin[0] = 0;
+        for (j = 0; j < n_events; ++j) {
+            if (j > 0 && events[j].time != events[j - 1].time)
+                cal->slot_begin[++s] = j;
+            cal->slot_edges[j] = events[j].edge;
+        }
+        cal->slot_begin[n_slots] = n_events;
+        delete[] events;
+    }
+
+    delete[] ce;
+    delete[] per;
+    delete[] phase;
+    return cal;
+}
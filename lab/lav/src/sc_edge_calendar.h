@@ -0,0 +1,89 @@
+/******************************************************************************
+    Copyright (c) 1996-2000 Synopsys, Inc.    ALL RIGHTS RESERVED
+
+  The contents of this file are subject to the restrictions and limitations
+  set forth in the SystemC(TM) Open Community License Software Download and
+  Use License Version 1.1 (the "License"); you may not use this file except
+  in compliance with such restrictions and limitations. You may obtain
+  instructions on how to receive a copy of the License at
+  http://www.systemc.org/. Software distributed by Original Contributor
+  under the License is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+  ANY KIND, either express or implied. See the License for the specific
+  language governing rights and limitations under the License.
+
+******************************************************************************/
+
+/******************************************************************************
+
+    sc_edge_calendar.h -- precomputed schedule of periodic clock edges.
+
+******************************************************************************/
+
+/******************************************************************************
+
+    MODIFICATION LOG - modifiers, enter your name, affliation and
+    changes you are making here:
+
+    Modifier Name & Affiliation:
+    Description of Modification:
+
+
+******************************************************************************/
+
+#ifndef SC_EDGE_CALENDAR_H
+#define SC_EDGE_CALENDAR_H
+
+#include "sc_vector.h"
+#include "sc_time_base.h"
+
+class sc_clock_edge;
+
+//
+//  <summary> Clock edge calendar </summary>
+//
+//  Since clock periods are whole numbers of ticks, the order in which
+//  the edges of periodic clocks occur repeats after the hyperperiod (the
+//  least common multiple of the periods).  sc_edge_calendar lists the
+//  edges of one hyperperiod, grouped into slots of coincident edges, and
+//  simply cycles through the slots.  Within a slot the edges are in the order
+//  the priority queue would have extracted them (ascending id).
+//
+//  build() returns 0 if the hyperperiod would be too long or contain
+//  too many edges, or if some clock has not yet reached its steady
+//  state (its next edge lies more than one period ahead of the earliest
+//  edge).  The simulation context then keeps using the priority queue.
+//
+class sc_edge_calendar {
+public:
+    static sc_edge_calendar* build( const sc_pvector<sc_clock_edge*>& edges );
+    ~sc_edge_calendar();
+
+        // The edges of the upcoming slot, and their number
+    sc_clock_edge* const* upcoming() const
+        { return slot_edges + slot_begin[curr_slot]; }
+    int upcoming_size() const
+        { return slot_begin[curr_slot + 1] - slot_begin[curr_slot]; }
+
+        // Time of the upcoming slot, as tracked by its edges
+    sc_ticks upcoming_time() const;
+
+        // Moves on to the next slot, wrapping around at the end of the
+        // hyperperiod.
+    void advance()
+    {
+        if (++curr_slot == num_slots)
+            curr_slot = 0;
+    }
+
+    int size() const { return num_slots; }
+
+private:
+    sc_edge_calendar( int n_edges, int n_slots );
+
+    sc_clock_edge** slot_edges;   /* edges of all slots, back to back */
+    int*            slot_begin;   /* num_slots + 1 entries */
+    int             num_slots;
+    int             curr_slot;
+};
+
+#endif
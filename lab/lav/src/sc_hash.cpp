@@ -42,7 +42,6 @@
 #pragma hdrstop
 #endif
 #include "sc_hash.h"
-#include "sc_mempool.h"
 #ifdef WIN32
 #include "sc_cmnhdr.h"
 #endif
@@ -53,31 +52,21 @@ using namespace std;
 
 const double PHASH_DEFAULT_GROW_FACTOR     = 2.0;
 
-class sc_phash_elem {
-    friend class sc_phash_base;
-    friend class sc_phash_base_iter;
-
-private:
-    void* key;
-    void* contents;
-    sc_phash_elem* next;
-
-    sc_phash_elem( void* k, void* c, sc_phash_elem* n )
-        : key(k), contents(c), next(n) { }
-    sc_phash_elem() { }
-    ~sc_phash_elem() { }
-
-    static void* operator new(size_t sz)            { return sc_mempool::allocate(sz); }
-    static void operator delete(void* p, size_t sz) { sc_mempool::release(p, sz);      }
-};
-
+static int
+slots_for_size(int size)
+{
+    int n = 8;
+    while (n < size)
+        n <<= 1;
+    return n;
+}
 
 sc_phash_base::sc_phash_base(
     void* def,
     int size,
-    int density,
+    int /* density */,
     double grow,
-    bool reorder,
+    bool /* reorder */,
     unsigned (*hash_fn)(const void*),
     int (*cmp_fn)(const void*, const void*)
 )
@@ -85,18 +74,17 @@ sc_phash_base::sc_phash_base(
     default_value = def;
     hash          = hash_fn;
     num_entries   = 0;
-    max_density   = density;
-    grow_factor   = grow;
-    reorder_flag  = reorder;
+    num_removed   = 0;
+
+    grow_shift = 1;
+    while ((double) (1 << grow_shift) < grow && grow_shift < 4)
+        ++grow_shift;
 
     if (size <= 0)
         size = PHASH_DEFAULT_INIT_TABLE_SIZE;
-    else if ((size % 2) == 0)
-        size += 1;
-    num_bins = size;
-    bins = new sc_phash_elem*[size];
-    for (int i = 0; i < size; ++i)
-        bins[i] = 0;
+    num_slots = slots_for_size(size);
+    slots = new slot[num_slots];
+    memset( slots, 0, sizeof(slot) * num_slots );
 
     set_cmpr_fn(cmp_fn);
 }
@@ -115,140 +103,126 @@ sc_phash_base::set_hash_fn(hash_fn_t h)
 
 sc_phash_base::~sc_phash_base()
 {
-    sc_phash_elem* ptr;
-    sc_phash_elem* next;
-
-    for (int i = 0; i < num_bins; ++i) {
-        ptr = bins[i];
-        while (ptr != 0) {
-            next = ptr->next;
-            delete ptr;
-            ptr = next;
-        }
-    }
-    delete[] bins;
+    delete[] slots;
 }
 
-void
-sc_phash_base::rehash()
-{
-    sc_phash_elem* ptr;
-    sc_phash_elem* next;
-    sc_phash_elem** old_bins = bins;
-
-    int old_num_bins = num_bins;
-    unsigned hash_val;
-
-    num_bins = (int) (grow_factor * old_num_bins);
-    if (num_bins % 2 == 0)
-        ++num_bins;
-
-    num_entries = 0;
-    bins = new sc_phash_elem*[num_bins];
-    memset( bins, 0, sizeof(sc_phash_elem*) * num_bins );
-
-    for (int i = 0; i < old_num_bins; ++i) {
-        ptr = old_bins[i];
-        while (ptr != 0) {
-            next = ptr->next;
-            hash_val = do_hash(ptr->key);
-            ptr->next = bins[hash_val];
-            bins[hash_val] = ptr;
-            ++num_entries;
-            ptr = next;
-        }
-    }
-    delete[] old_bins;
+/* The hash functions are not made for a power-of-two table (the
+   low bits of the pointer hash hardly vary), so mix all of the bits
+   into the low ones. */
+unsigned
+sc_phash_base::do_hash(const void* key) const
+{
+    unsigned h = (*hash)(key);
+    h ^= h >> 16;
+    h *= 0x85ebca6bU;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35U;
+    h ^= h >> 16;
+    return h;
 }
 
-sc_phash_elem*
-sc_phash_base::find_entry_q( unsigned hash_val, const void* key, sc_phash_elem*** plast )
-{
-    sc_phash_elem** last = &(bins[hash_val]);
-    sc_phash_elem*  ptr  = *last;
-
-    /* The (ptr->key != key) here is meant by the "q" */
-    while ((ptr != 0) && (ptr->key != key)) {
-        /*                         ^^ right here */
-        last = &(ptr->next);
-        ptr  = *last;
-    }
-    if ((ptr != 0) && reorder_flag) {
-        *last = ptr->next;
-        ptr->next = bins[hash_val];
-        bins[hash_val] = ptr;
-        last = &(bins[hash_val]);
+void
+sc_phash_base::rehash(int new_num_slots)
+{
+    slot* old_slots = slots;
+    int old_num_slots = num_slots;
+
+    num_slots = new_num_slots;
+    slots = new slot[num_slots];
+    memset( slots, 0, sizeof(slot) * num_slots );
+    num_removed = 0;
+
+    const unsigned mask = num_slots - 1;
+    for (int i = 0; i < old_num_slots; ++i) {
+        if (old_slots[i].state != SLOT_FULL)
+            continue;
+        unsigned j = old_slots[i].hash & mask;
+        while (slots[j].state != SLOT_EMPTY)
+            j = (j + 1) & mask;
+        slots[j] = old_slots[i];
     }
-    if (plast) *plast = last;
-    return ptr;
+    delete[] old_slots;
 }
 
-sc_phash_elem*
-sc_phash_base::find_entry_c( unsigned hash_val, const void* key, sc_phash_elem*** plast )
-{
-    sc_phash_elem** last = &(bins[hash_val]);
-    sc_phash_elem*  ptr  = *last;
-
-    while ((ptr != 0) && ((*cmpr)(ptr->key, key) != 0)) {
-        last = &(ptr->next);
-        ptr = *last;
-    }
-        /* Bring to front */
-    if ((ptr != 0) && reorder_flag) {
-        *last = ptr->next;
-        ptr->next = bins[hash_val];
-        bins[hash_val] = ptr;
-        last = &(bins[hash_val]);
+int
+sc_phash_base::find_entry( unsigned hash_val, const void* key ) const
+{
+    const unsigned mask = num_slots - 1;
+    unsigned i = hash_val & mask;
+    while (true) {
+        const slot& s = slots[i];
+        if (s.state == SLOT_EMPTY)
+            return -1;
+        if (s.state == SLOT_FULL && s.hash == hash_val &&
+            (cmpr == 0 ? (s.key == key) : ((*cmpr)(s.key, key) == 0)))
+            return (int) i;
+        i = (i + 1) & mask;
     }
-    if (plast) *plast = last;
-    return ptr;
 }
 
-sc_phash_elem*
+/* The key must not be in the table yet */
+void
 sc_phash_base::add_direct( void* key, void* contents, unsigned hash_val )
 {
-    if (num_entries / num_bins >= max_density) {
-        rehash();
-        hash_val = do_hash(key);
+    if (2 * (num_entries + num_removed + 1) > num_slots) {
+        int n = num_slots;
+        while (2 * (num_entries + 1) > n / 2)
+            n <<= grow_shift;
+        rehash(n);
     }
 
-    sc_phash_elem* new_entry = new sc_phash_elem(key, contents, bins[hash_val]);
-    bins[hash_val] = new_entry;
+    const unsigned mask = num_slots - 1;
+    unsigned i = hash_val & mask;
+    while (slots[i].state == SLOT_FULL)
+        i = (i + 1) & mask;
+    slot& s = slots[i];
+    if (s.state == SLOT_REMOVED)
+        --num_removed;
+    s.hash     = hash_val;
+    s.state    = SLOT_FULL;
+    s.key      = key;
+    s.contents = contents;
     ++num_entries;
-    return new_entry;
 }
 
 void
-sc_phash_base::erase()
+sc_phash_base::remove_at( int i )
 {
-    for (int i = 0; i < num_bins; ++i) {
-        sc_phash_elem* ptr = bins[i];
-        while (ptr != 0) {
-            sc_phash_elem* next = ptr->next;
-            delete ptr;
-            ptr = next;
-            --num_entries;
+    const unsigned mask = num_slots - 1;
+    slots[i].state    = SLOT_REMOVED;
+    slots[i].key      = 0;
+    slots[i].contents = 0;
+    --num_entries;
+    ++num_removed;
+
+    /* A run of tombstones that ends in an empty slot is not needed to
+       get past it; empty it */
+    if (slots[(i + 1) & mask].state == SLOT_EMPTY) {
+        unsigned j = i;
+        while (slots[j].state == SLOT_REMOVED) {
+            slots[j].state = SLOT_EMPTY;
+            --num_removed;
+            j = (j - 1) & mask;
         }
-        bins[i] = 0;
     }
-    assert(num_entries == 0);
+}
+
+void
+sc_phash_base::erase()
+{
+    memset( slots, 0, sizeof(slot) * num_slots );
+    num_entries = 0;
+    num_removed = 0;
 }
 
 void
 sc_phash_base::erase(void (*kfree)(void*))
 {
-    for (int i = 0; i < num_bins; ++i) {
-        sc_phash_elem* ptr = bins[i];
-        while (ptr != 0) {
-            sc_phash_elem* next = ptr->next;
-            (*kfree)(ptr->key);
-            delete ptr;
-            ptr = next;
-            --num_entries;
-        }
-        bins[i] = 0;
+    for (int i = 0; i < num_slots; ++i) {
+        if (slots[i].state == SLOT_FULL)
+            (*kfree)(slots[i].key);
     }
-    assert(num_entries == 0);
+    erase();
 }
 
 void
@@ -273,13 +247,13 @@ int
 sc_phash_base::insert( void* k, void* c )
 {
     unsigned hash_val = do_hash(k);
-    sc_phash_elem* ptr = find_entry( hash_val, k );
-    if (ptr == 0) {
-        (void) add_direct(k, c, hash_val);
+    int i = find_entry( hash_val, k );
+    if (i < 0) {
+        add_direct(k, c, hash_val);
         return 0;
     }
     else {
-        ptr->contents = c;
+        slots[i].contents = c;
         return 1;
     }
 }
@@ -288,13 +262,13 @@ int
 sc_phash_base::insert( void* k, void* c, void* (*kdup)(const void*) )
 {
     unsigned hash_val = do_hash(k);
-    sc_phash_elem* ptr = find_entry( hash_val, k );
-    if (ptr == 0) {
-        (void) add_direct((*kdup)(k), c, hash_val);
+    int i = find_entry( hash_val, k );
+    if (i < 0) {
+        add_direct((*kdup)(k), c, hash_val);
         return 0;
     }
     else {
-        ptr->contents = c;
+        slots[i].contents = c;
         return 1;
     }
 }
@@ -303,9 +277,8 @@ int
 sc_phash_base::insert_if_not_exists( void* k, void* c )
 {
     unsigned hash_val = do_hash(k);
-    sc_phash_elem* ptr = find_entry( hash_val, k );
-    if (ptr == 0) {
-        (void) add_direct( k, c, hash_val );
+    if (find_entry( hash_val, k ) < 0) {
+        add_direct( k, c, hash_val );
         return 0;
     }
     else
@@ -316,9 +289,8 @@ int
 sc_phash_base::insert_if_not_exists( void* k, void* c, void* (*kdup)(const void*) )
 {
     unsigned hash_val = do_hash(k);
-    sc_phash_elem* ptr = find_entry( hash_val, k );
-    if (ptr == 0) {
-        (void) add_direct( (*kdup)(k), c, hash_val );
+    if (find_entry( hash_val, k ) < 0) {
+        add_direct( (*kdup)(k), c, hash_val );
         return 0;
     }
     else
@@ -328,41 +300,25 @@ sc_phash_base::insert_if_not_exists( void* k, void* c, void* (*kdup)(const void*
 int
 sc_phash_base::remove( const void* k )
 {
-    unsigned hash_val = do_hash(k);
-    sc_phash_elem** last;
-    sc_phash_elem*  ptr = find_entry( hash_val, k, &last );
-
-    if (ptr == 0)
+    int i = find_entry( do_hash(k), k );
+    if (i < 0)
         return 0;
-
-    assert(*last == ptr);
-    *last = ptr->next;
-    delete ptr;
-    --num_entries;
+    remove_at(i);
     return 1;
 }
 
 int
 sc_phash_base::remove( const void* k, void** pk, void** pc )
 {
-    unsigned hash_val = do_hash(k);
-    sc_phash_elem** last;
-    sc_phash_elem*  ptr = find_entry( hash_val, k, &last );
-
-    if (ptr == 0) {
+    int i = find_entry( do_hash(k), k );
+    if (i < 0) {
         *pk = 0;
         *pc = 0;
         return 0;
     }
-    else {
-        *pk = ptr->key;
-        *pc = ptr->contents;
-    }
-
-    assert(*last == ptr);
-    *last = ptr->next;
-    delete ptr;
-    --num_entries;
+    *pk = slots[i].key;
+    *pc = slots[i].contents;
+    remove_at(i);
     return 1;
 }
 
@@ -382,124 +338,67 @@ sc_phash_base::remove(const void* k, void (*kfree)(void*))
 int
 sc_phash_base::remove_by_contents( const void* c )
 {
-    sc_phash_elem** last;
-    sc_phash_elem*  ptr;
-
-    int num_removed = 0;
-    for (int i = 0; i < num_bins; ++i) {
-        last = &(bins[i]);
-        ptr = *last;
-        while (ptr != 0) {
-            if (ptr->contents != c) {
-                last = &(ptr->next);
-                ptr  = *last;
-            }
-            else {
-                *last = ptr->next;
-                delete ptr;
-                ptr = *last;
-                --num_entries;
-                ++num_removed;
-            }
+    int num_removed_here = 0;
+    for (int i = 0; i < num_slots; ++i) {
+        if (slots[i].state == SLOT_FULL && slots[i].contents == c) {
+            remove_at(i);
+            ++num_removed_here;
         }
     }
-    return num_removed;
+    return num_removed_here;
 }
 
 int
 sc_phash_base::remove_by_contents( bool (*predicate)(const void* c, void* arg), void* arg )
 {
-    sc_phash_elem** last;
-    sc_phash_elem*  ptr;
-
-    int num_removed = 0;
-    for (int i = 0; i < num_bins; ++i) {
-        last = &(bins[i]);
-        ptr = *last;
-        while (ptr != 0) {
-            if (! (*predicate)(ptr->contents, arg)) {
-                last = &(ptr->next);
-                ptr  = *last;
-            }
-            else {
-                *last = ptr->next;
-                delete ptr;
-                ptr = *last;
-                --num_entries;
-                ++num_removed;
-            }
+    int num_removed_here = 0;
+    for (int i = 0; i < num_slots; ++i) {
+        if (slots[i].state == SLOT_FULL && (*predicate)(slots[i].contents, arg)) {
+            remove_at(i);
+            ++num_removed_here;
         }
     }
-    return num_removed;
+    return num_removed_here;
 }
 
 int
 sc_phash_base::remove_by_contents( const void* c, void (*kfree)(void*) )
 {
-    sc_phash_elem** last;
-    sc_phash_elem*  ptr;
-
-    int num_removed = 0;
-    for (int i = 0; i < num_bins; ++i) {
-        last = &(bins[i]);
-        ptr = *last;
-        while (ptr != 0) {
-            if (ptr->contents != c) {
-                last = &(ptr->next);
-                ptr  = *last;
-            }
-            else {
-                *last = ptr->next;
-                (*kfree)(ptr->key);
-                delete ptr;
-                ptr = *last;
-                --num_entries;
-                ++num_removed;
-            }
+    int num_removed_here = 0;
+    for (int i = 0; i < num_slots; ++i) {
+        if (slots[i].state == SLOT_FULL && slots[i].contents == c) {
+            (*kfree)(slots[i].key);
+            remove_at(i);
+            ++num_removed_here;
         }
     }
-    return num_removed;
+    return num_removed_here;
 }
 
 int
 sc_phash_base::remove_by_contents( bool (*predicate)(const void*, void*), void* arg, void (*kfree)(void*))
 {
-    sc_phash_elem** last;
-    sc_phash_elem*  ptr;
-
-    int num_removed = 0;
-    for (int i = 0; i < num_bins; ++i) {
-        last = &(bins[i]);
-        ptr = *last;
-        while (ptr != 0) {
-            if (! (*predicate)(ptr->contents, arg)) {
-                last = &(ptr->next);
-                ptr  = *last;
-            }
-            else {
-                *last = ptr->next;
-                (*kfree)(ptr->key);
-                delete ptr;
-                ptr = *last;
-                --num_entries;
-                ++num_removed;
-            }
+    int num_removed_here = 0;
+    for (int i = 0; i < num_slots; ++i) {
+        if (slots[i].state == SLOT_FULL && (*predicate)(slots[i].contents, arg)) {
+            (*kfree)(slots[i].key);
+            remove_at(i);
+            ++num_removed_here;
         }
     }
-    return num_removed;
+    return num_removed_here;
 }
 
 int
 sc_phash_base::lookup( const void* k, void** c_ptr ) const
 {
-    unsigned hash_val = do_hash(k);
-    sc_phash_elem* ptr = find_entry( hash_val, k );
-    if (ptr == 0) {
+    int i = find_entry( do_hash(k), k );
+    if (i < 0) {
         if (c_ptr != 0) *c_ptr = default_value;
         return 0;
     }
     else {
-        if (c_ptr != 0) *c_ptr = ptr->contents;
+        if (c_ptr != 0) *c_ptr = slots[i].contents;
         return 1;
     }
 }
@@ -514,91 +413,68 @@ sc_phash_base::operator[]( const void* key ) const
 
 /***************************************************************************/
 
+void
+sc_phash_base_iter::advance()
+{
+    while (index < table->num_slots &&
+           table->slots[index].state != sc_phash_base::SLOT_FULL)
+        ++index;
+}
+
 void
 sc_phash_base_iter::reset( sc_phash_base* t )
 {
     table = t;
     index = 0;
-    entry = 0;
-    next  = 0;
-
-    for (int i = index; i < table->num_bins; ++i) {
-        if (table->bins[i] != 0) {
-            index = i + 1;
-            last  = &(table->bins[i]);
-            entry = *last;
-            next  = entry->next;
-            break;
-        }
-    }
+    advance();
 }
 
 bool
 sc_phash_base_iter::empty() const
 {
-    return (entry == 0);
+    return (index >= table->num_slots);
 }
 
 void
 sc_phash_base_iter::step()
 {
-    if (entry) {
-        last = &(entry->next);
-    }
-    entry = next;
-    if (! entry) {
-        for (int i = index; i < table->num_bins; ++i) {
-            if (table->bins[i] != 0) {
-                index = i + 1;
-                last = &(table->bins[i]);
-                entry = *last;
-                next = entry->next;
-                break;
-            }
-        }
-    }
-    else {
-        next = entry->next;
+    if (index < table->num_slots) {
+        ++index;
+        advance();
     }
 }
 
 void
 sc_phash_base_iter::remove()
 {
-    delete entry;
-    *last = next;
-    entry = 0;
-    --table->num_entries;
+    table->remove_at(index);
     step();
 }
 
 void
 sc_phash_base_iter::remove(void (*kfree)(void*))
 {
-    (*kfree)(entry->key);
-    delete entry;
-    *last = next;
-    entry = 0;
-    --table->num_entries;
+    (*kfree)(table->slots[index].key);
+    table->remove_at(index);
     step();
 }
 
 void*
 sc_phash_base_iter::key() const
 {
-    return entry->key;
+    return table->slots[index].key;
 }
 
 void*
 sc_phash_base_iter::contents() const
 {
-    return entry->contents;
+    return table->slots[index].contents;
 }
 
 void*
 sc_phash_base_iter::set_contents( void* c )
 {
-    return entry->contents = c;
+    return table->slots[index].contents = c;
 }
 
 /****************************************************************************/
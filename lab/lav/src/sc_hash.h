@@ -41,7 +41,6 @@ extern unsigned default_int_hash_fn(const void*);
 extern unsigned default_ptr_hash_fn(const void*);
 extern unsigned default_str_hash_fn(const void*);
 
-class sc_phash_elem;
 class sc_phash_base_iter;
 template<class K, class C>  //template class 
 class sc_pdhash_iter;       //decl. -- Amit
@@ -51,6 +50,21 @@ const int    PHASH_DEFAULT_INIT_TABLE_SIZE = 11;
 extern const double PHASH_DEFAULT_GROW_FACTOR;
 const bool   PHASH_DEFAULT_REORDER_FLAG    = true;
 
+//
+//  <summary> Hash table of void* keys and contents </summary>
+//
+//  The entries are kept in one power-of-two array of slots, and are
+//  found by linear probing, so a table allocates nothing per entry.
+//  Each slot keeps the hash of its key; the compare function is only
+//  called on keys whose hashes are equal, and a lookup never writes to
+//  the table.  A removed entry leaves a tombstone that later insertions
+//  reuse.  The table is rebuilt when entries and tombstones together
+//  would fill more than half of it.
+//
+//  The density and reorder arguments of the constructor are kept for
+//  compatibility; the load is bounded as above, and there are no chains
+//  to reorder.  The grow factor is rounded up to a power of two.
+//
 class sc_phash_base {
     friend class sc_phash_base_iter;
 
@@ -61,33 +75,32 @@ public:
     typedef int (*cmpr_fn_t)(const void*, const void*);
 
 protected:
+    enum { SLOT_EMPTY, SLOT_FULL, SLOT_REMOVED };
+
+    struct slot {
+        unsigned hash;
+        int      state;
+        void*    key;
+        void*    contents;
+    };
+
     void*    default_value;
-    int      num_bins;
+    int      num_slots;
     int      num_entries;
-    int      max_density;
-    int      reorder_flag;
-    double   grow_factor;
+    int      num_removed;       /* tombstones */
+    int      grow_shift;
 
-    sc_phash_elem** bins;
+    slot*    slots;
 
     hash_fn_t hash;
     cmpr_fn_t cmpr;
 
-    void rehash();
-    unsigned do_hash(const void* key) const { return (*hash)(key) % num_bins; }
+    void rehash(int new_num_slots);
+    unsigned do_hash(const void* key) const;
 
-    sc_phash_elem* add_direct(void* key, void* contents, unsigned hash_val);
-    sc_phash_elem* find_entry_c(unsigned hv, const void* k, sc_phash_elem*** plast);
-    sc_phash_elem* find_entry_q(unsigned hv, const void* k, sc_phash_elem*** plast);
-    sc_phash_elem* find_entry(unsigned hv, const void* k, sc_phash_elem*** plast=0) const
-    {
-      /* Got rid of member func. pointer and replaced with if-else  */
-      /* Amit (5/14/99)                                             */
-      if( cmpr == 0 )
-        return ((sc_phash_base*)this)->find_entry_q( hv, k, plast );
-      else 
-	return ((sc_phash_base*)this)->find_entry_c( hv, k, plast );
-    }
+    void add_direct(void* key, void* contents, unsigned hash_val);
+    int  find_entry(unsigned hv, const void* k) const;
+    void remove_at(int i);
 
 public:
     sc_phash_base( void* def       = 0,
@@ -128,13 +141,14 @@ public:
     void* operator[](const void* key) const;
 };
 
+//  Entries may be removed through the iterator while iterating, but
+//  the table must not otherwise be changed.
 class sc_phash_base_iter {
 protected:
     sc_phash_base*  table;
-    sc_phash_elem*  entry;
-    sc_phash_elem*  next;
-    sc_phash_elem** last;
-    int             index;
+    int             index;      /* of the current entry */
+
+    void advance();
 
 public:
     void reset(sc_phash_base* t);
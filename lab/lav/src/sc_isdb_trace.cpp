@@ -1404,10 +1404,9 @@ void isdb_trace_file::initialize()
   // Set previous-time
   // Convert init time to ISDB_Time
   //
-  double inittime = sc_simulation_time();
-  double_to_special_int64(inittime/timescale_unit,
-			  &previous_time_units_high,
-			  &previous_time_units_low );
+  ticks_to_special_int64(sc_ticks_to_units(sc_time_stamp_ticks(), timescale_unit),
+			 &previous_time_units_high,
+			 &previous_time_units_low );
   isdb_time.low = previous_time_units_low;
   isdb_time.high = previous_time_units_high;
 
@@ -1427,7 +1426,8 @@ void isdb_trace_file::initialize()
     fprintf(stderr,"WARNING: Default time step (1 s) is used for ISDB tracing.\n");
   }
 
-  // Define variables
+  // Define variables, which writes their values at the start time
+  ISDB_SetTime (database, isdb_time);
   int i;
   for (i = 0; i < traces.size(); i++) {
     isdb_trace* t = traces[i];
@@ -1491,7 +1491,7 @@ void isdb_trace_file::trace(const bool& object, const sc_string& name)
   
   sc_string temp_isdb_name;
   create_isdb_name(&temp_isdb_name);
-  traces.push_back(new isdb_bool_trace(object, name, temp_isdb_name));
+  add_trace(new isdb_bool_trace(object, name, temp_isdb_name));
 }
 
 
@@ -1503,7 +1503,7 @@ void isdb_trace_file::trace(const sc_bool_vector& object, const sc_string& name)
   
   sc_string temp_isdb_name;
   create_isdb_name(&temp_isdb_name);
-  traces.push_back(new isdb_bool_vector_trace(object, name, temp_isdb_name));
+  add_trace(new isdb_bool_vector_trace(object, name, temp_isdb_name));
 }
 
 
@@ -1515,7 +1515,7 @@ void isdb_trace_file::trace(const sc_logic& object, const sc_string& name)
   
   sc_string temp_isdb_name;
   create_isdb_name(&temp_isdb_name);
-  traces.push_back(new isdb_sc_logic_trace(object, name, temp_isdb_name));
+  add_trace(new isdb_sc_logic_trace(object, name, temp_isdb_name));
 }
 
 
@@ -1527,7 +1527,7 @@ void isdb_trace_file::trace(const sc_logic_vector& object, const sc_string& name
   
   sc_string temp_isdb_name;
   create_isdb_name(&temp_isdb_name);
-  traces.push_back(new isdb_sc_logic_vector_trace(object,name, temp_isdb_name));
+  add_trace(new isdb_sc_logic_vector_trace(object,name, temp_isdb_name));
 }
 
 void isdb_trace_file::trace(const unsigned& object, const sc_string& name, int _width)
@@ -1538,7 +1538,7 @@ void isdb_trace_file::trace(const unsigned& object, const sc_string& name, int _
   
   sc_string temp_isdb_name;
   create_isdb_name(&temp_isdb_name);
-  traces.push_back(new isdb_unsigned_int_trace(object, name, temp_isdb_name, _width));
+  add_trace(new isdb_unsigned_int_trace(object, name, temp_isdb_name, _width));
 }
 
 void isdb_trace_file::trace(const unsigned char& object, const sc_string& name, int _width)
@@ -1549,7 +1549,7 @@ void isdb_trace_file::trace(const unsigned char& object, const sc_string& name,
   
   sc_string temp_isdb_name;
   create_isdb_name(&temp_isdb_name);
-  traces.push_back(new isdb_unsigned_char_trace(object, name, temp_isdb_name, _width));
+  add_trace(new isdb_unsigned_char_trace(object, name, temp_isdb_name, _width));
 }
 
 void isdb_trace_file::trace(const unsigned short& object, const sc_string& name, int _width)
@@ -1560,7 +1560,7 @@ void isdb_trace_file::trace(const unsigned short& object, const sc_string& name,
   
   sc_string temp_isdb_name;
   create_isdb_name(&temp_isdb_name);
-  traces.push_back(new isdb_unsigned_short_trace(object, name, temp_isdb_name, _width));
+  add_trace(new isdb_unsigned_short_trace(object, name, temp_isdb_name, _width));
 }
 
 void isdb_trace_file::trace(const unsigned long& object, const sc_string& name, int _width)
@@ -1571,7 +1571,7 @@ void isdb_trace_file::trace(const unsigned long& object, const sc_string& name,
   
   sc_string temp_isdb_name;
   create_isdb_name(&temp_isdb_name);
-  traces.push_back(new isdb_unsigned_long_trace(object, name, temp_isdb_name, _width));
+  add_trace(new isdb_unsigned_long_trace(object, name, temp_isdb_name, _width));
 }
 
 void isdb_trace_file::trace(const int& object, const sc_string& name, int _width)
@@ -1582,7 +1582,7 @@ void isdb_trace_file::trace(const int& object, const sc_string& name, int _width
   
   sc_string temp_isdb_name;
   create_isdb_name(&temp_isdb_name);
-  traces.push_back(new isdb_signed_int_trace(object, name, temp_isdb_name, _width));
+  add_trace(new isdb_signed_int_trace(object, name, temp_isdb_name, _width));
 }
 
 void isdb_trace_file::trace(const char& object, const sc_string& name, int _width)
@@ -1593,7 +1593,7 @@ void isdb_trace_file::trace(const char& object, const sc_string& name, int _widt
   
   sc_string temp_isdb_name;
   create_isdb_name(&temp_isdb_name);
-  traces.push_back(new isdb_signed_char_trace(object, name, temp_isdb_name, _width));
+  add_trace(new isdb_signed_char_trace(object, name, temp_isdb_name, _width));
 }
 
 void isdb_trace_file::trace(const short& object, const sc_string& name, int _width)
@@ -1604,7 +1604,7 @@ void isdb_trace_file::trace(const short& object, const sc_string& name, int _wid
   
   sc_string temp_isdb_name;
   create_isdb_name(&temp_isdb_name);
-  traces.push_back(new isdb_signed_short_trace(object, name, temp_isdb_name, _width));
+  add_trace(new isdb_signed_short_trace(object, name, temp_isdb_name, _width));
 }
 
 void isdb_trace_file::trace(const long& object, const sc_string& name, int _width)
@@ -1615,7 +1615,7 @@ void isdb_trace_file::trace(const long& object, const sc_string& name, int _widt
   
   sc_string temp_isdb_name;
   create_isdb_name(&temp_isdb_name);
-  traces.push_back(new isdb_signed_long_trace(object, name, temp_isdb_name, _width));
+  add_trace(new isdb_signed_long_trace(object, name, temp_isdb_name, _width));
 }
 
 void isdb_trace_file::trace(const float& object, const sc_string& name)
@@ -1626,7 +1626,7 @@ void isdb_trace_file::trace(const float& object, const sc_string& name)
   
   sc_string temp_isdb_name;
   create_isdb_name(&temp_isdb_name);
-  traces.push_back(new isdb_float_trace(object, name, temp_isdb_name));
+  add_trace(new isdb_float_trace(object, name, temp_isdb_name));
 }
 
 void isdb_trace_file::trace(const double& object, const sc_string& name)
@@ -1637,7 +1637,7 @@ void isdb_trace_file::trace(const double& object, const sc_string& name)
   
   sc_string temp_isdb_name;
   create_isdb_name(&temp_isdb_name);
-  traces.push_back(new isdb_double_trace(object, name, temp_isdb_name));
+  add_trace(new isdb_double_trace(object, name, temp_isdb_name));
 }
 
 void isdb_trace_file::trace(const sc_unsigned& object, const sc_string& name)
@@ -1648,7 +1648,7 @@ void isdb_trace_file::trace(const sc_unsigned& object, const sc_string& name)
   
   sc_string temp_isdb_name;
   create_isdb_name(&temp_isdb_name);
-  traces.push_back(new isdb_sc_unsigned_trace(object, name, temp_isdb_name));
+  add_trace(new isdb_sc_unsigned_trace(object, name, temp_isdb_name));
 }
 
 void isdb_trace_file::trace(const sc_signed& object, const sc_string& name)
@@ -1659,7 +1659,7 @@ void isdb_trace_file::trace(const sc_signed& object, const sc_string& name)
   
   sc_string temp_isdb_name;
   create_isdb_name(&temp_isdb_name);
-  traces.push_back(new isdb_sc_signed_trace(object, name, temp_isdb_name));
+  add_trace(new isdb_sc_signed_trace(object, name, temp_isdb_name));
 }
 
 
@@ -1671,7 +1671,7 @@ void isdb_trace_file::trace(const sc_int_base& object, const sc_string& name)
   
   sc_string temp_isdb_name;
   create_isdb_name(&temp_isdb_name);
-  traces.push_back(new isdb_sc_int_base_trace(object, name, temp_isdb_name));
+  add_trace(new isdb_sc_int_base_trace(object, name, temp_isdb_name));
 }
 
 void isdb_trace_file::trace(const sc_uint_base& object, const sc_string& name)
@@ -1682,7 +1682,7 @@ void isdb_trace_file::trace(const sc_uint_base& object, const sc_string& name)
   
   sc_string temp_isdb_name;
   create_isdb_name(&temp_isdb_name);
-  traces.push_back(new isdb_sc_uint_base_trace(object, name, temp_isdb_name));
+  add_trace(new isdb_sc_uint_base_trace(object, name, temp_isdb_name));
 }
 
 
@@ -1699,7 +1699,7 @@ isdb_trace_file::trace( const tp& object, const sc_string& name )             \
                                                                               \
     sc_string temp_isdb_name;                                                 \
     create_isdb_name( &temp_isdb_name );                                      \
-    traces.push_back( new isdb_ ## tp ## _trace( object,                      \
+    add_trace( new isdb_ ## tp ## _trace( object,                      \
 						 name,                        \
 						 temp_isdb_name ) );          \
 }
@@ -1722,7 +1722,7 @@ void isdb_trace_file::trace(const unsigned& object, const sc_string& name, const
   
   sc_string temp_isdb_name;
   create_isdb_name(&temp_isdb_name);
-  traces.push_back(new isdb_enum_trace(object, name, temp_isdb_name, enum_literals));
+  add_trace(new isdb_enum_trace(object, name, temp_isdb_name, enum_literals));
 }
 
 void isdb_trace_file::trace(const sc_signal_bool_vector& object, const sc_string& name)
@@ -1733,7 +1733,7 @@ void isdb_trace_file::trace(const sc_signal_bool_vector& object, const sc_string
 
     sc_string temp_isdb_name;
     create_isdb_name(&temp_isdb_name);
-    traces.push_back(new isdb_bool_vector_trace((const sc_bool_vector&) object, name, temp_isdb_name));
+    add_trace(new isdb_bool_vector_trace((const sc_bool_vector&) object, name, temp_isdb_name));
 }
 
 
@@ -1745,7 +1745,7 @@ void isdb_trace_file::trace(const sc_signal_logic_vector& object, const sc_strin
 
     sc_string temp_isdb_name;
     create_isdb_name(&temp_isdb_name);
-    traces.push_back(new isdb_sc_logic_vector_trace((const sc_logic_vector&) object, name, temp_isdb_name));
+    add_trace(new isdb_sc_logic_vector_trace((const sc_logic_vector&) object, name, temp_isdb_name));
 }
 
 void isdb_trace_file::trace(const sc_signal_resolved& object, const sc_string& name)
@@ -1756,7 +1756,7 @@ void isdb_trace_file::trace(const sc_signal_resolved& object, const sc_string& n
 
     sc_string temp_isdb_name;
     create_isdb_name(&temp_isdb_name);
-    traces.push_back(new isdb_sc_logic_trace((const sc_logic&) *(object.get_data_ptr()), name, temp_isdb_name));
+    add_trace(new isdb_sc_logic_trace((const sc_logic&) *(object.get_data_ptr()), name, temp_isdb_name));
 }
 
 void isdb_trace_file::trace(const sc_signal_resolved_vector& object, const sc_string& name)
@@ -1767,7 +1767,7 @@ void isdb_trace_file::trace(const sc_signal_resolved_vector& object, const sc_st
 
     sc_string temp_isdb_name;
     create_isdb_name(&temp_isdb_name);
-    traces.push_back(new isdb_sc_logic_vector_trace((const sc_logic_vector&) object, name, temp_isdb_name));
+    add_trace(new isdb_sc_logic_vector_trace((const sc_logic_vector&) object, name, temp_isdb_name));
 }
 
 void isdb_trace_file::write_comment(const sc_string& comment)
@@ -1795,14 +1795,15 @@ void isdb_trace_file::cycle(bool this_is_a_delta_cycle)
   // Check for initialization
   if (!initialized) {
     initialize();
+    clear_dirty();
     initialized = true;
     return;
   };
 
 
-  double now_units = sc_simulation_time() / timescale_unit;
+  sc_ticks now_units = sc_ticks_to_units(sc_time_stamp_ticks(), timescale_unit);
   unsigned now_units_high, now_units_low;
-  double_to_special_int64(now_units, &now_units_high, &now_units_low );
+  ticks_to_special_int64(now_units, &now_units_high, &now_units_low );
 
   bool now_later_than_previous_time = false;
   if(      now_units_low > previous_time_units_low 
@@ -1887,8 +1888,10 @@ void isdb_trace_file::cycle(bool this_is_a_delta_cycle)
   //
   bool time_printed = false;
   isdb_trace* const* const l_traces = traces.raw_data();
-  for (int i = 0; i < traces.size(); i++) {
-    isdb_trace* t = l_traces[i];
+  int n_check;
+  sc_trace_watch* const* const to_check = traces_to_check(n_check);
+  for (int k = 0; k < n_check; k++) {
+    isdb_trace* t = l_traces[to_check[k]->index];
     if(t->changed()){
 
       // Set time stamp on the fly
@@ -1916,6 +1919,12 @@ void isdb_trace_file::cycle(bool this_is_a_delta_cycle)
 }
 
 
+void isdb_trace_file::add_trace(isdb_trace* t)
+{
+  traces.push_back(t);
+  trace_added();
+}
+
 void isdb_trace_file::create_isdb_name(sc_string* p_destination)
 {
     const char first_type_used = 'a';
@@ -230,6 +230,8 @@ private:
     void initialize();
     // Create ISDB names for each variable
     void create_isdb_name(sc_string* p_destination);
+    // Add a trace to the traces
+    void add_trace(isdb_trace* t);
     
     // Array to store the variables traced
     sc_pvector<isdb_trace*> traces;
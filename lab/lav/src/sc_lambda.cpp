@@ -49,6 +49,8 @@ using std::hex;
 #endif
 #include <assert.h>
 #include "sc_lambda.h"
+#include "sc_simcontext.h"
+#include "sc_process_int.h"
 
 sc_lambda sc_lambda::dummy_lambda;
 
@@ -58,12 +60,16 @@ sc_lambda::sc_lambda( sc_lambda_rator_e op,
     : rator_ty(op), op1(o1), op2(o2)
 {
     ref_count = 0;
+    code = 0;
+    compiled = false;
 }
 
 sc_lambda::sc_lambda( const sc_signal_edgy& b )
     : rator_ty(SC_LAMBDA_BOOL), op1(new sc_lambda_rand(b)), op2(0)
 {
     ref_count = 0;
+    code = 0;
+    compiled = false;
 }
 
 // This version should be used for creating the dummy_lambda only
@@ -77,17 +83,40 @@ sc_lambda::sc_lambda()
     one++;
     // Make sure it doesn't get deleted
     ref_count = 1;
+    code = 0;
+    compiled = false;
 }
 
 sc_lambda::~sc_lambda()
 {
     assert((ref_count == 0) || (this == &dummy_lambda));
+    discard_code();
     delete op1;
     delete op2;
 }
 
 bool
 sc_lambda::eval() const
+{
+    if (code != 0) {
+        if (dirty) {
+            value = run_code();
+            dirty = false;
+        }
+        return value;
+    }
+    /* Ports are replaced by signals only when simulation starts, so
+       compiling any earlier could subscribe to the wrong objects. */
+    if (! compiled && sc_get_curr_simcontext()->is_running()) {
+        compile();
+        if (code != 0)
+            return eval();
+    }
+    return tree_eval();
+}
+
+bool
+sc_lambda::tree_eval() const
 {
     // The compiler should optimize the switch statement to a computed
     // branch.  Otherwise, we should create a table of functions to
@@ -146,6 +175,7 @@ void
 sc_lambda::replace_ports( void (*replace_fn)(sc_port_manager*, sc_lambda_rand*),
                           sc_port_manager* port_manager )
 {
+    discard_code();
     if (op1) op1->replace_ports( replace_fn, port_manager );
     if (op2) op2->replace_ports( replace_fn, port_manager );
 }
@@ -207,6 +237,561 @@ sc_lambda::sc_logic_eval() const
 
 /*****************************************************************************/
 
+/* Compiled lambdas.
+
+   compile() flattens the expression tree into a postfix sequence of
+   instructions, with the operators of sc_lambda_rator_e as opcodes
+   and a few more for loading operands and short-circuiting && and ||.
+   run_code() executes it on two small stacks, one of ints (also used
+   for bools) and one of sc_logics.
+
+   The lambda is then subscribed to each signal it reads: a
+   sc_lambda_watch per signal is linked into the signal's
+   lambda_watchers list, and sc_signal_base::notify_watchers() marks
+   the lambda dirty whenever an update changes the signal.  The
+   processes in `waiters' are handed back to their clock edge at the
+   same time, and stop waiting on the lambda. */
+
+enum sc_lambda_op_e
+{
+    SC_LAMBDA_OP_PUSH_INT = SC_LAMBDA_INT_BITXOR + 1,
+    SC_LAMBDA_OP_PUSH_SUL,
+    SC_LAMBDA_OP_PUSH_BOOL_SIG,
+    SC_LAMBDA_OP_PUSH_INT_SIG,
+    SC_LAMBDA_OP_PUSH_SUL_SIG,
+    SC_LAMBDA_OP_JUMP_FALSE_OR_POP,
+    SC_LAMBDA_OP_JUMP_TRUE_OR_POP
+};
+
+/* Deeper expressions are left to tree_eval() */
+const int SC_LAMBDA_STACK_SIZE = 16;
+
+struct sc_lambda_insn {
+    int op;
+    union {
+        int                        val;     /* constant, or jump target */
+        const sc_logic*            sul_val;
+        const sc_signal_edgy*      edgy_sig;
+        const sc_signal<int>*      int_sig;
+        const sc_signal<sc_logic>* sul_sig;
+    };
+};
+
+struct sc_lambda_watch {
+    const sc_lambda*      lambda;
+    const sc_signal_base* sig;       /* 0 once the signal is destroyed */
+    sc_lambda_watch*      next;
+    sc_lambda_watch*      prev;
+};
+
+struct sc_lambda_code {
+    sc_lambda_insn*  insns;
+    int              n_insns;
+    sc_lambda_watch* watches;
+    int              n_watches;
+};
+
+//
+//  <summary> Translates a lambda tree into sc_lambda_code </summary>
+//
+//  Each *_expr() and *_rand() method emits the code that leaves the
+//  value of its node on top of the corresponding stack, and returns
+//  false if the node has the wrong type or is malformed.
+//
+class sc_lambda_compiler {
+public:
+    sc_lambda_compiler( const sc_lambda* l, sc_lambda_code* c );
+
+    bool bool_expr( const sc_lambda* l );
+    bool int_expr( const sc_lambda* l );
+    bool sul_expr( const sc_lambda* l );
+
+    bool stacks_fit() const
+    {
+        return (max_int_depth <= SC_LAMBDA_STACK_SIZE) &&
+               (max_sul_depth <= SC_LAMBDA_STACK_SIZE);
+    }
+
+        // Upper bound on the number of instructions for `l'
+    static int size( const sc_lambda* l );
+
+private:
+    bool bool_rand( const sc_lambda_rand* r );
+    bool int_rand( const sc_lambda_rand* r );
+    bool sul_rand( const sc_lambda_rand* r );
+
+    static const sc_lambda* sub_lambda( const sc_lambda_rand* r )
+    {
+        return ((const sc_lambda_ptr*) r->lamb_space)->ptr;
+    }
+    static int size( const sc_lambda_rand* r );
+
+    sc_lambda_insn& emit( int op, int int_delta, int sul_delta );
+    void subscribe( const sc_signal_base* sig );
+
+    const sc_lambda* owner;
+    sc_lambda_code*  code;
+    int int_depth;
+    int max_int_depth;
+    int sul_depth;
+    int max_sul_depth;
+};
+
+sc_lambda_compiler::sc_lambda_compiler( const sc_lambda* l, sc_lambda_code* c )
+    : owner(l), code(c)
+{
+    int_depth = max_int_depth = 0;
+    sul_depth = max_sul_depth = 0;
+}
+
+int
+sc_lambda_compiler::size( const sc_lambda* l )
+{
+    return 1 + size( l->op1 ) + size( l->op2 );
+}
+
+int
+sc_lambda_compiler::size( const sc_lambda_rand* r )
+{
+    if (r == 0)
+        return 0;
+    if (r->rand_ty == SC_LAMBDA_RAND_LAMBDA)
+        return size( sub_lambda( r ) );
+    return 1;
+}
+
+sc_lambda_insn&
+sc_lambda_compiler::emit( int op, int int_delta, int sul_delta )
+{
+    if ((int_depth += int_delta) > max_int_depth)
+        max_int_depth = int_depth;
+    if ((sul_depth += sul_delta) > max_sul_depth)
+        max_sul_depth = sul_depth;
+    sc_lambda_insn& insn = code->insns[code->n_insns++];
+    insn.op = op;
+    insn.val = 0;
+    return insn;
+}
+
+void
+sc_lambda_compiler::subscribe( const sc_signal_base* sig )
+{
+    for (int i = 0; i < code->n_watches; ++i) {
+        if (code->watches[i].sig == sig)
+            return;
+    }
+    sc_lambda_watch& w = code->watches[code->n_watches++];
+    w.lambda = owner;
+    w.sig = sig;
+    w.next = 0;
+    w.prev = 0;
+}
+
+bool
+sc_lambda_compiler::bool_expr( const sc_lambda* l )
+{
+    switch (l->rator_ty) {
+
+    case SC_LAMBDA_FALSE:
+    case SC_LAMBDA_TRUE:
+        emit( SC_LAMBDA_OP_PUSH_INT, 1, 0 ).val = (l->rator_ty == SC_LAMBDA_TRUE);
+        return true;
+
+    case SC_LAMBDA_BOOL:
+        return bool_rand( l->op1 );
+
+    case SC_LAMBDA_NOT:
+        if (! bool_rand( l->op1 ))
+            return false;
+        emit( SC_LAMBDA_NOT, 0, 0 );
+        return true;
+
+    case SC_LAMBDA_AND:
+    case SC_LAMBDA_OR: {
+        if (! bool_rand( l->op1 ))
+            return false;
+        /* The jump pops the left operand only if the right one is
+           to be evaluated in its place. */
+        int jump = code->n_insns;
+        emit( (l->rator_ty == SC_LAMBDA_AND) ? SC_LAMBDA_OP_JUMP_FALSE_OR_POP
+                                             : SC_LAMBDA_OP_JUMP_TRUE_OR_POP,
+              -1, 0 );
+        if (! bool_rand( l->op2 ))
+            return false;
+        code->insns[jump].val = code->n_insns;
+        return true;
+    }
+
+    case SC_LAMBDA_BOOL_EQ:
+    case SC_LAMBDA_BOOL_NE:
+        if (! bool_rand( l->op1 ) || ! bool_rand( l->op2 ))
+            return false;
+        emit( l->rator_ty, -1, 0 );
+        return true;
+
+    case SC_LAMBDA_SUL_EQ:
+    case SC_LAMBDA_SUL_NE:
+        if (! sul_rand( l->op1 ) || ! sul_rand( l->op2 ))
+            return false;
+        emit( l->rator_ty, 1, -2 );
+        return true;
+
+    case SC_LAMBDA_INT_EQ:
+    case SC_LAMBDA_INT_NE:
+    case SC_LAMBDA_INT_LE:
+    case SC_LAMBDA_INT_GE:
+    case SC_LAMBDA_INT_LT:
+    case SC_LAMBDA_INT_GT:
+        if (! int_rand( l->op1 ) || ! int_rand( l->op2 ))
+            return false;
+        emit( l->rator_ty, -1, 0 );
+        return true;
+
+    default:
+        return false;
+    }
+}
+
+bool
+sc_lambda_compiler::int_expr( const sc_lambda* l )
+{
+    switch (l->rator_ty) {
+
+    case SC_LAMBDA_INT_BITNOT:
+        if (! int_rand( l->op1 ))
+            return false;
+        emit( l->rator_ty, 0, 0 );
+        return true;
+
+    case SC_LAMBDA_INT_ADD:
+    case SC_LAMBDA_INT_SUB:
+    case SC_LAMBDA_INT_MUL:
+    case SC_LAMBDA_INT_DIV:
+    case SC_LAMBDA_INT_REM:
+    case SC_LAMBDA_INT_BITAND:
+    case SC_LAMBDA_INT_BITOR:
+    case SC_LAMBDA_INT_BITXOR:
+        if (! int_rand( l->op1 ) || ! int_rand( l->op2 ))
+            return false;
+        emit( l->rator_ty, -1, 0 );
+        return true;
+
+    default:
+        return false;
+    }
+}
+
+bool
+sc_lambda_compiler::sul_expr( const sc_lambda* l )
+{
+    switch (l->rator_ty) {
+
+    case SC_LAMBDA_SUL_BITNOT:
+        if (! sul_rand( l->op1 ))
+            return false;
+        emit( l->rator_ty, 0, 0 );
+        return true;
+
+    case SC_LAMBDA_SUL_BITAND:
+    case SC_LAMBDA_SUL_BITOR:
+    case SC_LAMBDA_SUL_BITXOR:
+        if (! sul_rand( l->op1 ) || ! sul_rand( l->op2 ))
+            return false;
+        emit( l->rator_ty, 0, -1 );
+        return true;
+
+    default:
+        return false;
+    }
+}
+
+bool
+sc_lambda_compiler::bool_rand( const sc_lambda_rand* r )
+{
+    if (r == 0)
+        return false;
+
+    switch (r->rand_ty) {
+
+    case SC_LAMBDA_RAND_BOOL:
+    case SC_LAMBDA_RAND_INT:
+        emit( SC_LAMBDA_OP_PUSH_INT, 1, 0 ).val = (r->val != 0);
+        return true;
+
+    case SC_LAMBDA_RAND_SIGNAL_BOOL:
+        emit( SC_LAMBDA_OP_PUSH_BOOL_SIG, 1, 0 ).edgy_sig = r->edgy_sig;
+        subscribe( r->edgy_sig );
+        return true;
+
+    case SC_LAMBDA_RAND_LAMBDA:
+        return bool_expr( sub_lambda( r ) );
+
+    default:
+        return false;
+    }
+}
+
+bool
+sc_lambda_compiler::int_rand( const sc_lambda_rand* r )
+{
+    if (r == 0)
+        return false;
+
+    switch (r->rand_ty) {
+
+    case SC_LAMBDA_RAND_INT:
+        emit( SC_LAMBDA_OP_PUSH_INT, 1, 0 ).val = r->val;
+        return true;
+
+    case SC_LAMBDA_RAND_SIGNAL_INT:
+        emit( SC_LAMBDA_OP_PUSH_INT_SIG, 1, 0 ).int_sig = r->int_sig;
+        subscribe( r->int_sig );
+        return true;
+
+    case SC_LAMBDA_RAND_LAMBDA:
+        return int_expr( sub_lambda( r ) );
+
+    default:
+        return false;
+    }
+}
+
+bool
+sc_lambda_compiler::sul_rand( const sc_lambda_rand* r )
+{
+    if (r == 0)
+        return false;
+
+    switch (r->rand_ty) {
+
+    case SC_LAMBDA_RAND_SUL:
+        emit( SC_LAMBDA_OP_PUSH_SUL, 0, 1 ).sul_val = (const sc_logic*) r->ch_space;
+        return true;
+
+    case SC_LAMBDA_RAND_SIGNAL_SUL:
+        emit( SC_LAMBDA_OP_PUSH_SUL_SIG, 0, 1 ).sul_sig = r->sul_sig;
+        subscribe( r->sul_sig );
+        return true;
+
+    case SC_LAMBDA_RAND_LAMBDA:
+        return sul_expr( sub_lambda( r ) );
+
+    default:
+        return false;
+    }
+}
+
+void
+sc_lambda::compile() const
+{
+    compiled = true;
+    if (this == &dummy_lambda)
+        return;
+
+    int n = sc_lambda_compiler::size( this );
+    sc_lambda_code* c = new sc_lambda_code;
+    c->insns = new sc_lambda_insn[n];
+    c->n_insns = 0;
+    c->watches = new sc_lambda_watch[n];
+    c->n_watches = 0;
+
+    sc_lambda_compiler compiler( this, c );
+    if (! compiler.bool_expr( this ) || ! compiler.stacks_fit()) {
+        delete[] c->insns;
+        delete[] c->watches;
+        delete c;
+        return;
+    }
+
+    for (int i = 0; i < c->n_watches; ++i) {
+        sc_lambda_watch* w = &c->watches[i];
+        w->next = w->sig->lambda_watchers;
+        if (w->next != 0)
+            w->next->prev = w;
+        w->sig->lambda_watchers = w;
+    }
+    code = c;
+    dirty = true;
+}
+
+void
+sc_lambda::discard_code() const
+{
+    compiled = false;
+    if (code == 0)
+        return;
+
+    for (int i = 0; i < code->n_watches; ++i) {
+        sc_lambda_watch* w = &code->watches[i];
+        if (w->sig == 0)
+            continue;
+        if (w->prev != 0)
+            w->prev->next = w->next;
+        else
+            w->sig->lambda_watchers = w->next;
+        if (w->next != 0)
+            w->next->prev = w->prev;
+    }
+    delete[] code->insns;
+    delete[] code->watches;
+    delete code;
+    code = 0;
+}
+
+void
+sc_lambda::forget_signal( const sc_signal_base* sig )
+{
+    sc_lambda_watch* w = sig->lambda_watchers;
+    while (w != 0) {
+        sc_lambda_watch* next = w->next;
+        w->sig = 0;
+        w->next = 0;
+        w->prev = 0;
+        w = next;
+    }
+    sig->lambda_watchers = 0;
+}
+
+void
+sc_lambda_notify( sc_lambda_watch* watchers )
+{
+    for (sc_lambda_watch* w = watchers; w != 0; w = w->next) {
+        const sc_lambda* l = w->lambda;
+        l->dirty = true;
+        if (l->waiters.size() != 0) {
+            for (int i = 0; i < l->waiters.size(); ++i)
+                l->waiters[i]->operand_changed();
+            l->waiters.erase_all();
+        }
+    }
+}
+
+bool
+sc_lambda::run_code() const
+{
+    int      int_stack[SC_LAMBDA_STACK_SIZE];
+    sc_logic sul_stack[SC_LAMBDA_STACK_SIZE];
+    int*      ip = int_stack - 1;   // top of the stacks
+    sc_logic* lp = sul_stack - 1;
+
+    const sc_lambda_insn* const insns = code->insns;
+    const int n = code->n_insns;
+
+    for (int pc = 0; pc < n; ++pc) {
+        const sc_lambda_insn& insn = insns[pc];
+        switch (insn.op) {
+
+        case SC_LAMBDA_OP_PUSH_INT:
+            *++ip = insn.val;
+            break;
+        case SC_LAMBDA_OP_PUSH_BOOL_SIG:
+            *++ip = insn.edgy_sig->edgy_read();
+            break;
+        case SC_LAMBDA_OP_PUSH_INT_SIG:
+            *++ip = insn.int_sig->read();
+            break;
+        case SC_LAMBDA_OP_PUSH_SUL:
+            *++lp = *insn.sul_val;
+            break;
+        case SC_LAMBDA_OP_PUSH_SUL_SIG:
+            *++lp = insn.sul_sig->read();
+            break;
+
+        case SC_LAMBDA_OP_JUMP_FALSE_OR_POP:
+            if (*ip)
+                --ip;
+            else
+                pc = insn.val - 1;
+            break;
+        case SC_LAMBDA_OP_JUMP_TRUE_OR_POP:
+            if (*ip)
+                pc = insn.val - 1;
+            else
+                --ip;
+            break;
+
+        case SC_LAMBDA_NOT:
+            ip[0] = ! ip[0];
+            break;
+        case SC_LAMBDA_BOOL_EQ:
+        case SC_LAMBDA_INT_EQ:
+            --ip; ip[0] = (ip[0] == ip[1]);
+            break;
+        case SC_LAMBDA_BOOL_NE:
+        case SC_LAMBDA_INT_NE:
+            --ip; ip[0] = (ip[0] != ip[1]);
+            break;
+        case SC_LAMBDA_INT_LE:
+            --ip; ip[0] = (ip[0] <= ip[1]);
+            break;
+        case SC_LAMBDA_INT_GE:
+            --ip; ip[0] = (ip[0] >= ip[1]);
+            break;
+        case SC_LAMBDA_INT_LT:
+            --ip; ip[0] = (ip[0] < ip[1]);
+            break;
+        case SC_LAMBDA_INT_GT:
+            --ip; ip[0] = (ip[0] > ip[1]);
+            break;
+
+        case SC_LAMBDA_SUL_EQ:
+            lp -= 2; *++ip = (lp[1] == lp[2]);
+            break;
+        case SC_LAMBDA_SUL_NE:
+            lp -= 2; *++ip = (lp[1] != lp[2]);
+            break;
+
+        case SC_LAMBDA_INT_ADD:
+            --ip; ip[0] = ip[0] + ip[1];
+            break;
+        case SC_LAMBDA_INT_SUB:
+            --ip; ip[0] = ip[0] - ip[1];
+            break;
+        case SC_LAMBDA_INT_MUL:
+            --ip; ip[0] = ip[0] * ip[1];
+            break;
+        case SC_LAMBDA_INT_DIV:
+            --ip; ip[0] = ip[0] / ip[1];
+            break;
+        case SC_LAMBDA_INT_REM:
+            --ip; ip[0] = ip[0] % ip[1];
+            break;
+        case SC_LAMBDA_INT_BITAND:
+            --ip; ip[0] = ip[0] & ip[1];
+            break;
+        case SC_LAMBDA_INT_BITOR:
+            --ip; ip[0] = ip[0] | ip[1];
+            break;
+        case SC_LAMBDA_INT_BITXOR:
+            --ip; ip[0] = ip[0] ^ ip[1];
+            break;
+        case SC_LAMBDA_INT_BITNOT:
+            ip[0] = ~ ip[0];
+            break;
+
+        case SC_LAMBDA_SUL_BITAND:
+            --lp; lp[0] = lp[0] & lp[1];
+            break;
+        case SC_LAMBDA_SUL_BITOR:
+            --lp; lp[0] = lp[0] | lp[1];
+            break;
+        case SC_LAMBDA_SUL_BITXOR:
+            --lp; lp[0] = lp[0] ^ lp[1];
+            break;
+        case SC_LAMBDA_SUL_BITNOT:
+            lp[0] = ~ lp[0];
+            break;
+
+        default:
+            assert( false );
+            break;
+        }
+    }
+    return (int_stack[0] != 0);
+}
+
+/*****************************************************************************/
+
 static const char* sc_lambda_rand_names[] = {
     "SC_LAMBDA_RAND_LAMBDA",
     "SC_LAMBDA_RAND_SIGNAL_INT",
@@ -91,6 +91,9 @@ enum sc_lambda_rator_e
 class sc_lambda;
 class sc_lambda_rand;
 class sc_lambda_ptr;
+class sc_lambda_compiler;
+struct sc_lambda_code;
+class sc_sync_process;
 
 /*---------------------------------------------------------------------------*/
 
@@ -108,11 +111,23 @@ class sc_lambda_ptr;
 //     object will be automatically created.  The management of
 //     the lambda objects is performed by the sc_sync class.
 //
+//     Once simulation has started, the first eval() flattens the
+//     tree into postfix code and subscribes the lambda to its
+//     operand signals.  Updating any of those signals marks the
+//     lambda dirty; otherwise eval() returns the previous result
+//     without reading a single signal.  It also hands the clocked
+//     processes waiting on the lambda back to their clock edge, to be
+//     examined on its next edge.
+//
 class sc_lambda
 {
     friend class sc_lambda_ptr;
     friend class sc_lambda_rand;
     friend class sc_port_manager;
+    friend class sc_lambda_compiler;
+    friend class sc_signal_base;
+    friend class sc_sync_process;
+    friend void sc_lambda_notify( sc_lambda_watch* watchers );
 
 #include "sc_lambda_friends.h_"
 
@@ -123,7 +138,8 @@ public:
         // Create a lambda out of a bool signal
     explicit sc_lambda( const sc_signal_edgy& b );
 
-        // Evaluates the expression tree.
+        // Evaluates the expression; see above for when the result of
+        // the previous evaluation is returned instead.
     bool eval() const;
 
         // Destructor
@@ -134,6 +150,9 @@ private:
     sc_lambda( sc_lambda_rator_e op,
                sc_lambda_rand* o1 = 0, sc_lambda_rand* o2 = 0 );
 
+        // Evaluates the expression tree itself
+    bool tree_eval() const;
+
         // Evaluates the expression as an int
     int int_eval() const;
 
@@ -163,12 +182,30 @@ private:
     void replace_ports( void (*fn)(sc_port_manager*, sc_lambda_rand*),
                         sc_port_manager* m );
 
+        // Flattens the tree into `code' and subscribes to the operand
+        // signals; leaves `code' null if the tree cannot be compiled.
+    void compile() const;
+    void discard_code() const;
+    bool run_code() const;
+
+        // Called when `sig' is destroyed
+    static void forget_signal( const sc_signal_base* sig );
+
 private:
     sc_lambda_rator_e rator_ty;
     sc_lambda_rand* op1;
     sc_lambda_rand* op2;
     int ref_count;              // reference count
 
+    mutable sc_lambda_code* code;   // compiled form, or 0
+    mutable bool compiled;          // compile() has been tried
+    mutable bool dirty;             // an operand has been updated
+    mutable bool value;             // result of the last run_code()
+
+        // The processes to recheck when an operand changes; see
+        // sc_sync_process::wait_on_lambdas()
+    mutable sc_pvector<sc_sync_process*> waiters;
+
 private:
     sc_lambda();
     static sc_lambda dummy_lambda;
@@ -195,6 +232,7 @@ class sc_lambda_ptr
     friend class sc_lambda;
     friend class sc_lambda_rand;
     friend class sc_port_manager;
+    friend class sc_lambda_compiler;
 
 #include "sc_lambda_friends.h_"
 
@@ -300,6 +338,7 @@ class sc_lambda_rand
 {
     friend class sc_lambda;
     friend class sc_port_manager;
+    friend class sc_lambda_compiler;
 
 public:
     static void* operator new(size_t sz)       { return sc_mempool::allocate(sz); }
@@ -818,10 +818,6 @@ signal_sulv::dump(ostream& os) const
     for (i = len - 1; i >= 0; --i) {
         os << get_signal(i)->get_new_value();
     }
-    os << "old value = ";
-    for (i = len - 1; i >= 0; --i) {
-        os << get_signal(i)->get_old_value();
-    }
     os << endl;
 }
 
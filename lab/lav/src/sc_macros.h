@@ -98,9 +98,9 @@ do { \
 
 /* These help debugging -- user can find out where each process is stopped at. */
 
-#define WAIT()             sc_set_location(__FILE__,__LINE__); wait()
-#define WAITN(n)           sc_set_location(__FILE__,__LINE__); wait(n)
-#define NEXT()             sc_set_location(__FILE__,__LINE__); wait()
-#define WAIT_UNTIL(lambda) sc_set_location(__FILE__,__LINE__); wait_until(lambda)
+#define WAIT()             sc_set_location(__FILE__,__LINE__); (void) wait()
+#define WAITN(n)           sc_set_location(__FILE__,__LINE__); (void) wait(n)
+#define NEXT()             sc_set_location(__FILE__,__LINE__); (void) wait()
+#define WAIT_UNTIL(lambda) sc_set_location(__FILE__,__LINE__); (void) wait_until(lambda)
 
 #endif
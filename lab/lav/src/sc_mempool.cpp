@@ -33,18 +33,25 @@
 ******************************************************************************/
 
 
-//  <sc_mempool> is a class that manages the memory for small objects,
-//  of sizes <increment>, 2 * <increment>, ..., <num_pools> *
-//  <increment>.  When a memory request of <k> bytes is made through
-//  the memory pool, the smallest pool <j> such that <j> * <increment>
-//  >= <k> is used.  The default values of <increment> and <num_pools>
-//  are 8 and 8, respectively.  Each pool has an allocator, that
-//  simply keeps a free list of cells, and allocate new blocks
-//  whenever necessary.  We are relying on malloc() to return a
-//  properly aligned memory blocks.  Note that the memory blocks
-//  allocated by the mempool are never freed.  Thus, if purify is
-//  used, we may get MIU (memory-in-use) warnings.  To disable this,
-//  set the environment variable SYSTEMC_MEMPOOL_DONT_USE to 1.
+//  <sc_mempool> is a class that manages the memory for small objects.
+//  Requests are rounded up to one of a set of size classes, which by
+//  default run from 8 to 4096 bytes and can be replaced with
+//  sc_mempool::configure() before the first allocation.  Larger
+//  requests go to the global operator new.
+//
+//  Cells of a class are carved out of blocks of <block_size> bytes,
+//  which are aligned on their size so that the block of a cell can be
+//  found from its address.  Each thread keeps a cache of free cells
+//  per class, and allocates and releases cells there without locking.
+//  When its cache runs empty, or grows beyond twice the batch size of
+//  the class, a thread exchanges a batch of cells with the shared free
+//  list of the class under a lock.  sc_mempool::trim() gives the
+//  blocks all of whose cells are free back to the system, so that a
+//  long run that once needed many objects does not keep their memory.
+//
+//  To bypass the pool altogether, e.g. to find leaks with a memory
+//  checker, set the environment variable SYSTEMC_MEMPOOL_DONT_USE
+//  to 1.
 
 
 static const char* dont_use_envstring = "SYSTEMC_MEMPOOL_DONT_USE";
@@ -53,172 +60,147 @@ static bool use_default_new = false;
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <new>
+#ifndef _MSC_VER
+#include <iostream>
+using std::cerr;
+using std::endl;
+#else
+#include <iostream.h>
+#endif
+#include <assert.h>
+
+#ifdef WIN32
+#include "sc_cmnhdr.h"
+#include <Windows.h>
+#include <malloc.h>
+#else
+#include <pthread.h>
+#endif
+
 #include "sc_mempool.h"
 
+#ifdef _MSC_VER
+#define SC_THREAD_LOCAL __declspec(thread)
+#else
+#define SC_THREAD_LOCAL __thread
+#endif
 
-//  An allocator is one that handles a particular size.  It keeps a
-//  <free_list> from which a cell may be allocated quickly if there
-//  is one available.  If no cell is available from <free_list>, then
-//  the allocator tries to find whether space is available from the
-//  most-recently-allocated block, as pointed to by <next_avail>.  If
-//  so, then the cell pointed to by <next_avail> is returned, while
-//  <next_avail> is advanced.  If <next_avail> now points beyond
-//  the current block, then it's reset to 0.  On the other hand,
-//  if <next_avail> was 0 when a request to the block is made, then
-//  a new block is allocated by calling system malloc(), and the new
-//  block becomes the head of <block_list>.
 
+static const size_t block_size    = 65536;
+static const size_t max_cell      = 4096;
+static const int    max_classes   = 32;
+static const int    batch_bytes   = 8192;  /* per exchange with the shared list */
 
-class sc_allocator {
-    friend class sc_mempool;
+static const size_t default_cell_sizes[] = {
+       8,   16,   24,   32,   48,   64,   80,   96,  128,  160,  192,
+     256,  320,  384,  512,  768, 1024, 1536, 2048, 3072, 4096
+};
 
-public:
-    sc_allocator( int blksz, int cellsz );
-    ~sc_allocator();
-    void* allocate();
-    void release(void* p);
-    
-    void display_statistics();
+static size_t cell_sizes[max_classes];
+static int    num_classes = 0;
 
-private:
-    union link {
-        link* next;
-        double align;          // alignment required.
-    };
 
-    int block_size;            // size of each block in bytes,
-                               // including the link
-    int cell_size;             // size of each cell in bytes
+#ifdef WIN32
+static SRWLOCK pool_lock = SRWLOCK_INIT;
+static inline void lock_pool()   { AcquireSRWLockExclusive( &pool_lock ); }
+static inline void unlock_pool() { ReleaseSRWLockExclusive( &pool_lock ); }
+#else
+static pthread_mutex_t pool_lock = PTHREAD_MUTEX_INITIALIZER;
+static inline void lock_pool()   { pthread_mutex_lock( &pool_lock ); }
+static inline void unlock_pool() { pthread_mutex_unlock( &pool_lock ); }
+#endif
 
-    char* block_list;
-    link* free_list;
-    char* next_avail;
 
-    int total_alloc;
-    int total_freed;
-    int free_list_alloc;
+union sc_mempool_cell {
+    sc_mempool_cell* next;
+    double align;              // alignment required.
 };
 
-sc_allocator::sc_allocator( int blksz, int cellsz )
-{
-    cell_size = cellsz;
-    block_size = sizeof(link) + (((blksz - 1) / cellsz) + 1) * cellsz;
-    block_list = 0;
-    free_list = 0;
-    next_avail = 0;
-
-    total_alloc = 0;
-    total_freed = 0;
-    free_list_alloc = 0;
-}
+struct sc_mempool_block {
+    sc_mempool_block* next;
+    sc_mempool_block* prev;
+    int               size_class;
+    int               num_free;     /* counted by trim() */
+};
 
-sc_allocator::~sc_allocator()
-{
-    // Shouldn't free the block_list, since global objects that use
-    // the memory pool may not have been destroyed yet ...
-    // Let it leak, let it leak, let it leak ...
-}
+/* Cells start at this offset into their block */
+static const size_t first_cell = (sizeof(sc_mempool_block) + 15) & ~(size_t) 15;
 
-void*
-sc_allocator::allocate()
+static inline sc_mempool_block*
+block_of( void* p )
 {
-    void* result = 0;
-    total_alloc++;
-    if (free_list != 0) {
-        free_list_alloc++;
-        result = free_list;
-        free_list = free_list->next;
-        return result;
-    }
-    else if (next_avail != 0) {
-        result = next_avail;
-        next_avail += cell_size;
-        // next_avail goes beyond the block
-        if (next_avail >= block_list + block_size)
-            next_avail = 0;
-        return result;
-    }
-    else {  // (next_avail == 0)
-        link* new_block = (link*) malloc(block_size);  // need alignment?
-        new_block->next = (link*) block_list;
-        block_list = (char*) new_block;
-        result = (block_list + sizeof(link));
-        // Assume that the block will hold more than one cell ... why
-        // wouldn't it?
-        next_avail = ((char*) result) + cell_size;
-        return result;
-    }
+    return (sc_mempool_block*) ((size_t) p & ~(block_size - 1));
 }
 
-void
-sc_allocator::release(void* p)
-{
-    total_freed++;
-    ((link*) p)->next = free_list;
-    free_list = (link*) p;
-}
 
-void
-sc_allocator::display_statistics()
-{
-    int nblocks = 0;
-    for (link* b = (link*) block_list; b != 0; b = b->next)
-        nblocks++;
-    printf("size %3d: %2d block(s), %3d requests (%3d from free list), %3d freed.\n",
-           cell_size, nblocks, total_alloc, free_list_alloc, total_freed);
-}
+//  The shared part of a size class: the free list that the threads
+//  refill their caches from, the blocks the cells were carved out of,
+//  and the statistics folded in from the threads.
+
+struct sc_size_class {
+    size_t            cell_size;
+    int               cells_per_block;
+    int               batch;
 
+    sc_mempool_cell*  free_list;
+    int               num_free;
+    sc_mempool_block* blocks;
+    int               num_blocks;
 
-static const int cell_sizes[] = {
-/* 0 */   0,
-/* 1 */   8,
-/* 2 */  16,
-/* 3 */  24,
-/* 4 */  32,
-/* 5 */  48,
-/* 6 */  64,
-/* 7 */  80,
-/* 8 */  96,
-/* 9 */ 128
+    unsigned long     requests;
+    unsigned long     hits;
+    unsigned long     releases;
+    size_t            peak_bytes;
 };
 
-static const int cell_size_to_allocator[] = {
-/*  0 */    0,
-/*  1 */    1,
-/*  2 */    2,
-/*  3 */    3,
-/*  4 */    4,
-/*  5 */    5,
-/*  6 */    5,
-/*  7 */    6,
-/*  8 */    6,
-/*  9 */    7,
-/* 10 */    7,
-/* 11 */    8,
-/* 12 */    8,
-/* 13 */    9,
-/* 14 */    9,
-/* 15 */    9,
-/* 16 */    9
+//  A thread's cache.  The counts are the thread's since it last
+//  exchanged cells with the shared lists.
+
+struct sc_mempool_cache {
+    struct slot {
+        sc_mempool_cell* free_list;
+        int              count;
+        unsigned long    requests;
+        unsigned long    hits;
+        unsigned long    releases;
+    };
+    slot cls[max_classes];
 };
 
+static SC_THREAD_LOCAL sc_mempool_cache* thread_cache = 0;
+
 
 class sc_mempool_int {
     friend class sc_mempool;
 
 public:
-    sc_mempool_int(int blksz, int npools, int incr);
+    sc_mempool_int( const size_t* sizes, int n );
     ~sc_mempool_int();
-    void* do_allocate(size_t);
-    void  do_release(void*, size_t);
+    void* do_allocate( size_t );
+    void  do_release( void*, size_t );
 
     void display_statistics();
-    
+
 private:
-    sc_allocator** allocators;
-    int num_pools;
-    int increment;
-    int max_size;
+    int class_of( size_t sz ) const { return size_to_class[(sz + 7) >> 3]; }
+
+    sc_mempool_cache* new_cache();
+    void refill( int c, sc_mempool_cache::slot& s );
+    void drain( int c, sc_mempool_cache::slot& s, int n );
+    void fold( int c, sc_mempool_cache::slot& s );
+    void fold_all( sc_mempool_cache* tc );
+    void flush( sc_mempool_cache* tc );
+    void add_block( int c );
+    size_t trim();
+
+    sc_size_class  classes[max_classes];
+    int            num_pools;
+    size_t         max_size;
+    unsigned char* size_to_class;      /* indexed by (size + 7) / 8 */
+
+    size_t live;                       /* bytes, over all classes */
+    size_t peak;
 };
 
 
@@ -229,71 +211,314 @@ compute_use_default_new()
     return (e != 0) && (atoi(e) != 0);
 }
 
-sc_mempool_int::sc_mempool_int(int blksz, int npools, int incr)
+sc_mempool_int::sc_mempool_int( const size_t* sizes, int n )
 {
-    use_default_new = compute_use_default_new();
-    if (! use_default_new) {
-        num_pools = npools;
-        increment = incr;
-        max_size = cell_sizes[sizeof(cell_sizes)/sizeof(cell_sizes[0]) - 1];
-        allocators = new sc_allocator*[npools + 1];
-        for (int i = 1; i <= npools; ++i)
-            allocators[i] = new sc_allocator(blksz, cell_sizes[i]);
-        allocators[0] = allocators[1];
+    num_pools = n;
+    max_size = sizes[n - 1];
+    size_to_class = new unsigned char[(max_size >> 3) + 1];
+    int c = 0;
+    for (size_t k = 0; k <= (max_size >> 3); ++k) {
+        while (sizes[c] < (k << 3))
+            ++c;
+        size_to_class[k] = (unsigned char) c;
     }
+
+    for (c = 0; c < n; ++c) {
+        sc_size_class& cls = classes[c];
+        cls.cell_size       = sizes[c];
+        cls.cells_per_block = (int) ((block_size - first_cell) / sizes[c]);
+        cls.batch           = (int) (batch_bytes / sizes[c]);
+        if (cls.batch < 4)
+            cls.batch = 4;
+        else if (cls.batch > 64)
+            cls.batch = 64;
+        cls.free_list  = 0;
+        cls.num_free   = 0;
+        cls.blocks     = 0;
+        cls.num_blocks = 0;
+        cls.requests   = 0;
+        cls.hits       = 0;
+        cls.releases   = 0;
+        cls.peak_bytes = 0;
+    }
+    live = 0;
+    peak = 0;
 }
 
 sc_mempool_int::~sc_mempool_int()
 {
-    for (int i = 1; i <= num_pools; ++i)
-        delete allocators[i];
-    delete[] allocators;
+    // Shouldn't free the blocks, since global objects that use
+    // the memory pool may not have been destroyed yet ...
+    delete[] size_to_class;
 }
 
 static sc_mempool_int* the_mempool = 0;
 
+sc_mempool_cache*
+sc_mempool_int::new_cache()
+{
+    sc_mempool_cache* tc = (sc_mempool_cache*) malloc( sizeof(sc_mempool_cache) );
+    if (tc == 0)
+        throw std::bad_alloc();
+    for (int c = 0; c < max_classes; ++c) {
+        sc_mempool_cache::slot& s = tc->cls[c];
+        s.free_list = 0;
+        s.count     = 0;
+        s.requests  = 0;
+        s.hits      = 0;
+        s.releases  = 0;
+    }
+    thread_cache = tc;
+    return tc;
+}
+
+/* The following take the pool lock, or expect the caller to hold it. */
+
+void
+sc_mempool_int::add_block( int c )
+{
+    sc_size_class& cls = classes[c];
+    void* mem;
+#ifdef WIN32
+    mem = _aligned_malloc( block_size, block_size );
+#else
+    if (posix_memalign( &mem, block_size, block_size ) != 0)
+        mem = 0;
+#endif
+    if (mem == 0)
+        throw std::bad_alloc();
+
+    sc_mempool_block* b = (sc_mempool_block*) mem;
+    b->size_class = c;
+    b->num_free   = 0;
+    b->prev       = 0;
+    b->next       = cls.blocks;
+    if (cls.blocks != 0)
+        cls.blocks->prev = b;
+    cls.blocks = b;
+    cls.num_blocks++;
+
+    /* Thread the cells onto the free list, lowest address first */
+    char* first = (char*) b + first_cell;
+    for (int i = cls.cells_per_block - 1; i >= 0; --i) {
+        sc_mempool_cell* cell = (sc_mempool_cell*) (first + i * cls.cell_size);
+        cell->next = cls.free_list;
+        cls.free_list = cell;
+    }
+    cls.num_free += cls.cells_per_block;
+}
+
+void
+sc_mempool_int::fold( int c, sc_mempool_cache::slot& s )
+{
+    sc_size_class& cls = classes[c];
+    cls.requests += s.requests;
+    cls.hits     += s.hits;
+    cls.releases += s.releases;
+
+    size_t nlive = (cls.requests > cls.releases)
+                 ? (cls.requests - cls.releases) * cls.cell_size : 0;
+    if (nlive > cls.peak_bytes)
+        cls.peak_bytes = nlive;
+
+    live += s.requests * cls.cell_size;
+    live -= (s.releases * cls.cell_size > live) ? live : s.releases * cls.cell_size;
+    if (live > peak)
+        peak = live;
+
+    s.requests = 0;
+    s.hits     = 0;
+    s.releases = 0;
+}
+
+void
+sc_mempool_int::fold_all( sc_mempool_cache* tc )
+{
+    if (tc != 0) {
+        for (int c = 0; c < num_pools; ++c)
+            fold( c, tc->cls[c] );
+    }
+}
+
+void
+sc_mempool_int::refill( int c, sc_mempool_cache::slot& s )
+{
+    sc_size_class& cls = classes[c];
+    lock_pool();
+    fold( c, s );
+    if (cls.num_free < cls.batch)
+        add_block( c );
+    for (int i = 0; i < cls.batch; ++i) {
+        sc_mempool_cell* cell = cls.free_list;
+        cls.free_list = cell->next;
+        cell->next = s.free_list;
+        s.free_list = cell;
+    }
+    cls.num_free -= cls.batch;
+    s.count += cls.batch;
+    unlock_pool();
+}
+
+void
+sc_mempool_int::drain( int c, sc_mempool_cache::slot& s, int n )
+{
+    sc_size_class& cls = classes[c];
+    lock_pool();
+    fold( c, s );
+    for (int i = 0; i < n; ++i) {
+        sc_mempool_cell* cell = s.free_list;
+        s.free_list = cell->next;
+        cell->next = cls.free_list;
+        cls.free_list = cell;
+    }
+    s.count -= n;
+    cls.num_free += n;
+    unlock_pool();
+}
+
+void
+sc_mempool_int::flush( sc_mempool_cache* tc )
+{
+    for (int c = 0; c < num_pools; ++c)
+        drain( c, tc->cls[c], tc->cls[c].count );
+}
+
+size_t
+sc_mempool_int::trim()
+{
+    size_t released = 0;
+
+    lock_pool();
+    for (int c = 0; c < num_pools; ++c) {
+        sc_size_class& cls = classes[c];
+        sc_mempool_block* b;
+        for (b = cls.blocks; b != 0; b = b->next)
+            b->num_free = 0;
+        sc_mempool_cell* cell;
+        for (cell = cls.free_list; cell != 0; cell = cell->next)
+            block_of( cell )->num_free++;
+
+        /* Drop the cells of the blocks that are wholly free */
+        sc_mempool_cell** pp = &cls.free_list;
+        while ((cell = *pp) != 0) {
+            if (block_of( cell )->num_free == cls.cells_per_block) {
+                *pp = cell->next;
+                cls.num_free--;
+            } else {
+                pp = &cell->next;
+            }
+        }
+
+        b = cls.blocks;
+        while (b != 0) {
+            sc_mempool_block* next = b->next;
+            if (b->num_free == cls.cells_per_block) {
+                if (b->prev != 0)
+                    b->prev->next = next;
+                else
+                    cls.blocks = next;
+                if (next != 0)
+                    next->prev = b->prev;
+                cls.num_blocks--;
+#ifdef WIN32
+                _aligned_free( b );
+#else
+                free( b );
+#endif
+                released += block_size;
+            }
+            b = next;
+        }
+    }
+    unlock_pool();
+    return released;
+}
+
 void*
-sc_mempool_int::do_allocate(size_t sz)
+sc_mempool_int::do_allocate( size_t sz )
 {
-    int which_allocator = cell_size_to_allocator[(sz - 1) / increment + 1];
-    void* p = allocators[which_allocator]->allocate();
-    return p;
+    int c = class_of( sz );
+    sc_mempool_cache* tc = thread_cache;
+    if (tc == 0)
+        tc = new_cache();
+    sc_mempool_cache::slot& s = tc->cls[c];
+    s.requests++;
+    if (s.free_list != 0)
+        s.hits++;
+    else
+        refill( c, s );
+    sc_mempool_cell* cell = s.free_list;
+    s.free_list = cell->next;
+    s.count--;
+    return cell;
 }
 
 void
-sc_mempool_int::do_release(void* p, size_t sz)
+sc_mempool_int::do_release( void* p, size_t sz )
 {
-    int which_allocator = cell_size_to_allocator[(sz - 1) / increment + 1];
-    allocators[which_allocator]->release(p);
+    int c = class_of( sz );
+    sc_mempool_cache* tc = thread_cache;
+    if (tc == 0)
+        tc = new_cache();
+    sc_mempool_cache::slot& s = tc->cls[c];
+    sc_mempool_cell* cell = (sc_mempool_cell*) p;
+    cell->next = s.free_list;
+    s.free_list = cell;
+    s.count++;
+    s.releases++;
+    if (s.count >= 2 * classes[c].batch)
+        drain( c, s, classes[c].batch );
 }
 
 void
 sc_mempool_int::display_statistics()
 {
+    sc_mempool_stats st;
     printf("*** Memory Pool Statistics ***\n");
-    for (int i = 1; i <= num_pools; ++i)
-        allocators[i]->display_statistics();
+    for (int i = 0; i < num_pools; ++i) {
+        sc_mempool::statistics(i, st);
+        printf("size %4d: %3d block(s), %8lu requests (%5.1f%% hits), %8lu freed, "
+               "%8lu bytes live, %8lu peak.\n",
+               (int) st.cell_size, (int) (st.held_bytes / block_size), st.requests,
+               100.0 * st.hit_rate(), st.releases,
+               (unsigned long) st.live_bytes, (unsigned long) st.peak_bytes);
+    }
+    printf("total: %lu bytes live, %lu peak.\n",
+           (unsigned long) sc_mempool::live_bytes(),
+           (unsigned long) sc_mempool::peak_bytes());
 }
 
 /****************************************************************************/
 
+static sc_mempool_int*
+create_mempool()
+{
+    lock_pool();
+    if (the_mempool == 0) {
+        use_default_new = compute_use_default_new();
+        if (! use_default_new) {
+            // Note that the_mempool is never freed.  This is going to cause
+            // memory leaks when the program exits.
+            if (num_classes == 0)
+                sc_mempool::configure( default_cell_sizes,
+                    sizeof(default_cell_sizes)/sizeof(default_cell_sizes[0]) );
+            the_mempool = new sc_mempool_int( cell_sizes, num_classes );
+        }
+    }
+    unlock_pool();
+    return the_mempool;
+}
+
 void*
 sc_mempool::allocate(size_t sz)
 {
     if (use_default_new)
         return ::operator new(sz);
 
-    if (the_mempool == 0) {
-        use_default_new = compute_use_default_new();
-        if (use_default_new)
-            return ::operator new(sz);
-
-        // Note that the_mempool is never freed.  This is going to cause
-        // memory leaks when the program exits.
-        the_mempool = new sc_mempool_int( 1984, sizeof(cell_sizes)/sizeof(cell_sizes[0]) - 1, 8 );
-    }
+    if (the_mempool == 0 && create_mempool() == 0)
+        return ::operator new(sz);
 
-    if (sz > (unsigned) the_mempool->max_size)
+    if (sz > the_mempool->max_size)
         return ::operator new(sz);
 
     return the_mempool->do_allocate(sz);
@@ -303,8 +528,8 @@ void
 sc_mempool::release(void* p, size_t sz)
 {
     if (p) {
-        
-        if (use_default_new || sz > (unsigned) the_mempool->max_size) {
+
+        if (use_default_new || the_mempool == 0 || sz > the_mempool->max_size) {
             ::operator delete(p);
             return;
         }
@@ -313,6 +538,118 @@ sc_mempool::release(void* p, size_t sz)
     }
 }
 
+void
+sc_mempool::configure(const size_t* sizes, int n)
+{
+    if (the_mempool != 0) {
+        cerr << "SystemC error: the memory pool can only be configured "
+             << "before its first allocation" << endl;
+        assert(false);
+        return;
+    }
+    if (n <= 0 || n > max_classes) {
+        cerr << "SystemC error: the memory pool takes 1 to " << max_classes
+             << " size classes" << endl;
+        assert(false);
+        return;
+    }
+    for (int i = 0; i < n; ++i) {
+        if (sizes[i] == 0 || (sizes[i] & 7) != 0 || sizes[i] > max_cell ||
+            (i > 0 && sizes[i] <= sizes[i - 1])) {
+            cerr << "SystemC error: bad memory pool size class " << sizes[i]
+                 << endl;
+            assert(false);
+            return;
+        }
+    }
+    for (int j = 0; j < n; ++j)
+        cell_sizes[j] = sizes[j];
+    num_classes = n;
+}
+
+size_t
+sc_mempool::max_cell_size()
+{
+    return max_cell;
+}
+
+size_t
+sc_mempool::trim()
+{
+    if (the_mempool == 0)
+        return 0;
+    if (thread_cache != 0)
+        the_mempool->flush(thread_cache);
+    return the_mempool->trim();
+}
+
+void
+sc_mempool::flush_thread_cache()
+{
+    sc_mempool_cache* tc = thread_cache;
+    if (the_mempool == 0 || tc == 0)
+        return;
+    the_mempool->flush(tc);
+    thread_cache = 0;
+    free(tc);
+}
+
+int
+sc_mempool::num_size_classes()
+{
+    if (the_mempool != 0)
+        return the_mempool->num_pools;
+    return num_classes ? num_classes
+                       : (int) (sizeof(default_cell_sizes)/sizeof(default_cell_sizes[0]));
+}
+
+bool
+sc_mempool::statistics(int size_class, sc_mempool_stats& st)
+{
+    if (the_mempool == 0 || size_class < 0 || size_class >= the_mempool->num_pools)
+        return false;
+
+    sc_mempool_cache* tc = thread_cache;
+    lock_pool();
+    if (tc != 0)
+        the_mempool->fold(size_class, tc->cls[size_class]);
+    const sc_size_class& cls = the_mempool->classes[size_class];
+    st.cell_size  = cls.cell_size;
+    st.requests   = cls.requests;
+    st.hits       = cls.hits;
+    st.releases   = cls.releases;
+    st.live_bytes = (cls.requests > cls.releases)
+                  ? (cls.requests - cls.releases) * cls.cell_size : 0;
+    st.peak_bytes = cls.peak_bytes;
+    st.held_bytes = cls.num_blocks * block_size;
+    unlock_pool();
+    return true;
+}
+
+size_t
+sc_mempool::live_bytes()
+{
+    if (the_mempool == 0)
+        return 0;
+    lock_pool();
+    the_mempool->fold_all(thread_cache);
+    size_t n = the_mempool->live;
+    unlock_pool();
+    return n;
+}
+
+size_t
+sc_mempool::peak_bytes()
+{
+    if (the_mempool == 0)
+        return 0;
+    lock_pool();
+    the_mempool->fold_all(thread_cache);
+    size_t n = the_mempool->peak;
+    unlock_pool();
+    return n;
+}
+
 void
 sc_mempool::display_statistics()
 {
@@ -41,11 +41,53 @@
 using std::size_t;
 #endif
 
+//
+//  <summary> Per-size-class statistics of the memory pool </summary>
+//
+//  Counts made by other threads are folded in whenever those threads
+//  exchange a batch of cells with the shared pool, so they may lag by
+//  up to a batch.
+//
+struct sc_mempool_stats {
+    size_t        cell_size;
+    unsigned long requests;     /* allocations of this class */
+    unsigned long hits;         /* ... served from a thread's cache */
+    unsigned long releases;
+    size_t        live_bytes;   /* allocated and not yet released */
+    size_t        peak_bytes;   /* highest live_bytes seen */
+    size_t        held_bytes;   /* in blocks obtained from the system */
+
+    double hit_rate() const
+    {
+        return requests ? (double) hits / (double) requests : 0.0;
+    }
+};
+
 class sc_mempool {
 public:
     static void* allocate(size_t sz);
     static void release(void* p, size_t sz);
     static void display_statistics();
+
+        // Replaces the size classes; `sizes' must be increasing
+        // multiples of 8, no larger than max_cell_size().  Only
+        // allowed before the first allocation.
+    static void configure(const size_t* sizes, int n);
+    static size_t max_cell_size();
+
+        // Returns to the system the blocks all of whose cells are
+        // free, and the number of bytes released
+    static size_t trim();
+
+        // Hands the cells cached by the calling thread back to the
+        // shared pool; threads other than the simulation thread should
+        // call it before they exit.
+    static void flush_thread_cache();
+
+    static int num_size_classes();
+    static bool statistics(int size_class, sc_mempool_stats& st);
+    static size_t live_bytes();
+    static size_t peak_bytes();
 };
 
 class sc_mpobject {
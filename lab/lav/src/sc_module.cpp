@@ -77,15 +77,41 @@ using std::hex;
 
 
 int sc_module::num_modules = 0;
+bool sc_module::all_validated = false;
 
 /* This should be moved to sc_simcontext */
-static sc_plist<sc_module*>&
+/* The modules in the order of their creation.  A module that is
+   destroyed leaves a null entry behind, and the list is compacted once
+   half of it is null. */
+static sc_pvector<sc_module*>&
 get_list_of_modules()
 {
-    static sc_plist<sc_module*> list_of_modules;
+    static sc_pvector<sc_module*> list_of_modules;
     return list_of_modules;
 }
 
+static int num_unlisted_modules = 0;
+
+void
+sc_module::unlist(sc_module* m)
+{
+    sc_pvector<sc_module*>& l = get_list_of_modules();
+    l[m->handle] = 0;
+    if (2 * ++num_unlisted_modules <= l.size())
+        return;
+
+    int n = 0;
+    for (int i = 0; i < l.size(); ++i) {
+        sc_module* p = l[i];
+        if (p) {
+            p->handle = n;
+            l[n++] = p;
+        }
+    }
+    l.decr_count(l.size() - n);
+    num_unlisted_modules = 0;
+}
+
 
 class sc_module_dynalloc_list {
 public:
@@ -126,8 +152,10 @@ sc_module::sc_module_init()
 {
     tid = num_modules++;
     end_module_called = false;
+    all_validated = false;
     simcontext()->hierarchy_push(this);
-    handle = get_list_of_modules().push_back(this);
+    handle = get_list_of_modules().size();
+    get_list_of_modules().push_back(this);
     port_vector = new sc_pvector<sc_port_b*>(16);
     port_index = 0;
 }
@@ -218,7 +246,7 @@ sc_module::sc_module( const sc_string& s )
 
 sc_module::~sc_module()
 {
-    get_list_of_modules().remove(handle);
+    unlist(this);
     delete port_vector;
 }
 
@@ -244,23 +272,29 @@ sc_module::validate() const
 void
 sc_module::dump_modules()
 {
-    sc_plist<sc_module*>::iterator it(get_list_of_modules());
-    for ( ; ! it.empty(); it++) {
-        sc_module* p = *it;
+    const sc_pvector<sc_module*>& l = get_list_of_modules();
+    for (int i = 0; i < l.size(); ++i) {
+        sc_module* p = l[i];
+        if (! p)
+            continue;
         const char* q = p->kind();
         cerr << p->id() << "\t" << q << "\t"
              << p->name() << endl;
     }
 }
 
+/* A module stays valid once end_module() has been called for it, so the
+   list is only walked again after new modules have been created. */
 void
 sc_module::validate_all()
 {
+    if (all_validated)
+        return;
     bool error = false;
-    sc_plist<sc_module*>::iterator it(get_list_of_modules());
-    for ( ; ! it.empty(); it++) {
-        sc_module* p = *it;
-        if (! p->validate()) {
+    const sc_pvector<sc_module*>& l = get_list_of_modules();
+    for (int i = 0; i < l.size(); ++i) {
+        sc_module* p = l[i];
+        if (p && ! p->validate()) {
             cerr << "SystemC error: did you forget to call end_module() for `"
                  << p->name() << "'?\n";
             if (error) {
@@ -270,6 +304,7 @@ sc_module::validate_all()
             error = true;
         }
     }
+    all_validated = ! error;
 }
 
 const char* sc_module::kind_string = "sc_module";
@@ -121,11 +121,11 @@ protected:
         // this must be called by user-defined modules
     void end_module();
 
-    void halt()      { ::halt(simcontext());    }
-    void wait()      { ::wait(simcontext());    }
-    void wait(int n) { ::wait(n, simcontext()); }
-    void wait_until(const sc_lambda_ptr& l)        { ::wait_until(l, simcontext()); }
-    void wait_until(const sc_signal_edgy_deval& s) { ::wait_until(s, simcontext()); }
+    sc_wait_awaiter halt()      { return ::halt(simcontext());    }
+    sc_wait_awaiter wait()      { return ::wait(simcontext());    }
+    sc_wait_awaiter wait(int n) { return ::wait(n, simcontext()); }
+    sc_wait_awaiter wait_until(const sc_lambda_ptr& l)        { return ::wait_until(l, simcontext()); }
+    sc_wait_awaiter wait_until(const sc_signal_edgy_deval& s) { return ::wait_until(s, simcontext()); }
     void watching(const sc_lambda_ptr& l)          { ::watching(l, simcontext());   }
     void watching(const sc_signal_edgy_deval& s)   { ::watching(s, simcontext());   }
     void at_posedge(const sc_signal<sc_logic>& s)  { ::at_posedge(s, simcontext()); }
@@ -146,10 +146,12 @@ protected:
 
 private:
     static int num_modules;     // number of modules instantiated
+    static bool all_validated;  // no module created since validate_all()
+    static void unlist(sc_module* m);
 
     bool end_module_called;
     int tid;                    // id of the module
-    sc_plist<sc_module*>::handle_t handle;
+    int handle;                 // index in the list of modules
     sc_pvector<sc_port_b*>* port_vector;
     int port_index;
 
@@ -0,0 +1,249 @@
+/******************************************************************************
+    Copyright (c) 1996-2000 Synopsys, Inc.    ALL RIGHTS RESERVED
+
+  The contents of this file are subject to the restrictions and limitations
+  set forth in the SystemC(TM) Open Community License Software Download and
+  Use License Version 1.1 (the "License"); you may not use this file except
+  in compliance with such restrictions and limitations. You may obtain
+  instructions on how to receive a copy of the License at
+  http://www.systemc.org/. Software distributed by Original Contributor
+  under the License is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+  ANY KIND, either express or implied. See the License for the specific
+  language governing rights and limitations under the License.
+
+******************************************************************************/
+
+/******************************************************************************
+
+    sc_name_table.cpp -- interned hierarchical names of simulation objects.
+
+******************************************************************************/
+
+/******************************************************************************
+
+    MODIFICATION LOG - modifiers, enter your name, affliation and
+    changes you are making here:
+
+    Modifier Name & Affiliation:
+    Description of Modification:
+
+
+******************************************************************************/
+
+#include <string.h>
+#include <stdlib.h>
+#include "sc_mempool.h"
+#include "sc_object.h"
+#include "sc_name_table.h"
+
+/* FNV-1a, which can be carried on from the hash of a prefix */
+
+static const unsigned fnv_basis = 2166136261U;
+
+static inline unsigned
+fnv_hash( unsigned h, const char* s, int n )
+{
+    for (int i = 0; i < n; ++i) {
+        h ^= (unsigned char) s[i];
+        h *= 16777619U;
+    }
+    return h;
+}
+
+unsigned
+sc_name_hash( const char* name )
+{
+    return fnv_hash( fnv_basis, name, strlen( name ) );
+}
+
+/*****************************************************************************/
+
+/* The interned basenames.  They are never freed, as the same basenames
+   tend to come back whenever a design is built again. */
+
+static const char** intern_slots = 0;
+static unsigned     intern_mask  = 0;
+static int          intern_count = 0;
+
+static char*        arena      = 0;
+static size_t       arena_left = 0;
+static const size_t arena_size = 16384;
+
+static const char*
+intern_store( const char* s, int len )
+{
+    char* p;
+    if ((size_t) len + 1 > arena_size / 4) {
+        p = new char[len + 1];
+    } else {
+        if ((size_t) len + 1 > arena_left) {
+            arena = new char[arena_size];
+            arena_left = arena_size;
+        }
+        p = arena;
+        arena += len + 1;
+        arena_left -= len + 1;
+    }
+    memcpy( p, s, len );
+    p[len] = '\0';
+    return p;
+}
+
+static void
+intern_grow()
+{
+    unsigned old_size = intern_slots ? intern_mask + 1 : 0;
+    const char** old_slots = intern_slots;
+    unsigned new_size = old_size ? 2 * old_size : 1024;
+
+    intern_slots = new const char*[new_size];
+    intern_mask = new_size - 1;
+    for (unsigned i = 0; i < new_size; ++i)
+        intern_slots[i] = 0;
+    for (unsigned j = 0; j < old_size; ++j) {
+        const char* s = old_slots[j];
+        if (s == 0)
+            continue;
+        unsigned k = fnv_hash( fnv_basis, s, strlen( s ) ) & intern_mask;
+        while (intern_slots[k] != 0)
+            k = (k + 1) & intern_mask;
+        intern_slots[k] = s;
+    }
+    delete[] old_slots;
+}
+
+static const char*
+intern( const char* s, int len )
+{
+    if (2 * (intern_count + 1) > (int) (intern_slots ? intern_mask + 1 : 0))
+        intern_grow();
+
+    unsigned k = fnv_hash( fnv_basis, s, len ) & intern_mask;
+    const char* t;
+    while ((t = intern_slots[k]) != 0) {
+        if (strncmp( t, s, len ) == 0 && t[len] == '\0')
+            return t;
+        k = (k + 1) & intern_mask;
+    }
+    intern_count++;
+    return intern_slots[k] = intern_store( s, len );
+}
+
+/*****************************************************************************/
+
+void*
+sc_name_node::operator new( size_t sz )
+{
+    return sc_mempool::allocate( sz );
+}
+
+void
+sc_name_node::operator delete( void* p, size_t sz )
+{
+    sc_mempool::release( p, sz );
+}
+
+sc_name_node*
+sc_name_node::make( sc_name_node* parent, const char* base, bool intern_base )
+{
+    sc_name_node* node = new sc_name_node;
+    int len = strlen( base );
+
+    node->parent = parent;
+    node->base_len = len;
+    node->own_base = ! intern_base;
+    if (intern_base) {
+        node->base = intern( base, len );
+    } else {
+        char* b = new char[len + 1];
+        strcpy( b, base );
+        node->base = b;
+    }
+    if (parent) {
+        parent->refs++;
+        node->name_len = parent->name_len + 1 + len;
+        node->hash_value = fnv_hash( fnv_hash( parent->hash_value, &HIERARCHY_CHAR, 1 ),
+                                     base, len );
+    } else {
+        node->name_len = len;
+        node->hash_value = fnv_hash( fnv_basis, base, len );
+    }
+    node->refs = 1;
+    node->full = 0;
+    return node;
+}
+
+void
+sc_name_node::release( sc_name_node* node )
+{
+    while (node != 0 && --node->refs == 0) {
+        sc_name_node* parent = node->parent;
+        delete[] node->full;
+        if (node->own_base)
+            delete[] (char*) node->base;
+        delete node;
+        node = parent;
+    }
+}
+
+const char*
+sc_name_node::make_full() const
+{
+    char* p = new char[name_len + 1];
+    char* q = p + name_len;
+    *q = '\0';
+    for (const sc_name_node* n = this; n != 0; n = n->parent) {
+        q -= n->base_len;
+        memcpy( q, n->base, n->base_len );
+        if (n->parent)
+            *--q = HIERARCHY_CHAR;
+    }
+    full = p;
+    return p;
+}
+
+/* Matches the name against the start of `nm', and returns the rest of
+   `nm', or 0 if it does not match. */
+const char*
+sc_name_node::match( const char* nm ) const
+{
+    if (parent) {
+        nm = parent->match( nm );
+        if (nm == 0 || *nm != HIERARCHY_CHAR)
+            return 0;
+        ++nm;
+    }
+    if (strncmp( nm, base, base_len ) != 0)
+        return 0;
+    return nm + base_len;
+}
+
+bool
+sc_name_node::equals( const char* nm ) const
+{
+    if (full)
+        return strcmp( full, nm ) == 0;
+    const char* rest = match( nm );
+    return rest != 0 && *rest == '\0';
+}
+
+bool
+sc_name_node::same_as( const sc_name_node* other ) const
+{
+    if (hash_value != other->hash_value || name_len != other->name_len)
+        return false;
+
+    const sc_name_node* a = this;
+    const sc_name_node* b = other;
+    while (a != b) {
+        if (a == 0 || b == 0 || a->base_len != b->base_len ||
+            (a->base != b->base && memcmp( a->base, b->base, a->base_len ) != 0)) {
+            /* The levels differ, as when a basename holds the
+               hierarchy character; compare the full names */
+            return strcmp( name(), other->name() ) == 0;
+        }
+        a = a->parent;
+        b = b->parent;
+    }
+    return true;
+}
@@ -0,0 +1,94 @@
+/******************************************************************************
+    Copyright (c) 1996-2000 Synopsys, Inc.    ALL RIGHTS RESERVED
+
+  The contents of this file are subject to the restrictions and limitations
+  set forth in the SystemC(TM) Open Community License Software Download and
+  Use License Version 1.1 (the "License"); you may not use this file except
+  in compliance with such restrictions and limitations. You may obtain
+  instructions on how to receive a copy of the License at
+  http://www.systemc.org/. Software distributed by Original Contributor
+  under the License is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+  ANY KIND, either express or implied. See the License for the specific
+  language governing rights and limitations under the License.
+
+******************************************************************************/
+
+/******************************************************************************
+
+    sc_name_table.h -- interned hierarchical names of simulation objects.
+
+******************************************************************************/
+
+/******************************************************************************
+
+    MODIFICATION LOG - modifiers, enter your name, affliation and
+    changes you are making here:
+
+    Modifier Name & Affiliation:
+    Description of Modification:
+
+
+******************************************************************************/
+
+#ifndef SC_NAME_TABLE_H
+#define SC_NAME_TABLE_H
+
+#ifndef _MSC_VER
+#include <cstddef>
+using std::size_t;
+#endif
+
+    // Hash of a hierarchical name, as used by the object tables; it may
+    // be computed once and passed to sc_simcontext::find_object().
+extern unsigned sc_name_hash( const char* name );
+
+//
+//  <summary> Hierarchical name of a simulation object </summary>
+//
+//  A name is a chain of nodes, one per level of the hierarchy.  The node
+//  of an object refers to the node of its parent, so the objects of a
+//  module share the module's name instead of each holding a copy of it.
+//  The basenames of named objects are interned, so that a basename
+//  used in many modules ("clk", "reset") is stored once.
+//
+//  The full name is only put together when name() is first called on
+//  the node, and stays valid for the life of the node.  The hash of the
+//  full name is computed as the node is made, from that of the parent.
+//
+class sc_name_node {
+public:
+        // A new node for `base' under `parent' (0 at the top level).
+        // Unless `intern' is set, `base' is copied rather than interned.
+    static sc_name_node* make( sc_name_node* parent, const char* base,
+                               bool intern );
+    static void release( sc_name_node* node );
+
+    const char* name() const { return full ? full : make_full(); }
+    const char* basename() const { return base; }
+    unsigned hash() const { return hash_value; }
+
+        // Whether the full name is `nm', or that of `other'
+    bool equals( const char* nm ) const;
+    bool same_as( const sc_name_node* other ) const;
+
+    static void* operator new( size_t sz );
+    static void operator delete( void* p, size_t sz );
+
+private:
+    sc_name_node() { }
+    ~sc_name_node() { }
+
+    const char* make_full() const;
+    const char* match( const char* nm ) const;
+
+    sc_name_node* parent;
+    const char*   base;
+    int           base_len;
+    int           name_len;        /* of the full name */
+    unsigned      hash_value;
+    int           refs;            /* the object, and the child nodes */
+    bool          own_base;
+    mutable char* full;
+};
+
+#endif
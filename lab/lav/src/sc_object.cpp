@@ -90,13 +90,6 @@ typedef int (*STRCMP)(const void*, const void*);
    problems. */
 bool sc_enable_name_checking = true;
 
-const char*
-sc_object::basename() const
-{
-    const char* p = strrchr( m_name, HIERARCHY_CHAR );
-    return p ? (p + 1) : m_name;
-}
-
 void
 sc_object::print() const
 {
@@ -160,34 +153,18 @@ sc_object::sc_object_init(const char* nm)
         put_in_table = false;
     }
 
-    /* Note here we pull a little trick -- use the
-       first byte to store information about whether
-       to put the object in the object table in the
-       object manager */
-    if (parent) {
-        int pn_len = strlen(parent->name());
-        m_name = new char[pn_len + strlen(newname) + 3];
-        m_name++;
-        strcpy(m_name, parent->name());
-        m_name[pn_len] = HIERARCHY_CHAR;
-        m_name[pn_len + 1] = '\0';
-    }
-    else {
-        m_name = new char[strlen(newname) + 3];
-        m_name++;
-        m_name[0] = '\0';
-    }
-    m_name[-1] = put_in_table;
-    strcat(m_name, newname);
+    /* The name shares the parent's; the basenames of unnamed
+       objects are unique, so there is no point interning them */
+    m_name = sc_name_node::make(parent ? parent->m_name : 0, newname, put_in_table);
+    in_table = false;
 
     if (put_in_table) {
-        if (object_manager->find_object(m_name)) {
-            cerr << "SystemC error: Object `" << m_name << "' already exists." << endl;
+        if (! object_manager->insert_object(this)) {
+            cerr << "SystemC error: Object `" << name() << "' already exists." << endl;
             cerr << "              (Latter declaration will be ignored.)" << endl;
         }
         else {
-            /* should check for the uniqueness of the name */
-            object_manager->insert_object(m_name, this);
+            in_table = true;
         }
     }
 }
@@ -239,12 +216,11 @@ sc_object::sc_object(const char* nm)
 
 sc_object::~sc_object()
 {
-    if (m_name[-1] && simc) {
+    if (in_table && simc) {
         sc_object_manager* object_manager = simc->get_object_manager();
-        object_manager->remove_object(m_name);
+        object_manager->remove_object(this);
     }
-    --m_name;
-    delete[] m_name;
+    sc_name_node::release(m_name);
 }
 
 void
@@ -252,3 +228,9 @@ sc_object::trace( sc_trace_file * /* unused */) const
 {
     /* This space is intentionally left blank */
 }
+
+void
+sc_object::checkpoint( sc_checkpoint& /* unused */ )
+{
+    /* No state of its own */
+}
@@ -53,15 +53,18 @@ using std::hex;
 #pragma hdrstop
 #endif
 
+#include "sc_name_table.h"
+
 class sc_trace_file;
 class sc_simcontext;
+class sc_checkpoint;
 
 class sc_object {
     friend class sc_object_manager;
 
 public:
-    const char* name() const { return m_name; }
-    const char* basename() const;
+    const char* name() const { return m_name->name(); }
+    const char* basename() const { return m_name->basename(); }
 
     void print() const;
     virtual void print(ostream& os) const;
@@ -72,6 +75,10 @@ public:
 
     virtual void trace( sc_trace_file* tf ) const;
 
+    // Saves or restores the state of the object; see sc_checkpoint.h.
+    // Modules with state to preserve across a checkpoint override it.
+    virtual void checkpoint( sc_checkpoint& cp );
+
     static const char* kind_string;
     virtual const char* kind() const;
 
@@ -88,7 +95,8 @@ private:
 private:
     /* Each simulation object is associated with a simulation context */ 
     sc_simcontext* simc;   
-    char* m_name;
+    sc_name_node* m_name;
+    bool in_table;
 };
 
 const char HIERARCHY_CHAR = '.';
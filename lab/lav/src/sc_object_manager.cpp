@@ -59,17 +59,15 @@ using std::hex;
 #include "sc_object_manager.h"
 #include "sc_module_name.h"
 
-int strcmp_void(const void* a, const void* b)
-{
-  return strcmp(static_cast<const char*>(a),static_cast<const char*>(b));
-}
 sc_object_manager::sc_object_manager()
 {
     ordered_object_vector = new object_vector_type;
 
-    object_table = new object_table_type;
-    object_table->set_hash_fn(default_str_hash_fn);
-    object_table->set_cmpr_fn(strcmp_void);
+    object_table_mask = 255;
+    object_table = new sc_object*[object_table_mask + 1];
+    for (unsigned i = 0; i <= object_table_mask; ++i)
+        object_table[i] = 0;
+    num_objects = 0;
 
     object_hierarchy = new object_hierarchy_type;
     ordered_object_vector_dirty = true;
@@ -83,19 +81,32 @@ sc_object_manager::~sc_object_manager()
 
     /* Go through each object in the table, and
        mark the simc field of the object NULL */
-    object_table_type::iterator it(object_table);
-    for ( ; !it.empty(); it++) {
-        sc_object* obj = it.contents();
-        obj->simc = 0;
+    for (unsigned i = 0; i <= object_table_mask; ++i) {
+        sc_object* obj = object_table[i];
+        if (obj)
+            obj->simc = 0;
     }
-    delete object_table;
+    delete[] object_table;
     delete ordered_object_vector;
 }
 
 sc_object*
 sc_object_manager::find_object(const char* name)
 {
-    return (*object_table)[name];
+    return find_object(name, sc_name_hash(name));
+}
+
+sc_object*
+sc_object_manager::find_object(const char* name, unsigned hash)
+{
+    unsigned k = hash & object_table_mask;
+    sc_object* obj;
+    while ((obj = object_table[k]) != 0) {
+        if (obj->m_name->hash() == hash && obj->m_name->equals(name))
+            return obj;
+        k = (k + 1) & object_table_mask;
+    }
+    return 0;
 }
 
 extern "C" {
@@ -113,11 +124,9 @@ sc_object_manager::first_object()
 {
     if (ordered_object_vector_dirty) {
         ordered_object_vector->erase_all();
-        object_table_type::iterator it(object_table);
-        while (! it.empty()) {
-            sc_object* obj = it.contents();
-            ordered_object_vector->push_back(obj);
-            it++;
+        for (unsigned i = 0; i <= object_table_mask; ++i) {
+            if (object_table[i])
+                ordered_object_vector->push_back(object_table[i]);
         }
         ordered_object_vector->sort(object_name_compare);
         ordered_object_vector_dirty = false;
@@ -184,15 +193,70 @@ sc_object_manager::top_of_module_name_stack()
 }
 
 void
-sc_object_manager::insert_object(const char* name, sc_object* obj)
+sc_object_manager::grow_object_table()
 {
-    object_table->insert(name, obj);
+    sc_object** old_table = object_table;
+    unsigned old_mask = object_table_mask;
+
+    object_table_mask = 2 * object_table_mask + 1;
+    object_table = new sc_object*[object_table_mask + 1];
+    for (unsigned i = 0; i <= object_table_mask; ++i)
+        object_table[i] = 0;
+    for (unsigned j = 0; j <= old_mask; ++j) {
+        sc_object* obj = old_table[j];
+        if (obj == 0)
+            continue;
+        unsigned k = obj->m_name->hash() & object_table_mask;
+        while (object_table[k] != 0)
+            k = (k + 1) & object_table_mask;
+        object_table[k] = obj;
+    }
+    delete[] old_table;
+}
+
+bool
+sc_object_manager::insert_object(sc_object* obj)
+{
+    const sc_name_node* nm = obj->m_name;
+    unsigned k = nm->hash() & object_table_mask;
+    sc_object* other;
+    while ((other = object_table[k]) != 0) {
+        if (other->m_name->same_as(nm))
+            return false;
+        k = (k + 1) & object_table_mask;
+    }
+    object_table[k] = obj;
     ordered_object_vector_dirty = true;
+    if (2 * ++num_objects > (int) object_table_mask)
+        grow_object_table();
+    return true;
 }
 
 void
-sc_object_manager::remove_object(const char* name)
+sc_object_manager::remove_object(sc_object* obj)
 {
-    object_table->remove(name);
+    unsigned i = obj->m_name->hash() & object_table_mask;
+    while (object_table[i] != obj) {
+        if (object_table[i] == 0)
+            return;
+        i = (i + 1) & object_table_mask;
+    }
+
+    /* Shift back the entries of the probe sequence after the hole, so
+       that no lookup stops short of them */
+    unsigned j = i;
+    while (true) {
+        j = (j + 1) & object_table_mask;
+        sc_object* next = object_table[j];
+        if (next == 0)
+            break;
+        unsigned k = next->m_name->hash() & object_table_mask;
+        if ((i < j) ? (k <= i || k > j) : (k <= i && k > j)) {
+            object_table[i] = next;
+            i = j;
+        }
+    }
+    object_table[i] = 0;
+    --num_objects;
     ordered_object_vector_dirty = true;
 }
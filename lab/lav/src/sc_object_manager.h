@@ -42,7 +42,6 @@ class sc_object_manager {
     friend class sc_simcontext;
 
 public:
-    typedef sc_phash<const char*, sc_object*> object_table_type;
     typedef sc_pvector<sc_object*> object_vector_type;
     typedef sc_plist<sc_object*> object_hierarchy_type;
 
@@ -50,6 +49,8 @@ public:
     ~sc_object_manager();
 
     sc_object* find_object(const char* name);
+        // `hash' is sc_name_hash(name)
+    sc_object* find_object(const char* name, unsigned hash);
     sc_object* first_object();
     sc_object* next_object();
 
@@ -62,11 +63,19 @@ public:
     sc_module_name* pop_module_name();
     sc_module_name* top_of_module_name_stack();
 
-    void insert_object(const char* name, sc_object* obj);
-    void remove_object(const char* name);
+        // Returns false if an object of the same name is already there
+    bool insert_object(sc_object* obj);
+    void remove_object(sc_object* obj);
 
 private:
-    object_table_type* object_table;
+    void grow_object_table();
+
+    /* The named objects, by the hash of their names, with linear
+       probing; the table is kept at most half full */
+    sc_object** object_table;
+    unsigned object_table_mask;
+    int num_objects;
+
     object_vector_type* ordered_object_vector;
     bool ordered_object_vector_dirty;
     int next_object_index;
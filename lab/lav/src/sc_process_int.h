@@ -65,6 +65,7 @@ typedef unsigned long qt_word_t;
 #include "sc_list.h"
 #include "sc_lambda.h"
 #include "sc_module.h"
+#include "sc_co_process.h"
 
 class sc_signal_array_base;
 class sc_module;
@@ -84,12 +85,14 @@ public:
     int          proc_id;
     const char*  file;
     int          lineno;
+    int          prof_index;    /* see sc_profiler.h */
     sc_process_b(const char* nm,
                  SC_ENTRY_FUNC fn,
                  sc_module* mod)
         : sc_object(nm),
           entry_fn(fn),
-          module(mod)
+          module(mod),
+          prof_index(-1)
     {
         /*EMPTY*/
     }
@@ -119,10 +122,11 @@ class sc_sync_process : public sc_process_b {
     friend class sc_simcontext;
     friend class sc_clock_helpers;
     friend class sc_port_manager;
+    friend class sc_co_helpers;
 
 private:
     enum sc_wait_state_t { WAIT_CLOCK, WAIT_LAMBDA, WAIT_UNKNOWN };
-    typedef sc_pvector< sc_plist<sc_lambda_ptr*>* > dwatchlists_t;
+    typedef sc_pvector<sc_lambda_ptr*> dwatchlist_t;
 
     sc_polarity      polarity;   /* used when process not yet bound to real clock edge */
 #ifdef WIN32
@@ -136,6 +140,7 @@ private:
 #else
     PVOID            pFiber;
 #endif
+    sc_co_state*     co;         /* non-null for a stackless process */
 
     sc_wait_state_t  wait_state;
     int              wait_cycles;
@@ -146,11 +151,23 @@ private:
 #endif
     int              watch_level;
     private:
-    dwatchlists_t    dwatchlists;
+    /* The watched lambdas of each watching level, evaluated on every
+       wakeup */
+    dwatchlist_t     dwatchlists[SYSTEMC_MAX_WATCH_LEVEL];
 
     sc_sync_process* next_handle;
     sc_sync_process* prev_handle;
 
+    /* Used by sc_clock_edge::advance() to decide when to wake us up */
+    int              runnable_seq; /* position in the runnable list */
+    unsigned         wake_cycle;   /* edge count at which wait(n) is over */
+    sc_sync_process* wheel_next;   /* next in the same timing-wheel bucket */
+    bool             terminated;   /* moved to the defunct list */
+    bool             queued;       /* on the edge's poll list */
+
+    /* The compiled lambdas whose `waiters' hold this process */
+    sc_pvector<const sc_lambda*> waiting_on;
+
     sc_sync_process(const char* nm,
                     SC_ENTRY_FUNC fn,
                     sc_module* mod,
@@ -169,8 +186,18 @@ private:
     private:
 #endif
     bool eval_watchlist();
+    bool has_watching() const;
     bool ready_to_wakeup();
+
+    /* Parks the process on the lambdas it waits for; returns false,
+       leaving it unparked, if one of them is not compiled. */
+    bool wait_on_lambdas();
+    void stop_waiting_on_lambdas();
+    /* Called by sc_lambda_notify() when an operand of such a lambda
+       changes */
+    void operand_changed();
     bool eval_watchlist_curr_level();
+    void clear_watchlist(int wlevel);
 
     friend void* sc_sync_process_yieldhelp(qt_t*, void*, void*);
     friend void* sc_sync_process_aborthelp(qt_t*, void*, void*);
@@ -181,10 +208,12 @@ private:
     void __close_watching()    { watch_level--; assert(watch_level >= 0); }
     int  __watch_level() const { return watch_level; }
 
-    friend void halt(sc_simcontext*);
-    friend void wait(sc_simcontext*);
-    friend void wait(int, sc_simcontext*);
-    friend void wait_until(const sc_lambda_ptr&, sc_simcontext*);
+    friend sc_wait_awaiter halt(sc_simcontext*);
+    friend sc_wait_awaiter wait(sc_simcontext*);
+    friend sc_wait_awaiter wait(int, sc_simcontext*);
+    friend sc_wait_awaiter wait_until(const sc_lambda_ptr&, sc_simcontext*);
+    friend void sc_co_wait_resume(const sc_wait_awaiter&);
+    friend void sc_lambda_notify(sc_lambda_watch*);
     friend void watching_before_simulation(const sc_lambda_ptr&, sc_simcontext*);
     friend void watching_during_simulation(const sc_lambda_ptr&, sc_simcontext*);
     friend void __reset_watching( sc_sync_process_handle );
@@ -213,6 +242,7 @@ class sc_async_process : public sc_process_b {
     friend class sc_sensitive;
     friend class sc_sensitive_pos;
     friend class sc_sensitive_neg;
+    friend class sc_async_pool;
 
 private:
     bool              m_is_in_updateq;
@@ -253,6 +283,7 @@ class sc_aproc_process : public sc_process_b {
     friend class sc_sensitive;
     friend class sc_sensitive_pos;
     friend class sc_sensitive_neg;
+    friend class sc_co_helpers;
 
 private:
     bool              m_is_in_updateq;
@@ -264,6 +295,7 @@ private:
 #else
     PVOID             pFiber;
 #endif 
+    sc_co_state*      co;         /* non-null for a stackless process */
 
     sc_pvector<const sc_signal_base*> trigger_signals;
     sc_pvector<const sc_signal_edgy*> trigger_signals_edgy_neg;
@@ -308,7 +340,7 @@ public:
     void sensitive_neg( const sc_signal_edgy& s );
     void sensitive( const sc_signal_edgy& s );
 
-    friend void wait( sc_simcontext* );
+    friend sc_wait_awaiter wait( sc_simcontext* );
     friend void sc_set_stack_size( sc_aproc_process_handle aproc_h,
                                    size_t size );
 };
@@ -0,0 +1,321 @@
+/******************************************************************************
+    Copyright (c) 1996-2000 Synopsys, Inc.    ALL RIGHTS RESERVED
+
+  The contents of this file are subject to the restrictions and limitations
+  set forth in the SystemC(TM) Open Community License Software Download and
+  Use License Version 1.1 (the "License"); you may not use this file except
+  in compliance with such restrictions and limitations. You may obtain
+  instructions on how to receive a copy of the License at
+  http://www.systemc.org/. Software distributed by Original Contributor
+  under the License is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+  ANY KIND, either express or implied. See the License for the specific
+  language governing rights and limitations under the License.
+
+******************************************************************************/
+
+/******************************************************************************
+
+    sc_profiler.cpp -- kernel activity profiler.
+
+******************************************************************************/
+
+/******************************************************************************
+
+    MODIFICATION LOG - modifiers, enter your name, affliation and
+    changes you are making here:
+
+    Modifier Name & Affiliation:
+    Description of Modification:
+
+
+******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+#ifdef WIN32
+#include <Windows.h>
+#else
+#include <time.h>
+#endif
+
+#include "sc_signal.h"
+#include "sc_clock.h"
+#include "sc_profiler.h"
+
+#ifdef WIN32
+
+double
+sc_profiler_clock()
+{
+    static double period = 0.0;
+    LARGE_INTEGER count;
+    if (period == 0.0) {
+        LARGE_INTEGER freq;
+        QueryPerformanceFrequency( &freq );
+        period = 1.0 / (double) freq.QuadPart;
+    }
+    QueryPerformanceCounter( &count );
+    return (double) count.QuadPart * period;
+}
+
+#else
+
+double
+sc_profiler_clock()
+{
+    struct timespec ts;
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return (double) ts.tv_sec + (double) ts.tv_nsec * 1e-9;
+}
+
+#endif
+
+sc_profiler::sc_profiler( const char* fn, sc_profile_format fmt )
+{
+    file_name = new char[strlen(fn) + 1];
+    strcpy( file_name, fn );
+    format = fmt;
+
+    procs = 0;
+    n_procs = 0;
+    sigs = 0;
+    n_sigs = 0;
+    edges = 0;
+    n_edges = 0;
+
+    curr = -1;
+    since = 0.0;
+
+    async_threads = 1;
+    aproc_switches = 0;
+    time_steps = 0;
+    delta_cycles = 0;
+    max_delta_cycles = 0;
+    for (int i = 0; i < DELTA_HISTOGRAM_SIZE; ++i)
+        delta_histogram[i] = 0;
+}
+
+sc_profiler::~sc_profiler()
+{
+    delete[] file_name;
+    delete[] procs;
+    delete[] sigs;
+    delete[] edges;
+}
+
+void
+sc_profiler::reserve( int n_processes, int n_signals, int n_clock_edges )
+{
+    assert( procs == 0 && sigs == 0 && edges == 0 );
+    procs = new process_rec[n_processes > 0 ? n_processes : 1];
+    sigs = new signal_rec[n_signals > 0 ? n_signals : 1];
+    edges = new edge_rec[n_clock_edges > 0 ? n_clock_edges : 1];
+}
+
+int
+sc_profiler::add_process( const sc_object* proc, const char* kind )
+{
+    process_rec& r = procs[n_procs];
+    r.obj = proc;
+    r.kind = kind;
+    r.activations = 0;
+    r.seconds = 0.0;
+    return n_procs++;
+}
+
+int
+sc_profiler::add_signal( const sc_signal_base* sig )
+{
+    signal_rec& r = sigs[n_sigs];
+    r.obj = sig;
+    r.updates = 0;
+    r.toggles = 0;
+    return n_sigs++;
+}
+
+int
+sc_profiler::add_edge( const sc_clock_edge* edge )
+{
+    edge_rec& r = edges[n_edges];
+    r.obj = edge;
+    r.edges = 0;
+    r.context_switches = 0;
+    return n_edges++;
+}
+
+void
+sc_profiler::signals_updated( sc_signal_base* const* l_sigs, int lastof )
+{
+    for (int i = lastof; i >= 0; --i) {
+        const sc_signal_base* sig = l_sigs[i];
+        if (sig->prof_index < 0)
+            continue;
+        signal_rec& r = sigs[sig->prof_index];
+        r.updates++;
+        if (sig->changing())
+            r.toggles++;
+    }
+}
+
+void
+sc_profiler::pooled_signals_updated( sc_signal_base* const* l_sigs,
+                                     unsigned written, unsigned changed )
+{
+    for (int k = 0; written != 0; ++k, written >>= 1, changed >>= 1) {
+        if (! (written & 1) || l_sigs[k] == 0 || l_sigs[k]->prof_index < 0)
+            continue;
+        signal_rec& r = sigs[l_sigs[k]->prof_index];
+        r.updates++;
+        if (changed & 1)
+            r.toggles++;
+    }
+}
+
+void
+sc_profiler::time_step( int n )
+{
+    time_steps++;
+    delta_cycles += n;
+    if (n > max_delta_cycles)
+        max_delta_cycles = n;
+
+    int bucket = 0;
+    while (n > 1 && bucket < DELTA_HISTOGRAM_SIZE - 1) {
+        n >>= 1;
+        bucket++;
+    }
+    delta_histogram[bucket]++;
+}
+
+/*****************************************************************************/
+
+static void
+put_json_string( FILE* fp, const char* s )
+{
+    putc( '"', fp );
+    for (; *s; ++s) {
+        if (*s == '"' || *s == '\\')
+            putc( '\\', fp );
+        if ((unsigned char) *s < ' ')
+            fprintf( fp, "\\u%04x", (unsigned char) *s );
+        else
+            putc( *s, fp );
+    }
+    putc( '"', fp );
+}
+
+static void
+put_csv_string( FILE* fp, const char* s )
+{
+    putc( '"', fp );
+    for (; *s; ++s) {
+        if (*s == '"')
+            putc( '"', fp );
+        putc( *s, fp );
+    }
+    putc( '"', fp );
+}
+
+void
+sc_profiler::write() const
+{
+    FILE* fp = fopen( file_name, "w" );
+    if (fp == 0) {
+        fprintf( stderr, "SystemC warning: cannot write profile to %s\n",
+                 file_name );
+        return;
+    }
+    if (format == SC_PROFILE_CSV)
+        write_csv( fp );
+    else
+        write_json( fp );
+    fclose( fp );
+}
+
+void
+sc_profiler::write_json( FILE* fp ) const
+{
+    int i;
+
+    fprintf( fp, "{\n" );
+    fprintf( fp, "  \"time_steps\": %lu,\n", time_steps );
+    fprintf( fp, "  \"delta_cycles\": %lu,\n", delta_cycles );
+    fprintf( fp, "  \"max_delta_cycles\": %d,\n", max_delta_cycles );
+    fprintf( fp, "  \"delta_cycle_histogram\": [" );
+    for (i = 0; i < DELTA_HISTOGRAM_SIZE; ++i)
+        fprintf( fp, "%s%lu", i ? ", " : "", delta_histogram[i] );
+    fprintf( fp, "],\n" );
+    fprintf( fp, "  \"aproc_context_switches\": %lu,\n", aproc_switches );
+    fprintf( fp, "  \"async_threads\": %d,\n", async_threads );
+    fprintf( fp, "  \"asyncs_serialized\": %s,\n",
+             async_threads > 1 ? "true" : "false" );
+
+    fprintf( fp, "  \"processes\": [" );
+    for (i = 0; i < n_procs; ++i) {
+        const process_rec& r = procs[i];
+        fprintf( fp, "%s\n    { \"name\": ", i ? "," : "" );
+        put_json_string( fp, r.obj->name() );
+        fprintf( fp, ", \"kind\": \"%s\", \"activations\": %lu, "
+                     "\"wall_seconds\": %.9f }",
+                 r.kind, r.activations, r.seconds );
+    }
+    fprintf( fp, "\n  ],\n" );
+
+    fprintf( fp, "  \"signals\": [" );
+    for (i = 0; i < n_sigs; ++i) {
+        const signal_rec& r = sigs[i];
+        fprintf( fp, "%s\n    { \"name\": ", i ? "," : "" );
+        put_json_string( fp, r.obj->name() );
+        fprintf( fp, ", \"updates\": %lu, \"toggles\": %lu }",
+                 r.updates, r.toggles );
+    }
+    fprintf( fp, "\n  ],\n" );
+
+    fprintf( fp, "  \"clock_edges\": [" );
+    for (i = 0; i < n_edges; ++i) {
+        const edge_rec& r = edges[i];
+        fprintf( fp, "%s\n    { \"name\": ", i ? "," : "" );
+        put_json_string( fp, r.obj->name() );
+        fprintf( fp, ", \"phase\": \"%s\", \"edges\": %lu, "
+                     "\"context_switches\": %lu }",
+                 r.obj->phase() == PHASE_POS ? "pos" : "neg",
+                 r.edges, r.context_switches );
+    }
+    fprintf( fp, "\n  ]\n" );
+    fprintf( fp, "}\n" );
+}
+
+/* One row per object, with the columns that do not apply left empty;
+   the kernel-wide figures are in a row of kind "kernel". */
+void
+sc_profiler::write_csv( FILE* fp ) const
+{
+    int i;
+
+    fprintf( fp, "kind,name,activations,wall_seconds,updates,toggles,"
+                 "edges,context_switches,time_steps,delta_cycles,"
+                 "max_delta_cycles,async_threads,asyncs_serialized\n" );
+    fprintf( fp, "kernel,,,,,,,%lu,%lu,%lu,%d,%d,%d\n",
+             aproc_switches, time_steps, delta_cycles, max_delta_cycles,
+             async_threads, async_threads > 1 );
+    for (i = 0; i < n_procs; ++i) {
+        const process_rec& r = procs[i];
+        fprintf( fp, "%s,", r.kind );
+        put_csv_string( fp, r.obj->name() );
+        fprintf( fp, ",%lu,%.9f,,,,,,,,,\n", r.activations, r.seconds );
+    }
+    for (i = 0; i < n_sigs; ++i) {
+        const signal_rec& r = sigs[i];
+        fprintf( fp, "signal," );
+        put_csv_string( fp, r.obj->name() );
+        fprintf( fp, ",,,%lu,%lu,,,,,,,\n", r.updates, r.toggles );
+    }
+    for (i = 0; i < n_edges; ++i) {
+        const edge_rec& r = edges[i];
+        fprintf( fp, "%s,", r.obj->phase() == PHASE_POS ? "posedge" : "negedge" );
+        put_csv_string( fp, r.obj->name() );
+        fprintf( fp, ",,,,,%lu,%lu,,,,,\n", r.edges, r.context_switches );
+    }
+}
@@ -0,0 +1,163 @@
+/******************************************************************************
+    Copyright (c) 1996-2000 Synopsys, Inc.    ALL RIGHTS RESERVED
+
+  The contents of this file are subject to the restrictions and limitations
+  set forth in the SystemC(TM) Open Community License Software Download and
+  Use License Version 1.1 (the "License"); you may not use this file except
+  in compliance with such restrictions and limitations. You may obtain
+  instructions on how to receive a copy of the License at
+  http://www.systemc.org/. Software distributed by Original Contributor
+  under the License is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+  ANY KIND, either express or implied. See the License for the specific
+  language governing rights and limitations under the License.
+
+******************************************************************************/
+
+/******************************************************************************
+
+    sc_profiler.h -- kernel activity profiler.
+
+******************************************************************************/
+
+/******************************************************************************
+
+    MODIFICATION LOG - modifiers, enter your name, affliation and
+    changes you are making here:
+
+    Modifier Name & Affiliation:
+    Description of Modification:
+
+
+******************************************************************************/
+
+#ifndef SC_PROFILER_H
+#define SC_PROFILER_H
+
+#include <stdio.h>
+
+class sc_object;
+class sc_signal_base;
+class sc_clock_edge;
+
+enum sc_profile_format {
+    SC_PROFILE_JSON,
+    SC_PROFILE_CSV
+};
+
+extern double sc_profiler_clock();   /* wall time, in seconds */
+
+//
+//  <summary> Kernel activity profiler </summary>
+//
+//  An sc_profiler is attached to the simulation context by
+//  sc_simcontext::enable_profiling(), and records
+//
+//    - for each process, how often it ran and the wall time it took;
+//    - for each signal, how often it was updated, and how many of the
+//      updates changed its value (toggles);
+//    - for each clock edge, how often it occurred and the context
+//      switches it caused;
+//    - the number of delta cycles of each time step.
+//
+//  Profiling disables the thread pool of sc_simcontext::set_async_threads():
+//  sc_asyncs run serially, so their wall times are comparable, but the
+//  total is not what the parallel run would take.  The report records
+//  the number of threads that were set.
+//
+//  The report is written at the end of each sc_start(), keyed by the
+//  names of the objects.  Without a profiler the kernel's hooks are a
+//  test of a null pointer; processes, signals and clock edges carry
+//  the index of their record (prof_index), which is -1 until
+//  initialize() numbers them.
+//
+class sc_profiler {
+public:
+    sc_profiler( const char* file_name, sc_profile_format fmt );
+    ~sc_profiler();
+
+        // Called by sc_simcontext::initialize() with the number of
+        // objects, followed by one add_*() for each
+    void reserve( int n_processes, int n_signals, int n_edges );
+    int  add_process( const sc_object* proc, const char* kind );
+    int  add_signal( const sc_signal_base* sig );
+    int  add_edge( const sc_clock_edge* edge );
+
+        // The process with record `index' (-1 for none) takes over
+    void switch_to( int index )
+    {
+        double now = sc_profiler_clock();
+        if (curr >= 0)
+            procs[curr].seconds += now - since;
+        curr = index;
+        if (index >= 0)
+            procs[index].activations++;
+        since = now;
+    }
+
+        // The signals sigs[0..lastof] are about to be updated
+    void signals_updated( sc_signal_base* const* sigs, int lastof );
+        // Of the pooled signals sigs[0..31], the ones with their bit
+        // set in `written' were updated, and those in `changed' changed
+    void pooled_signals_updated( sc_signal_base* const* sigs,
+                                 unsigned written, unsigned changed );
+
+    void edge_advanced( int index ) { edges[index].edges++; }
+    void edge_context_switches( int index, int n )
+    {
+        edges[index].context_switches += n;
+    }
+    void aproc_context_switches( int n ) { aproc_switches += n; }
+    void time_step( int delta_cycles );
+        // The number of threads set for evaluating sc_asyncs; the
+        // kernel runs them serially while profiling, whatever the
+        // number, and the report says so
+    void set_async_threads( int n ) { async_threads = n; }
+
+        // (Re)writes the report with the totals so far
+    void write() const;
+
+private:
+    struct process_rec {
+        const sc_object* obj;
+        const char*      kind;
+        unsigned long    activations;
+        double           seconds;
+    };
+    struct signal_rec {
+        const sc_signal_base* obj;
+        unsigned long         updates;
+        unsigned long         toggles;
+    };
+    struct edge_rec {
+        const sc_clock_edge* obj;
+        unsigned long        edges;
+        unsigned long        context_switches;
+    };
+
+    enum { DELTA_HISTOGRAM_SIZE = 16 };
+
+    void write_json( FILE* fp ) const;
+    void write_csv( FILE* fp ) const;
+
+    char*             file_name;
+    sc_profile_format format;
+
+    process_rec* procs;
+    int          n_procs;
+    signal_rec*  sigs;
+    int          n_sigs;
+    edge_rec*    edges;
+    int          n_edges;
+
+    int    curr;     /* record of the running process, or -1 */
+    double since;    /* when it started running */
+
+    int           async_threads;
+    unsigned long aproc_switches;
+    unsigned long time_steps;
+    unsigned long delta_cycles;
+    int           max_delta_cycles;
+    unsigned long delta_histogram[DELTA_HISTOGRAM_SIZE];  /* by log2 */
+};
+
+#endif
@@ -61,16 +61,33 @@ public:
   virtual sc_signal_resolved_t<T,R>& operator=(const T& d) { return write(d); }
   virtual sc_signal_resolved_t<T,R>& operator=(const sc_signal_resolved_t<T,R>& d)
    {return operator=(d.read()); }
+#ifdef SC_HAS_RVALUE_REFS
+  // The driver of each process keeps a copy, so there is nothing to move
+  virtual sc_signal_resolved_t<T,R>& write( T&& d ) { return write((const T&) d); }
+  virtual sc_signal_resolved_t<T,R>& operator=(T&& d) { return write((const T&) d); }
+#endif
 #else
   virtual sc_signal<T>& write( const T& d );
   virtual sc_signal<T>& operator=(const T& d) { return write(d); }
   virtual sc_signal<T>& operator=(const sc_signal_resolved_t<T,R>& d)
    {return operator=(d.read()); }
+#ifdef SC_HAS_RVALUE_REFS
+  // The driver of each process keeps a copy, so there is nothing to move
+  virtual sc_signal<T>& write( T&& d ) { return write((const T&) d); }
+  virtual sc_signal<T>& operator=(T&& d) { return write((const T&) d); }
+#endif
 #endif
 
+  // Also saves what each process drives
+  void checkpoint( sc_checkpoint& cp );
+
 protected:
   // Hides the definition of update in sc_signal<T>
   void update();
+  virtual bool value_changing() const
+  {
+    return this->get_cur_value() != R::resolve(*nvalues);
+  }
 
     static void update_prop_none(sc_signal_base*);
     static void update_prop_async(sc_signal_base*);
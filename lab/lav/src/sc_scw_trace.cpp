@@ -0,0 +1,1103 @@
+/******************************************************************************
+    Copyright (c) 1996-2000 Synopsys, Inc.    ALL RIGHTS RESERVED
+
+  The contents of this file are subject to the restrictions and limitations
+  set forth in the SystemC(TM) Open Community License Software Download and
+  Use License Version 1.1 (the "License"); you may not use this file except
+  in compliance with such restrictions and limitations. You may obtain
+  instructions on how to receive a copy of the License at
+  http://www.systemc.org/. Software distributed by Original Contributor
+  under the License is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+  ANY KIND, either express or implied. See the License for the specific
+  language governing rights and limitations under the License.
+
+******************************************************************************/
+
+/******************************************************************************
+
+    sc_scw_trace.cpp -- compressed binary waveform (SCW) tracing.
+
+******************************************************************************/
+
+/******************************************************************************
+
+    MODIFICATION LOG - modifiers, enter your name, affliation and
+    changes you are making here:
+
+    Modifier Name & Affiliation:
+    Description of Modification:
+
+
+******************************************************************************/
+
+
+/* The SCW format.  Integers are little-endian, and a varint is an
+   unsigned LEB128 number (7 bits per byte, low bits first).
+
+   Header:
+       "SCW1"
+       u8   version (1)
+       i8   time unit, as a power of ten of seconds
+       u32  number of traces, then for each trace:
+              u8   kind (SCW_UINT, SCW_BITS, SCW_LOGIC or SCW_REAL)
+              u32  width in bits
+              u16  length of the name, followed by the name
+
+   Blocks:
+       "SCWB"
+       u8   flags (SCW_BLOCK_SNAPSHOT, SCW_BLOCK_COMPRESSED)
+       u32  size of the data once uncompressed
+       u32  size of the data as stored
+       u64  time of the block, in time units
+       the data, compressed in the LZ4 block format if flagged so
+
+   Index, after the last block:
+       for each block: u64 time, u64 file offset, u8 flags
+       u64  file offset of the index
+       u32  number of blocks
+       "SCWE"
+
+   The data of a block is a sequence of time steps.  A step is the
+   varint time since the previous step (or since the time of the
+   block), the changes, and a 0 byte.  A change is the varint of
+   (d << 1 | x), where d >= 1 is the index of the trace minus that of
+   the previous change of the step (-1 for the first), and x is set if
+   all the bits are unknown.  Unless x is set, the value follows:
+
+       SCW_UINT   (at most 64 bits) the varint of the zigzag encoded
+                  difference from the previous value of the trace
+       SCW_BITS   8 bits per byte, from the most significant bit, the
+                  last byte padded with 0
+       SCW_LOGIC  4 bits per byte, from the most significant bit, as
+                  0 = '0', 1 = '1', 2 = 'x' and 3 = 'z'
+       SCW_REAL   the 8 bytes of a double
+
+   A block flagged SCW_BLOCK_SNAPSHOT starts with a step that changes
+   every trace, for which the previous values of the SCW_UINT traces
+   are taken as 0.  Decoding must start at such a block.
+
+   Comments (sc_write_comment()) come between the header and the first
+   block, or between blocks, ahead of the block in which they were
+   made:
+       "SCWC"
+       u64  time of the comment, in time units
+       u32  length of the text, followed by the text */
+
+#include <assert.h>
+#include <string.h>
+#include <stdlib.h>
+#ifdef __BCPLUSPLUS__
+#pragma hdrstop
+#endif
+#include "sc_string.h"
+#include "sc_logic.h"
+#include "sc_logic_vector.h"
+
+#include "sc_bool_vector.h"
+#include "sc_scw_trace.h"
+#include "sc_simcontext.h"
+#include "numeric_bit/numeric_bit.h"
+#include "sc_resolved.h"
+#include "sc_dump.h"
+
+enum scw_kind {
+    SCW_UINT  = 0,
+    SCW_BITS  = 1,
+    SCW_LOGIC = 2,
+    SCW_REAL  = 3
+};
+
+enum {
+    SCW_BLOCK_SNAPSHOT   = 1,
+    SCW_BLOCK_COMPRESSED = 2
+};
+
+const int SCW_BLOCK_SIZE = 1 << 16;    // uncompressed bytes per block
+const int SCW_SNAPSHOT_RATIO = 4;      // bytes of changes per byte of snapshot
+
+static void scw_put_error_message(const char* msg, bool just_warning);
+
+static bool running_regression = false;
+
+
+/*****************************************************************************/
+
+// Growable byte buffer
+class scw_buffer {
+public:
+    scw_buffer() : data(0), len(0), alloc(0) { }
+    ~scw_buffer() { free(data); }
+
+    int size() const { return len; }
+    const unsigned char* raw_data() const { return data; }
+    void clear() { len = 0; }
+
+    void put_byte(unsigned char b)
+    {
+        if (len == alloc)
+            grow(1);
+        data[len++] = b;
+    }
+    void put_bytes(const void* p, int n)
+    {
+        if (len + n > alloc)
+            grow(n);
+        memcpy(data + len, p, n);
+        len += n;
+    }
+    void put_varint(scw_uint64 v)
+    {
+        while (v >= 0x80) {
+            put_byte((unsigned char) (v | 0x80));
+            v >>= 7;
+        }
+        put_byte((unsigned char) v);
+    }
+    void put_u16(unsigned v)  { put_le(v, 2); }
+    void put_u32(unsigned v)  { put_le(v, 4); }
+    void put_u64(scw_uint64 v) { put_le(v, 8); }
+
+private:
+    void put_le(scw_uint64 v, int n)
+    {
+        for (int i = 0; i < n; i++) {
+            put_byte((unsigned char) v);
+            v >>= 8;
+        }
+    }
+    void grow(int n)
+    {
+        alloc = 2 * alloc + n + 256;
+        data = (unsigned char*) realloc(data, alloc);
+        if (data == 0) {
+            fprintf(stderr, "FATAL: out of memory for SCW trace\n");
+            exit(1);
+        }
+    }
+
+    unsigned char* data;
+    int len;
+    int alloc;
+};
+
+
+/*****************************************************************************/
+
+// Compression in the LZ4 block format: a sequence of a token (literal
+// count in the high nibble, match length - 4 in the low one, 15 meaning
+// that more follows in bytes of up to 255), the literals, and the u16
+// offset of the match.  The last sequence has literals only.
+
+static inline unsigned scw_read32(const unsigned char* p)
+{
+    unsigned v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+static unsigned char* scw_put_length(unsigned char* op, int n)
+{
+    for (; n >= 255; n -= 255)
+        *op++ = 255;
+    *op++ = (unsigned char) n;
+    return op;
+}
+
+// Bound on the compressed size of n bytes
+static int scw_compress_bound(int n)
+{
+    return n + n / 255 + 16;
+}
+
+static int scw_compress(const unsigned char* src, int n, unsigned char* dst)
+{
+    const int hash_log = 12;
+    int table[1 << hash_log];
+    int i;
+    for (i = 0; i < (1 << hash_log); i++)
+        table[i] = -1;
+
+    const unsigned char* const end = src + n;
+    const unsigned char* const match_limit = end - 5;   // the last 5 bytes are literals
+    const unsigned char* const start_limit = end - 12;  // no match starts after this
+    const unsigned char* ip = src;
+    const unsigned char* anchor = src;
+    unsigned char* op = dst;
+
+    while (n >= 13 && ip < start_limit) {
+        unsigned seq = scw_read32(ip);
+        unsigned h = (seq * 2654435761U) >> (32 - hash_log);
+        int ref = table[h];
+        table[h] = (int) (ip - src);
+        if (ref < 0 || (ip - src) - ref > 65535 || scw_read32(src + ref) != seq) {
+            ip++;
+            continue;
+        }
+
+        const unsigned char* match = src + ref;
+        int match_len = 4;
+        while (ip + match_len < match_limit && ip[match_len] == match[match_len])
+            match_len++;
+
+        int lit_len = (int) (ip - anchor);
+        int ml = match_len - 4;
+        unsigned char* token = op++;
+        *token = (unsigned char) (((lit_len < 15 ? lit_len : 15) << 4) | (ml < 15 ? ml : 15));
+        if (lit_len >= 15)
+            op = scw_put_length(op, lit_len - 15);
+        memcpy(op, anchor, lit_len);
+        op += lit_len;
+        int offset = (int) (ip - match);
+        *op++ = (unsigned char) offset;
+        *op++ = (unsigned char) (offset >> 8);
+        if (ml >= 15)
+            op = scw_put_length(op, ml - 15);
+
+        ip += match_len;
+        anchor = ip;
+    }
+
+    int lit_len = (int) (end - anchor);
+    *op++ = (unsigned char) ((lit_len < 15 ? lit_len : 15) << 4);
+    if (lit_len >= 15)
+        op = scw_put_length(op, lit_len - 15);
+    memcpy(op, anchor, lit_len);
+    op += lit_len;
+    return (int) (op - dst);
+}
+
+
+/*****************************************************************************/
+
+// Base class for the traces
+class scw_trace {
+public:
+    scw_trace(const sc_string& _name, int _kind, int _width);
+    virtual ~scw_trace();
+
+    virtual bool changed() = 0;
+
+    // Append the current value as a change `id_delta' traces after the
+    // previous one, and make it the old value
+    virtual void write(scw_buffer& out, int id_delta) = 0;
+
+    virtual void set_width();
+
+    // The next value of an SCW_UINT trace is encoded from 0
+    void reset_base() { base = 0; }
+
+    const sc_string name;
+    int kind;
+    int width;
+
+protected:
+    // Append a change of an SCW_UINT trace; all bits unknown if is_x
+    void put_uint(scw_buffer& out, int id_delta, scw_uint64 value, bool is_x);
+    // Append a change from the VCD characters ('0', '1', 'x', 'z') of
+    // the bits, most significant first
+    void put_bit_chars(scw_buffer& out, int id_delta, const char* chars);
+
+    scw_uint64 base;    // last value of an SCW_UINT trace
+};
+
+scw_trace::scw_trace(const sc_string& _name, int _kind, int _width)
+    : name(_name), kind(_kind), width(_width), base(0)
+{
+    /* Intentionally blank */
+}
+
+scw_trace::~scw_trace()
+{
+    /* Intentionally blank */
+}
+
+void scw_trace::set_width()
+{
+    /* Intentionally blank, defined by the vectors */
+}
+
+void scw_trace::put_uint(scw_buffer& out, int id_delta, scw_uint64 value, bool is_x)
+{
+    if (is_x) {
+        out.put_varint(((scw_uint64) id_delta << 1) | 1);
+        return;
+    }
+    out.put_varint((scw_uint64) id_delta << 1);
+    scw_uint64 d = value - base;
+    // zigzag: small differences of either sign give small numbers
+    out.put_varint((d << 1) ^ ((d >> 63) ? ~(scw_uint64) 0 : 0));
+    base = value;
+}
+
+void scw_trace::put_bit_chars(scw_buffer& out, int id_delta, const char* chars)
+{
+    int i;
+    if (kind == SCW_UINT) {
+        scw_uint64 value = 0;
+        for (i = 0; i < width; i++)
+            value = (value << 1) | (chars[i] == '1');
+        put_uint(out, id_delta, value, false);
+        return;
+    }
+
+    out.put_varint((scw_uint64) id_delta << 1);
+    int per_byte = (kind == SCW_BITS) ? 8 : 4;
+    int shift = 8 / per_byte;
+    for (i = 0; i < width; i += per_byte) {
+        unsigned b = 0;
+        for (int j = 0; j < per_byte; j++) {
+            unsigned code = 0;
+            if (i + j < width) {
+                switch (chars[i + j]) {
+                case '1': code = 1; break;
+                case 'x': code = 2; break;
+                case 'z': code = 3; break;
+                default:  code = 0; break;
+                }
+            }
+            b = (b << shift) | code;
+        }
+        out.put_byte((unsigned char) b);
+    }
+}
+
+
+/*****************************************************************************/
+
+// Integers, bool and enums.  Values that do not fit in the width are
+// written as unknown, as the VCD writer does.
+template <class T, class UT>
+class scw_int_trace : public scw_trace {
+public:
+    scw_int_trace(const T& _object, const sc_string& _name, int _width)
+        : scw_trace(_name, SCW_UINT, _width), object(_object)
+    {
+        mask = (width >= 64) ? ~(scw_uint64) 0 : (((scw_uint64) 1 << width) - 1);
+        old_value = object;
+    }
+    bool changed() { return object != old_value; }
+    void write(scw_buffer& out, int id_delta)
+    {
+        scw_uint64 value = (scw_uint64) (UT) object;
+        put_uint(out, id_delta, value, (value & mask) != value);
+        old_value = object;
+    }
+
+protected:
+    const T& object;
+    T old_value;
+    scw_uint64 mask;
+};
+
+/*****************************************************************************/
+
+static inline double scw_to_double(float v)  { return v; }
+static inline double scw_to_double(double v) { return v; }
+#ifdef SC_INCLUDE_FX
+static inline double scw_to_double(const sc_fxval& v)      { return v.to_double(); }
+static inline double scw_to_double(const sc_fxval_fast& v) { return v.to_double(); }
+#endif
+
+template <class T>
+class scw_real_trace : public scw_trace {
+public:
+    scw_real_trace(const T& _object, const sc_string& _name)
+        : scw_trace(_name, SCW_REAL, 64), object(_object)
+    {
+        old_value = object;
+    }
+    bool changed() { return object != old_value; }
+    void write(scw_buffer& out, int id_delta)
+    {
+        double value = scw_to_double(object);
+        out.put_varint((scw_uint64) id_delta << 1);
+        out.put_bytes(&value, sizeof(value));
+        old_value = object;
+    }
+
+protected:
+    const T& object;
+    T old_value;
+};
+
+/*****************************************************************************/
+
+class scw_sc_logic_trace : public scw_trace {
+public:
+    scw_sc_logic_trace(const sc_logic& _object, const sc_string& _name)
+        : scw_trace(_name, SCW_LOGIC, 1), object(_object)
+    {
+        old_value = object;
+    }
+    bool changed() { return object != old_value; }
+    void write(scw_buffer& out, int id_delta)
+    {
+        char c;
+        switch (object.to_char()) {
+        case '0': case 'L': c = '0'; break;
+        case '1': case 'H': c = '1'; break;
+        case 'Z':           c = 'z'; break;
+        default:            c = 'x'; break;
+        }
+        put_bit_chars(out, id_delta, &c);
+        old_value = object;
+    }
+
+protected:
+    const sc_logic& object;
+    sc_logic old_value;
+};
+
+/*****************************************************************************/
+
+// The vectors write their bits through a buffer of characters
+class scw_vector_trace : public scw_trace {
+public:
+    scw_vector_trace(const sc_string& _name, int _kind)
+        : scw_trace(_name, _kind, 0), chars(0) { }
+    ~scw_vector_trace() { delete[] chars; }
+
+    // Two-valued vectors of up to 64 bits are written as SCW_UINT
+    void set_width()
+    {
+        width = vector_width();
+        if (kind == SCW_BITS && width <= 64)
+            kind = SCW_UINT;
+        delete[] chars;
+        chars = new char[width > 0 ? width : 1];
+    }
+
+protected:
+    virtual int vector_width() = 0;
+
+    char* chars;
+};
+
+class scw_bool_vector_trace : public scw_vector_trace {
+public:
+    scw_bool_vector_trace(const sc_bool_vector& _object, const sc_string& _name)
+        : scw_vector_trace(_name, SCW_BITS), object(_object), old_value(_object.length())
+    {
+        old_value = object;
+    }
+    bool changed() { return object != old_value; }
+    void write(scw_buffer& out, int id_delta)
+    {
+        for (int i = 0; i < width; i++)
+            chars[i] = "01"[object[width - 1 - i]];
+        put_bit_chars(out, id_delta, chars);
+        old_value = object;
+    }
+
+protected:
+    int vector_width() { return object.length(); }
+
+    const sc_bool_vector& object;
+    sc_bool_vector old_value;
+};
+
+class scw_sc_logic_vector_trace : public scw_vector_trace {
+public:
+    scw_sc_logic_vector_trace(const sc_logic_vector& _object, const sc_string& _name)
+        : scw_vector_trace(_name, SCW_LOGIC), object(_object), old_value(_object.length())
+    {
+        old_value = object;
+    }
+    bool changed() { return object != old_value; }
+    void write(scw_buffer& out, int id_delta)
+    {
+        for (int i = 0; i < width; i++) {
+            switch (object[width - 1 - i].to_char()) {
+            case '0': case 'L': chars[i] = '0'; break;
+            case '1': case 'H': chars[i] = '1'; break;
+            case 'Z':           chars[i] = 'z'; break;
+            default:            chars[i] = 'x'; break;
+            }
+        }
+        put_bit_chars(out, id_delta, chars);
+        old_value = object;
+    }
+
+protected:
+    int vector_width() { return object.length(); }
+
+    const sc_logic_vector& object;
+    sc_logic_vector old_value;
+};
+
+class scw_sc_unsigned_trace : public scw_vector_trace {
+public:
+    scw_sc_unsigned_trace(const sc_unsigned& _object, const sc_string& _name)
+        : scw_vector_trace(_name, SCW_BITS), object(_object), old_value(_object.length())
+    {
+        old_value = object;
+    }
+    bool changed() { return object != old_value; }
+    void write(scw_buffer& out, int id_delta)
+    {
+        for (int i = 0; i < width; i++)
+            chars[i] = "01"[object[width - 1 - i]];
+        put_bit_chars(out, id_delta, chars);
+        old_value = object;
+    }
+
+protected:
+    int vector_width() { return object.length(); }
+
+    const sc_unsigned& object;
+    sc_unsigned old_value;
+};
+
+class scw_sc_signed_trace : public scw_vector_trace {
+public:
+    scw_sc_signed_trace(const sc_signed& _object, const sc_string& _name)
+        : scw_vector_trace(_name, SCW_BITS), object(_object), old_value(_object.length())
+    {
+        old_value = object;
+    }
+    bool changed() { return object != old_value; }
+    void write(scw_buffer& out, int id_delta)
+    {
+        for (int i = 0; i < width; i++)
+            chars[i] = "01"[object[width - 1 - i]];
+        put_bit_chars(out, id_delta, chars);
+        old_value = object;
+    }
+
+protected:
+    int vector_width() { return object.length(); }
+
+    const sc_signed& object;
+    sc_signed old_value;
+};
+
+class scw_sc_uint_base_trace : public scw_vector_trace {
+public:
+    scw_sc_uint_base_trace(const sc_uint_base& _object, const sc_string& _name)
+        : scw_vector_trace(_name, SCW_BITS), object(_object), old_value(_object.width)
+    {
+        old_value = object;
+    }
+    bool changed() { return object != old_value; }
+    void write(scw_buffer& out, int id_delta)
+    {
+        for (int i = 0; i < width; i++)
+            chars[i] = "01"[int(object[width - 1 - i])];
+        put_bit_chars(out, id_delta, chars);
+        old_value = object;
+    }
+
+protected:
+    int vector_width() { return object.width; }
+
+    const sc_uint_base& object;
+    sc_uint_base old_value;
+};
+
+class scw_sc_int_base_trace : public scw_vector_trace {
+public:
+    scw_sc_int_base_trace(const sc_int_base& _object, const sc_string& _name)
+        : scw_vector_trace(_name, SCW_BITS), object(_object), old_value(_object.width)
+    {
+        old_value = object;
+    }
+    bool changed() { return object != old_value; }
+    void write(scw_buffer& out, int id_delta)
+    {
+        for (int i = 0; i < width; i++)
+            chars[i] = "01"[int(object[width - 1 - i])];
+        put_bit_chars(out, id_delta, chars);
+        old_value = object;
+    }
+
+protected:
+    int vector_width() { return object.width; }
+
+    const sc_int_base& object;
+    sc_int_base old_value;
+};
+
+#ifdef SC_INCLUDE_FX
+
+template <class T>
+class scw_fxnum_trace : public scw_vector_trace {
+public:
+    scw_fxnum_trace(const T& _object, const sc_string& _name)
+        : scw_vector_trace(_name, SCW_BITS), object(_object),
+          old_value(_object._params.type_params(),
+                    _object._params.enc(),
+                    _object._params.cast_switch(),
+                    0)
+    {
+        old_value = object;
+    }
+    bool changed() { return object != old_value; }
+    void write(scw_buffer& out, int id_delta)
+    {
+        for (int i = 0; i < width; i++)
+            chars[i] = "01"[object[width - 1 - i]];
+        put_bit_chars(out, id_delta, chars);
+        old_value = object;
+    }
+
+protected:
+    int vector_width() { return object.wl(); }
+
+    const T& object;
+    T old_value;
+};
+
+#endif
+
+
+/*****************************************************************************
+           scw_trace_file functions
+*****************************************************************************/
+
+scw_trace_file::scw_trace_file(const char *name)
+{
+    sc_string file_name = name;
+    file_name += ".scw";
+    fp = fopen((const char *) file_name, "wb");
+    if (!fp) {
+        sc_string msg = sc_string("Cannot write trace file '") + file_name + "'";
+        fprintf(stderr, "FATAL: %s\n", (const char *) msg);
+        exit(1);
+    }
+    initialized = false;
+
+    //default timestep = 1 sec
+    timescale_unit = 1;
+    timescale_exponent = 0;
+    timescale_set_by_user = false;
+
+    block = new scw_buffer;
+    block_open = false;
+    block_snapshot = false;
+    block_start = 0;
+    last_time = 0;
+
+    file_pos = 0;
+    since_snapshot = 0;
+    snapshot_size = 0;
+
+    index = new scw_buffer;
+    num_blocks = 0;
+    comments = new scw_buffer;
+}
+
+scw_trace_file::~scw_trace_file()
+{
+    int i;
+    if (initialized) {
+        if (block_open)
+            close_block();
+        write_comments();
+        write_index();
+    }
+    fclose(fp);
+    for (i = 0; i < traces.size(); i++)
+        delete traces[i];
+    delete block;
+    delete index;
+    delete comments;
+}
+
+void scw_trace_file::sc_set_scw_time_unit(int exponent10_seconds)
+{
+    if (initialized) {
+        scw_put_error_message("SCW trace timescale unit cannot be changed once tracing has begun.\n"
+                              "To change the scale, create a new trace file.",
+                              false);
+        return;
+    }
+    if (exponent10_seconds < -15 || exponent10_seconds > 2) {
+        scw_put_error_message("set_scw_time_unit() has valid exponent range -15...+2.", false);
+        return;
+    }
+
+    timescale_exponent = exponent10_seconds;
+    timescale_unit = 1;
+    for (int i = 0; i < exponent10_seconds; i++)
+        timescale_unit *= 10;
+    for (int j = 0; j > exponent10_seconds; j--)
+        timescale_unit /= 10;
+    timescale_set_by_user = true;
+}
+
+void scw_trace_file::initialize()
+{
+    scw_buffer header;
+    int i;
+
+    header.put_bytes("SCW1", 4);
+    header.put_byte(1);
+    header.put_byte((unsigned char) (signed char) timescale_exponent);
+    header.put_u32(traces.size());
+    for (i = 0; i < traces.size(); i++) {
+        scw_trace* t = traces[i];
+        t->set_width();
+        if (t->width == 0) {
+            char buf[2000];
+            sprintf(buf, "Traced object \"%s\" has 0 Bits, cannot be traced.", (const char *) t->name);
+            scw_put_error_message(buf, false);
+        }
+        header.put_byte((unsigned char) t->kind);
+        header.put_u32(t->width);
+        int len = t->name.length();
+        header.put_u16(len);
+        header.put_bytes((const char *) t->name, len);
+    }
+    fwrite(header.raw_data(), 1, header.size(), fp);
+    file_pos += header.size();
+
+    running_regression = (getenv("SCENIC_REGRESSION") == NULL);
+    // Don't print message if running regression
+    if (timescale_set_by_user == false && running_regression) {
+        fprintf(stderr, "WARNING: Default time step (1 s) is used for SCW tracing.\n");
+    }
+
+    write_comments();
+    open_block(sc_ticks_to_units(sc_time_stamp_ticks(), timescale_unit));
+}
+
+void scw_trace_file::add_trace(scw_trace* t)
+{
+    if (initialized) {
+        scw_put_error_message("No traces can be added once simulation has started.\n"
+                              "To add traces, create a new SCW trace file.", false);
+    }
+    traces.push_back(t);
+    trace_added();
+}
+
+void scw_trace_file::open_block(sc_ticks now)
+{
+    block->clear();
+    block_open = true;
+    block_start = now;
+    last_time = now;
+
+    block_snapshot = (snapshot_size == 0 ||
+                      since_snapshot >= SCW_SNAPSHOT_RATIO * snapshot_size);
+    if (block_snapshot) {
+        // A step that changes every trace, at the time of the block
+        block->put_varint(0);
+        int prev = -1;
+        for (int i = 0; i < traces.size(); i++) {
+            scw_trace* t = traces[i];
+            if (t->width == 0)
+                continue;
+            t->reset_base();
+            t->write(*block, i - prev);
+            prev = i;
+        }
+        block->put_byte(0);
+        snapshot_size = block->size();
+        since_snapshot = 0;
+    }
+}
+
+void scw_trace_file::close_block()
+{
+    write_comments();
+
+    int raw_size = block->size();
+    unsigned char* packed = new unsigned char[scw_compress_bound(raw_size)];
+    int packed_size = scw_compress(block->raw_data(), raw_size, packed);
+
+    unsigned flags = block_snapshot ? SCW_BLOCK_SNAPSHOT : 0;
+    const unsigned char* data = block->raw_data();
+    int data_size = raw_size;
+    if (packed_size < raw_size) {
+        flags |= SCW_BLOCK_COMPRESSED;
+        data = packed;
+        data_size = packed_size;
+    }
+
+    scw_buffer header;
+    header.put_bytes("SCWB", 4);
+    header.put_byte((unsigned char) flags);
+    header.put_u32(raw_size);
+    header.put_u32(data_size);
+    header.put_u64((scw_uint64) block_start);
+    fwrite(header.raw_data(), 1, header.size(), fp);
+    fwrite(data, 1, data_size, fp);
+
+    index->put_u64((scw_uint64) block_start);
+    index->put_u64(file_pos);
+    index->put_byte((unsigned char) flags);
+    num_blocks++;
+
+    file_pos += header.size() + data_size;
+    since_snapshot += raw_size;
+    delete[] packed;
+    block->clear();
+    block_open = false;
+}
+
+void scw_trace_file::write_comments()
+{
+    fwrite(comments->raw_data(), 1, comments->size(), fp);
+    file_pos += comments->size();
+    comments->clear();
+}
+
+void scw_trace_file::write_index()
+{
+    scw_buffer trailer;
+    trailer.put_u64(file_pos);
+    trailer.put_u32(num_blocks);
+    trailer.put_bytes("SCWE", 4);
+    fwrite(index->raw_data(), 1, index->size(), fp);
+    fwrite(trailer.raw_data(), 1, trailer.size(), fp);
+}
+
+void scw_trace_file::cycle(bool this_is_a_delta_cycle)
+{
+    if (this_is_a_delta_cycle)
+        return;
+
+    if (!initialized) {
+        initialize();
+        clear_dirty();
+        initialized = true;
+        return;
+    }
+
+    sc_ticks now = sc_ticks_to_units(sc_time_stamp_ticks(), timescale_unit);
+    if (now <= last_time) {
+        // As for VCD, repeats of time zero go without a warning
+        static bool warned = false;
+        if (!warned && (now < last_time || (running_regression && now != 0))) {
+            char message[4000];
+            sprintf(message,
+                    "Multiple cycles found with the same time units count, or one with\n"
+                    "a smaller count than the last (%u).  Waveform viewers will only\n"
+                    "show the states of the last one.\n"
+                    "Use ((scw_trace_file*)scwfile)->sc_set_scw_time_unit(int exponent10_seconds)\n"
+                    "to increase time resolution.",
+                    (unsigned) last_time);
+            scw_put_error_message(message, true);
+            warned = true;
+        }
+        now = last_time;
+    }
+    if (!block_open) {
+        open_block(now);
+        if (block_snapshot) {
+            // The snapshot holds the values of this cycle already
+            clear_dirty();
+            return;
+        }
+    }
+
+    bool time_written = false;
+    int prev = -1;
+    scw_trace* const* const l_traces = traces.raw_data();
+    int n_check;
+    sc_trace_watch* const* const to_check = traces_to_check(n_check);
+    for (int k = 0; k < n_check; k++) {
+        int i = to_check[k]->index;
+        scw_trace* t = l_traces[i];
+        if (t->width != 0 && t->changed()) {
+            if (!time_written) {
+                block->put_varint((scw_uint64) (now - last_time));
+                last_time = now;
+                time_written = true;
+            }
+            t->write(*block, i - prev);
+            prev = i;
+        }
+    }
+
+    if (time_written) {
+        block->put_byte(0);
+        if (block->size() >= SCW_BLOCK_SIZE)
+            close_block();
+    }
+}
+
+void scw_trace_file::write_comment(const sc_string& comment)
+{
+    int len = comment.length();
+    comments->put_bytes("SCWC", 4);
+    comments->put_u64((scw_uint64) sc_ticks_to_units(sc_time_stamp_ticks(), timescale_unit));
+    comments->put_u32(len);
+    comments->put_bytes((const char *) comment, len);
+}
+
+void scw_trace_file::trace(const bool& object, const sc_string& name)
+{
+    add_trace(new scw_int_trace<bool, bool>(object, name, 1));
+}
+
+void scw_trace_file::trace(const sc_logic& object, const sc_string& name)
+{
+    add_trace(new scw_sc_logic_trace(object, name));
+}
+
+void scw_trace_file::trace(const sc_bool_vector& object, const sc_string& name)
+{
+    add_trace(new scw_bool_vector_trace(object, name));
+}
+
+void scw_trace_file::trace(const sc_logic_vector& object, const sc_string& name)
+{
+    add_trace(new scw_sc_logic_vector_trace(object, name));
+}
+
+void scw_trace_file::trace(const unsigned char& object, const sc_string& name, int width)
+{
+    add_trace(new scw_int_trace<unsigned char, unsigned char>(object, name, width));
+}
+
+void scw_trace_file::trace(const unsigned short& object, const sc_string& name, int width)
+{
+    add_trace(new scw_int_trace<unsigned short, unsigned short>(object, name, width));
+}
+
+void scw_trace_file::trace(const unsigned int& object, const sc_string& name, int width)
+{
+    add_trace(new scw_int_trace<unsigned int, unsigned int>(object, name, width));
+}
+
+void scw_trace_file::trace(const unsigned long& object, const sc_string& name, int width)
+{
+    add_trace(new scw_int_trace<unsigned long, unsigned long>(object, name, width));
+}
+
+void scw_trace_file::trace(const char& object, const sc_string& name, int width)
+{
+    add_trace(new scw_int_trace<char, unsigned char>(object, name, width));
+}
+
+void scw_trace_file::trace(const short& object, const sc_string& name, int width)
+{
+    add_trace(new scw_int_trace<short, unsigned short>(object, name, width));
+}
+
+void scw_trace_file::trace(const int& object, const sc_string& name, int width)
+{
+    add_trace(new scw_int_trace<int, unsigned int>(object, name, width));
+}
+
+void scw_trace_file::trace(const long& object, const sc_string& name, int width)
+{
+    add_trace(new scw_int_trace<long, unsigned long>(object, name, width));
+}
+
+void scw_trace_file::trace(const float& object, const sc_string& name)
+{
+    add_trace(new scw_real_trace<float>(object, name));
+}
+
+void scw_trace_file::trace(const double& object, const sc_string& name)
+{
+    add_trace(new scw_real_trace<double>(object, name));
+}
+
+void scw_trace_file::trace(const sc_signal_bool_vector& object, const sc_string& name)
+{
+    add_trace(new scw_bool_vector_trace((const sc_bool_vector&) object, name));
+}
+
+void scw_trace_file::trace(const sc_signal_logic_vector& object, const sc_string& name)
+{
+    add_trace(new scw_sc_logic_vector_trace((const sc_logic_vector&) object, name));
+}
+
+void scw_trace_file::trace(const sc_uint_base& object, const sc_string& name)
+{
+    add_trace(new scw_sc_uint_base_trace(object, name));
+}
+
+void scw_trace_file::trace(const sc_int_base& object, const sc_string& name)
+{
+    add_trace(new scw_sc_int_base_trace(object, name));
+}
+
+void scw_trace_file::trace(const sc_unsigned& object, const sc_string& name)
+{
+    add_trace(new scw_sc_unsigned_trace(object, name));
+}
+
+void scw_trace_file::trace(const sc_signed& object, const sc_string& name)
+{
+    add_trace(new scw_sc_signed_trace(object, name));
+}
+
+#ifdef SC_INCLUDE_FX
+
+void scw_trace_file::trace(const sc_fxval& object, const sc_string& name)
+{
+    add_trace(new scw_real_trace<sc_fxval>(object, name));
+}
+
+void scw_trace_file::trace(const sc_fxval_fast& object, const sc_string& name)
+{
+    add_trace(new scw_real_trace<sc_fxval_fast>(object, name));
+}
+
+void scw_trace_file::trace(const sc_fxnum& object, const sc_string& name)
+{
+    add_trace(new scw_fxnum_trace<sc_fxnum>(object, name));
+}
+
+void scw_trace_file::trace(const sc_fxnum_fast& object, const sc_string& name)
+{
+    add_trace(new scw_fxnum_trace<sc_fxnum_fast>(object, name));
+}
+
+#endif
+
+void scw_trace_file::trace(const sc_signal_resolved& object, const sc_string& name)
+{
+    add_trace(new scw_sc_logic_trace((const sc_logic&) *(object.get_data_ptr()), name));
+}
+
+void scw_trace_file::trace(const sc_signal_resolved_vector& object, const sc_string& name)
+{
+    add_trace(new scw_sc_logic_vector_trace((const sc_logic_vector&) object, name));
+}
+
+void scw_trace_file::trace(const unsigned& object, const sc_string& name, const char** enum_literals)
+{
+    // Number of bits required to represent the number of literals
+    unsigned nliterals;
+    for (nliterals = 0; enum_literals[nliterals]; nliterals++);
+    int width = 0;
+    for (unsigned shifted_maxindex = nliterals - 1; shifted_maxindex != 0; shifted_maxindex >>= 1)
+        width++;
+
+    add_trace(new scw_int_trace<unsigned, unsigned>(object, name, width));
+}
+
+
+static void
+scw_put_error_message(const char* msg, bool just_warning)
+{
+    if (just_warning) {
+        fprintf(stderr, "SCW Trace Warning:\n%s\n\n", msg);
+    }
+    else {
+        fprintf(stderr, "SCW Trace ERROR:\n%s\n\n", msg);
+    }
+}
+
+
+sc_trace_file *sc_create_scw_trace_file(const char * name)
+{
+    sc_trace_file *tf;
+
+    tf = new scw_trace_file(name);
+    sc_get_curr_simcontext()->add_trace_file(tf);
+    the_dumpfile = tf; // To help sc_dumpall()
+    return tf;
+}
+
+void sc_close_scw_trace_file( sc_trace_file* tf )
+{
+    scw_trace_file* scw_tf = (scw_trace_file*)tf;
+    delete scw_tf;
+}
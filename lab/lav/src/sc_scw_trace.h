@@ -0,0 +1,156 @@
+/******************************************************************************
+    Copyright (c) 1996-2000 Synopsys, Inc.    ALL RIGHTS RESERVED
+
+  The contents of this file are subject to the restrictions and limitations
+  set forth in the SystemC(TM) Open Community License Software Download and
+  Use License Version 1.1 (the "License"); you may not use this file except
+  in compliance with such restrictions and limitations. You may obtain
+  instructions on how to receive a copy of the License at
+  http://www.systemc.org/. Software distributed by Original Contributor
+  under the License is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+  ANY KIND, either express or implied. See the License for the specific
+  language governing rights and limitations under the License.
+
+******************************************************************************/
+
+/******************************************************************************
+
+    sc_scw_trace.h -- compressed binary waveform (SCW) tracing.
+
+******************************************************************************/
+
+/******************************************************************************
+
+    MODIFICATION LOG - modifiers, enter your name, affliation and
+    changes you are making here:
+
+    Modifier Name & Affiliation:
+    Description of Modification:
+
+
+******************************************************************************/
+
+
+#ifndef SC_SCW_TRACE_H
+#define SC_SCW_TRACE_H
+
+#include <stdio.h>
+#include "sc_trace.h"
+#include "sc_vector.h"
+
+class scw_trace;   // defined in sc_scw_trace.cpp
+class scw_buffer;
+
+#ifndef WIN32
+typedef unsigned long long scw_uint64;
+#else
+typedef unsigned __int64   scw_uint64;
+#endif
+
+//
+//  <summary> Compressed binary waveform trace file </summary>
+//
+//  Writes the traced values in the SCW format, which is described at
+//  the top of sc_scw_trace.cpp.  The value changes are delta and
+//  varint encoded, collected in blocks of about 64 KB, and each block
+//  is compressed on its own.  An index of the blocks by time at the end
+//  of the file lets a reader seek to any time without decoding the
+//  blocks before it, back to the last one that starts with a snapshot
+//  of all the values.
+//
+//  Delta cycles are not traced.
+//
+class scw_trace_file : public sc_trace_file {
+public:
+    void sc_set_scw_time_unit(int exponent10_seconds); // -7 -> 100ns
+
+    // Create an SCW trace file.
+    // `Name' forms the base of the name to which `.scw' is added.
+    scw_trace_file(const char *name);
+
+    // Write the last block and the index, and close the file.
+    ~scw_trace_file();
+
+protected:
+    // These are all virtual functions in sc_trace_file and
+    // they need to be defined here.
+
+    void trace(const bool& object, const sc_string& name);
+    void trace(const sc_logic& object, const sc_string& name);
+    void trace(const sc_bool_vector& object, const sc_string& name);
+    void trace(const sc_logic_vector& object, const sc_string& name);
+    void trace(const unsigned char& object, const sc_string& name, int width);
+    void trace(const unsigned short& object, const sc_string& name, int width);
+    void trace(const unsigned int& object, const sc_string& name, int width);
+    void trace(const unsigned long& object, const sc_string& name, int width);
+    void trace(const char& object, const sc_string& name, int width);
+    void trace(const short& object, const sc_string& name, int width);
+    void trace(const int& object, const sc_string& name, int width);
+    void trace(const long& object, const sc_string& name, int width);
+    void trace(const float& object, const sc_string& name);
+    void trace(const double& object, const sc_string& name);
+    void trace(const sc_signal_bool_vector& object, const sc_string& name);
+    void trace(const sc_signal_logic_vector& object, const sc_string& name);
+    void trace(const sc_uint_base& object, const sc_string& name);
+    void trace(const sc_int_base& object, const sc_string& name);
+    void trace(const sc_unsigned& object, const sc_string& name);
+    void trace(const sc_signed& object, const sc_string& name);
+#ifdef SC_INCLUDE_FX
+    void trace(const sc_fxval& object, const sc_string& name);
+    void trace(const sc_fxval_fast& object, const sc_string& name);
+    void trace(const sc_fxnum& object, const sc_string& name);
+    void trace(const sc_fxnum_fast& object, const sc_string& name);
+#endif
+    void trace(const sc_signal_resolved& object, const sc_string& name);
+    void trace(const sc_signal_resolved_vector& object, const sc_string& name);
+    void trace(const unsigned& object, const sc_string& name, const char** enum_literals);
+
+    // Comments are kept apart from the values, stamped with their time
+    void write_comment(const sc_string& comment);
+
+    // Write trace info for cycle.
+    void cycle(bool delta_cycle);
+
+private:
+    // Write the header and the first snapshot
+    void initialize();
+    // Add a trace to the traces
+    void add_trace(scw_trace* t);
+
+    // Start a block at time `now', with a snapshot of all the values
+    // if enough has been written since the last one
+    void open_block(sc_ticks now);
+    // Compress and write the current block, and add it to the index
+    void close_block();
+    // Write the comments made since the last call
+    void write_comments();
+    void write_index();
+
+    sc_pvector<scw_trace*> traces;
+    FILE* fp;
+
+    double timescale_unit;      // in seconds
+    int timescale_exponent;     // of timescale_unit
+    bool timescale_set_by_user;
+    bool initialized;
+
+    scw_buffer* block;          // the uncompressed current block
+    bool block_open;
+    bool block_snapshot;        // the current block starts with a snapshot
+    sc_ticks block_start;       // time of the block, in timescale units
+    sc_ticks last_time;         // of the last time step in the block
+
+    scw_uint64 file_pos;        // bytes written so far
+    scw_uint64 since_snapshot;  // uncompressed bytes since the last snapshot
+    scw_uint64 snapshot_size;   // uncompressed size of the last snapshot
+
+    scw_buffer* index;          // one entry for each block written
+    unsigned num_blocks;
+    scw_buffer* comments;       // "SCWC" records not yet written
+};
+
+// Create SCW file
+extern sc_trace_file *sc_create_scw_trace_file(const char* name);
+extern void sc_close_scw_trace_file( sc_trace_file* tf );
+
+#endif
@@ -85,10 +85,16 @@ sc_signal_base::sc_signal_base( sc_object* from, bool add_to_simcontext )
 {
     submitted = false;
     created_by = from;
+    sig_index = -1;
     if (add_to_simcontext)
         simcontext()->add_signal(this);
     update_func = update_func_abort;
     prop_which  = SC_SIGNAL_PROP_NONE;
+    lambda_watchers = 0;
+    trace_watchers = 0;
+    prof_index = -1;
+    changed_in_delta = 0;
+    compares = true;
 }
 
 sc_signal_base::sc_signal_base( const char* nm, sc_object* from,
@@ -97,15 +103,38 @@ sc_signal_base::sc_signal_base( const char* nm, sc_object* from,
 {
     submitted = false;
     created_by = from;
+    sig_index = -1;
     if (add_to_simcontext)
         simcontext()->add_signal(this);
     update_func = update_func_abort;
     prop_which  = SC_SIGNAL_PROP_NONE;
+    lambda_watchers = 0;
+    trace_watchers = 0;
+    prof_index = -1;
+    changed_in_delta = 0;
+    compares = true;
 }
 
 sc_signal_base::~sc_signal_base()
 {
-    /* Intentionally blank */
+    /* Lambdas and traces that still read this signal must not touch
+       it later */
+    sc_lambda::forget_signal( this );
+    sc_trace_file::forget_signal( this );
+    if (sig_index >= 0)
+        simcontext()->remove_signal( this );
+}
+
+void
+sc_signal_base::checkpoint( sc_checkpoint& cp )
+{
+    cp.unsupported();
+}
+
+sc_signal_delay_base*
+sc_signal_base::new_delayed( const sc_module* )
+{
+    return 0;
 }
 
 void
@@ -220,7 +249,6 @@ sc_signal<unsigned>::sc_signal()
 {
     sc_signal_init(&cur_value);
     sc_signal_init(&new_value);
-    sc_signal_init(&old_value);
     update_func = &sc_signal_optimize::unsigned_update_prop_none;
 }
 
@@ -229,7 +257,6 @@ sc_signal<unsigned>::sc_signal( const char* nm )
 {
     sc_signal_init(&cur_value);
     sc_signal_init(&new_value);
-    sc_signal_init(&old_value);
     update_func = &sc_signal_optimize::unsigned_update_prop_none;
 }
 
@@ -238,7 +265,6 @@ sc_signal<unsigned>::sc_signal( sc_object* created_by )
 {
     sc_signal_init(&cur_value);
     sc_signal_init(&new_value);
-    sc_signal_init(&old_value);
     update_func = &sc_signal_optimize::unsigned_update_prop_none;
 }
 
@@ -259,7 +285,6 @@ sc_signal<unsigned>::update_funcs_array() const
 sc_signal<sc_logic>::sc_signal()
     : sc_signal_base(this)
 {
-    sc_signal_init(&old_value);
     sc_signal_init(&cur_value);
     sc_signal_init(&new_value);
     update_func = &sc_signal_optimize::sc_logic_update_prop_none;
@@ -270,7 +295,6 @@ sc_signal<sc_logic>::sc_signal( const char* nm )
 {
     sc_signal_init(&cur_value);
     sc_signal_init(&new_value);
-    sc_signal_init(&old_value);
     update_func = &sc_signal_optimize::sc_logic_update_prop_none;
 }
 
@@ -279,7 +303,6 @@ sc_signal<sc_logic>::sc_signal( sc_object* created_by )
 {
     sc_signal_init(&cur_value);
     sc_signal_init(&new_value);
-    sc_signal_init(&old_value);
     update_func = &sc_signal_optimize::sc_logic_update_prop_none;
 }
 
@@ -40,6 +40,7 @@
 #ifndef SC_SIGNAL_H
 #define SC_SIGNAL_H
 
+#include <algorithm>
 #include "sc_logic.h"
 #include "sc_object.h"
 #include "sc_simcontext.h"
@@ -52,6 +53,17 @@ class sc_sync;
 class sc_async;
 class sc_aproc;
 class sc_module;
+class sc_lambda;
+struct sc_lambda_watch;
+class sc_profiler;
+class sc_checkpoint;
+class sc_signal_delay_base;
+
+extern void sc_lambda_notify( sc_lambda_watch* watchers );
+
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1600)
+#define SC_HAS_RVALUE_REFS
+#endif
 
 #define SC_SIGNAL_PROP_NONE      0
 #define SC_SIGNAL_PROP_ASYNC     (1U<<0)
@@ -67,17 +79,23 @@ namespace sc_bv_ns
 //
 // Base class for all types of signals.
 //
-// A signal is an entity that has three values: an old value, 
-// a present value  and a future value. When one writes 
-// to a signal, one writes to its future value; the present value will 
-// become updated when the method update() is invoked; and the 
-// old value is recorded when the method update_old() is invoked.
+// A signal is an entity that has two values: a present value and a
+// future value. When one writes to a signal, one writes to its future
+// value; the present value will become updated when the method
+// update() is invoked.  The kernel then stamps the signal with the
+// current delta cycle, and event() holds for as long as the delta
+// cycle lasts.
 //
 class sc_signal_base : public sc_object
 {
     friend class sc_aproc_process;
     friend class sc_simcontext;
     friend class sc_signal_optimize;
+    friend class sc_lambda;
+    friend class sc_profiler;
+    friend class sc_signal_pool_base;
+    friend class sc_checkpoint;
+    friend class sc_trace_file;
 
 public:
     typedef void (*UPDATE_FUNC)(sc_signal_base*);
@@ -89,7 +107,17 @@ public:
 
     // Updates the current value of the signal to its new value
     virtual void update() = 0;
-    virtual void update_old() = 0;
+
+    // Marks the compiled lambdas and the traces that read this signal
+    // for re-evaluation; the kernel calls this after every update()
+    // that changes the value.
+    void notify_watchers() const
+    {
+        if (lambda_watchers != 0)
+            sc_lambda_notify( lambda_watchers );
+        if (trace_watchers != 0)
+            sc_trace_notify( trace_watchers );
+    }
 
     static const char* kind_string;
     virtual const char* kind() const;
@@ -109,11 +137,37 @@ public:
 #if defined(__BCPLUSPLUS__)
 #pragma warn .inl
 #endif
+
+        // The signal types that can be checkpointed override this
+    virtual void checkpoint( sc_checkpoint& cp );
+
 protected:
     virtual UPDATE_FUNC* update_funcs_array() const = 0;
     UPDATE_FUNC update_func;
     unsigned prop_which; /* 0 = none, 1 = asyncs, 2 = aprocs, 3 = both */
 
+        // Whether the pending update() changes the current value; the
+        // update phase stamps only these, and sc_profiler counts toggles.
+    virtual bool value_changing() const { return true; }
+        // False if every update counts as a change, as for a type whose
+        // sc_signal_traits has no compare; the update phase then does
+        // not call value_changing().
+    bool compares;
+    bool changing() const { return ! compares || value_changing(); }
+    int prof_index;      /* see sc_profiler.h */
+    int sig_index;       /* in the simcontext's list of signals, or -1 */
+
+        // A delayed write to this signal, with a default value, for
+        // restoring a checkpoint; 0 if the type has none
+    virtual sc_signal_delay_base* new_delayed( const sc_module* proc );
+
+        // Delta cycle of the last change; see sc_simcontext::delta_stamp()
+    sc_delta_stamp changed_in_delta;
+    bool has_event() const
+    {
+        return changed_in_delta == simcontext()->delta_stamp();
+    }
+
         // Constructors
     sc_signal_base( sc_object* from, bool add_to_simcontext = true );
     sc_signal_base( const char* nm, sc_object* from, bool add_to_simcontext = true );
@@ -146,12 +200,40 @@ protected:
     mutable sc_pvector<sc_aproc_process_handle> sensitive_aprocs;
 
 private:
+    mutable sc_lambda_watch* lambda_watchers; /* see sc_lambda::compile() */
+    mutable sc_trace_watch*  trace_watchers;  /* see sc_trace_file::trace_added() */
+
         // Prevent use of copy constructor.  This constructor has no
         // implementation.
     sc_signal_base( const sc_signal_base& );
     void operator=( const sc_signal_base& );
 };
 
+#include "sc_signal_pool.h"
+#include "sc_checkpoint.h"
+
+/*---------------------------------------------------------------------------*/
+
+//
+// How sc_signal<T> handles values of T.  Specialize it for types whose
+// values are expensive to compare or to copy, e.g. large transaction
+// structs:
+//
+//   compare - write() ignores a value equal to the current one.  With 0,
+//             every write is propagated, and costs no comparison.
+//   swap    - the update exchanges the current and new values with
+//             swap() instead of copying the new value over the current
+//             one.  Worth it for types that hold their payload through
+//             a pointer and have a swap() that exchanges the pointers.
+//             The storage of the signal does not move, so read()
+//             references and traces stay valid.
+//
+template< class T >
+struct sc_signal_traits
+{
+    enum { compare = 1, swap = 0 };
+};
+
 /*---------------------------------------------------------------------------*/
 
 //
@@ -191,12 +273,22 @@ public:
     T* get_data_ptr();
     const T* get_data_ptr() const;
 
-    const T& get_new_value() const { return new_value; }
-    const T& get_old_value() const { return old_value; }
+    const T& get_new_value() const { return values.nxt(); }
         // </group>
 
     virtual sc_signal<T>& write( const T& d );
     virtual sc_signal<T>& operator=( const T& d );
+#ifdef SC_HAS_RVALUE_REFS
+        // Move the value in, rather than copying it; virtual, so that
+        // derived signals that override write( const T& ) see these too
+    virtual sc_signal<T>& write( T&& d );
+    virtual sc_signal<T>& operator=( T&& d ) { return write( std::move( d ) ); }
+#endif
+
+        // Writes `d' `delay' edges of the calling process's clock from
+        // now; only clocked thread processes may do this.  Defined in
+        // sc_signal_delay.h.
+    sc_signal<T>& write_d( const T& d, int delay );
     virtual sc_signal<T>& operator=( const sc_signal<T>& d ) { return operator=(d.read()); }
 // remove this conditional when VC++ fixes these bugs
 #if !defined(_MSC_VER) && !defined(__SUNPRO_CC)
@@ -217,15 +309,21 @@ public:
 #endif
 
     void trace( sc_trace_file* tf ) const;
+    void checkpoint( sc_checkpoint& cp );
 
 protected:
         // Updates the current value of the signal with the new value.
     virtual void update();
-    virtual void update_old();
+    virtual bool value_changing() const
+    {
+        return ! sc_signal_traits<T>::compare || !(values.nxt() == values.cur());
+    }
+        // Defined in sc_signal_delay.h
+    sc_signal_delay_base* new_delayed( const sc_module* proc );
     // The following needed for resolved signals
-    void set_cur_value(const T& nv) { cur_value = nv; }
-    void set_new_value(const T& nv) { new_value = nv; }
-    const T& get_cur_value() const { return cur_value; }
+    void set_cur_value(const T& nv) { values.cur() = nv; }
+    void set_new_value(const T& nv) { values.nxt() = nv; }
+    const T& get_cur_value() const { return values.cur(); }
 
     static void update_prop_none(sc_signal_base*);
     static void update_prop_async(sc_signal_base*);
@@ -233,10 +331,26 @@ protected:
     static void update_prop_both(sc_signal_base*);
     virtual UPDATE_FUNC* update_funcs_array() const;
 
+    void submit_write()
+    {
+        if (values.direct_writes())
+            values.mark_written();
+        else
+            submit_update();
+    }
+    void take_new_value()
+    {
+        if (sc_signal_traits<T>::swap) {
+            using std::swap;
+            swap( values.cur(), values.nxt() );
+        } else {
+            values.cur() = values.nxt();
+        }
+    }
+
 private:
-    T cur_value;
-    T new_value;
-    T old_value;
+    /* The values, or their slot in the signal pool; see sc_signal_pool.h */
+    sc_signal_values<T> values;
 };
 
 /*---------------------------------------------------------------------------*/
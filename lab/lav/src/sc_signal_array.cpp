@@ -119,17 +119,6 @@ sc_signal_array_base::update()
     }
 }
 
-void
-sc_signal_array_base::update_old()
-{
-    // See comments at the top of the file.
-    assert( false );
-
-    for (int i = _length; i >= 0; --i) {
-        indiv_signals[i]->update_old();
-    }
-}
-
 #if defined(__BCPLUSPLUS__)
 #pragma warn -8060
 #endif
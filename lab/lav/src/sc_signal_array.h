@@ -72,6 +72,9 @@ public:
     void decl_sensitive_async( sc_async_process_handle async ) const;
     void decl_sensitive_aproc( sc_aproc_process_handle aproc ) const;
     int length() const { return _length; }
+
+        // Nothing to save: the elements are signals of their own
+    void checkpoint( sc_checkpoint& ) { }
     bool event()const;
 
 protected:
@@ -81,7 +84,6 @@ protected:
     /* These should never be called - update() should be called on atomic signals only */
     virtual sc_signal_base::UPDATE_FUNC* update_funcs_array() const;
     virtual void update();
-    virtual void update_old();
 
     int _length;
     sc_signal_base** indiv_signals;
@@ -201,6 +203,12 @@ public:
     // See definition of DECL_XWRITE_D() in "sc_signal.h"
     sc_signal_array_gnu<A,T>& write( const sc_array<T>& );
     sc_signal_array_gnu<A,T>& write( const T* );
+
+        // Writes `nv' `delay' edges of the calling process's clock from
+        // now, as sc_signal<T>::write_d() does.  Defined in
+        // sc_signal_delay.h.
+    sc_signal_array_gnu<A,T>& write_d( const sc_array<T>& nv, int delay );
+    sc_signal_array_gnu<A,T>& write_d( const T* nv, int delay );
     sc_signal_array_gnu<A,T>& operator=( const sc_array<T>& nv )
     {
         return write(nv);
@@ -381,6 +389,14 @@ public:
     {
         return (sc_signal_array<A>&) sc_signal_array_gnu<A,T>::write(nv);
     }
+    sc_signal_array<A>& write_d( const sc_array<T>& nv, int delay )
+    {
+        return (sc_signal_array<A>&) sc_signal_array_gnu<A,T>::write_d(nv, delay);
+    }
+    sc_signal_array<A>& write_d( const T* nv, int delay )
+    {
+        return (sc_signal_array<A>&) sc_signal_array_gnu<A,T>::write_d(nv, delay);
+    }
     sc_signal_array<A>& operator=( const sc_array<T>& nv )
     {
         return (sc_signal_array<A>&) sc_signal_array_gnu<A,T>::write(nv);
@@ -554,6 +570,9 @@ public:
     // See definition of DECL_XWRITE_D() in "sc_signal.h"
     this_type& write( const sc_array<T>& );
     this_type& write( const T* );
+        // See sc_signal_array_gnu<A,T>::write_d()
+    this_type& write_d( const sc_array<T>&, int delay );
+    this_type& write_d( const T*, int delay );
     this_type& operator=( const sc_array<T>& );
     this_type& operator=( const this_type& v )
     {
@@ -37,16 +37,26 @@
 #ifndef SC_SIGNAL_DELAY_H
 #define SC_SIGNAL_DELAY_H
 
+#include "sc_mempool.h"
+#include "sc_signal.h"
+#include "sc_signal_array.h"
+#include "sc_clock.h"
+
 //
 // Base class for delayed assignment of signals
 //
 // sc_signal_delay_base serves as the base class for delayed assignment of
 // signals.  This is so that polymorphism can be achieved---the sc_clock_edge
 // does not have to know exactly what the signal is: the subclasses define
-// that.
+// that.  do_write() performs the write when the delay is up.
 //
 class sc_signal_delay_base {
     friend class sc_clock_edge;
+    friend class sc_checkpoint;
+
+public:
+    static void* operator new(size_t sz)            { return sc_mempool::allocate(sz); }
+    static void operator delete(void* p, size_t sz) { sc_mempool::release(p, sz); }
 
 protected:
     sc_signal_delay_base( const sc_module* p, sc_signal_base* dst )
@@ -56,7 +66,16 @@ protected:
     virtual ~sc_signal_delay_base() { }
     const sc_module* process() const { return proc; }
     sc_signal_base* destination() const { return dest; }
-    virtual bool do_xwrite() = 0;
+    virtual void do_write() = 0;
+        // Saves or restores the value to be written
+    virtual void checkpoint_value( sc_checkpoint& cp ) { cp.unsupported(); }
+        // Appends to `parts' the delayed writes to single signals that
+        // together do the same as this one; a checkpoint saves those.
+        // The parts other than this one are the caller's to delete.
+    virtual void split( sc_pvector<sc_signal_delay_base*>& parts )
+    {
+        parts.push_back( this );
+    }
 
 private:    
     sc_signal_delay_base* get_next() const { return nxt; }
@@ -65,24 +84,35 @@ private:
         // The process that caused the delayed assignment.
     const sc_module* proc;
     sc_signal_base* dest;
-        // Next assignment with the same delay
+        // Next assignment due on the same edge
     sc_signal_delay_base* nxt;
+        // Edge count of the clock edge at which the assignment is due,
+        // and submission order, which orders those past the edge's
+        // delay wheel
+    unsigned due;
+    unsigned seq;
 };
 
 template< class T > class sc_signal_delay : public sc_signal_delay_base
 {
     friend class sc_signal<T>;
+#ifdef USE_SC_SIGNAL_ARRAY_GNU_HACK
+    template< class A, class U > friend class sc_signal_array_delay_gnu;
+#else
+    template< class A > friend class sc_signal_array_delay;
+#endif
 
 private:
     sc_signal_delay( const sc_module* p, sc_signal<T>* dst, const T& nv );
     ~sc_signal_delay();
-    bool do_xwrite();
+    void do_write();
+    void checkpoint_value( sc_checkpoint& cp );
 
     T new_value;
 };
 
 
-#ifdef __GNUC__
+#ifdef USE_SC_SIGNAL_ARRAY_GNU_HACK
 
 template< class A, class T >
 class sc_signal_array_delay_gnu : public sc_signal_delay_base
@@ -100,7 +130,8 @@ private:
                                sc_signal_array_gnu<A,T>* dst );
     ~sc_signal_array_delay_gnu();
 
-    bool do_xwrite();
+    void do_write();
+    void split( sc_pvector<sc_signal_delay_base*>& parts );
     T* new_value_array;
 };
 
@@ -121,7 +152,8 @@ private:
                            const sc_array<T>& nv );
     sc_signal_array_delay( const sc_module* p, sc_signal_array<A>* dst );
     ~sc_signal_array_delay();
-    bool do_xwrite();
+    void do_write();
+    void split( sc_pvector<sc_signal_delay_base*>& parts );
 
     T* new_value_array;
 };
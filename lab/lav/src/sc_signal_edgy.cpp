@@ -191,48 +191,56 @@ sc_signal_edgy::remove_sensitive_aproc_neg( sc_aproc_process_handle aproc ) cons
 
 
 sc_signal<bool>::sc_signal()
-    : sc_signal_edgy(this)
+    : sc_signal_edgy(this), values(this, true)
 {
 #ifndef WIN32
-    sc_signal_init(&cur_value);
-    sc_signal_init(&new_value);
-    sc_signal_init(&old_value);
+    sc_signal_init(&values.cur());
+    sc_signal_init(&values.nxt());
 #else
-    cur_value &= true;
-    new_value &= true;
-    old_value &= true;
+    values.cur() &= true;
+    values.nxt() &= true;
 #endif
     update_func = &sc_signal_optimize::bool_update_prop_none;
 }
 
 
 sc_signal<bool>::sc_signal( const char* nm )
-    : sc_signal_edgy(nm, this)
+    : sc_signal_edgy(nm, this), values(this, true)
 {
 #ifndef WIN32
-    sc_signal_init(&cur_value);
-    sc_signal_init(&new_value);
-    sc_signal_init(&old_value);
+    sc_signal_init(&values.cur());
+    sc_signal_init(&values.nxt());
 #else
-    cur_value &= true;
-    new_value &= true;
-    old_value &= true;
+    values.cur() &= true;
+    values.nxt() &= true;
+#endif
+    update_func = &sc_signal_optimize::bool_update_prop_none;
+}
+
+
+sc_signal<bool>::sc_signal( const char* nm, bool poolable )
+    : sc_signal_edgy(nm, this), values(this, poolable)
+{
+#ifndef WIN32
+    sc_signal_init(&values.cur());
+    sc_signal_init(&values.nxt());
+#else
+    values.cur() &= true;
+    values.nxt() &= true;
 #endif
     update_func = &sc_signal_optimize::bool_update_prop_none;
 }
 
 
 sc_signal<bool>::sc_signal( sc_object* created_by )
-    : sc_signal_edgy( created_by )
+    : sc_signal_edgy( created_by ), values(this, true)
 {
 #ifndef WIN32
-    sc_signal_init(&cur_value);
-    sc_signal_init(&new_value);
-    sc_signal_init(&old_value);
+    sc_signal_init(&values.cur());
+    sc_signal_init(&values.nxt());
 #else
-    cur_value &= true;
-    new_value &= true;
-    old_value &= true;
+    values.cur() &= true;
+    values.nxt() &= true;
 #endif
     update_func = &sc_signal_optimize::bool_update_prop_none;
 }
@@ -242,7 +250,7 @@ sc_signal<bool>::sc_signal( sc_object* created_by )
 bool
 sc_signal<bool>::edgy_read() const
 {
-    return cur_value;
+    return values.cur();
 }
 
 
@@ -298,50 +306,43 @@ sc_signal<sc_bit>::write( bool d )
 
 
 bool
-sc_signal<sc_bit>::event() const
+sc_signal<sc_bit>::value_changing() const
 {
-    bool cv, ov;
-    if (cur_value.is_bitref()) {
-        cv = sc_bvrep_test_wb((const sc_bvrep*) cur_value.rep,
-                              0, cur_value.val_or_index);
-        ov = sc_bvrep_test_wb((const sc_bvrep*) old_value.rep,
+    bool nv;
+    if (cur_value.is_bitref())
+        nv = sc_bvrep_test_wb((const sc_bvrep*) new_value.rep,
                               0, cur_value.val_or_index);
-        return (cv != ov);
-    } else {
-        return (cur_value.val_or_index != old_value.value);
-    }
+    else
+        nv = (new_value.value != 0);
+    return nv != read();
+}
+
+
+bool
+sc_signal<sc_bit>::event() const
+{
+    return has_event();
 }
 
 
 bool
 sc_signal<sc_bit>::posedge() const
 {
-    bool cv, ov;
-    if (cur_value.is_bitref()) {
-        cv = sc_bvrep_test_wb((const sc_bvrep*) cur_value.rep,
-                              0, cur_value.val_or_index);
-        ov = sc_bvrep_test_wb((const sc_bvrep*) old_value.rep,
-                              0, cur_value.val_or_index);
-        return (cv && !ov);
-    } else {
-        return (cur_value.val_or_index && !old_value.value);
-    }
+    return (has_event() && read());
 }
 
 
 bool
 sc_signal<sc_bit>::negedge() const
 {
-    bool cv, ov;
-    if (cur_value.is_bitref()) {
-        cv = sc_bvrep_test_wb((const sc_bvrep*) cur_value.rep,
-                              0, cur_value.val_or_index);
-        ov = sc_bvrep_test_wb((const sc_bvrep*) old_value.rep,
-                              0, cur_value.val_or_index);
-        return (!cv && ov);
-    } else {
-        return (!cur_value.val_or_index && old_value.value);
-    }
+    return (has_event() && ! read());
+}
+
+
+bool
+sc_signal<sc_bit>::get_old_value() const
+{
+    return (has_event() ? ! read() : read());
 }
 
 
@@ -355,22 +356,19 @@ sc_signal<sc_bit>::print(ostream& os) const
 void
 sc_signal<sc_bit>::dump(ostream& os) const
 {
-    bool cv, ov, nv;
+    bool cv, nv;
     if (cur_value.is_bitref()) {
         cv = sc_bvrep_test_wb((const sc_bvrep*) cur_value.rep,
                               0, cur_value.val_or_index);
-        ov = sc_bvrep_test_wb((const sc_bvrep*) old_value.rep,
-                              0, cur_value.val_or_index);
         nv = sc_bvrep_test_wb((const sc_bvrep*) new_value.rep,
                               0, cur_value.val_or_index);
     } else {
         cv = cur_value.val_or_index;
-        ov = old_value.value;
         nv = new_value.value;
     }
     sc_signal_base::dump(os);
     os << "value = " << cv << endl;
-    os << "old value = " << ov << endl;
+    os << "old value = " << get_old_value() << endl;
     os << "new value = " << nv << endl;
 }
 
@@ -402,26 +400,10 @@ sc_signal<sc_bit>::update()
 }
 
 
-void
-sc_signal<sc_bit>::update_old()
-{
-    bool cv;
-    if (cur_value.is_bitref()) {
-        cv = sc_bvrep_test_wb((const sc_bvrep*) cur_value.rep,
-                              0, cur_value.val_or_index);
-        sc_bvrep_set_wb((sc_bvrep*) old_value.rep,
-                        0, cur_value.val_or_index, cv);
-    } else {
-        old_value.value = cur_value.val_or_index;
-    }
-}
-
-
 sc_signal<sc_bit>::sc_signal()
     : sc_signal_edgy( this )
 {
     new_value.value &= 1;
-    old_value.value &= 1;
     update_func = &sc_signal_optimize::sc_bit_update_prop_none;
     prop_which = SC_SIGNAL_PROP_NONE;
 }
@@ -431,7 +413,6 @@ sc_signal<sc_bit>::sc_signal( const char* nm )
     : sc_signal_edgy( nm, this )
 {
     new_value.value &= 1;
-    old_value.value &= 1;
     update_func = &sc_signal_optimize::sc_bit_update_prop_none;
     prop_which = SC_SIGNAL_PROP_NONE;
 }
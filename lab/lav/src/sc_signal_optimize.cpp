@@ -303,8 +303,8 @@ void
 sc_signal_optimize::bool_update_prop_none(sc_signal_base* me)
 {
     sc_signal<bool>* Tme = static_cast<sc_signal<bool>*>(me);
-    bool nv = Tme->new_value;
-    Tme->cur_value = nv;
+    bool nv = Tme->values.nxt();
+    Tme->values.cur() = nv;
     /* No need to propagate */
 }
 
@@ -315,8 +315,8 @@ void
 sc_signal_optimize::bool_update_prop_async(sc_signal_base* me)
 {
     sc_signal<bool>* Tme = static_cast<sc_signal<bool>*>(me);
-    bool nv = Tme->new_value;
-    Tme->cur_value = nv;
+    bool nv = Tme->values.nxt();
+    Tme->values.cur() = nv;
     if (nv) {
         Tme->prop_asyncs_only();
     } /* no need to prop on negedge */
@@ -328,8 +328,8 @@ void
 sc_signal_optimize::bool_update_prop_aproc(sc_signal_base* me)
 {
     sc_signal<bool>* Tme = static_cast<sc_signal<bool>*>(me);
-    bool nv = Tme->new_value;
-    Tme->cur_value = nv;
+    bool nv = Tme->values.nxt();
+    Tme->values.cur() = nv;
     if (nv) {
         Tme->prop_aprocs_only();
     } /* no need to prop on negedge */
@@ -341,8 +341,8 @@ void
 sc_signal_optimize::bool_update_prop_both(sc_signal_base* me)
 {
     sc_signal<bool>* Tme = static_cast<sc_signal<bool>*>(me);
-    bool nv = Tme->new_value;
-    Tme->cur_value = nv;
+    bool nv = Tme->values.nxt();
+    Tme->values.cur() = nv;
     if (nv) {
         Tme->prop_asyncs_aprocs();
     } /* no need to prop on negedge */
@@ -354,8 +354,8 @@ void
 sc_signal_optimize::bool_update_prop_async_neg(sc_signal_base* me)
 {
     sc_signal<bool>* Tme = static_cast<sc_signal<bool>*>(me);
-    bool nv = Tme->new_value;
-    Tme->cur_value = nv;
+    bool nv = Tme->values.nxt();
+    Tme->values.cur() = nv;
     if (!nv) {
         Tme->prop_asyncs_only_neg();
     } /* no need to prop on posedge */
@@ -367,8 +367,8 @@ void
 sc_signal_optimize::bool_update_prop_async_neg_async(sc_signal_base* me)
 {
     sc_signal<bool>* Tme = static_cast<sc_signal<bool>*>(me);
-    bool nv = Tme->new_value;
-    Tme->cur_value = nv;
+    bool nv = Tme->values.nxt();
+    Tme->values.cur() = nv;
     if (nv) {
         Tme->prop_asyncs_only();
     } else {
@@ -382,8 +382,8 @@ void
 sc_signal_optimize::bool_update_prop_async_neg_aproc(sc_signal_base* me)
 {
     sc_signal<bool>* Tme = static_cast<sc_signal<bool>*>(me);
-    bool nv = Tme->new_value;
-    Tme->cur_value = nv;
+    bool nv = Tme->values.nxt();
+    Tme->values.cur() = nv;
     if (nv) {
         Tme->prop_aprocs_only();
     } else {
@@ -397,8 +397,8 @@ void
 sc_signal_optimize::bool_update_prop_async_neg_both(sc_signal_base* me)
 {
     sc_signal<bool>* Tme = static_cast<sc_signal<bool>*>(me);
-    bool nv = Tme->new_value;
-    Tme->cur_value = nv;
+    bool nv = Tme->values.nxt();
+    Tme->values.cur() = nv;
     if (nv) {
         Tme->prop_asyncs_aprocs();
     } else {
@@ -412,8 +412,8 @@ void
 sc_signal_optimize::bool_update_prop_aproc_neg(sc_signal_base* me)
 {
     sc_signal<bool>* Tme = static_cast<sc_signal<bool>*>(me);
-    bool nv = Tme->new_value;
-    Tme->cur_value = nv;
+    bool nv = Tme->values.nxt();
+    Tme->values.cur() = nv;
     if (!nv) {
         Tme->prop_aprocs_only_neg();
     } /* no need to prop on posedge */
@@ -425,8 +425,8 @@ void
 sc_signal_optimize::bool_update_prop_aproc_neg_async(sc_signal_base* me)
 {
     sc_signal<bool>* Tme = static_cast<sc_signal<bool>*>(me);
-    bool nv = Tme->new_value;
-    Tme->cur_value = nv;
+    bool nv = Tme->values.nxt();
+    Tme->values.cur() = nv;
     if (nv) {
         Tme->prop_asyncs_only();
     } else {
@@ -440,8 +440,8 @@ void
 sc_signal_optimize::bool_update_prop_aproc_neg_aproc(sc_signal_base* me)
 {
     sc_signal<bool>* Tme = static_cast<sc_signal<bool>*>(me);
-    bool nv = Tme->new_value;
-    Tme->cur_value = nv;
+    bool nv = Tme->values.nxt();
+    Tme->values.cur() = nv;
     if (nv) {
         Tme->prop_aprocs_only();
     } else {
@@ -455,8 +455,8 @@ void
 sc_signal_optimize::bool_update_prop_aproc_neg_both(sc_signal_base* me)
 {
     sc_signal<bool>* Tme = static_cast<sc_signal<bool>*>(me);
-    bool nv = Tme->new_value;
-    Tme->cur_value = nv;
+    bool nv = Tme->values.nxt();
+    Tme->values.cur() = nv;
     if (nv) {
         Tme->prop_asyncs_aprocs();
     } else {
@@ -470,8 +470,8 @@ void
 sc_signal_optimize::bool_update_prop_both_neg(sc_signal_base* me)
 {
     sc_signal<bool>* Tme = static_cast<sc_signal<bool>*>(me);
-    bool nv = Tme->new_value;
-    Tme->cur_value = nv;
+    bool nv = Tme->values.nxt();
+    Tme->values.cur() = nv;
     if (!nv) {
         Tme->prop_asyncs_aprocs_neg();
     } /* no need to prop on posedge */
@@ -483,8 +483,8 @@ void
 sc_signal_optimize::bool_update_prop_both_neg_async(sc_signal_base* me)
 {
     sc_signal<bool>* Tme = static_cast<sc_signal<bool>*>(me);
-    bool nv = Tme->new_value;
-    Tme->cur_value = nv;
+    bool nv = Tme->values.nxt();
+    Tme->values.cur() = nv;
     if (nv) {
         Tme->prop_asyncs_only();
     } else {
@@ -498,8 +498,8 @@ void
 sc_signal_optimize::bool_update_prop_both_neg_aproc(sc_signal_base* me)
 {
     sc_signal<bool>* Tme = static_cast<sc_signal<bool>*>(me);
-    bool nv = Tme->new_value;
-    Tme->cur_value = nv;
+    bool nv = Tme->values.nxt();
+    Tme->values.cur() = nv;
     if (nv) {
         Tme->prop_aprocs_only();
     } else {
@@ -513,8 +513,8 @@ void
 sc_signal_optimize::bool_update_prop_both_neg_both(sc_signal_base* me)
 {
     sc_signal<bool>* Tme = static_cast<sc_signal<bool>*>(me);
-    bool nv = Tme->new_value;
-    Tme->cur_value = nv;
+    bool nv = Tme->values.nxt();
+    Tme->values.cur() = nv;
     if (nv) {
         Tme->prop_asyncs_aprocs();
     } else {
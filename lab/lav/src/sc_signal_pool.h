@@ -0,0 +1,366 @@
+/******************************************************************************
+    Copyright (c) 1996-2000 Synopsys, Inc.    ALL RIGHTS RESERVED
+
+  The contents of this file are subject to the restrictions and limitations
+  set forth in the SystemC(TM) Open Community License Software Download and
+  Use License Version 1.1 (the "License"); you may not use this file except
+  in compliance with such restrictions and limitations. You may obtain
+  instructions on how to receive a copy of the License at
+  http://www.systemc.org/. Software distributed by Original Contributor
+  under the License is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+  ANY KIND, either express or implied. See the License for the specific
+  language governing rights and limitations under the License.
+
+******************************************************************************/
+
+/******************************************************************************
+
+    sc_signal_pool.h -- contiguous value store for signals of plain types.
+
+******************************************************************************/
+
+/******************************************************************************
+
+    MODIFICATION LOG - modifiers, enter your name, affliation and
+    changes you are making here:
+
+    Modifier Name & Affiliation:
+    Description of Modification:
+
+
+******************************************************************************/
+
+/* Included by sc_signal.h, after the definition of sc_signal_base. */
+
+#ifndef SC_SIGNAL_POOL_H
+#define SC_SIGNAL_POOL_H
+
+#include <new>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+template<int W> class sc_int;
+template<int W> class sc_uint;
+template<class T> class sc_signal;
+
+//
+//  <summary> Types whose signals may be pooled </summary>
+//
+//  Only types that are cheap to copy and compare qualify, since the
+//  update phase copies and compares whole runs of them at a time.
+//
+template<class T> struct sc_signal_poolable { enum { value = 0 }; };
+
+template<> struct sc_signal_poolable<bool>           { enum { value = 1 }; };
+template<> struct sc_signal_poolable<char>           { enum { value = 1 }; };
+template<> struct sc_signal_poolable<signed char>    { enum { value = 1 }; };
+template<> struct sc_signal_poolable<unsigned char>  { enum { value = 1 }; };
+template<> struct sc_signal_poolable<short>          { enum { value = 1 }; };
+template<> struct sc_signal_poolable<unsigned short> { enum { value = 1 }; };
+template<> struct sc_signal_poolable<int>            { enum { value = 1 }; };
+template<> struct sc_signal_poolable<long>           { enum { value = 1 }; };
+template<> struct sc_signal_poolable<unsigned long>  { enum { value = 1 }; };
+template<> struct sc_signal_poolable<float>          { enum { value = 1 }; };
+template<> struct sc_signal_poolable<double>         { enum { value = 1 }; };
+template<int W> struct sc_signal_poolable< sc_int<W> >  { enum { value = 1 }; };
+template<int W> struct sc_signal_poolable< sc_uint<W> > { enum { value = 1 }; };
+
+    // Index of the lowest bit set in x, which must not be 0
+inline int
+sc_lowest_bit( unsigned x )
+{
+#if defined(__GNUC__)
+    return __builtin_ctz( x );
+#elif defined(_MSC_VER)
+    unsigned long i;
+    _BitScanForward( &i, x );
+    return (int) i;
+#else
+    int i = 0;
+    while (! (x & 1)) {
+        x >>= 1;
+        ++i;
+    }
+    return i;
+#endif
+}
+
+//
+//  <summary> Contiguous value store for signals </summary>
+//
+//  When sc_simcontext::set_signal_pool() is on, each signal of a
+//  poolable type T keeps its current and new values in the
+//  sc_signal_pool<T> of the simulation context rather than in the
+//  signal object.  The values of all signals of T are then held in a
+//  few contiguous arrays.
+//
+//  The pool also keeps a bitmap of the signals that have been written.
+//  An sc_async or sc_aproc that writes a pooled signal only sets its
+//  bit, and does not put the signal on the update queue.  The update
+//  phase then goes over the written words of the bitmap.  For each
+//  word it compares and copies a block of 32 values in one go, and
+//  only the signals whose value changed are stamped and propagated.
+//
+//  Writes from sc_sync processes go through the update queue as
+//  usual, since the clock edge decides when they take effect.  Writes
+//  made while sc_asyncs run in parallel also use the queue, because
+//  the bitmap is not thread-safe.  Clocks are never pooled.
+//
+class sc_signal_pool_base {
+    friend class sc_simcontext;
+
+public:
+        // `key' tells the pools of different types apart
+    sc_signal_pool_base( sc_simcontext* simc, const void* key );
+    virtual ~sc_signal_pool_base();
+
+        // Whether a write may set the bitmap now, rather than going
+        // through the update queue
+    bool direct_writes() const
+    {
+        return (simc->curr_proc_info.kind != SC_CURR_PROC_SYNC &&
+                ! simc->async_pool_running);
+    }
+
+protected:
+    void set_pending()
+    {
+        pending = true;
+        simc->pool_writes_pending = true;
+    }
+
+        // Update phase for the signals written since the last one; the
+        // ones that change are stamped with `stamp'.
+    virtual void update( sc_delta_stamp stamp ) = 0;
+
+    static void changed( sc_signal_base* sig, sc_delta_stamp stamp )
+    {
+        sig->changed_in_delta = stamp;
+        if (sig->prop_which != SC_SIGNAL_PROP_NONE)
+            (*sig->update_func)( sig );
+        sig->notify_watchers();
+    }
+
+    sc_profiler* profiler() const { return simc->profiler; }
+
+        // The pool of `simc' with `key', or 0
+    static sc_signal_pool_base* find( sc_simcontext* simc, const void* key );
+
+    sc_simcontext* simc;
+    const void*    key;
+    bool           pending;
+};
+
+template<class T>
+class sc_signal_pool : public sc_signal_pool_base {
+public:
+        // Gives `sig' a slot, or returns 0 if signals of T are not
+        // being pooled
+    static sc_signal_pool<T>* attach( sc_signal<T>* sig, int& slot );
+    void detach( int slot );
+
+    T& cur( int slot ) { return chunks[slot >> CHUNK_SHIFT]->cur[slot & CHUNK_MASK]; }
+    T& nxt( int slot ) { return chunks[slot >> CHUNK_SHIFT]->nxt[slot & CHUNK_MASK]; }
+
+    void mark_written( int slot )
+    {
+        chunk* c = chunks[slot >> CHUNK_SHIFT];
+        int i = slot & CHUNK_MASK;
+        c->written[i >> 5] |= 1U << (i & 31);
+        c->written_words |= 1U << (i >> 5);
+        if (! pending)
+            set_pending();
+    }
+
+protected:
+    void update( sc_delta_stamp stamp );
+
+private:
+    enum { CHUNK_SHIFT = 10,
+           CHUNK_SIZE  = 1 << CHUNK_SHIFT,
+           CHUNK_MASK  = CHUNK_SIZE - 1,
+           CHUNK_WORDS = CHUNK_SIZE / 32 };
+
+    struct chunk {
+        T               cur[CHUNK_SIZE];
+        T               nxt[CHUNK_SIZE];
+        unsigned        written[CHUNK_WORDS];
+        unsigned        written_words;      /* one bit per word of written */
+        sc_signal_base* owner[CHUNK_SIZE];
+    };
+
+    sc_signal_pool( sc_simcontext* simc ) : sc_signal_pool_base( simc, &key_tag ), num_slots( 0 ) { }
+    ~sc_signal_pool();
+
+    sc_pvector<chunk*> chunks;
+    int                num_slots;
+
+    static const char  key_tag;     /* its address is the key of T */
+};
+
+template<class T>
+const char sc_signal_pool<T>::key_tag = 0;
+
+//
+//  <summary> Where a signal keeps its current and new values </summary>
+//
+//  A signal of a type that cannot be pooled holds its two values.  A
+//  signal of a poolable type holds either its two values, or its slot
+//  in the pool of its type, in the same space; its pool pointer tells
+//  which.
+//
+template<class T, int poolable = sc_signal_poolable<T>::value>
+class sc_signal_values {
+public:
+    sc_signal_values( sc_signal<T>*, bool ) : cur_value(), new_value() { }
+
+    T& cur() { return cur_value; }
+    const T& cur() const { return cur_value; }
+    T& nxt() { return new_value; }
+    const T& nxt() const { return new_value; }
+
+    bool direct_writes() const { return false; }
+    void mark_written() { }
+
+private:
+    T cur_value;
+    T new_value;
+};
+
+template<class T>
+class sc_signal_values<T,1> {
+public:
+        // Takes a slot in the pool of T for `sig' if `use_pool' and
+        // pooling is on
+    sc_signal_values( sc_signal<T>* sig, bool use_pool )
+    {
+        int slot = -1;
+        pool = use_pool ? sc_signal_pool<T>::attach( sig, slot ) : 0;
+        if (pool != 0) {
+            u.slot = slot;
+        } else {
+            new (own() + 0) T();
+            new (own() + 1) T();
+        }
+    }
+    ~sc_signal_values()
+    {
+        if (pool != 0) {
+            pool->detach( u.slot );
+        } else {
+            own()[0].~T();
+            own()[1].~T();
+        }
+    }
+
+    T& cur() { return pool ? pool->cur( u.slot ) : own()[0]; }
+    const T& cur() const { return pool ? pool->cur( u.slot ) : own()[0]; }
+    T& nxt() { return pool ? pool->nxt( u.slot ) : own()[1]; }
+    const T& nxt() const { return pool ? pool->nxt( u.slot ) : own()[1]; }
+
+        // See sc_signal_pool_base::direct_writes()
+    bool direct_writes() const { return pool != 0 && pool->direct_writes(); }
+    void mark_written() { pool->mark_written( u.slot ); }
+
+private:
+    T* own() const { return (T*) u.own; }
+
+    sc_signal_pool<T>* pool;
+    union {
+        int    slot;
+        double align;
+        char   own[2 * sizeof(T)];
+    } u;
+};
+
+template<class T>
+sc_signal_pool<T>*
+sc_signal_pool<T>::attach( sc_signal<T>* sig, int& slot )
+{
+    slot = -1;
+    if (! sc_signal_poolable<T>::value)
+        return 0;
+    sc_simcontext* simc = sig->simcontext();
+    if (! simc->signal_pool_enabled())
+        return 0;
+    /* The simulation context owns its pools, one for each type */
+    sc_signal_pool<T>* pool = (sc_signal_pool<T>*) find( simc, &key_tag );
+    if (pool == 0)
+        pool = new sc_signal_pool<T>( simc );
+
+    if ((pool->num_slots & CHUNK_MASK) == 0) {
+        chunk* c = new chunk;
+        for (int i = 0; i < CHUNK_SIZE; ++i) {
+            c->cur[i] = T();
+            c->nxt[i] = T();
+            c->owner[i] = 0;
+        }
+        for (int w = 0; w < CHUNK_WORDS; ++w)
+            c->written[w] = 0;
+        c->written_words = 0;
+        pool->chunks.push_back( c );
+    }
+    slot = pool->num_slots++;
+    pool->chunks[slot >> CHUNK_SHIFT]->owner[slot & CHUNK_MASK] = sig;
+    return pool;
+}
+
+/* Slots are not reused; signals are seldom destroyed before the end. */
+template<class T>
+void
+sc_signal_pool<T>::detach( int slot )
+{
+    chunk* c = chunks[slot >> CHUNK_SHIFT];
+    int i = slot & CHUNK_MASK;
+    c->written[i >> 5] &= ~(1U << (i & 31));
+    c->owner[i] = 0;
+}
+
+template<class T>
+sc_signal_pool<T>::~sc_signal_pool()
+{
+    for (int i = 0; i < chunks.size(); ++i)
+        delete chunks[i];
+}
+
+template<class T>
+void
+sc_signal_pool<T>::update( sc_delta_stamp stamp )
+{
+    pending = false;
+    for (int ci = 0; ci < chunks.size(); ++ci) {
+        chunk* const c = chunks[ci];
+        unsigned words = c->written_words;
+        c->written_words = 0;
+        while (words != 0) {
+            int w = sc_lowest_bit( words );
+            words &= words - 1;
+            unsigned bits = c->written[w];
+            c->written[w] = 0;
+
+            /* Straight-line compare and copy of the whole block, which
+               the compiler can vectorize */
+            T* const cur = c->cur + (w << 5);
+            const T* const nxt = c->nxt + (w << 5);
+            unsigned changes = 0;
+            int k;
+            for (k = 0; k < 32; ++k)
+                changes |= (unsigned) (! (cur[k] == nxt[k])) << k;
+            changes &= bits;
+            for (k = 0; k < 32; ++k)
+                cur[k] = ((changes >> k) & 1) ? nxt[k] : cur[k];
+
+            sc_signal_base* const* const owner = c->owner + (w << 5);
+            if (profiler() != 0)
+                profiler()->pooled_signals_updated( owner, bits, changes );
+            while (changes != 0) {
+                k = sc_lowest_bit( changes );
+                changes &= changes - 1;
+                changed( owner[k], stamp );
+            }
+        }
+    }
+}
+
+#endif
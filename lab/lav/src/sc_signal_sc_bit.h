@@ -58,10 +58,7 @@ public:
         return (cur_value.is_bitref() ? new_value.value : 
                 sc_bvrep_test_wb((const sc_bvrep*) new_value.rep, 0, cur_value.val_or_index));
     }
-    bool get_old_value()   {
-        return (cur_value.is_bitref() ? old_value.value :
-                sc_bvrep_test_wb((const sc_bvrep*) old_value.rep, 0, cur_value.val_or_index));
-    }
+    bool get_old_value() const;
     sc_signal<sc_bit>& write( bool d );
     sc_signal<sc_bit>& operator=( bool d )  { return write(d); }
     sc_signal<sc_bit>& operator=( const sc_signal<sc_bit>& d ) { return write(d); }
@@ -75,9 +72,8 @@ public:
 protected:
     virtual sc_signal_base::UPDATE_FUNC* update_funcs_array() const;
     void update();
-    void update_old();
+    virtual bool value_changing() const;
     void set_cur_value(bool v);
-    void set_old_value(bool v);
     sc_bit& get_cur_value() { return cur_value; }
     bool edgy_read() const;
 
@@ -87,6 +83,6 @@ private:
     union ptr_or_unsigned {
         void*    rep;
         unsigned value;
-    } new_value, old_value;
+    } new_value;
 };
 #endif
@@ -36,6 +36,7 @@
 
 #include <stdlib.h>
 #include <limits.h>
+#include <string.h>
 #ifndef _MSC_VER
 #include <iostream>
 using std::ostream;
@@ -61,6 +62,7 @@ using std::hex;
 #endif
 
 #include "sc_pq.h"
+#include "sc_edge_calendar.h"
 #include "sc_hash.h"
 #include "sc_simcontext.h"
 
@@ -165,10 +167,11 @@ next_edge_compare( const void* ve1, const void* ve2 )
     const sc_clock_edge* e1 = (const sc_clock_edge*) ve1;
     const sc_clock_edge* e2 = (const sc_clock_edge*) ve2;
 
-    double diff = e2->next_edge() - e1->next_edge();
-    if (diff < 0) {
+    sc_ticks t1 = e1->next_edge_ticks();
+    sc_ticks t2 = e2->next_edge_ticks();
+    if (t2 < t1) {
         return -1;
-    } else if (diff > 0) {
+    } else if (t2 > t1) {
         return 1;
     } else {
         return (e2->id() - e1->id());
@@ -212,10 +215,15 @@ sc_simcontext::sc_simcontext()
     port_manager = new sc_port_manager( this );
 
     prioq = 0;
-    curr_time = 0.0;
+    calendar = 0;
+    upcoming_edges = 0;
+    curr_time = 0;
     curr_edge = 0;
     forced_stop = false;
 
+    curr_proc_info.process_handle = 0;
+    curr_proc_info.kind           = SC_CURR_PROC_NONE;
+
     update_array0_alloc = 64;
     signals_to_update_arrays[0] = new sc_signal_base*[update_array0_alloc];
     signals_to_update_arrays[1] = 0;
@@ -236,16 +244,33 @@ sc_simcontext::sc_simcontext()
     total_number_of_signals = 0;
     total_number_of_asyncs = 0;
     total_number_of_aprocs = 0;
+    total_number_of_co_aprocs = 0;
 
     aa_process_table = new sc_async_aproc_process_table;
     error_occurred = false;
+
+    num_async_threads = 1;
+    async_pool = 0;
+    async_pool_running = false;
+    static_schedule = false;
+    profiler = 0;
+    elaboration_report = false;
+    curr_delta = 1;     /* signals start out stamped 0 */
+    use_signal_pool = false;
+    pool_writes_pending = false;
 }
 
 sc_simcontext::~sc_simcontext()
 {
+    delete profiler;
+    delete async_pool;
+    for (int i = 0; i < signal_pools.size(); ++i)
+        delete signal_pools[i];
     delete aa_process_table;
 
+    delete calendar;
     delete prioq;
+    delete[] upcoming_edges;
     for (int i = 0; i < trace_files.size(); ++i)
         delete trace_files[i];
 
@@ -266,11 +291,13 @@ sc_simcontext::~sc_simcontext()
 }
 
 void
-sc_simcontext::initialize()
+sc_simcontext::initialize( bool crunch )
 {
     if (! ready_to_simulate) {
 
+        double t_start = sc_profiler_clock();
         port_manager->resolve_all_ports();
+        double t_resolved = sc_profiler_clock();
         watching_fn = watching_during_simulation;
 
         /* signals_to_update_arrays[0] already initialized */
@@ -279,10 +306,9 @@ sc_simcontext::initialize()
 
         assert( signals_to_update == signals_to_update_arrays[0] );
 
-        sc_plist<sc_clock_edge*>::iterator it(clock_edge_list);
         int clock_edge_count = 0;
-        while (! it.empty()) {
-            sc_clock_edge* edge_tmp = *it;
+        while (clock_edge_count < clock_edge_list.size()) {
+            sc_clock_edge* edge_tmp = clock_edge_list[clock_edge_count];
             sc_clock_helpers::prepare_for_simulation(edge_tmp,
                                                      total_number_of_signals);
             // There's something weird about the sparc.  Even though
@@ -294,7 +320,6 @@ sc_simcontext::initialize()
             // This is due to instruction cache misses, I believe.  Not much
             // we can do about it.
             sc_signal_optimize::optimize_clock(&(edge_tmp->clock()));
-            it++;
             clock_edge_count++;
         }
 
@@ -307,6 +332,10 @@ sc_simcontext::initialize()
         lastof_clock_edges_to_advance = -1;
 
         asyncs_to_execute = new sc_async_process_handle[total_number_of_asyncs];
+        if (num_async_threads > 1) {
+            async_pool = new sc_async_pool( num_async_threads,
+                                            total_number_of_signals );
+        }
 
         /* one extra for the sentinel */
         aprocs_to_execute = new sc_aproc_process_handle[total_number_of_aprocs + 1];
@@ -320,16 +349,42 @@ sc_simcontext::initialize()
         next_aproc_index = 0;
         ready_to_simulate = true;
 
+        if (profiler != 0)
+            prepare_profiler();
+
         lastof_signals_to_update = total_number_of_signals - 1;
+        analyze_static_schedule();
 
         lastof_asyncs_to_execute = -1;
         lastof_aprocs_to_execute = -1;
 
-        initial_crunch();
-        /* The first call the trace_cycle simply dumps the current value.
-           We need the initial cycle too! */
-	trace_cycle( /* is not delta cycle */ false );
+        double t_prepared = sc_profiler_clock();
+        if (crunch) {
+            initial_crunch();
+            /* The first call the trace_cycle simply dumps the current value.
+               We need the initial cycle too! */
+            trace_cycle( /* is not delta cycle */ false );
+        } else {
+            for (int i = lastof_signals_to_update; i >= 0; --i)
+                signals_to_update[i]->set_submitted( false );
+            if (pool_writes_pending)
+                update_signal_pools( 0 );
+        }
         lastof_signals_to_update = -1;
+
+        if (elaboration_report) {
+            double t_done = sc_profiler_clock();
+            cout << "SystemC Info: elaboration of " << total_number_of_signals
+                 << " signals, " << total_number_of_asyncs << " asyncs, "
+                 << total_number_of_aprocs << " aprocs took "
+                 << (t_done - t_start) << " s" << endl
+                 << "    resolve_all_ports       " << (t_resolved - t_start)
+                 << " s" << endl
+                 << "    prepare_for_simulation  " << (t_prepared - t_resolved)
+                 << " s" << endl
+                 << "    initial_crunch          " << (t_done - t_prepared)
+                 << " s" << endl;
+        }
     
 #ifdef WIN32
         if (NULL == ConvertThreadToFiber(NULL)) {
@@ -348,14 +403,13 @@ sc_simcontext::initialize()
 void
 sc_simcontext::reset()
 {
+    delete calendar;
+    calendar = 0;
     delete prioq;
     prioq = 0;
-    curr_time = 0.0;
-    sc_plist<sc_clock_edge*>::iterator it(clock_edge_list);
-    while (! it.empty()) {
-        (*it)->reset();
-        it++;
-    }
+    curr_time = 0;
+    for (int i = 0; i < clock_edge_list.size(); ++i)
+        clock_edge_list[i]->reset();
 }
 
 void
@@ -367,13 +421,16 @@ sc_simcontext::initial_crunch()
         lastof_aprocs_to_execute = -1;
         for (i = lastof_signals_to_update; i >= 0; --i) {
             sc_signal_base* sig = signals_to_update[i];
+            const bool changing = sig->changing();
             sig->update();
-            /* Make sure we don't generate spurious events
-               to trigger edge-sensitive processes, by
-               prematurely updating the old value too. */
-            sig->update_old();
+            if (changing)
+                sig->notify_watchers();
+            /* The signal is not stamped with curr_delta, so that
+               edge-sensitive processes see no spurious events. */
             sig->set_submitted( false );
         }
+        if (pool_writes_pending)
+            update_signal_pools( 0 );
 
         lastof_signals_to_update = -1;
         lastof_clock_edges_to_advance = -1;
@@ -392,24 +449,185 @@ sc_simcontext::initial_crunch()
         (void) reset_curr_proc();
 
         /* No more signals to update, quit */
-        if (lastof_signals_to_update == -1)
+        if (lastof_signals_to_update == -1 && ! pool_writes_pending)
             break;
     }
     lastof_clock_edges_to_advance = -1;
 }
 
+/* The network is statically schedulable if the processes can only be
+   triggered by clock transitions: no aprocs, no syncs, and no signal
+   other than a clock has sensitive processes.  The signals written by
+   the asyncs then never trigger anything, and each clock transition
+   takes exactly one evaluation phase followed by one update phase.
+   Must be called while signals_to_update still holds every signal. */
+void
+sc_simcontext::analyze_static_schedule()
+{
+    static_schedule = false;
+    if (total_number_of_aprocs > 0 || total_number_of_asyncs == 0)
+        return;
+
+    for (int e = 0; e < clock_edge_list.size(); ++e) {
+        if (sc_clock_helpers::number_of_syncs(clock_edge_list[e]) > 0)
+            return;
+    }
+
+    for (int i = 0; i < total_number_of_signals; ++i) {
+        sc_signal_base* sig = signals_to_update[i];
+        if (sig->prop_which == SC_SIGNAL_PROP_NONE)
+            continue;
+        if (strcmp(sig->kind(), sc_clock::kind_string) != 0)
+            return;
+    }
+    static_schedule = true;
+}
+
+/* Straight-line evaluation of one time step of a statically schedulable
+   network.  The clock's sensitivity list for the edge just taken is the
+   schedule: its asyncs are run in list order, which is the order the
+   general loop runs them in, without going through asyncs_to_execute.
+   The signals they write are then updated in a single pass.
+
+   Returns false, having done nothing, unless exactly one clock
+   transition (and possibly some data signals written from outside the
+   simulation) is pending; crunch_delta_cycles() handles the rest. */
+bool
+sc_simcontext::crunch_static()
+{
+    int i;
+    sc_signal_base* const* old_signals_to_update = signals_to_update;
+    int old_lastof_signals_to_update = lastof_signals_to_update;
+    sc_clock* clk = 0;
+
+    if (lastof_clock_edges_async >= 0)
+        return false;
+    for (i = old_lastof_signals_to_update; i >= 0; --i) {
+        sc_signal_base* const sig = old_signals_to_update[i];
+        if (sig->prop_which != SC_SIGNAL_PROP_NONE) {
+            if (clk != 0)
+                return false;
+            /* analyze_static_schedule() made sure this is a clock */
+            clk = (sc_clock*) sig;
+        }
+    }
+    if (clk == 0)
+        return false;
+
+    /* Update phase of the clock transition */
+    if (profiler != 0)
+        profiler->signals_updated( old_signals_to_update,
+                                   old_lastof_signals_to_update );
+    const sc_delta_stamp stamp = curr_delta;
+    for (i = old_lastof_signals_to_update; i >= 0; --i) {
+        sc_signal_base* const sig = old_signals_to_update[i];
+        const bool changing = sig->changing();
+        if (changing)
+            sig->changed_in_delta = stamp;
+        if (sig != clk) {
+            (*sig->update_func)(sig);
+            if (changing)
+                sig->notify_watchers();
+        }
+        sig->set_submitted( false );
+    }
+    bool posedge = clk->values.nxt();
+    clk->values.cur() = posedge;
+    clk->notify_watchers();
+    if (pool_writes_pending)
+        update_signal_pools( stamp );
+
+    int my_curr_array = 1 - curr_array;
+    signals_to_update = signals_to_update_arrays[my_curr_array];
+    lastof_signals_to_update = -1;
+
+    /* Evaluation phase */
+    sc_pvector<sc_async_process_handle>& schedule =
+        posedge ? clk->sensitive_asyncs : clk->sensitive_asyncs_neg;
+    int n = schedule.size();
+    if (n >= SYSTEMC_MIN_PARALLEL_ASYNCS && async_pool != 0 && profiler == 0) {
+        async_pool_running = true;
+        async_pool->execute( schedule.raw_data(), n,
+                             signals_to_update, &lastof_signals_to_update );
+        async_pool_running = false;
+    }
+    else {
+        /* From the back, as the delta cycles and the pool run them */
+        sc_async_process_handle* const l_schedule = schedule.raw_data();
+        for (i = n - 1; i >= 0; --i) {
+            sc_async_process_handle async = l_schedule[i];
+            (void) set_curr_proc( async );
+            async->execute();
+        }
+    }
+    (void) reset_curr_proc();
+
+    /* The events of the clock transition expire */
+    ++curr_delta;
+
+    curr_array = my_curr_array;
+    if (lastof_signals_to_update < 0 && ! pool_writes_pending) {
+        if (profiler != 0)
+            profiler->time_step( 1 );
+        return true;
+    }
+    trace_cycle( /* delta cycle? */ true );
+
+    /* If anything written by the asyncs has sensitive processes (e.g.
+       a process drives a clock), fall back to delta cycles. */
+    int lastof = lastof_signals_to_update;
+    sc_signal_base* const* l_signals_to_update = signals_to_update;
+    for (i = lastof; i >= 0; --i) {
+        if (l_signals_to_update[i]->prop_which != SC_SIGNAL_PROP_NONE) {
+            crunch_delta_cycles( 1 );
+            return true;
+        }
+    }
+
+    /* Update phase of the signals written by the asyncs.  Nothing is
+       sensitive to them, but event() may still be asked for until the
+       next clock transition. */
+    if (profiler != 0)
+        profiler->signals_updated( l_signals_to_update, lastof );
+    const sc_delta_stamp async_stamp = curr_delta;
+    for (i = lastof; i >= 0; --i) {
+        sc_signal_base* const sig = l_signals_to_update[i];
+        const bool changing = sig->changing();
+        if (changing)
+            sig->changed_in_delta = async_stamp;
+        (*sig->update_func)(sig);
+        if (changing)
+            sig->notify_watchers();
+        sig->set_submitted( false );
+    }
+    if (pool_writes_pending)
+        update_signal_pools( async_stamp );
+    lastof_signals_to_update = -1;
+
+    /* ... and expire, as at the end of a delta cycle */
+    ++curr_delta;
+    if (profiler != 0)
+        profiler->time_step( 2 );
+    return true;
+
+} /* sc_simcontext::crunch_static() */
+
+/* `num_delta_cycles' is the number of delta cycles of this time step
+   already run by crunch_static(); the profiler counts them with the
+   rest, as one time step. */
 void
-sc_simcontext::crunch()
+sc_simcontext::crunch_delta_cycles( int num_delta_cycles )
 {
     int i, j;
     /* Some premature regalloc optimizations - root of all evil! */
     int my_curr_array = curr_array;   // This register-optimizes access to curr_array
 
     while (true) {
+        ++num_delta_cycles;
         lastof_asyncs_to_execute = -1;
         lastof_aprocs_to_execute = -1;
 
-        /* Save for updating old values -- also use as register allocation */
+        /* Save the queue -- also use as register allocation */
         sc_signal_base** old_signals_to_update = signals_to_update;
         int old_lastof_signals_to_update = lastof_signals_to_update;
 
@@ -426,11 +644,20 @@ sc_simcontext::crunch()
            any signal is a clock, then the corresponding edge will be
            inserted into the clock_edges_async_arrays[curr_clock_edges_array]
            as well as clock_edges_to_advance arrays */
+        if (profiler != 0)
+            profile_updates( old_signals_to_update, old_lastof_signals_to_update,
+                             old_clock_edges_async, old_lastof_clock_edges_async );
+        const sc_delta_stamp stamp = curr_delta;
         if (old_lastof_signals_to_update >= 0) {
             i = old_lastof_signals_to_update;
             do {
                 sc_signal_base* sig = old_signals_to_update[i];
+                const bool changing = sig->changing();
+                if (changing)
+                    sig->changed_in_delta = stamp;
                 (*sig->update_func)(sig);
+                if (changing)
+                    sig->notify_watchers();
                 sig->set_submitted( false );
             } while (--i >= 0);
         }
@@ -444,12 +671,19 @@ sc_simcontext::crunch()
                     sc_signal_base* const* l_signals_to_update = edge->signals_to_update;
                     do {
                         sc_signal_base* const sig = l_signals_to_update[j];
+                        const bool changing = sig->changing();
+                        if (changing)
+                            sig->changed_in_delta = stamp;
                         (*sig->update_func)(sig);
+                        if (changing)
+                            sig->notify_watchers();
                         sig->set_submitted( false );
                     } while (--j >= 0);
                 }
             } while (--i >= 0);
         }
+        if (pool_writes_pending)
+            update_signal_pools( stamp );
 
         /* Switch to the other array; this should be somewhat faster
            than using ?: */
@@ -459,7 +693,18 @@ sc_simcontext::crunch()
 
         /* Execute asynchronous BLOCKS (sc_async) (those without wait()) */
         i = lastof_asyncs_to_execute;
-        if (i >= 0) {
+        if (i >= SYSTEMC_MIN_PARALLEL_ASYNCS - 1 && async_pool != 0 && profiler == 0) {
+            /* Signals read by the asyncs are frozen until the next
+               update phase, so the asyncs may run concurrently.  The
+               pool merges the submitted signals back into
+               signals_to_update. */
+            async_pool_running = true;
+            async_pool->execute( asyncs_to_execute, i + 1,
+                                 signals_to_update, &lastof_signals_to_update );
+            async_pool_running = false;
+            (void) reset_curr_proc();
+        }
+        else if (i >= 0) {
             sc_async_process_handle* const l_asyncs_to_execute = asyncs_to_execute;
             do {
                 sc_async_process_handle async = l_asyncs_to_execute[i];
@@ -467,10 +712,28 @@ sc_simcontext::crunch()
                 async->set_in_updateq( false );
                 async->execute();
             } while (--i >= 0);
+            (void) reset_curr_proc();
         }
 
         /* Execute asynchronous PROCESSES (sc_aproc) (those with wait()) */
         int l_lastof_aprocs_to_execute = lastof_aprocs_to_execute;
+        if (total_number_of_co_aprocs > 0 && l_lastof_aprocs_to_execute >= 0) {
+            /* Stackless aprocs are simply called; the others are kept,
+               in order, for the chain of context switches below */
+            sc_aproc_process_handle* const l_aprocs_to_execute = aprocs_to_execute;
+            int k = -1;
+            for (j = 0; j <= l_lastof_aprocs_to_execute; ++j) {
+                sc_aproc_process_handle aproc = l_aprocs_to_execute[j];
+                if (0 != aproc->co) {
+                    (void) set_curr_proc( aproc );
+                    sc_co_helpers::resume( aproc );
+                } else {
+                    l_aprocs_to_execute[++k] = aproc;
+                }
+            }
+            (void) reset_curr_proc();
+            l_lastof_aprocs_to_execute = k;
+        }
         if (l_lastof_aprocs_to_execute >= 0) {
             sc_aproc_process_handle* const l_aprocs_to_execute = aprocs_to_execute;
             sc_aproc_process_handle aproc = l_aprocs_to_execute[0];
@@ -479,6 +742,8 @@ sc_simcontext::crunch()
                the simulation context.  see yieldhelp() */
             next_aproc_index = 1;
             l_aprocs_to_execute[l_lastof_aprocs_to_execute + 1] = (sc_aproc_process_handle) 0;
+            if (profiler != 0)
+                profiler->aproc_context_switches( l_lastof_aprocs_to_execute + 2 );
             (void) set_curr_proc( aproc );
 
 #ifndef WIN32 
@@ -493,28 +758,13 @@ sc_simcontext::crunch()
             /* The necessary set_in_updateq(false) is in sc_aproc::wait() */
         }
 
-	/* Update the old values now that the delta cycle is finished. */
-	for (i = old_lastof_signals_to_update; i >= 0; --i) {
-            sc_signal_base* const sig = old_signals_to_update[i];
-            sig->update_old();
-        }
+        /* The delta cycle is finished; the events of its update phase,
+           including those of signals tied to the output of synchronous
+           processes, expire all at once. */
+        ++curr_delta;
 
-        /* Update old values of signals tied to the output of synchronous
-           processes. */
-
-        for (i = old_lastof_clock_edges_async; i >= 0; --i) {
-            sc_clock_edge* const edge = old_clock_edges_async[i];
-            j = edge->lastof_signals_to_update;
-            if (j >= 0) {
-                sc_signal_base* const* l_signals_to_update = edge->signals_to_update;
-                do {
-                    sc_signal_base* const sig = l_signals_to_update[j];
-                    sig->update_old();
-                } while (--j >= 0);
-            }
-        }
-
-        if (lastof_signals_to_update + lastof_clock_edges_async == -2) {
+        if (lastof_signals_to_update + lastof_clock_edges_async == -2 &&
+            ! pool_writes_pending) {
             break;
         } else {
             trace_cycle( /* delta cycle? */ true );
@@ -539,7 +789,21 @@ sc_simcontext::crunch()
     signals_to_update = signals_to_update_arrays[my_curr_array];
     lastof_signals_to_update = -1;
 
-} /* sc_simcontext::crunch() */
+    if (profiler != 0)
+        profiler->time_step( num_delta_cycles );
+
+} /* sc_simcontext::crunch_delta_cycles() */
+
+void
+sc_simcontext::profile_updates( sc_signal_base* const* sigs, int lastof,
+                                sc_clock_edge* const* edges, int lastof_edges )
+{
+    profiler->signals_updated( sigs, lastof );
+    for (int i = lastof_edges; i >= 0; --i) {
+        profiler->signals_updated( edges[i]->signals_to_update,
+                                   edges[i]->lastof_signals_to_update );
+    }
+}
 
 
 #ifndef WIN32
@@ -582,194 +846,104 @@ sc_simcontext::submit_clock_edge( sc_clock_edge* edge )
     clock_edges_to_advance[++lastof_clock_edges_to_advance] = edge;
 }
 
-double
-sc_simcontext::simulate_forever( sc_simcontext::callback_fn callback, void* arg )
+sc_ticks
+sc_simcontext::upcoming_edge_time() const
 {
-    sc_clock_edge** edge_tmp_array;
-    edge_tmp_array = new sc_clock_edge* [prioq->size()];
-
-    while (true) {
-
-        sc_clock_edge* edge_tmp;   /* This is used to register allocate `edge'. */
-
-        // Check if we received a signal to stop.
-        if (forced_stop) {
-            cerr << "SystemC: simulation stopped by user.\n";
-	    delete[] edge_tmp_array;
-            return prioq->top()->next_edge();
-        }
-
-	double time_of_upcoming_edge = prioq->top()->next_edge();
-	int i = 0;
-
-	do {
-	    edge_tmp_array[i++] = edge_tmp = prioq->extract_top();
-
-	    /* Toggle the signal associated with the clock. */
-	    (void) sc_clock_helpers::toggle_clock_signal(edge_tmp);
-
-	} while (prioq->top()->next_edge() == time_of_upcoming_edge);
-
-	// Set the current edge of the simulation context.
-	curr_edge = edge_tmp;
-      
-        (void) (*callback)( *edge_tmp, arg );
-        crunch();
-      
-	while (--i >= 0) {
-	    prioq->insert(edge_tmp_array[i]);
-	}
-      
-        trace_cycle( /* is not delta cycle */ false );
-    }
+    return calendar ? calendar->upcoming_time() : prioq->top()->next_edge_ticks();
 }
 
-double
-sc_simcontext::simulate_forever()
+/* Toggles the clocks of all edges that occur at the upcoming time
+   instant, and makes the last of them the current edge.  With the
+   priority queue, the edges are removed from the queue and saved in
+   edge_tmp_array, and their number is returned; requeue_edges() puts
+   them back after the delta cycles of this instant. */
+inline int
+sc_simcontext::toggle_upcoming_edges( sc_clock_edge** edge_tmp_array )
 {
-    sc_clock_edge** edge_tmp_array;
-    edge_tmp_array = new sc_clock_edge* [prioq->size()];
-
-    while (true) {
-
-        sc_clock_edge* edge_tmp;   /* This is used to register allocate `edge'. */
-        
-	// Check if we received a signal to stop.
-        if (forced_stop) {
-            cerr << "SystemC: simulation stopped by user.\n";
-	    delete [] edge_tmp_array;
-            return prioq->top()->next_edge();
-        }
+    sc_clock_edge* edge_tmp;   /* This is used to register allocate `edge'. */
+    int i = 0;
 
-	double time_of_upcoming_edge = prioq->top()->next_edge();
-	int i = 0;
-
-	do {
-	    edge_tmp_array[i++] = edge_tmp = prioq->extract_top();
-
-	    /* Toggle the signal associated with the clock. */
-	    (void) sc_clock_helpers::toggle_clock_signal(edge_tmp);
-
-	} while (prioq->top()->next_edge() == time_of_upcoming_edge);
+    if (calendar) {
+        sc_clock_edge* const* l_edges = calendar->upcoming();
+        int n = calendar->upcoming_size();
+        do {
+            edge_tmp = l_edges[i];
+            (void) sc_clock_helpers::toggle_clock_signal(edge_tmp);
+        } while (++i < n);
+    }
+    else {
+        sc_ticks time_of_upcoming_edge = prioq->top()->next_edge_ticks();
+        do {
+            edge_tmp_array[i++] = edge_tmp = prioq->extract_top();
 
-	// Set the current edge of the simulation context.
-	curr_edge = edge_tmp;
+            /* Toggle the signal associated with the clock. */
+            (void) sc_clock_helpers::toggle_clock_signal(edge_tmp);
 
-        crunch();
-	
-	while (--i >= 0) {
-	    prioq->insert(edge_tmp_array[i]);
-	}
-      
-        trace_cycle( /* is not delta cycle */ false );
+        } while (prioq->top()->next_edge_ticks() == time_of_upcoming_edge);
     }
+
+    // Set the current edge of the simulation context.
+    curr_edge = edge_tmp;
+    return i;
 }
 
-double
-sc_simcontext::simulate_until( double until, sc_simcontext::callback_fn callback, void* arg )
+inline void
+sc_simcontext::requeue_edges( sc_clock_edge** edge_tmp_array, int n )
 {
-    sc_clock_edge** edge_tmp_array;
-    edge_tmp_array = new sc_clock_edge* [prioq->size()];
-
-    double time_of_upcoming_edge;
-
-    while ((time_of_upcoming_edge = prioq->top()->next_edge()) < until) {
-
-        sc_clock_edge* edge_tmp;   /* This is used to register allocate `edge'. */
-
-        // Check if we received a signal to stop.
-        if (forced_stop) {
-            cerr << "SystemC: simulation stopped by user.\n";
-	    delete [] edge_tmp_array;
-            return time_of_upcoming_edge;
+    if (calendar) {
+        calendar->advance();
+    }
+    else {
+        while (--n >= 0) {
+            prioq->insert(edge_tmp_array[n]);
         }
-
-	int i = 0;
-	do {
-	    edge_tmp_array[i++] = edge_tmp = prioq->extract_top();
-
-	    /* Toggle the signal associated with the clock. */
-	    (void) sc_clock_helpers::toggle_clock_signal(edge_tmp);
-	
-	} while (prioq->top()->next_edge() == time_of_upcoming_edge);
-
-	// Set the current edge of the simulation context.
-	curr_edge = edge_tmp;
-
-        (void) (*callback)( *edge_tmp, arg );
-        crunch();
-      
-	while (--i >= 0) {
-            prioq->insert(edge_tmp_array[i]);
-	}
-      
-        trace_cycle( /* is not delta cycle */ false );
     }
-
-    delete [] edge_tmp_array;
-    
-    return until;
 }
 
-double
-sc_simcontext::simulate_until( double until )
+/* Runs clock instants, i.e. the edges that occur at one time and the
+   delta cycles they cause, until the upcoming edge is at or after
+   `until' (never, if `until' is negative), `max_instants' instants
+   have run (no limit if it is negative) or stop() is called.  Returns
+   the number of instants run, and adds the number of edges to
+   `edges'.  Nothing is allocated here; simulate() and step() are
+   called many times in co-simulation loops. */
+int
+sc_simcontext::run_edges( sc_ticks until, int max_instants,
+                          sc_simcontext::callback_fn callback, void* arg,
+                          int& edges )
 {
-    sc_clock_edge** edge_tmp_array;
-    edge_tmp_array = new sc_clock_edge* [prioq->size()];
-
-    double time_of_upcoming_edge;
+    int instants = 0;
 
-    while ((time_of_upcoming_edge = prioq->top()->next_edge()) < until) {
-
-        sc_clock_edge* edge_tmp;   /* This is used to register allocate `edge'. */
+    while (instants != max_instants) {
+        if (until >= 0 && upcoming_edge_time() >= until)
+            break;
 
         // Check if we received a signal to stop.
         if (forced_stop) {
             cerr << "SystemC: simulation stopped by user.\n";
-	    delete [] edge_tmp_array;
-            return time_of_upcoming_edge;
+            break;
         }
 
-	int i = 0;
-	do {
-	    edge_tmp_array[i++] = edge_tmp = prioq->extract_top();
+        int i = toggle_upcoming_edges( upcoming_edges );
 
-	    /* Toggle the signal associated with the clock. */
-	    (void) sc_clock_helpers::toggle_clock_signal(edge_tmp);
-	
-	} while (prioq->top()->next_edge() == time_of_upcoming_edge);
+        if (callback != 0)
+            (void) (*callback)( *curr_edge, arg );
+        crunch();
 
-	// Set the current edge of the simulation context.
-	curr_edge = edge_tmp;
+        requeue_edges( upcoming_edges, i );
 
-        crunch();
-      
-	while (--i >= 0) {
-            prioq->insert(edge_tmp_array[i]);
-	}
-      
         trace_cycle( /* is not delta cycle */ false );
+        ++instants;
+        edges += i;
     }
-
-    delete [] edge_tmp_array;
-    
-    return until;
+    return instants;
 }
 
+/* Everything simulate() and step() need before the first instant:
+   returns false if no clock generates edges. */
 bool
-sc_simcontext::simulate( double duration, sc_clock::callback_fn callback, void* arg )
+sc_simcontext::prepare_to_run()
 {
-    if (
-#ifndef WIN32
-        curr_time < -0.1
-#else
-        curr_time + 0.1 < 0 
-#endif
-        ) {
-      cerr << "SystemC: no more processes in current context, simulation stopped.\n";
-      return false;
-    }
-    
     sc_curr_simcontext = this;
 
     if (! ready_to_simulate)
@@ -777,42 +951,101 @@ sc_simcontext::simulate( double duration, sc_clock::callback_fn callback, void*
 
     if (!prioq) {
         prioq = new sc_ppq<sc_clock_edge*>(clock_edge_list.size(), next_edge_compare);
-        sc_plist<sc_clock_edge*>::iterator it( clock_edge_list );
-        while (! it.empty()) {
+        for (int i = 0; i < clock_edge_list.size(); ++i) {
             // Only do automatic clock generation for those
             // clocks whose period is positive
-            if ((*it)->period() > 0.0) {
-                prioq->insert( *it );
+            if (clock_edge_list[i]->period() > 0.0) {
+                prioq->insert( clock_edge_list[i] );
             }
-            it++;
         }
     }
     if (0 == prioq->size()) {
         return false;
-    }    
+    }
+    if (0 == upcoming_edges) {
+        upcoming_edges = new sc_clock_edge*[clock_edge_list.size()];
+    }
 
+    /* Once all clocks are in their steady state, replay a precomputed
+       calendar of the edges instead of maintaining the queue.  The
+       queue remains in use (and this is retried on the next call)
+       for clocks that are not commensurable or not yet steady. */
+    if (!calendar) {
+        calendar = sc_edge_calendar::build( clock_edge_list );
+    }
+    return true;
+}
+
+bool
+sc_simcontext::simulate( double duration, sc_clock::callback_fn callback, void* arg )
+{
+    if (curr_time < 0) {
+      cerr << "SystemC: no more processes in current context, simulation stopped.\n";
+      return false;
+    }
+
+    if (! prepare_to_run())
+        return false;
+
+    int edges = 0;
     forced_stop = false;
     if (duration < 0) {
-        if (callback != 0)
-            curr_time = simulate_forever( callback, arg );
-        else
-            curr_time = simulate_forever();
+        (void) run_edges( -1, -1, callback, arg, edges );
+        curr_time = upcoming_edge_time();
     }
     else {
-        if (callback != 0)
-            curr_time = simulate_until( curr_time + duration, callback, arg );
-        else
-            curr_time = simulate_until( curr_time + duration );
+        sc_ticks until = curr_time + sc_seconds_to_ticks( duration );
+        (void) run_edges( until, -1, callback, arg, edges );
+        curr_time = forced_stop ? upcoming_edge_time() : until;
     }
     
     curr_edge = 0;
-    return (
-#ifndef WIN32
-        curr_time >= -0.1
-#else
-        curr_time + 0.1 >= 0
-#endif
-        );
+    write_profile();
+    return (curr_time >= 0);
+}
+
+/* Unlike simulate(), the calendar of edges is only built on the first
+   call, and the profile is not rewritten; step() leaves the time at
+   the last instant it ran rather than advancing it to the next one. */
+bool
+sc_simcontext::step_edges( sc_ticks until, int n_instants, sc_step_result* result )
+{
+    if (curr_time < 0)
+        return false;
+    if (0 == prioq || 0 == upcoming_edges || sc_curr_simcontext != this) {
+        if (! prepare_to_run())
+            return false;
+    }
+
+    sc_delta_stamp first_delta = curr_delta;
+    int edges = 0;
+    forced_stop = false;
+    int instants = run_edges( until, n_instants, 0, 0, edges );
+    if (until >= 0 && ! forced_stop)
+        curr_time = until;
+    else if (curr_edge != 0)
+        curr_time = curr_edge->time_stamp_ticks();
+    curr_edge = 0;
+
+    if (result != 0) {
+        result->instants = instants;
+        result->edges = edges;
+        result->delta_cycles = (unsigned long) (curr_delta - first_delta);
+        result->time = curr_time;
+    }
+    return ! forced_stop;
+}
+
+bool
+sc_simcontext::step( int n_instants, sc_step_result* result )
+{
+    return step_edges( -1, (n_instants > 0) ? n_instants : 0, result );
+}
+
+bool
+sc_simcontext::step_until( sc_ticks until, sc_step_result* result )
+{
+    return step_edges( (until > curr_time) ? until : curr_time, -1, result );
 }
 
 void
@@ -821,11 +1054,82 @@ sc_simcontext::stop()
     forced_stop = true;
 }
 
-sc_plist<sc_clock_edge*>::handle_t
+int
 sc_simcontext::add_clock_edge( sc_clock_edge* ce )
 {
     assert(! ready_to_simulate);
-    return clock_edge_list.push_back(ce);
+    clock_edge_list.push_back(ce);
+    return clock_edge_list.size() - 1;
+}
+
+void
+sc_simcontext::set_async_threads( int num_threads )
+{
+    if (ready_to_simulate) {
+        cerr << "The number of sc_async threads may not be changed after "
+             << "simulation has started." << endl;
+        assert( false );
+    }
+    num_async_threads = (num_threads > 1) ? num_threads : 1;
+}
+
+void
+sc_simcontext::enable_profiling( const char* file_name, sc_profile_format fmt )
+{
+    if (ready_to_simulate) {
+        cerr << "Profiling must be enabled before simulation starts." << endl;
+        assert( false );
+    }
+    delete profiler;
+    profiler = new sc_profiler( file_name, fmt );
+}
+
+void
+sc_simcontext::write_profile() const
+{
+    if (profiler != 0)
+        profiler->write();
+}
+
+/* Numbers the processes, signals and clock edges for the profiler.  All
+   signals are still on the initial update queue at this point. */
+void
+sc_simcontext::prepare_profiler()
+{
+    int n_syncs = 0;
+    int e;
+    for (e = 0; e < clock_edge_list.size(); ++e)
+        n_syncs += clock_edge_list[e]->total_number_of_syncs;
+    profiler->reserve( total_number_of_asyncs + total_number_of_aprocs + n_syncs,
+                       total_number_of_signals, clock_edge_list.size() );
+    profiler->set_async_threads( num_async_threads );
+
+    sc_async_process_handle async_h;
+    for (async_h = aa_process_table->async_head;
+         NIL(sc_async_process_handle) != async_h;
+         async_h = async_h->next_handle) {
+        async_h->prof_index = profiler->add_process( async_h, "sc_async" );
+    }
+    sc_aproc_process_handle aproc_h;
+    for (aproc_h = aa_process_table->aproc_head;
+         NIL(sc_aproc_process_handle) != aproc_h;
+         aproc_h = aproc_h->next_handle) {
+        aproc_h->prof_index = profiler->add_process( aproc_h, "sc_aproc" );
+    }
+    for (e = 0; e < clock_edge_list.size(); ++e) {
+        sc_clock_edge* edge = clock_edge_list[e];
+        edge->prof_index = profiler->add_edge( edge );
+        sc_sync_process_handle sync_h;
+        for (sync_h = edge->sync_runnable;
+             NIL(sc_sync_process_handle) != sync_h;
+             sync_h = sync_h->next_handle) {
+            sync_h->prof_index = profiler->add_process( sync_h, "sc_sync" );
+        }
+    }
+    for (int i = 0; i < total_number_of_signals; ++i) {
+        sc_signal_base* sig = signals_to_update_arrays[0][i];
+        sig->prof_index = profiler->add_signal( sig );
+    }
 }
 
 void
@@ -838,31 +1142,118 @@ sc_simcontext::add_signal( sc_signal_base* s )
 
     /* resize the array if necessary; make sure we have enough
        space for signal writes that appear in constructors */
-    if (total_number_of_signals == update_array0_alloc) {
-        update_array0_alloc += 64;
-        sc_signal_base** new_array = new sc_signal_base*[update_array0_alloc];
+    if (total_number_of_signals == update_array0_alloc)
+        reserve_signals( 1 );
+
+    /* Stick the signal to the update queue for the initial update */
+    s->set_submitted( true );
+    signals_to_update[total_number_of_signals++] = s;
+
+    s->sig_index = signal_list.size();
+    signal_list.push_back( s );
+}
 
-        /* Copy old array into new array */
-        for (int i = 0; i < total_number_of_signals; ++i)
-            new_array[i] = signals_to_update[i];
+void
+sc_simcontext::remove_signal( sc_signal_base* s )
+{
+    signal_list[s->sig_index] = 0;
+    s->sig_index = -1;
+}
 
-        /* Free the old array */
-        delete[] signals_to_update;
+bool
+sc_simcontext::save_checkpoint( const char* file_name )
+{
+    sc_checkpoint cp( this, false );
+    return cp.save( file_name );
+}
 
-        /* Make sure we update both */
-        signals_to_update = new_array;
-        signals_to_update_arrays[0] = new_array;
+bool
+sc_simcontext::restore_checkpoint( const char* file_name )
+{
+    sc_checkpoint cp( this, true );
+    return cp.restore( file_name );
+}
+
+void
+sc_simcontext::set_signal_pool( bool on )
+{
+    if (ready_to_simulate) {
+        cerr << "The signal pool must be set up before simulation starts." << endl;
+        assert( false );
     }
+    use_signal_pool = on;
+}
 
-    /* Stick the signal to the update queue for the initial update */
-    s->set_submitted( true );
-    signals_to_update[total_number_of_signals++] = s;
+void
+sc_simcontext::update_signal_pools( sc_delta_stamp stamp )
+{
+    pool_writes_pending = false;
+    for (int i = 0; i < signal_pools.size(); ++i) {
+        sc_signal_pool_base* pool = signal_pools[i];
+        if (pool->pending)
+            pool->update( stamp );
+    }
+}
+
+sc_signal_pool_base::sc_signal_pool_base( sc_simcontext* sc, const void* k )
+{
+    simc = sc;
+    key = k;
+    pending = false;
+    simc->signal_pools.push_back( this );
+}
+
+sc_signal_pool_base*
+sc_signal_pool_base::find( sc_simcontext* sc, const void* k )
+{
+    for (int i = 0; i < sc->signal_pools.size(); ++i) {
+        if (sc->signal_pools[i]->key == k)
+            return sc->signal_pools[i];
+    }
+    return 0;
+}
+
+sc_signal_pool_base::~sc_signal_pool_base()
+{
+
+}
+
+void
+sc_simcontext::reserve_signals( int n )
+{
+    int needed = total_number_of_signals + n;
+    if (needed <= update_array0_alloc)
+        return;
+
+    /* Grow geometrically, so that N signals cost O(N) copies */
+    int new_alloc = update_array0_alloc * 2;
+    if (new_alloc < needed)
+        new_alloc = needed;
+    sc_signal_base** new_array = new sc_signal_base*[new_alloc];
+
+    /* Copy old array into new array */
+    for (int i = 0; i < total_number_of_signals; ++i)
+        new_array[i] = signals_to_update[i];
+
+    /* Free the old array */
+    delete[] signals_to_update;
+
+    /* Make sure we update both */
+    update_array0_alloc = new_alloc;
+    signals_to_update = new_array;
+    signals_to_update_arrays[0] = new_array;
 }
 
 double
 sc_simcontext::time_stamp() const
 {
-    return curr_edge ? curr_edge->time_stamp() : curr_time;
+    return sc_ticks_to_seconds( time_stamp_ticks() );
+}
+
+sc_ticks
+sc_simcontext::time_stamp_ticks() const
+{
+    return curr_edge ? curr_edge->time_stamp_ticks() : curr_time;
 }
 
 void
@@ -876,7 +1267,7 @@ sc_simcontext::trace_cycle( bool delta_cycle )
 {
     sc_trace_file* const* const l_trace_files = trace_files.raw_data();
     for (int i = trace_files.size() - 1; i >=0; --i) {
-        l_trace_files[i]->cycle( delta_cycle );
+        l_trace_files[i]->kernel_cycle( delta_cycle );
     }
 }
 
@@ -919,6 +1310,12 @@ sc_simcontext::find_object(const char* name)
     return object_manager->find_object(name);
 }
 
+sc_object*
+sc_simcontext::find_object(const char* name, unsigned hash)
+{
+    return object_manager->find_object(name, hash);
+}
+
 
 sc_simcontext*
 sc_get_curr_simcontext()
@@ -947,6 +1344,12 @@ sc_time_stamp()
     return sc_get_curr_simcontext()->time_stamp();
 }
 
+sc_ticks
+sc_time_stamp_ticks()
+{
+    return sc_get_curr_simcontext()->time_stamp_ticks();
+}
+
 void
 sc_initialize()
 {
@@ -967,8 +1370,9 @@ sc_start(sc_clock& clock, double duration)
     sc_simcontext* simc = sc_get_curr_simcontext();
     double period = clock.period();
     double duty_cycle = clock.duty_cycle();
-    double first_half  = period * duty_cycle;
-    double second_half = period - first_half;
+    /* Whole cycles are counted in ticks, so the clock never drifts */
+    sc_ticks first_half  = sc_seconds_to_ticks( period * duty_cycle );
+    sc_ticks second_half = sc_seconds_to_ticks( period ) - first_half;
     double cycle_count_d = duration / period;
     unsigned cycle_count = ((cycle_count_d > (double)UINT_MAX) ?
                             UINT_MAX : (unsigned) cycle_count_d);
@@ -985,27 +1389,27 @@ sc_start(sc_clock& clock, double duration)
                 // virtual function call (because operator=()
                 // is virtual.
                 sc_clock_helpers::clock_write(&clock, 1);
-                simc->sc_cycle(first_half);
+                simc->sc_cycle_ticks(first_half);
                 sc_clock_helpers::clock_write(&clock, 0);
-                simc->sc_cycle(second_half);
+                simc->sc_cycle_ticks(second_half);
             }
         } else {
-            double until = simc->curr_time + duration;
+            sc_ticks until = simc->curr_time + sc_seconds_to_ticks( duration );
             for (unsigned i = 0; i < cycle_count; ++i) {
                 if (simc->forced_stop)
                     break;
                 sc_clock_helpers::clock_write(&clock, 1);
-                simc->sc_cycle(first_half);
+                simc->sc_cycle_ticks(first_half);
                 sc_clock_helpers::clock_write(&clock, 0);
-                simc->sc_cycle(second_half);
+                simc->sc_cycle_ticks(second_half);
             }
-            while (simc->time_stamp() < until) {
+            while (simc->time_stamp_ticks() < until) {
                 if (simc->forced_stop)
                     break;
                 sc_clock_helpers::clock_write(&clock, 1);
-                simc->sc_cycle(first_half);
+                simc->sc_cycle_ticks(first_half);
                 sc_clock_helpers::clock_write(&clock, 0);
-                simc->sc_cycle(second_half);
+                simc->sc_cycle_ticks(second_half);
             }
         }
     } else {
@@ -1015,19 +1419,19 @@ sc_start(sc_clock& clock, double duration)
                 if (simc->forced_stop)
                     break;
                 sc_clock_helpers::clock_write(&clock, 0);
-                simc->sc_cycle(first_half);
+                simc->sc_cycle_ticks(first_half);
                 sc_clock_helpers::clock_write(&clock, 1);
-                simc->sc_cycle(second_half);
+                simc->sc_cycle_ticks(second_half);
             }
         } else {
-            double until = simc->curr_time + duration;
+            sc_ticks until = simc->curr_time + sc_seconds_to_ticks( duration );
             for (unsigned i = 0; i < cycle_count; ++i) {
                 if (simc->forced_stop)
                     break;
                 sc_clock_helpers::clock_write(&clock, 0);
-                simc->sc_cycle(first_half);
+                simc->sc_cycle_ticks(first_half);
                 sc_clock_helpers::clock_write(&clock, 1);
-                simc->sc_cycle(second_half);
+                simc->sc_cycle_ticks(second_half);
             }
             // I have noticed a few times (not deterministically,
             // unfortunately) that adding *two* lines of
@@ -1035,18 +1439,51 @@ sc_start(sc_clock& clock, double duration)
             // here would significantly degrade the performance
             // of the a2901 example (with one process).  But I
             // cannot always reproduce the result ...
-            while (simc->time_stamp() < until) {
+            while (simc->time_stamp_ticks() < until) {
                 if (simc->forced_stop)
                     break;
                 sc_clock_helpers::clock_write(&clock, 0);
-                simc->sc_cycle(second_half);
+                simc->sc_cycle_ticks(second_half);
                 sc_clock_helpers::clock_write(&clock, 1);
-                simc->sc_cycle(first_half);
+                simc->sc_cycle_ticks(first_half);
             }
         }
     }
 }
 
+bool
+sc_step(int n_instants, sc_step_result* result)
+{
+    sc_simcontext* simc = sc_get_curr_simcontext();
+    if (! simc->is_running())
+        sc_module::validate_all();
+    return simc->step(n_instants, result);
+}
+
+bool
+sc_step_until(sc_ticks until, sc_step_result* result)
+{
+    sc_simcontext* simc = sc_get_curr_simcontext();
+    if (! simc->is_running())
+        sc_module::validate_all();
+    return simc->step_until(until, result);
+}
+
+bool
+sc_save_checkpoint(const char* file_name)
+{
+    return sc_get_curr_simcontext()->save_checkpoint(file_name);
+}
+
+bool
+sc_restore_checkpoint(const char* file_name)
+{
+    sc_simcontext* simc = sc_get_curr_simcontext();
+    if (! simc->is_running())
+        sc_module::validate_all();
+    return simc->restore_checkpoint(file_name);
+}
+
 void
 sc_stop()
 {
@@ -1110,6 +1547,42 @@ sc_simcontext::register_sc_sync_process(const char* name,
     return handle;
 }
 
+sc_aproc_process_handle
+sc_simcontext::register_sc_co_aproc_process(const char* name,
+                                            SC_CO_ENTRY_FUNC entry_fn,
+                                            sc_module* module)
+{
+    sc_aproc_process_handle handle;
+    handle = register_sc_aproc_process(name, SC_DEFUNCT_PROCESS_FUNCTION, module);
+    handle->co = sc_co_helpers::create(entry_fn);
+    total_number_of_co_aprocs++;
+    return handle;
+}
+
+sc_sync_process_handle
+sc_simcontext::register_sc_co_sync_process(const char* name,
+                                           SC_CO_ENTRY_FUNC entry_fn,
+                                           sc_module* module,
+                                           sc_clock_edge& clk_edge)
+{
+    return clk_edge.register_sc_sync_process(name, SC_DEFUNCT_PROCESS_FUNCTION,
+                                             module,
+                                             sc_co_helpers::create(entry_fn));
+}
+
+sc_sync_process_handle
+sc_simcontext::register_sc_co_sync_process(const char* name,
+                                           SC_CO_ENTRY_FUNC entry_fn,
+                                           sc_module* module,
+                                           const sc_polarity& polarity)
+{
+    sc_sync_process_handle handle;
+    handle = register_sc_sync_process(name, SC_DEFUNCT_PROCESS_FUNCTION,
+                                      module, polarity);
+    handle->co = sc_co_helpers::create(entry_fn);
+    return handle;
+}
+
 void
 sc_defunct_process_function(sc_module* p)
 {
@@ -39,6 +39,16 @@
 #include "sc_list.h"
 #include "sc_vector.h"
 #include "sc_process.h"
+#include "sc_async_pool.h"
+#include "sc_time_base.h"
+#include "sc_co_process.h"
+#include "sc_profiler.h"
+
+#ifndef WIN32
+typedef unsigned long long sc_delta_stamp;
+#else
+typedef unsigned __int64   sc_delta_stamp;
+#endif
 
 #ifndef WIN32
 struct qt_t;
@@ -59,12 +69,21 @@ class sc_array_concat_manager;
 class sc_object_manager;
 class sc_object;
 template<class T> class sc_ppq;
+class sc_edge_calendar;
 template<class K, class C> class sc_phash;
 class sc_lambda_ptr;
 class sc_signal_edgy_deval;
 struct sc_polarity;
 class sc_module_name;
 
+/* What one call of sc_step() or sc_step_until() did */
+struct sc_step_result {
+    int           instants;      /* times at which clock edges occurred */
+    int           edges;         /* clock edges, counting coinciding ones */
+    unsigned long delta_cycles;
+    sc_ticks      time;          /* the time reached */
+};
+
 enum sc_curr_proc_kind {
     SC_CURR_PROC_NONE,
     SC_CURR_PROC_ASYNC,
@@ -78,6 +97,7 @@ struct sc_curr_proc_info {
 };
 
 struct sc_async_aproc_process_table;
+class sc_signal_pool_base;
 
 class sc_simcontext {
     friend class sc_clock;
@@ -88,6 +108,8 @@ class sc_simcontext {
     friend class sc_async;
     friend class sc_aproc;
     friend class sc_module;
+    friend class sc_signal_pool_base;
+    friend class sc_checkpoint;
 
 public:
     typedef int (*callback_fn)( const sc_clock_edge& edge, void* arg );
@@ -102,30 +124,95 @@ public:
     sc_object* first_object();
     sc_object* next_object();
     sc_object* find_object(const char* name);
+        // With `hash' = sc_name_hash(name), computed beforehand
+    sc_object* find_object(const char* name, unsigned hash);
 
     bool simulate( double duration, callback_fn callback = 0, void* arg = 0 );
+
+    /* For co-simulation loops that advance the model a little at a
+       time: step() runs the next `n_instants' times at which clock
+       edges occur, step_until() the edges before `until' (in ticks).
+       Neither allocates nor repeats the preparation done on the first
+       call.  Both return false if there are no clock edges or the
+       simulation was stopped, and fill in `result' if it is not 0. */
+    bool step( int n_instants, sc_step_result* result = 0 );
+    bool step_until( sc_ticks until, sc_step_result* result = 0 );
+
+    /* Writes the state of the simulation to `file_name', or loads it
+       into this context, which must hold a freshly elaborated instance
+       of the same design that has not been initialized yet; see
+       sc_checkpoint.h.  Both return false on failure. */
+    bool save_checkpoint( const char* file_name );
+    bool restore_checkpoint( const char* file_name );
     void stop();
     void reset();
 
     double time_stamp() const;
+    sc_ticks time_stamp_ticks() const;
 
     void add_trace_file(sc_trace_file* tf);
     void trace_cycle(bool delta_cycle);
 
     /* prepare for simulation - should be called after all objects have been
-       instantiated */
-    void initialize();
+       instantiated.  With `crunch' false the initial crunch and the first
+       trace dump are left out; sc_checkpoint does so, and loads the values
+       of the signals in their place. */
+    void initialize( bool crunch = true );
 
     void submit_update( sc_signal_base* sig )
     {
+        if (async_pool_running) {
+            sc_async_pool::submit_update(sig);
+            return;
+        }
         signals_to_update[++lastof_signals_to_update] = sig;
     }
 
     void add_signal( sc_signal_base* sig );
+    void remove_signal( sc_signal_base* sig );
+
+    /* Number of the current delta cycle.  The update phase stamps the
+       signals whose value it changes with it, and it advances once the
+       evaluation phase is over, which is when those events expire. */
+    sc_delta_stamp delta_stamp() const { return curr_delta; }
+
+    /* Keeps the values of signals of plain types (see sc_signal_pool.h)
+       in contiguous arrays; only affects the signals created after the
+       call, so it must come before elaboration. */
+    void set_signal_pool( bool on );
+    bool signal_pool_enabled() const { return use_signal_pool; }
+        // Makes room for `n' more signals, e.g. before the elements
+        // of a signal array are created
+    void reserve_signals( int n );
+
+    /* Number of threads evaluating sc_async processes; must be set
+       before simulation starts.  1 (the default) means serial. */
+    void set_async_threads( int num_threads );
+    int async_threads() const { return num_async_threads; }
+
+    /* Records kernel activity (see sc_profiler.h) into `file_name',
+       which is rewritten at the end of every simulate(); must be
+       called before simulation starts.  While profiling, sc_asyncs
+       are evaluated serially. */
+    void enable_profiling( const char* file_name,
+                           sc_profile_format fmt = SC_PROFILE_JSON );
+    void write_profile() const;
+
+    /* Prints how long initialize() spent resolving ports, preparing
+       the processes and clock edges, and in the initial crunch. */
+    void set_elaboration_report( bool on ) { elaboration_report = on; }
 
     void initial_crunch();
-    void crunch();
+    void crunch()
+    {
+        if (! static_schedule || ! crunch_static())
+            crunch_delta_cycles();
+    }
     void sc_cycle( double t )
+    {
+        sc_cycle_ticks( sc_seconds_to_ticks( t ) );
+    }
+    void sc_cycle_ticks( sc_ticks t )
     {
         crunch();
 	trace_cycle( /* is not delta cycle */ false );
@@ -136,6 +223,9 @@ public:
        IMPLEMENTATION.  */
     const sc_curr_proc_info* get_curr_proc_info()
     {
+        /* Each worker of the async pool runs its own process */
+        if (async_pool_running)
+            return sc_async_pool::curr_proc_info();
         return &curr_proc_info;
     }
     void reset_curr_proc();
@@ -159,12 +249,20 @@ public:
     sc_port_manager*         get_port_manager()   { return port_manager; }
 
 private:
-    sc_plist<sc_clock_edge*>::handle_t add_clock_edge(sc_clock_edge* ce);
+    int add_clock_edge(sc_clock_edge* ce);
+
+    bool prepare_to_run();
+    int  run_edges( sc_ticks until, int max_instants,
+                    callback_fn callback, void* arg, int& edges );
+    bool step_edges( sc_ticks until, int n_instants, sc_step_result* result );
+
+    void crunch_delta_cycles( int num_delta_cycles = 0 );
+    bool crunch_static();
+    void analyze_static_schedule();
 
-    double simulate_forever( callback_fn callback, void* arg );
-    double simulate_forever();
-    double simulate_until( double until, callback_fn callback, void* arg );
-    double simulate_until( double until );
+    sc_ticks upcoming_edge_time() const;
+    int  toggle_upcoming_edges( sc_clock_edge** edge_tmp_array );
+    void requeue_edges( sc_clock_edge** edge_tmp_array, int n );
 
 #ifndef WIN32
     friend void* sc_simcontext_yieldhelp( qt_t* sp, void* simc, void* );
@@ -187,13 +285,28 @@ public:
                                                       sc_module*,
                                                       const sc_polarity& polarity );
 
+    /* Stackless processes; see sc_co_process.h */
+    sc_aproc_process_handle register_sc_co_aproc_process( const char* name,
+                                                          SC_CO_ENTRY_FUNC fn,
+                                                          sc_module* );
+    sc_sync_process_handle  register_sc_co_sync_process( const char* name,
+                                                         SC_CO_ENTRY_FUNC fn,
+                                                         sc_module*,
+                                                         sc_clock_edge& clk_edge );
+    sc_sync_process_handle  register_sc_co_sync_process( const char* name,
+                                                         SC_CO_ENTRY_FUNC fn,
+                                                         sc_module*,
+                                                         const sc_polarity& polarity );
+
 private:
     sc_array_concat_manager* concat_manager;
     sc_object_manager*       object_manager;
     sc_port_manager*         port_manager;
 
     sc_ppq<sc_clock_edge*>* prioq;     // priority queue for ordering clocks
-    sc_plist<sc_clock_edge*> clock_edge_list;
+    sc_edge_calendar* calendar;        // replaces prioq for periodic clocks
+    sc_clock_edge** upcoming_edges;    // the edges of the current instant
+    sc_pvector<sc_clock_edge*> clock_edge_list;
 
     sc_curr_proc_info  curr_proc_info;
 
@@ -230,19 +343,44 @@ private:
 
     sc_async_aproc_process_table* aa_process_table;
 
+    int            num_async_threads;
+    sc_async_pool* async_pool;         /* 0 unless num_async_threads > 1 */
+    bool           async_pool_running; /* true while the pool executes */
+
+    /* true iff every sc_async is sensitive to clocks only, and there are
+       neither aprocs nor syncs; see analyze_static_schedule() */
+    bool static_schedule;
+
+    sc_profiler* profiler;             /* 0 unless profiling */
+    void prepare_profiler();
+    void profile_updates( sc_signal_base* const* sigs, int lastof,
+                          sc_clock_edge* const* edges, int lastof_edges );
+
+    bool elaboration_report;
+
+    bool use_signal_pool;
+    sc_pvector<sc_signal_pool_base*> signal_pools;
+    bool pool_writes_pending;   /* some pool has written signals */
+    void update_signal_pools( sc_delta_stamp stamp );
+
 #ifndef WIN32
     qt_t*      sp;  /* the simulation context's own stack ptr */
 #else
     PVOID pFiber;   /* simulation context's own fiber */
 #endif
 
+    sc_delta_stamp curr_delta;
+
     int total_number_of_signals;
+    sc_pvector<sc_signal_base*> signal_list;  /* in order of creation;
+                                                 0 for those destroyed */
     int total_number_of_asyncs;
     int total_number_of_aprocs;
+    int total_number_of_co_aprocs;  /* stackless ones among the aprocs */
 
     int next_aproc_index;
 
-    double curr_time;
+    sc_ticks curr_time;
     sc_clock_edge* curr_edge;
     bool forced_stop;
 
@@ -265,6 +403,7 @@ inline sc_process_b* sc_get_curr_process_handle()
 
 extern double sc_simulation_time();
 extern double sc_time_stamp();
+extern sc_ticks sc_time_stamp_ticks();
 
 inline void sc_cycle( double t )
 {
@@ -276,6 +415,10 @@ extern void sc_initialize();
 typedef int (*sc_callback_fn)(const sc_clock_edge&, void*);
 extern void sc_start(double duration, sc_callback_fn cb = 0, void* ua = 0);
 extern void sc_start(sc_clock& clk, double duration);
+extern bool sc_step(int n_instants, sc_step_result* result = 0);
+extern bool sc_step_until(sc_ticks until, sc_step_result* result = 0);
+extern bool sc_save_checkpoint(const char* file_name);
+extern bool sc_restore_checkpoint(const char* file_name);
 extern void sc_stop();
 
 #endif
@@ -40,6 +40,8 @@
 inline void
 sc_simcontext::reset_curr_proc()
 {
+  if (profiler != 0)
+      profiler->switch_to( -1 );
   return;
   /*
     curr_proc_info.process_handle = 0;
@@ -52,6 +54,8 @@ sc_simcontext::set_curr_proc(sc_async_process_handle h)
 {
     curr_proc_info.process_handle = h;
     curr_proc_info.kind           = SC_CURR_PROC_ASYNC;
+    if (profiler != 0)
+        profiler->switch_to( h->prof_index );
 }
 
 inline void
@@ -59,6 +63,8 @@ sc_simcontext::set_curr_proc(sc_aproc_process_handle h)
 {
     curr_proc_info.process_handle = h;
     curr_proc_info.kind           = SC_CURR_PROC_APROC;
+    if (profiler != 0)
+        profiler->switch_to( h->prof_index );
 }
 
 inline void
@@ -66,6 +72,8 @@ sc_simcontext::set_curr_proc(sc_sync_process_handle h)
 {
     curr_proc_info.process_handle = h;
     curr_proc_info.kind           = SC_CURR_PROC_SYNC;
+    if (profiler != 0)
+        profiler->switch_to( h->prof_index );
 }
 
 extern void sc_defunct_process_function(sc_module*);
@@ -0,0 +1,169 @@
+/******************************************************************************
+    Copyright (c) 1996-2000 Synopsys, Inc.    ALL RIGHTS RESERVED
+
+  The contents of this file are subject to the restrictions and limitations
+  set forth in the SystemC(TM) Open Community License Software Download and
+  Use License Version 1.1 (the "License"); you may not use this file except
+  in compliance with such restrictions and limitations. You may obtain
+  instructions on how to receive a copy of the License at
+  http://www.systemc.org/. Software distributed by Original Contributor
+  under the License is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+  ANY KIND, either express or implied. See the License for the specific
+  language governing rights and limitations under the License.
+
+******************************************************************************/
+
+
+/******************************************************************************
+
+    sc_stack_pool.cpp -- pool of guard-paged coroutine stacks.
+
+******************************************************************************/
+
+/******************************************************************************
+
+    MODIFICATION LOG - modifiers, enter your name, affliation and
+    changes you are making here:
+
+    Modifier Name & Affiliation:
+    Description of Modification:
+
+
+******************************************************************************/
+
+#ifndef WIN32
+
+#include <sys/mman.h>
+#include <unistd.h>
+#ifndef _MSC_VER
+#include <iostream>
+using std::cerr;
+using std::endl;
+#else
+#include <iostream.h>
+#endif
+#include <assert.h>
+
+#include "sc_vector.h"
+#include "sc_stack_pool.h"
+
+#ifndef MAP_ANONYMOUS
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+#ifndef MAP_NORESERVE
+#define MAP_NORESERVE 0
+#endif
+
+/* Free stacks of one size */
+struct sc_stack_bucket {
+    size_t             size;
+    sc_pvector<void*>  stacks;
+};
+
+static sc_pvector<sc_stack_bucket*> buckets;
+static int stacks_mapped = 0;
+static int stacks_in_use = 0;
+
+/* Stacks are mapped this many at a time */
+static const int stacks_per_chunk = 32;
+
+static size_t
+page_size()
+{
+    static size_t page = 0;
+    if (page == 0)
+        page = (size_t) sysconf( _SC_PAGESIZE );
+    return page;
+}
+
+static sc_stack_bucket*
+find_bucket( size_t size )
+{
+    for (int i = 0; i < buckets.size(); ++i) {
+        if (buckets[i]->size == size)
+            return buckets[i];
+    }
+    sc_stack_bucket* b = new sc_stack_bucket;
+    b->size = size;
+    buckets.push_back( b );
+    return b;
+}
+
+/* Maps stacks_per_chunk stacks of the bucket's size in one go.  Stacks
+   grow downwards, so each one is preceded by its guard page. */
+static void
+map_chunk( sc_stack_bucket* b )
+{
+    static bool guards_exhausted = false;
+
+    size_t page = page_size();
+    size_t stride = b->size + page;
+    char* base = (char*) mmap( 0, stride * stacks_per_chunk,
+                               PROT_READ | PROT_WRITE,
+                               MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE,
+                               -1, 0 );
+    if (base == (char*) MAP_FAILED) {
+        cerr << "SystemC: unable to map process stacks of "
+             << b->size << " bytes." << endl;
+        assert( false );
+    }
+
+    /* Every guard page splits the mapping; once the system's limit on
+       the number of mappings is reached, stacks go unguarded. */
+    for (int i = stacks_per_chunk - 1; i >= 0; --i) {
+        char* guard = base + i * stride;
+        if (! guards_exhausted && mprotect( guard, page, PROT_NONE ) != 0) {
+            guards_exhausted = true;
+            cerr << "SystemC: too many memory mappings, further process "
+                 << "stacks have no guard page." << endl;
+        }
+        b->stacks.push_back( guard + page );
+    }
+    stacks_mapped += stacks_per_chunk;
+}
+
+void*
+sc_stack_pool::allocate( size_t* size )
+{
+    size_t page = page_size();
+    size_t usable = (*size + page - 1) & ~(page - 1);
+    *size = usable;
+    ++stacks_in_use;
+
+    sc_stack_bucket* b = find_bucket( usable );
+    int n = b->stacks.size();
+    if (n == 0) {
+        map_chunk( b );
+        n = b->stacks.size();
+    }
+    void* stack = b->stacks[n - 1];
+    b->stacks.decr_count();
+    return stack;
+}
+
+void
+sc_stack_pool::release( void* stack, size_t size )
+{
+    if (stack == 0)
+        return;
+    --stacks_in_use;
+
+    /* Drop the pages that were touched; they will read as zero (and
+       cost nothing) until the stack is used again. */
+    (void) madvise( stack, size, MADV_DONTNEED );
+    find_bucket( size )->stacks.push_back( stack );
+}
+
+int
+sc_stack_pool::num_mapped()
+{
+    return stacks_mapped;
+}
+
+int
+sc_stack_pool::num_in_use()
+{
+    return stacks_in_use;
+}
+
+#endif
@@ -0,0 +1,67 @@
+/******************************************************************************
+    Copyright (c) 1996-2000 Synopsys, Inc.    ALL RIGHTS RESERVED
+
+  The contents of this file are subject to the restrictions and limitations
+  set forth in the SystemC(TM) Open Community License Software Download and
+  Use License Version 1.1 (the "License"); you may not use this file except
+  in compliance with such restrictions and limitations. You may obtain
+  instructions on how to receive a copy of the License at
+  http://www.systemc.org/. Software distributed by Original Contributor
+  under the License is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+  ANY KIND, either express or implied. See the License for the specific
+  language governing rights and limitations under the License.
+
+******************************************************************************/
+
+
+/******************************************************************************
+
+    sc_stack_pool.h -- pool of guard-paged coroutine stacks.
+
+******************************************************************************/
+
+/******************************************************************************
+
+    MODIFICATION LOG - modifiers, enter your name, affliation and
+    changes you are making here:
+
+    Modifier Name & Affiliation:
+    Description of Modification:
+
+
+******************************************************************************/
+
+#ifndef SC_STACK_POOL_H
+#define SC_STACK_POOL_H
+
+#include <stddef.h>
+
+//
+//  <summary> Coroutine stacks </summary>
+//
+//  Stacks of sc_sync and sc_aproc processes are mapped with mmap(), so
+//  that memory is only committed for the pages a process actually
+//  touches.  An inaccessible guard page below each stack turns a stack
+//  overflow into a fault instead of silent corruption.  Released stacks
+//  are kept, with their pages returned to the system, for reuse by
+//  processes asking for the same size.
+//
+//  Not used on WIN32, where the fibers own their stacks.
+//
+class sc_stack_pool {
+public:
+        // Returns the lowest usable address of a stack of at least
+        // `*size' bytes, and sets `*size' to the usable size (a whole
+        // number of pages).
+    static void* allocate( size_t* size );
+
+        // Gives back a stack obtained from allocate(); `size' is the
+        // size that allocate() returned.  A null stack is ignored.
+    static void release( void* stack, size_t size );
+
+        // Number of stacks mapped, and number of those currently in use
+    static int num_mapped();
+    static int num_in_use();
+};
+
+#endif
@@ -62,12 +62,13 @@ using std::size_t;
 #include "sc_clock_int.h"
 #include "sc_except.h"
 #include "sc_module.h"
+#include "sc_stack_pool.h"
 
 sc_sync_process::sc_sync_process(const char* nm,
                                  SC_ENTRY_FUNC fn,
                                  sc_module* mod,
                                  sc_clock_edge* edge)
-    : sc_process_b(nm, fn, mod), dwatchlists(SYSTEMC_MAX_WATCH_LEVEL)
+    : sc_process_b(nm, fn, mod)
 {
     static int next_proc_id = 0;
 
@@ -86,35 +87,35 @@ sc_sync_process::sc_sync_process(const char* nm,
 #else
     pFiber          = (PVOID) 0;
 #endif
+    co              = 0;
 
     wait_state      = WAIT_UNKNOWN;
     wait_cycles     = 0;
     exception_level = -1;
     __reset_watching();
-    for (int i = 0; i < SYSTEMC_MAX_WATCH_LEVEL; ++i)
-        dwatchlists[i] = new sc_plist<sc_lambda_ptr*>;
 
     prev_handle = next_handle = 0;
+    runnable_seq = 0;
+    wake_cycle   = 0;
+    wheel_next   = 0;
+    terminated   = false;
+    queued       = false;
 }
 
 
 sc_sync_process::~sc_sync_process()
 {
+    sc_co_helpers::destroy( co );
 #ifndef WIN32
-    delete[] (char*)stack;
+    sc_stack_pool::release( stack, stack_size );
 #else
     if ((PVOID) 0 != pFiber) 
         DeleteFiber( pFiber );
 #endif
 
-    for (int i = 0; i < SYSTEMC_MAX_WATCH_LEVEL; ++i) {
-        sc_plist<sc_lambda_ptr*>::iterator it(dwatchlists[i]);
-        while (! it.empty()) {
-            delete *it;  /* this was created with `new sc_lambda_ptr' */
-            it.remove(); /* and go on to next */
-        }
-        delete dwatchlists[i];
-    }
+    stop_waiting_on_lambdas();
+    for (int i = 0; i < SYSTEMC_MAX_WATCH_LEVEL; ++i)
+        clear_watchlist(i);
 }
 
 void
@@ -126,12 +127,15 @@ sc_sync_process::set_stack_size(size_t size)
 void
 sc_sync_process::prepare_for_simulation()
 {
+    if (co != 0) {
+        /* A stackless process needs nothing but its coroutine frame */
+        sc_co_helpers::start( co, module );
+        return;
+    }
 #ifndef WIN32
     /* Create a coroutine for the sc_sync_process */
-    stack = new char[stack_size];
-    assert( 0 != stack );
-    void* sto = stack_align( stack, QT_STKALIGN, &stack_size );
-    sp = QT_SP( sto, stack_size - QT_STKALIGN );
+    stack = sc_stack_pool::allocate( &stack_size );
+    sp = QT_SP( stack, stack_size );
     sp = QT_ARGS( sp, this, this, 0, sc_sync_process_only );
 #else
     /* Create a fiber for the sc_sync_process */
@@ -179,8 +183,9 @@ sc_sync_process_yieldhelp( qt_t* sp, void* old, void* )
 void*
 sc_sync_process_aborthelp( qt_t*, void* old, void* )
 {
-    delete[] (char*) (((sc_sync_process_handle) old)->stack);
-    ((sc_sync_process_handle) old)->stack = 0;
+    sc_sync_process_handle handle = (sc_sync_process_handle) old;
+    sc_stack_pool::release( handle->stack, handle->stack_size );
+    handle->stack = 0;
     return 0;
 }
 
@@ -188,12 +193,10 @@ qt_t*
 sc_sync_process::next_qt()
 {
     sc_simcontext* simc = module->simcontext();
-    sc_sync_process_handle next_h;
-    for (next_h = next_handle; 0 != next_h; next_h = next_h->next_handle) {
-        if (next_h->ready_to_wakeup()) {
-            (void) simc->set_curr_proc(next_h);
-            return next_h->sp;
-        }
+    sc_sync_process_handle next_h = clock_edge->next_ready_process();
+    if (0 != next_h) {
+        (void) simc->set_curr_proc(next_h);
+        return next_h->sp;
     }
     (void) simc->reset_curr_proc();
     return clock_edge->qt();
@@ -233,12 +236,10 @@ PVOID
 sc_sync_process::next_fiber()
 {
     sc_simcontext* simc = module->simcontext();
-    sc_sync_process_handle next_h;
-    for (next_h = next_handle; 0 != next_h; next_h = next_h->next_handle) {
-        if (next_h->ready_to_wakeup()) {
-            (void) simc->set_curr_proc(next_h);
-            return next_h->pFiber;
-        }
+    sc_sync_process_handle next_h = clock_edge->next_ready_process();
+    if (0 != next_h) {
+        (void) simc->set_curr_proc(next_h);
+        return next_h->pFiber;
     }
     (void) simc->reset_curr_proc();
     return clock_edge->fiber();
@@ -247,25 +248,29 @@ sc_sync_process::next_fiber()
 #endif
 
 
+void
+sc_sync_process::clear_watchlist(int wlevel)
+{
+    dwatchlist_t& li = dwatchlists[wlevel];
+    for (int k = 0; k < li.size(); ++k)
+        delete li[k];  /* this was created with `new sc_lambda_ptr' */
+    li.erase_all();
+}
+
 bool
 sc_sync_process::eval_watchlist_curr_level()
 {
     int wlevel = watch_level;
     assert(wlevel > 0);
     
-    sc_plist<sc_lambda_ptr*>& li = *dwatchlists[wlevel];
-    sc_plist<sc_lambda_ptr*>::iterator wit(li);
-    while (! wit.empty()) {
-        if ((**wit)->eval()) {
+    dwatchlist_t& li = dwatchlists[wlevel];
+    sc_lambda_ptr* const* w = li.raw_data();
+    for (int k = li.size(); k > 0; --k, ++w) {
+        if ((**w)->eval()) {
             exception_level = wlevel;
-            wit.reset(li);
-            while (! wit.empty()) {
-                delete *wit;
-                wit.remove();
-            }
+            clear_watchlist(wlevel);
             return true;
         }
-        wit++;
     }
     exception_level = -1;
     return false;
@@ -292,35 +297,98 @@ sc_sync_process::ready_to_wakeup()
     return ready;
 }
 
+bool
+sc_sync_process::has_watching() const
+{
+    int wlevel = watch_level;
+    for (int i = 0; i <= wlevel; ++i) {
+        if (dwatchlists[i].size() != 0)
+            return true;
+    }
+    return false;
+}
+
 bool
 sc_sync_process::eval_watchlist()
 {
     int wlevel = __watch_level();
     for (int i = 0; i <= wlevel; ++i) {
-        sc_plist<sc_lambda_ptr*>& li = *(dwatchlists[i]);
-        sc_plist<sc_lambda_ptr*>::iterator wit(li);
-        while (! wit.empty()) {
-            if ((**wit)->eval()) {
+        const dwatchlist_t& li = dwatchlists[i];
+        sc_lambda_ptr* const* w = li.raw_data();
+        for (int k = li.size(); k > 0; --k, ++w) {
+            if ((**w)->eval()) {
                 exception_level = i;
                 if (i == 0) /* never remove global watching */
                     i = 1;
-                for (; i <= wlevel; ++i) {
-                    sc_plist<sc_lambda_ptr*>& l = *(dwatchlists[i]);
-                    sc_plist<sc_lambda_ptr*>::iterator it(l);
-                    while (! it.empty()) {
-                        delete *it;
-                        it.remove();
-                    }
-                }
+                for (; i <= wlevel; ++i)
+                    clear_watchlist(i);
                 return true;
             }
-            wit++;
         }
     }
     exception_level = -1;
     return false;
 }
 
+/* A process that has just been found not ready can wait for a change
+   of an operand of the lambdas it evaluated, instead of being examined
+   on every edge: as long as no operand changes, they keep their value.
+   Lambdas that are not compiled are not told of such changes. */
+bool
+sc_sync_process::wait_on_lambdas()
+{
+    int wlevel = watch_level;
+    int i;
+    if (WAIT_LAMBDA == wait_state && 0 == wait_lambda->code)
+        return false;
+    for (i = 0; i <= wlevel; ++i) {
+        const dwatchlist_t& li = dwatchlists[i];
+        for (int k = 0; k < li.size(); ++k) {
+            if (0 == (*li[k])->code)
+                return false;
+        }
+    }
+
+    if (WAIT_LAMBDA == wait_state) {
+        wait_lambda->waiters.push_back( this );
+        waiting_on.push_back( wait_lambda.ptr );
+    }
+    for (i = 0; i <= wlevel; ++i) {
+        const dwatchlist_t& li = dwatchlists[i];
+        for (int k = 0; k < li.size(); ++k) {
+            const sc_lambda* l = li[k]->ptr;
+            l->waiters.push_back( this );
+            waiting_on.push_back( l );
+        }
+    }
+    return true;
+}
+
+void
+sc_sync_process::stop_waiting_on_lambdas()
+{
+    for (int i = 0; i < waiting_on.size(); ++i) {
+        sc_pvector<sc_sync_process*>& w = waiting_on[i]->waiters;
+        for (int k = w.size() - 1; k >= 0; --k) {
+            if (w[k] == this) {
+                w[k] = w[w.size() - 1];
+                w.decr_count();
+                break;
+            }
+        }
+    }
+    waiting_on.erase_all();
+}
+
+void
+sc_sync_process::operand_changed()
+{
+    if (! queued) {
+        queued = true;
+        clock_edge->poll[++clock_edge->lastof_poll] = this;
+    }
+}
+
 void
 sc_set_stack_size(sc_sync_process_handle sync_h,
                   size_t size)
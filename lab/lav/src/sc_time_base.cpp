@@ -0,0 +1,107 @@
+/******************************************************************************
+    Copyright (c) 1996-2000 Synopsys, Inc.    ALL RIGHTS RESERVED
+
+  The contents of this file are subject to the restrictions and limitations
+  set forth in the SystemC(TM) Open Community License Software Download and
+  Use License Version 1.1 (the "License"); you may not use this file except
+  in compliance with such restrictions and limitations. You may obtain
+  instructions on how to receive a copy of the License at
+  http://www.systemc.org/. Software distributed by Original Contributor
+  under the License is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+  ANY KIND, either express or implied. See the License for the specific
+  language governing rights and limitations under the License.
+
+******************************************************************************/
+
+/******************************************************************************
+
+    sc_time_base.cpp -- integer representation of simulated time.
+
+******************************************************************************/
+
+/******************************************************************************
+
+    MODIFICATION LOG - modifiers, enter your name, affliation and
+    changes you are making here:
+
+    Modifier Name & Affiliation:
+    Description of Modification:
+
+
+******************************************************************************/
+
+
+#include <math.h>
+#ifndef _MSC_VER
+#include <iostream>
+using std::cerr;
+using std::endl;
+#else
+// MSVC6.0 has bugs in standard library
+#include <iostream.h>
+#endif
+#include <assert.h>
+
+#include "sc_time_base.h"
+
+/* Ticks per second; a power of ten, hence exact as a double for all
+   supported resolutions.  Dividing by it (rather than multiplying by
+   the resolution) gives correctly rounded times in seconds. */
+static double ticks_per_second = 1e12;
+static bool   resolution_fixed = false;
+
+static const double max_ticks = 9.2e18;
+
+void
+sc_set_time_resolution( sc_time_unit unit )
+{
+    static const double unit_ticks_per_second[] = {
+        1e15, 1e12, 1e9, 1e6, 1e3, 1e0
+    };
+
+    if (resolution_fixed) {
+        cerr << "The time resolution must be set before any clock is "
+             << "created and before simulation starts." << endl;
+        assert( false );
+    }
+    ticks_per_second = unit_ticks_per_second[unit];
+}
+
+double
+sc_get_time_resolution()
+{
+    return 1.0 / ticks_per_second;
+}
+
+sc_ticks
+sc_seconds_to_ticks( double t )
+{
+    resolution_fixed = true;
+    double n = floor( t * ticks_per_second + 0.5 );
+    if (n > max_ticks || n < -max_ticks) {
+        cerr << "Time " << t << " is out of range for the time resolution "
+             << sc_get_time_resolution() << " sec." << endl;
+        assert( false );
+    }
+    return (sc_ticks) n;
+}
+
+double
+sc_ticks_to_seconds( sc_ticks t )
+{
+    return (double) t / ticks_per_second;
+}
+
+sc_ticks
+sc_ticks_to_units( sc_ticks t, double unit )
+{
+    double ratio = unit * ticks_per_second;
+    if (ratio >= 1.0) {
+        sc_ticks r = (sc_ticks) floor( ratio + 0.5 );
+        return (t + r / 2) / r;
+    }
+    else {
+        sc_ticks m = (sc_ticks) floor( 1.0 / ratio + 0.5 );
+        return t * m;
+    }
+}
@@ -0,0 +1,81 @@
+/******************************************************************************
+    Copyright (c) 1996-2000 Synopsys, Inc.    ALL RIGHTS RESERVED
+
+  The contents of this file are subject to the restrictions and limitations
+  set forth in the SystemC(TM) Open Community License Software Download and
+  Use License Version 1.1 (the "License"); you may not use this file except
+  in compliance with such restrictions and limitations. You may obtain
+  instructions on how to receive a copy of the License at
+  http://www.systemc.org/. Software distributed by Original Contributor
+  under the License is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+  ANY KIND, either express or implied. See the License for the specific
+  language governing rights and limitations under the License.
+
+******************************************************************************/
+
+/******************************************************************************
+
+    sc_time_base.h -- integer representation of simulated time.
+
+******************************************************************************/
+
+/******************************************************************************
+
+    MODIFICATION LOG - modifiers, enter your name, affliation and
+    changes you are making here:
+
+    Modifier Name & Affiliation:
+    Description of Modification:
+
+
+******************************************************************************/
+
+
+#ifndef SC_TIME_BASE_H
+#define SC_TIME_BASE_H
+
+//
+//  <summary> Simulated time </summary>
+//
+//  The kernel keeps time as a 64-bit count of ticks of a global
+//  resolution (1 ps unless set otherwise), so that clock edges and time
+//  comparisons are exact.  The user interface still speaks in seconds
+//  (double); these are rounded to the nearest tick on the way in.
+//
+//  The resolution can only be changed before the first conversion,
+//  i.e. before any clock is created and before time advances.
+//
+
+#ifndef WIN32
+typedef long long sc_ticks;
+#else
+typedef __int64   sc_ticks;
+#endif
+
+//  Code that still names the unsigned fixed-point encoding SC_US (see
+//  sc_fxdefs.h) defines SC_FX_OLD_ENC_NAMES; microseconds then have no
+//  name of their own here.
+//
+enum sc_time_unit {
+    SC_FS,
+    SC_PS,
+    SC_NS,
+#ifndef SC_FX_OLD_ENC_NAMES
+    SC_US,
+#endif
+    SC_MS = SC_NS + 2,
+    SC_SEC
+};
+
+extern void   sc_set_time_resolution( sc_time_unit unit );
+    // Length of a tick, in seconds
+extern double sc_get_time_resolution();
+
+extern sc_ticks sc_seconds_to_ticks( double t );
+extern double   sc_ticks_to_seconds( sc_ticks t );
+
+    // Converts a time in ticks to (rounded) units of `unit' seconds,
+    // `unit' being a power of ten (e.g. the timescale of a trace file).
+extern sc_ticks sc_ticks_to_units( sc_ticks t, double unit );
+
+#endif
@@ -46,6 +46,7 @@
 
 #include <stdarg.h>
 #include <stdio.h>
+#include <assert.h>
 #ifndef _MSC_VER
 #include <iostream>
 using std::ostream;
@@ -61,12 +62,126 @@ using std::hex;
 #endif
 #include "sc_trace.h"
 #include "sc_signal.h"
+#include "sc_simcontext.h"
 
 // Trace file common functions.
 
 sc_trace_file::sc_trace_file()
 {
-  /* Intentionally blank */
+    traced_signal = 0;
+    num_traces = 0;
+    trigger_condition = 0;
+    trigger_arg = 0;
+    trigger_time = 0;
+    trigger_armed = false;
+    history_depth = 0;
+}
+
+sc_trace_file::~sc_trace_file()
+{
+    int i;
+    for (i = 0; i < watches.size(); i++) {
+        sc_trace_watch* w = watches[i];
+        if (w->sig != 0) {
+            if (w->prev != 0)
+                w->prev->next = w->next;
+            else
+                w->sig->trace_watchers = w->next;
+            if (w->next != 0)
+                w->next->prev = w->prev;
+        }
+        delete w;
+    }
+    for (i = 0; i < polled.size(); i++)
+        delete polled[i];
+}
+
+void sc_trace_file::trace_added()
+{
+    sc_trace_watch* w = new sc_trace_watch;
+    w->tf = this;
+    w->index = num_traces++;
+    w->dirty = false;
+    w->sig = traced_signal;
+    w->prev = 0;
+    if (traced_signal == 0) {
+        w->next = 0;
+        polled.push_back(w);
+        return;
+    }
+    w->next = traced_signal->trace_watchers;
+    if (w->next != 0)
+        w->next->prev = w;
+    traced_signal->trace_watchers = w;
+    watches.push_back(w);
+}
+
+static int
+compare_watch_index(const void* a, const void* b)
+{
+    return (*(const sc_trace_watch* const*) a)->index
+         - (*(const sc_trace_watch* const*) b)->index;
+}
+
+/* The dirty watches, sorted, are merged with the polled ones.  Sorting
+   keeps the order of the old full scan, so the output does not depend
+   on the order in which the signals were updated. */
+sc_trace_watch* const* sc_trace_file::traces_to_check(int& n)
+{
+    if (dirty.size() == 0) {
+        n = polled.size();
+        return polled.raw_data();
+    }
+
+    dirty.sort(compare_watch_index);
+    to_check.erase_all();
+    sc_trace_watch* const* d = dirty.raw_data();
+    sc_trace_watch* const* p = polled.raw_data();
+    int nd = dirty.size();
+    int np = polled.size();
+    int i = 0, j = 0;
+    while (i < nd || j < np) {
+        if (j == np || (i < nd && d[i]->index < p[j]->index)) {
+            d[i]->dirty = false;
+            to_check.push_back(d[i++]);
+        }
+        else {
+            to_check.push_back(p[j++]);
+        }
+    }
+    dirty.erase_all();
+    n = to_check.size();
+    return to_check.raw_data();
+}
+
+void sc_trace_file::clear_dirty()
+{
+    for (int i = 0; i < dirty.size(); i++)
+        dirty[i]->dirty = false;
+    dirty.erase_all();
+}
+
+void sc_trace_file::forget_signal(const sc_signal_base* sig)
+{
+    sc_trace_watch* w = sig->trace_watchers;
+    while (w != 0) {
+        sc_trace_watch* next = w->next;
+        w->sig = 0;
+        w->next = 0;
+        w->prev = 0;
+        w = next;
+    }
+    sig->trace_watchers = 0;
+}
+
+void sc_trace_notify(sc_trace_watch* watchers)
+{
+    for (sc_trace_watch* w = watchers; w != 0; w = w->next) {
+        if (! w->dirty) {
+            w->dirty = true;
+            w->tf->dirty.push_back(w);
+        }
+    }
 }
 
 void tprintf(sc_trace_file* tf,  const char* format, ...)
@@ -89,23 +204,63 @@ void sc_trace_file::delta_cycles(bool)
   /* Intentionally blank */
 }
 
+void sc_trace_file::set_trigger(bool (*condition)(void*), void* arg, int depth)
+{
+    assert(condition != 0 && depth >= 0);
+    trigger_condition = condition;
+    trigger_arg = arg;
+    trigger_armed = true;
+    history_depth = depth;
+}
+
+void sc_trace_file::set_trigger_time(double t, int depth)
+{
+    assert(depth >= 0);
+    trigger_condition = 0;
+    trigger_time = sc_seconds_to_ticks(t);
+    trigger_armed = true;
+    history_depth = depth;
+}
+
+bool sc_trace_file::keeps_history() const
+{
+    return false;
+}
+
+/* The trigger is only checked at time steps, so that a condition on
+   signal values sees them settled. */
+void sc_trace_file::kernel_cycle(bool delta_cycle)
+{
+    if (trigger_armed && ! delta_cycle) {
+        if (trigger_condition != 0 ? (*trigger_condition)(trigger_arg)
+                                   : sc_time_stamp_ticks() >= trigger_time)
+            trigger_armed = false;
+    }
+    if (! trigger_armed || keeps_history())
+        cycle(delta_cycle);
+}
+
 void sc_trace(sc_trace_file *tf, const sc_signal<char>& object, const sc_string& name, int width) 
 {
+    sc_trace_signal_scope scope(tf, &object);
     if (tf) tf->trace(*(object.get_data_ptr()), name, width);
 }
 
 void sc_trace(sc_trace_file *tf, const sc_signal<short>& object, const sc_string& name, int width) 
 {
+    sc_trace_signal_scope scope(tf, &object);
     if (tf) tf->trace(*(object.get_data_ptr()), name, width);
 }
 
 void sc_trace(sc_trace_file *tf, const sc_signal<int>& object, const sc_string& name, int width) 
 {
+    sc_trace_signal_scope scope(tf, &object);
     if (tf) tf->trace(*(object.get_data_ptr()), name, width);
 }
 
 void sc_trace(sc_trace_file *tf, const sc_signal<long>& object, const sc_string& name, int width) 
 {
+    sc_trace_signal_scope scope(tf, &object);
     if (tf) tf->trace(*(object.get_data_ptr()), name, width);
 }
 
@@ -128,3 +283,12 @@ void double_to_special_int64(double in, unsigned* high, unsigned* low)
     else *low = (unsigned)rest;
 }
 
+void ticks_to_special_int64(sc_ticks in, unsigned* high, unsigned* low)
+{
+    sc_ticks invar = in;
+    if(invar > (sc_ticks) 5e17) invar = (sc_ticks) 5e17; // Saturation limit
+    if(invar < 0) invar = 0;
+    *high = (unsigned)(invar / 1000000000);
+    *low = (unsigned)(invar % 1000000000);
+}
+
@@ -47,6 +47,8 @@
 #define SC_TRACE_H
 
 #include "sc_string.h"
+#include "sc_time_base.h"
+#include "sc_vector.h"
 
 //Some forward declarations
 class sc_logic;
@@ -72,15 +74,36 @@ template <class A> class sc_signal_array;
 template <class T> class sc_channel;
 template <class A> class sc_channel_array;
 class sc_signal_resolved_vector;
+class sc_signal_base;
+class sc_trace_file;
+
+// Subscription of a trace to the signal it reads.  The kernel marks the
+// trace dirty whenever an update changes the signal.
+struct sc_trace_watch {
+    sc_trace_file*        tf;
+    int                   index;    // of the trace in the trace file
+    bool                  dirty;
+    const sc_signal_base* sig;      // 0 if the trace does not read a signal
+    sc_trace_watch*       next;     // in the signal's trace_watchers list
+    sc_trace_watch*       prev;
+};
+
+extern void sc_trace_notify( sc_trace_watch* watchers );
 
 // Base class for all kinds of trace files. 
 
 class sc_trace_file {
     friend class sc_simcontext;
+    friend class sc_signal_base;
+    friend void sc_trace_notify( sc_trace_watch* watchers );
     
 public:
     // Constructor
     sc_trace_file();
+
+    // The signal that the traces added next read, or 0.  Set by the
+    // sc_trace() functions for signals; see sc_trace_signal_scope.
+    void set_traced_signal(const sc_signal_base* sig) { traced_signal = sig; }
     
     // All functions are pure virtual because they need to be defined by the
     // particular tracing mechanism
@@ -184,12 +207,83 @@ public:
     // Also trace transitions between delta cycles if flag is true.
     virtual void delta_cycles(bool flag);
 
+    // Capture window.  Nothing is written until the trigger fires:
+    // when condition(arg) first returns true, which is checked at each
+    // time step, or at the time t (in seconds).  A file that keeps a
+    // history (VCD) then also writes out the last `depth' cycles that
+    // changed a value before the trigger; the others start at the
+    // trigger.  Must be called before the simulation starts.
+    void set_trigger(bool (*condition)(void* arg), void* arg, int depth = 0);
+    void set_trigger_time(double t, int depth = 0);
+
+    // Whether the trigger has fired, or there is none
+    bool triggered() const { return ! trigger_armed; }
+
 protected:
     // Write trace info for cycle.
     virtual void cycle(bool delta_cycle) = 0;
 
     // Flush results and close file.
-    virtual ~sc_trace_file() { /* Intentionally blank */ };
+    virtual ~sc_trace_file();
+
+    // The derived classes call this for each trace they add, in order.
+    // A trace that reads a signal is only checked for changes after
+    // an update has changed the signal; the others are always checked.
+    void trace_added();
+
+    // The traces that may have changed since the last call, in the
+    // order they were added; `n' is set to their number.
+    sc_trace_watch* const* traces_to_check(int& n);
+
+    // Forgets the changes marked so far; called after writing the
+    // values of all the traces.
+    void clear_dirty();
+
+    // The depth given with the trigger
+    int trigger_depth() const { return history_depth; }
+
+    // Whether cycle() is to be called before the trigger fires, for the
+    // file to keep a history; false unless redefined.
+    virtual bool keeps_history() const;
+
+private:
+    // Called by the kernel in place of cycle(); checks the trigger
+    void kernel_cycle(bool delta_cycle);
+
+    // Called when a signal is destroyed
+    static void forget_signal(const sc_signal_base* sig);
+
+    const sc_signal_base* traced_signal;
+    int num_traces;
+
+    sc_pvector<sc_trace_watch*> watches;     // of the traces that read a signal
+    sc_pvector<sc_trace_watch*> polled;      // of the other traces
+    sc_pvector<sc_trace_watch*> dirty;       // watches marked since the last check
+    sc_pvector<sc_trace_watch*> to_check;
+
+    bool (*trigger_condition)(void* arg);   // 0 for a trigger time
+    void* trigger_arg;
+    sc_ticks trigger_time;
+    bool trigger_armed;
+    int history_depth;
+};
+
+//
+//  <summary> Subscribes the traces added in its scope to a signal </summary>
+//
+class sc_trace_signal_scope {
+public:
+    sc_trace_signal_scope(sc_trace_file* _tf, const sc_signal_base* sig) : tf(_tf)
+    {
+        if (tf) tf->set_traced_signal(sig);
+    }
+    ~sc_trace_signal_scope()
+    {
+        if (tf) tf->set_traced_signal(0);
+    }
+
+private:
+    sc_trace_file* tf;
 };
 
 /***************************************************************************************************/
@@ -346,6 +440,7 @@ inline void sc_trace(sc_trace_file *tf, const double* object, const sc_string& n
 template< class T > 
 inline void sc_trace(sc_trace_file *tf, const sc_signal<T>& object, const sc_string& name)
 {
+    sc_trace_signal_scope scope(tf, &object);
     sc_trace(tf, *(object.get_data_ptr()), name);
 }
 
@@ -363,6 +458,7 @@ inline void sc_trace(sc_trace_file *tf, const sc_signal<T>& object, const sc_str
 template< class T >
 inline void sc_trace(sc_trace_file *tf, const sc_signal<T>& object, const char* name)
 {
+    sc_trace_signal_scope scope(tf, &object);
     sc_trace(tf, *(object.get_data_ptr()), name);
 }
 
@@ -538,5 +634,6 @@ void tprintf(sc_trace_file* tf,  const char* format, ...);
 
 // Convert double time to 64-bit integer
 extern void double_to_special_int64(double in, unsigned* high, unsigned* low);
+extern void ticks_to_special_int64(sc_ticks in, unsigned* high, unsigned* low);
 
 #endif
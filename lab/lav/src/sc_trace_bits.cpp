@@ -0,0 +1,59 @@
+/******************************************************************************
+    Copyright (c) 1996-2000 Synopsys, Inc.    ALL RIGHTS RESERVED
+
+  The contents of this file are subject to the restrictions and limitations
+  set forth in the SystemC(TM) Open Community License Software Download and
+  Use License Version 1.1 (the "License"); you may not use this file except
+  in compliance with such restrictions and limitations. You may obtain
+  instructions on how to receive a copy of the License at
+  http://www.systemc.org/. Software distributed by Original Contributor
+  under the License is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+  ANY KIND, either express or implied. See the License for the specific
+  language governing rights and limitations under the License.
+
+******************************************************************************/
+
+/******************************************************************************
+
+    sc_trace_bits.cpp -- fast conversion of bit values to text for the trace files.
+
+******************************************************************************/
+
+/******************************************************************************
+
+    MODIFICATION LOG - modifiers, enter your name, affliation and
+    changes you are making here:
+
+    Modifier Name & Affiliation:
+    Description of Modification:
+
+
+******************************************************************************/
+
+
+#include "sc_trace_bits.h"
+
+#define SC_BITS_1(n) { '0' + (((n) >> 7) & 1), '0' + (((n) >> 6) & 1), \
+                       '0' + (((n) >> 5) & 1), '0' + (((n) >> 4) & 1), \
+                       '0' + (((n) >> 3) & 1), '0' + (((n) >> 2) & 1), \
+                       '0' + (((n) >> 1) & 1), '0' + ((n) & 1) }
+#define SC_BITS_2(n)   SC_BITS_1(n),  SC_BITS_1((n) + 1)
+#define SC_BITS_4(n)   SC_BITS_2(n),  SC_BITS_2((n) + 2)
+#define SC_BITS_8(n)   SC_BITS_4(n),  SC_BITS_4((n) + 4)
+#define SC_BITS_16(n)  SC_BITS_8(n),  SC_BITS_8((n) + 8)
+#define SC_BITS_32(n)  SC_BITS_16(n), SC_BITS_16((n) + 16)
+#define SC_BITS_64(n)  SC_BITS_32(n), SC_BITS_32((n) + 32)
+#define SC_BITS_128(n) SC_BITS_64(n), SC_BITS_64((n) + 64)
+
+const char sc_trace_byte_bits[256][8] = {
+    SC_BITS_128(0), SC_BITS_128(128)
+};
+
+#undef SC_BITS_1
+#undef SC_BITS_2
+#undef SC_BITS_4
+#undef SC_BITS_8
+#undef SC_BITS_16
+#undef SC_BITS_32
+#undef SC_BITS_64
+#undef SC_BITS_128
@@ -0,0 +1,133 @@
+/******************************************************************************
+    Copyright (c) 1996-2000 Synopsys, Inc.    ALL RIGHTS RESERVED
+
+  The contents of this file are subject to the restrictions and limitations
+  set forth in the SystemC(TM) Open Community License Software Download and
+  Use License Version 1.1 (the "License"); you may not use this file except
+  in compliance with such restrictions and limitations. You may obtain
+  instructions on how to receive a copy of the License at
+  http://www.systemc.org/. Software distributed by Original Contributor
+  under the License is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+  ANY KIND, either express or implied. See the License for the specific
+  language governing rights and limitations under the License.
+
+******************************************************************************/
+
+/******************************************************************************
+
+    sc_trace_bits.h -- fast conversion of bit values to text for the trace files.
+
+******************************************************************************/
+
+/******************************************************************************
+
+    MODIFICATION LOG - modifiers, enter your name, affliation and
+    changes you are making here:
+
+    Modifier Name & Affiliation:
+    Description of Modification:
+
+
+******************************************************************************/
+
+
+#ifndef SC_TRACE_BITS_H
+#define SC_TRACE_BITS_H
+
+#include <string.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#ifndef WIN32
+typedef unsigned long long sc_trace_uint64;
+#else
+typedef unsigned __int64   sc_trace_uint64;
+#endif
+
+/* The text of each byte: 8 characters '0' and '1', most significant
+   bit first, not terminated. */
+extern const char sc_trace_byte_bits[256][8];
+
+    // Number of bits of v without its leading zeros (0 if v is 0)
+inline int
+sc_trace_bit_length( sc_trace_uint64 v )
+{
+    if (v == 0)
+        return 0;
+#if defined(__GNUC__)
+    return 64 - __builtin_clzll( v );
+#elif defined(_MSC_VER) && defined(_WIN64)
+    unsigned long i;
+    _BitScanReverse64( &i, v );
+    return (int) i + 1;
+#else
+    int n = 1;
+    if (v >> 32) { n += 32; v >>= 32; }
+    if (v >> 16) { n += 16; v >>= 16; }
+    if (v >> 8)  { n += 8;  v >>= 8; }
+    if (v >> 4)  { n += 4;  v >>= 4; }
+    if (v >> 2)  { n += 2;  v >>= 2; }
+    if (v >> 1)  { n += 1; }
+    return n;
+#endif
+}
+
+    // Writes the `nbits' (at most 64) low bits of v to dst as '0' and
+    // '1', most significant first, and returns the end of the text,
+    // which is not terminated.  The bits go a byte at a time.
+inline char*
+sc_trace_put_bits( char* dst, sc_trace_uint64 v, int nbits )
+{
+    int head = nbits & 7;
+    if (head != 0) {
+        memcpy( dst, sc_trace_byte_bits[(v >> (nbits - head)) & 0xff] + 8 - head, head );
+        dst += head;
+    }
+    for (int shift = nbits - head - 8; shift >= 0; shift -= 8) {
+        memcpy( dst, sc_trace_byte_bits[(v >> shift) & 0xff], 8 );
+        dst += 8;
+    }
+    return dst;
+}
+
+    // Number of bits without the leading zeros of an `nbits' bit
+    // number held in digits of `bits_per_digit' bits, least
+    // significant first.  The bits of the last digit above `nbits'
+    // are ignored.
+template<class D>
+inline int
+sc_trace_bit_length( const D* digits, int bits_per_digit, int nbits )
+{
+    if (nbits <= 0)
+        return 0;
+    int top = (nbits - 1) / bits_per_digit;
+    int top_bits = nbits - top * bits_per_digit;
+    sc_trace_uint64 d = digits[top];
+    if (top_bits < 64)
+        d &= ((sc_trace_uint64) 1 << top_bits) - 1;
+    for (int i = top; ; ) {
+        if (d != 0)
+            return i * bits_per_digit + sc_trace_bit_length( d );
+        if (--i < 0)
+            return 0;
+        d = digits[i];
+    }
+}
+
+    // sc_trace_put_bits() for an `nbits' bit number held in digits of
+    // `bits_per_digit' (at most 64) bits, least significant first
+template<class D>
+inline char*
+sc_trace_put_bits( char* dst, const D* digits, int bits_per_digit, int nbits )
+{
+    if (nbits <= 0)
+        return dst;
+    int top = (nbits - 1) / bits_per_digit;
+    dst = sc_trace_put_bits( dst, digits[top], nbits - top * bits_per_digit );
+    for (int i = top - 1; i >= 0; --i)
+        dst = sc_trace_put_bits( dst, digits[i], bits_per_digit );
+    return dst;
+}
+
+#endif
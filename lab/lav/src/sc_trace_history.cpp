@@ -0,0 +1,110 @@
+/******************************************************************************
+    Copyright (c) 1996-2000 Synopsys, Inc.    ALL RIGHTS RESERVED
+
+  The contents of this file are subject to the restrictions and limitations
+  set forth in the SystemC(TM) Open Community License Software Download and
+  Use License Version 1.1 (the "License"); you may not use this file except
+  in compliance with such restrictions and limitations. You may obtain
+  instructions on how to receive a copy of the License at
+  http://www.systemc.org/. Software distributed by Original Contributor
+  under the License is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+  ANY KIND, either express or implied. See the License for the specific
+  language governing rights and limitations under the License.
+
+******************************************************************************/
+
+/******************************************************************************
+
+    sc_trace_history.cpp -- the last cycles of a trace file before its trigger.
+
+******************************************************************************/
+
+/******************************************************************************
+
+    MODIFICATION LOG - modifiers, enter your name, affliation and
+    changes you are making here:
+
+    Modifier Name & Affiliation:
+    Description of Modification:
+
+
+******************************************************************************/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "sc_trace_history.h"
+
+sc_trace_history::sc_trace_history( int l_depth, sc_trace_history_reader d,
+                                    void* arg )
+{
+    assert( l_depth > 0 );
+    drop = d;
+    drop_arg = arg;
+    depth = l_depth;
+    cycles = new cycle[depth];
+    for (int i = 0; i < depth; ++i) {
+        cycles[i].data = 0;
+        cycles[i].len = 0;
+        cycles[i].alloc = 0;
+    }
+    first = 0;
+    num = 0;
+    last = 0;
+}
+
+sc_trace_history::~sc_trace_history()
+{
+    for (int i = 0; i < depth; ++i)
+        free( cycles[i].data );
+    delete[] cycles;
+}
+
+void
+sc_trace_history::begin_cycle()
+{
+    if (num == depth) {
+        cycle* c = cycles + first;
+        (*drop)( drop_arg, c->data, c->len );
+        first = (first + 1) % depth;
+        num--;
+    }
+    last = (first + num) % depth;
+    cycles[last].len = 0;
+    num++;
+}
+
+void
+sc_trace_history::put( const void* data, int n )
+{
+    memcpy( reserve( n ), data, n );
+    commit( n );
+}
+
+void
+sc_trace_history::grow( int n )
+{
+    assert( num > 0 );    /* else no cycle was begun */
+    cycle* c = cycles + last;
+    c->alloc = 2 * c->alloc + n + 256;
+    c->data = (char*) realloc( c->data, c->alloc );
+    if (c->data == 0) {
+        fprintf( stderr, "FATAL: out of memory for the trace history\n" );
+        exit( 1 );
+    }
+}
+
+void
+sc_trace_history::replay( sc_trace_history_reader reader, void* arg )
+{
+    for (int i = 0; i < num; ++i) {
+        cycle* c = cycles + (first + i) % depth;
+        (*reader)( arg, c->data, c->len );
+    }
+    first = 0;
+    num = 0;
+    last = 0;
+}
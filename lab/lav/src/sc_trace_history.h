@@ -0,0 +1,95 @@
+/******************************************************************************
+    Copyright (c) 1996-2000 Synopsys, Inc.    ALL RIGHTS RESERVED
+
+  The contents of this file are subject to the restrictions and limitations
+  set forth in the SystemC(TM) Open Community License Software Download and
+  Use License Version 1.1 (the "License"); you may not use this file except
+  in compliance with such restrictions and limitations. You may obtain
+  instructions on how to receive a copy of the License at
+  http://www.systemc.org/. Software distributed by Original Contributor
+  under the License is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+  ANY KIND, either express or implied. See the License for the specific
+  language governing rights and limitations under the License.
+
+******************************************************************************/
+
+/******************************************************************************
+
+    sc_trace_history.h -- the last cycles of a trace file before its trigger.
+
+******************************************************************************/
+
+/******************************************************************************
+
+    MODIFICATION LOG - modifiers, enter your name, affliation and
+    changes you are making here:
+
+    Modifier Name & Affiliation:
+    Description of Modification:
+
+
+******************************************************************************/
+
+
+#ifndef SC_TRACE_HISTORY_H
+#define SC_TRACE_HISTORY_H
+
+    // Given the records of one cycle
+typedef void (*sc_trace_history_reader)( void* arg, const char* data, int len );
+
+//
+//  <summary> Records of the last cycles before a trigger </summary>
+//
+//  A trace file that waits for its trigger (see
+//  sc_trace_file::set_trigger()) appends the records of each cycle
+//  here instead of writing them.  Only the last `depth' cycles are
+//  kept: when a new cycle starts in a full history, the oldest one is
+//  given to the `drop' function, so that the file can fold it into the
+//  values at the start of the window, and its memory is reused.  When
+//  the trigger fires, replay() hands the cycles kept to the writer.
+//
+class sc_trace_history {
+public:
+    sc_trace_history( int depth, sc_trace_history_reader drop, void* arg );
+    ~sc_trace_history();
+
+        // Starts the records of a new cycle
+    void begin_cycle();
+
+        // Room for a record of up to `n' bytes, which is appended to
+        // the current cycle by commit()
+    char* reserve( int n )
+    {
+        cycle* c = cycles + last;
+        if (c->len + n > c->alloc)
+            grow( n );
+        return c->data + c->len;
+    }
+    void commit( int n ) { cycles[last].len += n; }
+
+    void put( const void* data, int n );
+
+        // Passes the cycles kept to `reader', oldest first, and empties
+        // the history
+    void replay( sc_trace_history_reader reader, void* arg );
+
+private:
+    void grow( int n );
+
+    struct cycle {
+        char* data;
+        int   len;
+        int   alloc;
+    };
+
+    sc_trace_history_reader drop;
+    void*                   drop_arg;
+
+    cycle* cycles;        /* ring of `depth' cycles */
+    int    depth;
+    int    first;         /* the oldest cycle kept */
+    int    num;           /* cycles kept */
+    int    last;          /* the cycle being recorded */
+};
+
+#endif
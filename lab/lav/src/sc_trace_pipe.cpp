@@ -0,0 +1,208 @@
+/******************************************************************************
+    Copyright (c) 1996-2000 Synopsys, Inc.    ALL RIGHTS RESERVED
+
+  The contents of this file are subject to the restrictions and limitations
+  set forth in the SystemC(TM) Open Community License Software Download and
+  Use License Version 1.1 (the "License"); you may not use this file except
+  in compliance with such restrictions and limitations. You may obtain
+  instructions on how to receive a copy of the License at
+  http://www.systemc.org/. Software distributed by Original Contributor
+  under the License is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+  ANY KIND, either express or implied. See the License for the specific
+  language governing rights and limitations under the License.
+
+******************************************************************************/
+
+/******************************************************************************
+
+    sc_trace_pipe.cpp -- hands trace records to a writer thread.
+
+******************************************************************************/
+
+/******************************************************************************
+
+    MODIFICATION LOG - modifiers, enter your name, affliation and
+    changes you are making here:
+
+    Modifier Name & Affiliation:
+    Description of Modification:
+
+
+******************************************************************************/
+
+
+#include <string.h>
+#include <assert.h>
+
+#ifdef WIN32
+#include "sc_cmnhdr.h"
+#include <Windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#include "sc_trace_pipe.h"
+
+struct sc_trace_pipe_sync {
+#ifdef WIN32
+    HANDLE             thread;
+    SRWLOCK            lock;
+    CONDITION_VARIABLE full_cond;   /* a page was handed over */
+    CONDITION_VARIABLE free_cond;   /* a page was written */
+#else
+    pthread_t          thread;
+    pthread_mutex_t    lock;
+    pthread_cond_t     full_cond;
+    pthread_cond_t     free_cond;
+#endif
+};
+
+#ifdef WIN32
+static inline void lock_pipe( sc_trace_pipe_sync* s )   { AcquireSRWLockExclusive( &s->lock ); }
+static inline void unlock_pipe( sc_trace_pipe_sync* s ) { ReleaseSRWLockExclusive( &s->lock ); }
+static inline void wake_pipe( CONDITION_VARIABLE* c )   { WakeConditionVariable( c ); }
+static inline void wait_pipe( sc_trace_pipe_sync* s, CONDITION_VARIABLE* c )
+{
+    SleepConditionVariableSRW( c, &s->lock, INFINITE, 0 );
+}
+#else
+static inline void lock_pipe( sc_trace_pipe_sync* s )   { pthread_mutex_lock( &s->lock ); }
+static inline void unlock_pipe( sc_trace_pipe_sync* s ) { pthread_mutex_unlock( &s->lock ); }
+static inline void wake_pipe( pthread_cond_t* c )       { pthread_cond_signal( c ); }
+static inline void wait_pipe( sc_trace_pipe_sync* s, pthread_cond_t* c )
+{
+    pthread_cond_wait( c, &s->lock );
+}
+#endif
+
+
+sc_trace_pipe::sc_trace_pipe( sc_trace_pipe_reader r, void* arg,
+                              int l_page_size, int l_num_pages )
+{
+    assert( l_num_pages >= 2 );
+
+    reader     = r;
+    reader_arg = arg;
+    page_size  = l_page_size;
+    num_pages  = l_num_pages;
+
+    full       = new char*[num_pages];
+    full_len   = new int[num_pages];
+    first_full = 0;
+    num_full   = 0;
+    free_pages = new char*[num_pages];
+    num_free   = 0;
+    for (int i = 1; i < num_pages; ++i)
+        free_pages[num_free++] = new char[page_size];
+    curr = new char[page_size];
+    fill = 0;
+
+    shutting_down = false;
+
+    sync = new sc_trace_pipe_sync;
+#ifdef WIN32
+    InitializeSRWLock( &sync->lock );
+    InitializeConditionVariable( &sync->full_cond );
+    InitializeConditionVariable( &sync->free_cond );
+    sync->thread = CreateThread( NULL, 0, writer_main, this, 0, NULL );
+#else
+    pthread_mutex_init( &sync->lock, 0 );
+    pthread_cond_init( &sync->full_cond, 0 );
+    pthread_cond_init( &sync->free_cond, 0 );
+    pthread_create( &sync->thread, 0, writer_main, this );
+#endif
+}
+
+sc_trace_pipe::~sc_trace_pipe()
+{
+    if (fill > 0)
+        hand_over();
+
+    /* The writer empties the queue before it looks at shutting_down */
+    lock_pipe( sync );
+    shutting_down = true;
+    wake_pipe( &sync->full_cond );
+    unlock_pipe( sync );
+#ifdef WIN32
+    WaitForSingleObject( sync->thread, INFINITE );
+    CloseHandle( sync->thread );
+#else
+    pthread_join( sync->thread, 0 );
+    pthread_cond_destroy( &sync->free_cond );
+    pthread_cond_destroy( &sync->full_cond );
+    pthread_mutex_destroy( &sync->lock );
+#endif
+    delete sync;
+
+    delete[] curr;
+    for (int i = 0; i < num_free; ++i)
+        delete[] free_pages[i];
+    delete[] free_pages;
+    delete[] full_len;
+    delete[] full;
+}
+
+void
+sc_trace_pipe::put( const void* data, int n )
+{
+    memcpy( reserve( n ), data, n );
+    commit( n );
+}
+
+void
+sc_trace_pipe::next_page()
+{
+    assert( fill > 0 );   /* else the record is larger than a page */
+    hand_over();
+}
+
+/* Queues the current page and takes a free one, waiting for the writer
+   if there is none. */
+void
+sc_trace_pipe::hand_over()
+{
+    lock_pipe( sync );
+    full[(first_full + num_full) % num_pages] = curr;
+    full_len[(first_full + num_full) % num_pages] = fill;
+    ++num_full;
+    wake_pipe( &sync->full_cond );
+    while (num_free == 0)
+        wait_pipe( sync, &sync->free_cond );
+    curr = free_pages[--num_free];
+    unlock_pipe( sync );
+    fill = 0;
+}
+
+#ifdef WIN32
+unsigned long __stdcall
+sc_trace_pipe::writer_main( void* arg )
+#else
+void*
+sc_trace_pipe::writer_main( void* arg )
+#endif
+{
+    sc_trace_pipe* pipe = (sc_trace_pipe*) arg;
+    sc_trace_pipe_sync* sync = pipe->sync;
+
+    lock_pipe( sync );
+    while (true) {
+        while (pipe->num_full == 0 && ! pipe->shutting_down)
+            wait_pipe( sync, &sync->full_cond );
+        if (pipe->num_full == 0)
+            break;
+
+        char* page = pipe->full[pipe->first_full];
+        int len = pipe->full_len[pipe->first_full];
+        pipe->first_full = (pipe->first_full + 1) % pipe->num_pages;
+        --pipe->num_full;
+        unlock_pipe( sync );
+
+        (*pipe->reader)( pipe->reader_arg, page, len );
+
+        lock_pipe( sync );
+        pipe->free_pages[pipe->num_free++] = page;
+        wake_pipe( &sync->free_cond );
+    }
+    unlock_pipe( sync );
+    return 0;
+}
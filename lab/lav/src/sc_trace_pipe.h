@@ -0,0 +1,106 @@
+/******************************************************************************
+    Copyright (c) 1996-2000 Synopsys, Inc.    ALL RIGHTS RESERVED
+
+  The contents of this file are subject to the restrictions and limitations
+  set forth in the SystemC(TM) Open Community License Software Download and
+  Use License Version 1.1 (the "License"); you may not use this file except
+  in compliance with such restrictions and limitations. You may obtain
+  instructions on how to receive a copy of the License at
+  http://www.systemc.org/. Software distributed by Original Contributor
+  under the License is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+  ANY KIND, either express or implied. See the License for the specific
+  language governing rights and limitations under the License.
+
+******************************************************************************/
+
+/******************************************************************************
+
+    sc_trace_pipe.h -- hands trace records to a writer thread.
+
+******************************************************************************/
+
+/******************************************************************************
+
+    MODIFICATION LOG - modifiers, enter your name, affliation and
+    changes you are making here:
+
+    Modifier Name & Affiliation:
+    Description of Modification:
+
+
+******************************************************************************/
+
+
+#ifndef SC_TRACE_PIPE_H
+#define SC_TRACE_PIPE_H
+
+struct sc_trace_pipe_sync;
+
+    // Called on the writer thread with the records of one page
+typedef void (*sc_trace_pipe_reader)( void* arg, const char* data, int len );
+
+//
+//  <summary> Hands trace records to a writer thread </summary>
+//
+//  The simulation thread appends records to a page of its own, with no
+//  locking or system calls.  Only when the page is full is it handed to
+//  the writer thread, which passes it to the reader function and then
+//  returns it for reuse.  A record never straddles two pages.
+//
+//  The pipe has a fixed number of pages.  When the writer falls behind
+//  and all of them are waiting to be written, the simulation thread
+//  blocks until one comes back, so the memory used stays bounded.
+//
+class sc_trace_pipe {
+public:
+    sc_trace_pipe( sc_trace_pipe_reader reader, void* arg,
+                   int page_size = 1 << 20, int num_pages = 4 );
+
+        // Writes out everything, then stops the writer thread
+    ~sc_trace_pipe();
+
+        // Room for a record of up to `n' bytes, which is appended by
+        // commit()
+    char* reserve( int n )
+    {
+        if (fill + n > page_size)
+            next_page();
+        return curr + fill;
+    }
+    void commit( int n ) { fill += n; }
+
+    void put( const void* data, int n );
+
+private:
+    void next_page();
+    void hand_over();
+
+#ifdef WIN32
+    static unsigned long __stdcall writer_main( void* arg );
+#else
+    static void* writer_main( void* arg );
+#endif
+
+private:
+    sc_trace_pipe_reader reader;
+    void*                reader_arg;
+
+    int   page_size;
+    char* curr;                   /* the page being filled */
+    int   fill;
+
+    /* Pages waiting to be written, oldest first, and free pages; both
+       are guarded by the lock in `sync' */
+    int    num_pages;
+    char** full;
+    int*   full_len;
+    int    first_full;
+    int    num_full;
+    char** free_pages;
+    int    num_free;
+    bool   shutting_down;
+
+    sc_trace_pipe_sync* sync;     /* platform-dependent */
+};
+
+#endif
@@ -49,6 +49,7 @@
 #include <assert.h>
 #include <time.h>
 #include <stdlib.h>
+#include <string.h>
 #ifdef __BCPLUSPLUS__
 #pragma hdrstop
 #endif
@@ -63,6 +64,9 @@
 #include "numeric_bit/numeric_bit.h"
 #include "sc_resolved.h"
 #include "sc_dump.h"
+#include "sc_trace_pipe.h"
+#include "sc_trace_history.h"
+#include "sc_trace_bits.h"
 
 static bool running_regression = false;
 
@@ -76,6 +80,49 @@ static void vcd_put_error_message(const char* msg, bool just_warning);
 // Remove name problems associated with [] in vcd names
 static void remove_vcd_name_problems(sc_string& name);
 
+// Print the time of a cycle
+static void print_vcd_time(FILE* f, unsigned units_high, unsigned units_low);
+
+// Records passed to the writer thread in asynchronous mode.  Each one
+// starts with the tag, followed by the listed fields (not aligned).
+enum vcd_record_tag {
+    VCD_REC_TIME,      // unsigned high, unsigned low
+    VCD_REC_VALUE,     // int trace index, int length, the captured value
+    VCD_REC_END,       // end of a cycle
+    VCD_REC_TEXT       // int length, the text
+};
+
+// Size of the record at data
+static int vcd_record_size(const char* data)
+{
+    int rec[3];
+    memcpy(rec, data, sizeof(int));
+    switch (rec[0]) {
+    case VCD_REC_TIME:
+        return 3 * sizeof(int);
+    case VCD_REC_VALUE:
+        memcpy(rec, data, 3 * sizeof(int));
+        return 3 * sizeof(int) + rec[2];
+    case VCD_REC_END:
+        return sizeof(int);
+    case VCD_REC_TEXT:
+        memcpy(rec, data, 2 * sizeof(int));
+        return 2 * sizeof(int) + rec[1];
+    default:
+        assert(false);
+        return 0;
+    }
+}
+
+// Makes a text record in buf, and returns its size
+static int vcd_text_record(char* buf, const char* text)
+{
+    int rec[2] = { VCD_REC_TEXT, (int) strlen(text) };
+    memcpy(buf, rec, sizeof(rec));
+    memcpy(buf + sizeof(rec), text, rec[1]);
+    return sizeof(rec) + rec[1];
+}
+
 
 /*****************************************************************************/
 
@@ -84,13 +131,22 @@ class vcd_trace {
 public:
     vcd_trace(const sc_string& _name, const sc_string& _vcd_name);
 
+    // Writes the current value and makes it the old value
+    void write(FILE* f);
+
     // Needs to be pure virtual as has to be defined by the particular
-    // type being traced
-    virtual void write(FILE* f) = 0;
+    // type being traced.  Stores the current value in buf, makes it
+    // the old value, and returns the number of bytes used; at most
+    // bit_width + 1, or 8 for types that store binary values.
+    virtual int capture(char* buf) = 0;
+
+    // Writes a value stored by capture().  By default the value is
+    // the VCD characters of the bits, terminated by '\0'.
+    virtual void write_captured(FILE* f, const char* buf);
     
     virtual void set_width();
 
-    static char* strip_leading_bits(char* originalbuf);
+    static const char* strip_leading_bits(const char* originalbuf);
 
     // Comparison function needs to be pure virtual too
     virtual bool changed() = 0;
@@ -98,7 +154,12 @@ public:
     // Make this virtual as some derived classes may overwrite
     virtual void print_variable_declaration_line(FILE* f);
 
-    void compose_data_line(char* rawdata, char* compdata);
+    void compose_data_line(const char* rawdata, char* compdata);
+
+    // Compose the data line of a two-valued value straight from its
+    // bits, with the leading zeros stripped as above
+    void compose_uint_line(sc_trace_uint64 value, char* compdata);
+    void compose_digits_line(const digit_type* digits, char* compdata);
 
     virtual ~vcd_trace();
 
@@ -114,8 +175,22 @@ vcd_trace::vcd_trace(const sc_string& _name, const sc_string& _vcd_name)
 {
     /* Intentionally blank */
 }
+
+void vcd_trace::write(FILE* f)
+{
+    char buf[1000];
+    capture(buf);
+    write_captured(f, buf);
+}
+
+void vcd_trace::write_captured(FILE* f, const char* buf)
+{
+    char compdata[1000];
+    compose_data_line(buf, compdata);
+    fputs(compdata, f);
+}
         
-void vcd_trace::compose_data_line(char* rawdata, char* compdata)
+void vcd_trace::compose_data_line(const char* rawdata, char* compdata)
 {
     assert(rawdata != compdata);
 
@@ -127,12 +202,56 @@ void vcd_trace::compose_data_line(char* rawdata, char* compdata)
             strcpy(&(compdata[1]), vcd_name);
         }
         else{
-            char* effective_begin = strip_leading_bits(rawdata);
+            const char* effective_begin = strip_leading_bits(rawdata);
             sprintf(compdata, "b%s %s", effective_begin, (const char *) vcd_name);
         }
     }
 }
 
+void vcd_trace::compose_uint_line(sc_trace_uint64 value, char* compdata)
+{
+    if (bit_width == 0) {
+        compdata[0] = '\0';
+        return;
+    }
+    if (bit_width < 64)
+        value &= ((sc_trace_uint64) 1 << bit_width) - 1;
+
+    char* p = compdata;
+    if (bit_width == 1)
+        *p++ = "01"[value & 1];
+    else {
+        int nbits = sc_trace_bit_length(value);
+        *p++ = 'b';
+        p = sc_trace_put_bits(p, value, nbits ? nbits : 1);
+        *p++ = ' ';
+    }
+    strcpy(p, vcd_name);
+}
+
+// The digits are those of sc_signed::get_2c_digits()
+void vcd_trace::compose_digits_line(const digit_type* digits, char* compdata)
+{
+    if (bit_width == 0) {
+        compdata[0] = '\0';
+        return;
+    }
+
+    char* p = compdata;
+    if (bit_width == 1)
+        *p++ = "01"[digits[0] & 1];
+    else {
+        int nbits = sc_trace_bit_length(digits, BITS_PER_DIGIT, bit_width);
+        *p++ = 'b';
+        if (nbits == 0)
+            *p++ = '0';
+        else
+            p = sc_trace_put_bits(p, digits, BITS_PER_DIGIT, nbits);
+        *p++ = ' ';
+    }
+    strcpy(p, vcd_name);
+}
+
 void vcd_trace::print_variable_declaration_line(FILE* f)
 {
     char buf[2000];
@@ -155,7 +274,7 @@ void vcd_trace::set_width()
   /* Intentionally Blank, should be defined for each type separately */
 }
 
-char* vcd_trace::strip_leading_bits(char* originalbuf)
+const char* vcd_trace::strip_leading_bits(const char* originalbuf)
 {
     //*********************************************************************
     // - Remove multiple leading 0,z,x, and replace by only one
@@ -168,7 +287,7 @@ char* vcd_trace::strip_leading_bits(char* originalbuf)
     // - For leading 0's followed by 1, remove all leading 0's
     //    b0000010101 -> b10101  
 
-    char* position = originalbuf;
+    const char* position = originalbuf;
 
     if( strlen(originalbuf) < 2 || (originalbuf[0] != 'z' && originalbuf[0] != 'x' && originalbuf[0] != '0' ))
       return originalbuf;
@@ -196,7 +315,7 @@ vcd_trace::~vcd_trace()
 class vcd_bool_trace : public vcd_trace {
 public:
     vcd_bool_trace(const bool& object, const sc_string& _name, const sc_string& _vcd_name);
-    void write(FILE* f);
+    int capture(char* buf);
     bool changed();
 
 protected:    
@@ -217,14 +336,12 @@ bool vcd_bool_trace::changed()
     return object != old_value;
 }
 
-void vcd_bool_trace::write(FILE* f)
+int vcd_bool_trace::capture(char* buf)
 {
-    if (object == true) fputc('1', f); 
-    else fputc('0', f);
-
-    fprintf(f,"%s", (const char *) vcd_name);
-
+    buf[0] = object ? '1' : '0';
+    buf[1] = '\0';
     old_value = object;
+    return 2;
 }
 
 /*******************************************************************************************/
@@ -232,7 +349,7 @@ void vcd_bool_trace::write(FILE* f)
 class vcd_sc_logic_trace : public vcd_trace {
 public:
     vcd_sc_logic_trace(const sc_logic& object, const sc_string& _name, const sc_string& _vcd_name);
-    void write(FILE* f);
+    int capture(char* buf);
     bool changed();
 
 protected:    
@@ -256,15 +373,12 @@ bool vcd_sc_logic_trace::changed()
 }
 
 
-void vcd_sc_logic_trace::write(FILE* f)
+int vcd_sc_logic_trace::capture(char* buf)
 {
-    char out_char;
-    out_char = map_sc_logic_state_to_vcd_state(object.to_char());
-    fputc(out_char, f); 
-
-    fprintf(f,"%s", (const char *) vcd_name);
-
+    buf[0] = map_sc_logic_state_to_vcd_state(object.to_char());
+    buf[1] = '\0';
     old_value = object;
+    return 2;
 }
 
 /******************************************************************************************/
@@ -272,7 +386,7 @@ void vcd_sc_logic_trace::write(FILE* f)
 class vcd_bool_vector_trace : public vcd_trace {
 public:
     vcd_bool_vector_trace(const sc_bool_vector& object, const sc_string& _name, const sc_string& _vcd_name);
-    void write(FILE* f);
+    int capture(char* buf);
     bool changed();
     void set_width();
 
@@ -294,20 +408,17 @@ bool vcd_bool_vector_trace::changed()
     return object != old_value;
 }
 
-void vcd_bool_vector_trace::write(FILE* f)
+int vcd_bool_vector_trace::capture(char* rawdata)
 {
-    char rawdata[1000], *rawdata_ptr = rawdata;
-    char compdata[1000];
+    char* rawdata_ptr = rawdata;
 
     int bitindex;
     for (bitindex = object.length() - 1; bitindex >= 0; --bitindex) {
         *rawdata_ptr++ = "01"[(object)[bitindex]];
     }
     *rawdata_ptr = '\0';
-    compose_data_line(rawdata, compdata);
-
-    fputs(compdata, f);
     old_value = object;
+    return (int) (rawdata_ptr - rawdata) + 1;
 }
 
 void vcd_bool_vector_trace::set_width()
@@ -321,7 +432,7 @@ void vcd_bool_vector_trace::set_width()
 class vcd_sc_logic_vector_trace : public vcd_trace {
 public:
     vcd_sc_logic_vector_trace(const sc_logic_vector& object, const sc_string& _name, const sc_string& _vcd_name);
-    void write(FILE* f);
+    int capture(char* buf);
     bool changed();
     void set_width();
 
@@ -343,12 +454,11 @@ bool vcd_sc_logic_vector_trace::changed()
 }
 
 
-void vcd_sc_logic_vector_trace::write(FILE* f)
+int vcd_sc_logic_vector_trace::capture(char* rawdata)
 {
     char in_char;
     char out_char;
-    char rawdata[1000], *rawdata_ptr = rawdata;
-    char compdata[1000];
+    char* rawdata_ptr = rawdata;
 
     int bitindex;
     for(bitindex = object.length() - 1; bitindex >= 0; --bitindex) {
@@ -357,10 +467,8 @@ void vcd_sc_logic_vector_trace::write(FILE* f)
         *rawdata_ptr++ = out_char; 
     }
     *rawdata_ptr = '\0';
-    compose_data_line(rawdata, compdata);
-
-    fputs(compdata, f);
     old_value = object;
+    return (int) (rawdata_ptr - rawdata) + 1;
 }
 
 
@@ -374,7 +482,8 @@ void vcd_sc_logic_vector_trace::set_width()
 class vcd_sc_unsigned_trace : public vcd_trace {
 public:
     vcd_sc_unsigned_trace(const sc_unsigned& object, const sc_string& _name, const sc_string& _vcd_name);
-    void write(FILE* f);
+    int capture(char* buf);
+    void write_captured(FILE* f, const char* buf);
     bool changed();
     void set_width();
 
@@ -396,20 +505,26 @@ bool vcd_sc_unsigned_trace::changed()
     return object != old_value;
 }
 
-void vcd_sc_unsigned_trace::write(FILE* f)
+// Captures the digits of the value rather than its characters
+int vcd_sc_unsigned_trace::capture(char* buf)
 {
-    char rawdata[1000], *rawdata_ptr = rawdata;
-    char compdata[1000];
+    digit_type digits[1000 / BITS_PER_DIGIT + 2];
+    int size = DIV_CEIL(object.length() + 1) * sizeof(digit_type);
 
-    int bitindex;
-    for (bitindex = object.length() - 1; bitindex >= 0; --bitindex) {
-        *rawdata_ptr++ = "01"[(object)[bitindex]];
-    }
-    *rawdata_ptr = '\0';
-    compose_data_line(rawdata, compdata);
+    object.get_2c_digits(digits);
+    memcpy(buf, digits, size);
+    old_value = object;
+    return size;
+}
+
+void vcd_sc_unsigned_trace::write_captured(FILE* f, const char* buf)
+{
+    digit_type digits[1000 / BITS_PER_DIGIT + 2];
+    char compdata[1000];
 
+    memcpy(digits, buf, DIV_CEIL(bit_width + 1) * sizeof(digit_type));
+    compose_digits_line(digits, compdata);
     fputs(compdata, f);
-    old_value = object;
 }
 
 void vcd_sc_unsigned_trace::set_width()
@@ -423,7 +538,8 @@ void vcd_sc_unsigned_trace::set_width()
 class vcd_sc_signed_trace : public vcd_trace {
 public:
     vcd_sc_signed_trace(const sc_signed& object, const sc_string& _name, const sc_string& _vcd_name);
-    void write(FILE* f);
+    int capture(char* buf);
+    void write_captured(FILE* f, const char* buf);
     bool changed();
     void set_width();
 
@@ -445,20 +561,26 @@ bool vcd_sc_signed_trace::changed()
     return object != old_value;
 }
 
-void vcd_sc_signed_trace::write(FILE* f)
+// Captures the digits of the value rather than its characters
+int vcd_sc_signed_trace::capture(char* buf)
 {
-    char rawdata[1000], *rawdata_ptr = rawdata;
-    char compdata[1000];
+    digit_type digits[1000 / BITS_PER_DIGIT + 2];
+    int size = DIV_CEIL(object.length() + 1) * sizeof(digit_type);
 
-    int bitindex;
-    for (bitindex = object.length() - 1; bitindex >= 0; --bitindex) {
-        *rawdata_ptr++ = "01"[(object)[bitindex]];
-    }
-    *rawdata_ptr = '\0';
-    compose_data_line(rawdata, compdata);
+    object.get_2c_digits(digits);
+    memcpy(buf, digits, size);
+    old_value = object;
+    return size;
+}
+
+void vcd_sc_signed_trace::write_captured(FILE* f, const char* buf)
+{
+    digit_type digits[1000 / BITS_PER_DIGIT + 2];
+    char compdata[1000];
 
+    memcpy(digits, buf, DIV_CEIL(bit_width + 1) * sizeof(digit_type));
+    compose_digits_line(digits, compdata);
     fputs(compdata, f);
-    old_value = object;
 }
 
 void vcd_sc_signed_trace::set_width()
@@ -471,7 +593,8 @@ void vcd_sc_signed_trace::set_width()
 class vcd_sc_uint_base_trace : public vcd_trace {
 public:
     vcd_sc_uint_base_trace(const sc_uint_base& object, const sc_string& _name, const sc_string& _vcd_name);
-    void write(FILE* f);
+    int capture(char* buf);
+    void write_captured(FILE* f, const char* buf);
     bool changed();
     void set_width();
 
@@ -493,20 +616,21 @@ bool vcd_sc_uint_base_trace::changed()
     return object != old_value;
 }
 
-void vcd_sc_uint_base_trace::write(FILE* f)
+int vcd_sc_uint_base_trace::capture(char* buf)
 {
-    char rawdata[1000], *rawdata_ptr = rawdata;
-    char compdata[1000];
+    memcpy(buf, &object.num, sizeof(object.num));
+    old_value = object;
+    return sizeof(object.num);
+}
 
-    int bitindex;
-    for (bitindex = object.width-1; bitindex >= 0; --bitindex) {
-        *rawdata_ptr++ = "01"[int((object)[bitindex])];
-    }
-    *rawdata_ptr = '\0';
-    compose_data_line(rawdata, compdata);
+void vcd_sc_uint_base_trace::write_captured(FILE* f, const char* buf)
+{
+    uint64 value;
+    char compdata[1000];
 
+    memcpy(&value, buf, sizeof(value));
+    compose_uint_line((sc_trace_uint64) value, compdata);
     fputs(compdata, f);
-    old_value = object;
 }
 
 void vcd_sc_uint_base_trace::set_width()
@@ -520,7 +644,8 @@ void vcd_sc_uint_base_trace::set_width()
 class vcd_sc_int_base_trace : public vcd_trace {
 public:
     vcd_sc_int_base_trace(const sc_int_base& object, const sc_string& _name, const sc_string& _vcd_name);
-    void write(FILE* f);
+    int capture(char* buf);
+    void write_captured(FILE* f, const char* buf);
     bool changed();
     void set_width();
 
@@ -542,20 +667,21 @@ bool vcd_sc_int_base_trace::changed()
     return object != old_value;
 }
 
-void vcd_sc_int_base_trace::write(FILE* f)
+int vcd_sc_int_base_trace::capture(char* buf)
 {
-    char rawdata[1000], *rawdata_ptr = rawdata;
-    char compdata[1000];
+    memcpy(buf, &object.num, sizeof(object.num));
+    old_value = object;
+    return sizeof(object.num);
+}
 
-    int bitindex;
-    for (bitindex = object.width-1; bitindex >= 0; --bitindex) {
-        *rawdata_ptr++ = "01"[int((object)[bitindex])];
-    }
-    *rawdata_ptr = '\0';
-    compose_data_line(rawdata, compdata);
+void vcd_sc_int_base_trace::write_captured(FILE* f, const char* buf)
+{
+    int64 value;
+    char compdata[1000];
 
+    memcpy(&value, buf, sizeof(value));
+    compose_uint_line((sc_trace_uint64) value, compdata);
     fputs(compdata, f);
-    old_value = object;
 }
 
 void vcd_sc_int_base_trace::set_width()
@@ -575,7 +701,8 @@ public:
     vcd_sc_fxval_trace( const sc_fxval& object,
 			const sc_string& _name,
 			const sc_string& _vcd_name );
-    void write( FILE* f );
+    int capture( char* buf );
+    void write_captured( FILE* f, const char* buf );
     bool changed();
 
 protected:
@@ -602,11 +729,21 @@ vcd_sc_fxval_trace::changed()
     return object != old_value;
 }
 
-void
-vcd_sc_fxval_trace::write( FILE* f )
+int
+vcd_sc_fxval_trace::capture( char* buf )
 {
-    fprintf( f, "r%.16g %s", object.to_double(), (const char*) vcd_name );
+    double value = object.to_double();
+    memcpy( buf, &value, sizeof( value ) );
     old_value = object;
+    return sizeof( value );
+}
+
+void
+vcd_sc_fxval_trace::write_captured( FILE* f, const char* buf )
+{
+    double value;
+    memcpy( &value, buf, sizeof( value ) );
+    fprintf( f, "r%.16g %s", value, (const char*) vcd_name );
 }
 
 /*****************************************************************************/
@@ -618,7 +755,8 @@ public:
     vcd_sc_fxval_fast_trace( const sc_fxval_fast& object,
 			     const sc_string& _name,
 			     const sc_string& _vcd_name );
-    void write( FILE* f );
+    int capture( char* buf );
+    void write_captured( FILE* f, const char* buf );
     bool changed();
 
 protected:
@@ -645,11 +783,21 @@ vcd_sc_fxval_fast_trace::changed()
     return object != old_value;
 }
 
-void
-vcd_sc_fxval_fast_trace::write( FILE* f )
+int
+vcd_sc_fxval_fast_trace::capture( char* buf )
 {
-    fprintf( f, "r%.16g %s", object.to_double(), (const char*) vcd_name );
+    double value = object.to_double();
+    memcpy( buf, &value, sizeof( value ) );
     old_value = object;
+    return sizeof( value );
+}
+
+void
+vcd_sc_fxval_fast_trace::write_captured( FILE* f, const char* buf )
+{
+    double value;
+    memcpy( &value, buf, sizeof( value ) );
+    fprintf( f, "r%.16g %s", value, (const char*) vcd_name );
 }
 
 /*****************************************************************************/
@@ -661,7 +809,7 @@ public:
     vcd_sc_fxnum_trace( const sc_fxnum& object,
 			const sc_string& _name,
 			const sc_string& _vcd_name );
-    void write( FILE* f );
+    int capture( char* buf );
     bool changed();
     void set_width();
 
@@ -692,11 +840,10 @@ vcd_sc_fxnum_trace::changed()
     return object != old_value;
 }
 
-void
-vcd_sc_fxnum_trace::write( FILE* f )
+int
+vcd_sc_fxnum_trace::capture( char* rawdata )
 {
-    char rawdata[1000], *rawdata_ptr = rawdata;
-    char compdata[1000];
+    char* rawdata_ptr = rawdata;
 
     int bitindex;
     for( bitindex = object.wl() - 1; bitindex >= 0; -- bitindex )
@@ -704,10 +851,8 @@ vcd_sc_fxnum_trace::write( FILE* f )
         *rawdata_ptr ++ = "01"[(object)[bitindex]];
     }
     *rawdata_ptr = '\0';
-    compose_data_line( rawdata, compdata );
-
-    fputs( compdata, f );
     old_value = object;
+    return (int) (rawdata_ptr - rawdata) + 1;
 }
 
 void
@@ -725,7 +870,7 @@ public:
     vcd_sc_fxnum_fast_trace( const sc_fxnum_fast& object,
 			     const sc_string& _name,
 			     const sc_string& _vcd_name );
-    void write( FILE* f );
+    int capture( char* buf );
     bool changed();
     void set_width();
 
@@ -756,11 +901,10 @@ vcd_sc_fxnum_fast_trace::changed()
     return object != old_value;
 }
 
-void
-vcd_sc_fxnum_fast_trace::write( FILE* f )
+int
+vcd_sc_fxnum_fast_trace::capture( char* rawdata )
 {
-    char rawdata[1000], *rawdata_ptr = rawdata;
-    char compdata[1000];
+    char* rawdata_ptr = rawdata;
 
     int bitindex;
     for( bitindex = object.wl() - 1; bitindex >= 0; -- bitindex )
@@ -768,10 +912,8 @@ vcd_sc_fxnum_fast_trace::write( FILE* f )
         *rawdata_ptr ++ = "01"[(object)[bitindex]];
     }
     *rawdata_ptr = '\0';
-    compose_data_line( rawdata, compdata );
-
-    fputs( compdata, f );
     old_value = object;
+    return (int) (rawdata_ptr - rawdata) + 1;
 }
 
 void
@@ -788,7 +930,8 @@ vcd_sc_fxnum_fast_trace::set_width()
 class vcd_unsigned_int_trace : public vcd_trace {
 public:
     vcd_unsigned_int_trace(const unsigned& object, const sc_string& _name, const sc_string& _vcd_name, int _width);
-    void write(FILE* f);
+    int capture(char* buf);
+    void write_captured(FILE* f, const char* buf);
     bool changed();
 
 protected:
@@ -819,29 +962,34 @@ bool vcd_unsigned_int_trace::changed()
 }
 
 
-void vcd_unsigned_int_trace::write(FILE* f)
+int vcd_unsigned_int_trace::capture(char* buf)
+{
+    memcpy(buf, &object, sizeof(object));
+    old_value = object;
+    return sizeof(object);
+}
+
+void vcd_unsigned_int_trace::write_captured(FILE* f, const char* buf)
 {
+    unsigned value;
     char rawdata[1000];
     char compdata[1000];
     int bitindex;
 
+    memcpy(&value, buf, sizeof(value));
+
     // Check for overflow
-    if ((object & mask) != object) {
+    if ((value & mask) != value) {
         for (bitindex = 0; bitindex < bit_width; bitindex++){
             rawdata[bitindex] = 'x';
         }
+        rawdata[bitindex] = '\0';
+        compose_data_line(rawdata, compdata);
     }
     else{
-        unsigned bit_mask = 1 << (bit_width-1);
-        for (bitindex = 0; bitindex < bit_width; bitindex++) {
-            rawdata[bitindex] = (object & bit_mask)? '1' : '0';
-            bit_mask = bit_mask >> 1;
-        }
+        compose_uint_line(value, compdata);
     }
-    rawdata[bitindex] = '\0';
-    compose_data_line(rawdata, compdata);
     fputs(compdata, f);
-    old_value = object;
 }
 
 /**************************************************************************************/
@@ -849,7 +997,8 @@ void vcd_unsigned_int_trace::write(FILE* f)
 class vcd_unsigned_short_trace : public vcd_trace {
 public:
     vcd_unsigned_short_trace(const unsigned short& object, const sc_string& _name, const sc_string& _vcd_name, int _width);
-    void write(FILE* f);
+    int capture(char* buf);
+    void write_captured(FILE* f, const char* buf);
     bool changed();
 
 protected:
@@ -880,29 +1029,34 @@ bool vcd_unsigned_short_trace::changed()
 }
 
 
-void vcd_unsigned_short_trace::write(FILE* f)
+int vcd_unsigned_short_trace::capture(char* buf)
 {
+    memcpy(buf, &object, sizeof(object));
+    old_value = object;
+    return sizeof(object);
+}
+
+void vcd_unsigned_short_trace::write_captured(FILE* f, const char* buf)
+{
+    unsigned short value;
     char rawdata[1000];
     char compdata[1000];
     int bitindex;
 
+    memcpy(&value, buf, sizeof(value));
+
     // Check for overflow
-    if ((object & mask) != object) {
+    if ((value & mask) != value) {
         for (bitindex = 0; bitindex < bit_width; bitindex++){
             rawdata[bitindex] = 'x';
         }
+        rawdata[bitindex] = '\0';
+        compose_data_line(rawdata, compdata);
     }
     else{
-        unsigned bit_mask = 1 << (bit_width-1);
-        for (bitindex = 0; bitindex < bit_width; bitindex++) {
-            rawdata[bitindex] = (object & bit_mask)? '1' : '0';
-            bit_mask = bit_mask >> 1;
-        }
+        compose_uint_line(value, compdata);
     }
-    rawdata[bitindex] = '\0';
-    compose_data_line(rawdata, compdata);
     fputs(compdata, f);
-    old_value = object;
 }
 
 /**************************************************************************************/
@@ -910,7 +1064,8 @@ void vcd_unsigned_short_trace::write(FILE* f)
 class vcd_unsigned_char_trace : public vcd_trace {
 public:
     vcd_unsigned_char_trace(const unsigned char& object, const sc_string& _name, const sc_string& _vcd_name, int _width);
-    void write(FILE* f);
+    int capture(char* buf);
+    void write_captured(FILE* f, const char* buf);
     bool changed();
 
 protected:
@@ -941,29 +1096,34 @@ bool vcd_unsigned_char_trace::changed()
 }
 
 
-void vcd_unsigned_char_trace::write(FILE* f)
+int vcd_unsigned_char_trace::capture(char* buf)
 {
+    memcpy(buf, &object, sizeof(object));
+    old_value = object;
+    return sizeof(object);
+}
+
+void vcd_unsigned_char_trace::write_captured(FILE* f, const char* buf)
+{
+    unsigned char value;
     char rawdata[1000];
     char compdata[1000];
     int bitindex;
 
+    memcpy(&value, buf, sizeof(value));
+
     // Check for overflow
-    if ((object & mask) != object) {
+    if ((value & mask) != value) {
         for (bitindex = 0; bitindex < bit_width; bitindex++){
             rawdata[bitindex] = 'x';
         }
+        rawdata[bitindex] = '\0';
+        compose_data_line(rawdata, compdata);
     }
     else{
-        unsigned bit_mask = 1 << (bit_width-1);
-        for (bitindex = 0; bitindex < bit_width; bitindex++) {
-            rawdata[bitindex] = (object & bit_mask)? '1' : '0';
-            bit_mask = bit_mask >> 1;
-        }
+        compose_uint_line(value, compdata);
     }
-    rawdata[bitindex] = '\0';
-    compose_data_line(rawdata, compdata);
     fputs(compdata, f);
-    old_value = object;
 }
 
 /**************************************************************************************/
@@ -971,7 +1131,8 @@ void vcd_unsigned_char_trace::write(FILE* f)
 class vcd_unsigned_long_trace : public vcd_trace {
 public:
     vcd_unsigned_long_trace(const unsigned long& object, const sc_string& _name, const sc_string& _vcd_name, int _width);
-    void write(FILE* f);
+    int capture(char* buf);
+    void write_captured(FILE* f, const char* buf);
     bool changed();
 
 protected:
@@ -1002,29 +1163,34 @@ bool vcd_unsigned_long_trace::changed()
 }
 
 
-void vcd_unsigned_long_trace::write(FILE* f)
+int vcd_unsigned_long_trace::capture(char* buf)
 {
+    memcpy(buf, &object, sizeof(object));
+    old_value = object;
+    return sizeof(object);
+}
+
+void vcd_unsigned_long_trace::write_captured(FILE* f, const char* buf)
+{
+    unsigned long value;
     char rawdata[1000];
     char compdata[1000];
     int bitindex;
 
+    memcpy(&value, buf, sizeof(value));
+
     // Check for overflow
-    if ((object & mask) != object) {
+    if ((value & mask) != value) {
         for (bitindex = 0; bitindex < bit_width; bitindex++){
             rawdata[bitindex] = 'x';
         }
+        rawdata[bitindex] = '\0';
+        compose_data_line(rawdata, compdata);
     }
     else{
-        unsigned bit_mask = 1 << (bit_width-1);
-        for (bitindex = 0; bitindex < bit_width; bitindex++) {
-            rawdata[bitindex] = (object & bit_mask)? '1' : '0';
-            bit_mask = bit_mask >> 1;
-        }
+        compose_uint_line(value, compdata);
     }
-    rawdata[bitindex] = '\0';
-    compose_data_line(rawdata, compdata);
     fputs(compdata, f);
-    old_value = object;
 }
 
 /**************************************************************************************/
@@ -1032,7 +1198,8 @@ void vcd_unsigned_long_trace::write(FILE* f)
 class vcd_signed_int_trace : public vcd_trace {
 public:
     vcd_signed_int_trace(const int& object, const sc_string& _name, const sc_string& _vcd_name, int _width);
-    void write(FILE* f);
+    int capture(char* buf);
+    void write_captured(FILE* f, const char* buf);
     bool changed();
 
 protected:
@@ -1063,29 +1230,34 @@ bool vcd_signed_int_trace::changed()
 }
 
 
-void vcd_signed_int_trace::write(FILE* f)
+int vcd_signed_int_trace::capture(char* buf)
+{
+    memcpy(buf, &object, sizeof(object));
+    old_value = object;
+    return sizeof(object);
+}
+
+void vcd_signed_int_trace::write_captured(FILE* f, const char* buf)
 {
+    int value;
     char rawdata[1000];
     char compdata[1000];
     int bitindex;
 
+    memcpy(&value, buf, sizeof(value));
+
     // Check for overflow
-    if (((unsigned) object & mask) != (unsigned) object) {
+    if (((unsigned) value & mask) != (unsigned) value) {
         for (bitindex = 0; bitindex < bit_width; bitindex++){
             rawdata[bitindex] = 'x';
         }
+        rawdata[bitindex] = '\0';
+        compose_data_line(rawdata, compdata);
     }
     else{
-        unsigned bit_mask = 1 << (bit_width-1);
-        for (bitindex = 0; bitindex < bit_width; bitindex++) {
-            rawdata[bitindex] = (object & bit_mask)? '1' : '0';
-            bit_mask = bit_mask >> 1;
-        }
+        compose_uint_line((unsigned) value, compdata);
     }
-    rawdata[bitindex] = '\0';
-    compose_data_line(rawdata, compdata);
     fputs(compdata, f);
-    old_value = object;
 }
 
 /**************************************************************************************/
@@ -1093,7 +1265,8 @@ void vcd_signed_int_trace::write(FILE* f)
 class vcd_signed_short_trace : public vcd_trace {
 public:
     vcd_signed_short_trace(const short& object, const sc_string& _name, const sc_string& _vcd_name, int _width);
-    void write(FILE* f);
+    int capture(char* buf);
+    void write_captured(FILE* f, const char* buf);
     bool changed();
 
 protected:
@@ -1124,29 +1297,34 @@ bool vcd_signed_short_trace::changed()
 }
 
 
-void vcd_signed_short_trace::write(FILE* f)
+int vcd_signed_short_trace::capture(char* buf)
 {
+    memcpy(buf, &object, sizeof(object));
+    old_value = object;
+    return sizeof(object);
+}
+
+void vcd_signed_short_trace::write_captured(FILE* f, const char* buf)
+{
+    short value;
     char rawdata[1000];
     char compdata[1000];
     int bitindex;
 
+    memcpy(&value, buf, sizeof(value));
+
     // Check for overflow
-    if (((unsigned short) object & mask) != (unsigned short) object) {
+    if (((unsigned short) value & mask) != (unsigned short) value) {
         for (bitindex = 0; bitindex < bit_width; bitindex++){
             rawdata[bitindex] = 'x';
         }
+        rawdata[bitindex] = '\0';
+        compose_data_line(rawdata, compdata);
     }
     else{
-        unsigned bit_mask = 1 << (bit_width-1);
-        for (bitindex = 0; bitindex < bit_width; bitindex++) {
-            rawdata[bitindex] = (object & bit_mask)? '1' : '0';
-            bit_mask = bit_mask >> 1;
-        }
+        compose_uint_line((unsigned short) value, compdata);
     }
-    rawdata[bitindex] = '\0';
-    compose_data_line(rawdata, compdata);
     fputs(compdata, f);
-    old_value = object;
 }
 
 /**************************************************************************************/
@@ -1154,7 +1332,8 @@ void vcd_signed_short_trace::write(FILE* f)
 class vcd_signed_char_trace : public vcd_trace {
 public:
     vcd_signed_char_trace(const char& object, const sc_string& _name, const sc_string& _vcd_name, int _width);
-    void write(FILE* f);
+    int capture(char* buf);
+    void write_captured(FILE* f, const char* buf);
     bool changed();
 
 protected:
@@ -1185,29 +1364,34 @@ bool vcd_signed_char_trace::changed()
 }
 
 
-void vcd_signed_char_trace::write(FILE* f)
+int vcd_signed_char_trace::capture(char* buf)
 {
+    memcpy(buf, &object, sizeof(object));
+    old_value = object;
+    return sizeof(object);
+}
+
+void vcd_signed_char_trace::write_captured(FILE* f, const char* buf)
+{
+    char value;
     char rawdata[1000];
     char compdata[1000];
     int bitindex;
 
+    memcpy(&value, buf, sizeof(value));
+
     // Check for overflow
-    if (((unsigned char) object & mask) != (unsigned char) object) {
+    if (((unsigned char) value & mask) != (unsigned char) value) {
         for (bitindex = 0; bitindex < bit_width; bitindex++){
             rawdata[bitindex] = 'x';
         }
+        rawdata[bitindex] = '\0';
+        compose_data_line(rawdata, compdata);
     }
     else{
-        unsigned bit_mask = 1 << (bit_width-1);
-        for (bitindex = 0; bitindex < bit_width; bitindex++) {
-            rawdata[bitindex] = (object & bit_mask)? '1' : '0';
-            bit_mask = bit_mask >> 1;
-        }
+        compose_uint_line((unsigned char) value, compdata);
     }
-    rawdata[bitindex] = '\0';
-    compose_data_line(rawdata, compdata);
     fputs(compdata, f);
-    old_value = object;
 }
 
 /**************************************************************************************/
@@ -1215,7 +1399,8 @@ void vcd_signed_char_trace::write(FILE* f)
 class vcd_signed_long_trace : public vcd_trace {
 public:
     vcd_signed_long_trace(const long& object, const sc_string& _name, const sc_string& _vcd_name, int _width);
-    void write(FILE* f);
+    int capture(char* buf);
+    void write_captured(FILE* f, const char* buf);
     bool changed();
 
 protected:
@@ -1246,29 +1431,34 @@ bool vcd_signed_long_trace::changed()
 }
 
 
-void vcd_signed_long_trace::write(FILE* f)
+int vcd_signed_long_trace::capture(char* buf)
+{
+    memcpy(buf, &object, sizeof(object));
+    old_value = object;
+    return sizeof(object);
+}
+
+void vcd_signed_long_trace::write_captured(FILE* f, const char* buf)
 {
+    long value;
     char rawdata[1000];
     char compdata[1000];
     int bitindex;
 
+    memcpy(&value, buf, sizeof(value));
+
     // Check for overflow
-    if (((unsigned long) object & mask) != (unsigned long) object) {
+    if (((unsigned long) value & mask) != (unsigned long) value) {
         for (bitindex = 0; bitindex < bit_width; bitindex++){
             rawdata[bitindex] = 'x';
         }
+        rawdata[bitindex] = '\0';
+        compose_data_line(rawdata, compdata);
     }
     else{
-        unsigned bit_mask = 1 << (bit_width-1);
-        for (bitindex = 0; bitindex < bit_width; bitindex++) {
-            rawdata[bitindex] = (object & bit_mask)? '1' : '0';
-            bit_mask = bit_mask >> 1;
-        }
+        compose_uint_line((unsigned long) value, compdata);
     }
-    rawdata[bitindex] = '\0';
-    compose_data_line(rawdata, compdata);
     fputs(compdata, f);
-    old_value = object;
 }
 
 
@@ -1277,7 +1467,8 @@ void vcd_signed_long_trace::write(FILE* f)
 class vcd_float_trace : public vcd_trace {
 public:
     vcd_float_trace(const float& object, const sc_string& _name, const sc_string& _vcd_name);
-    void write(FILE* f);
+    int capture(char* buf);
+    void write_captured(FILE* f, const char* buf);
     bool changed();
 
 protected:    
@@ -1298,10 +1489,18 @@ bool vcd_float_trace::changed()
     return object != old_value;
 }
 
-void vcd_float_trace::write(FILE* f)
+int vcd_float_trace::capture(char* buf)
 {
-    fprintf(f, "r%.16g %s", object, (const char *) vcd_name);
+    memcpy(buf, &object, sizeof(object));
     old_value = object;
+    return sizeof(object);
+}
+
+void vcd_float_trace::write_captured(FILE* f, const char* buf)
+{
+    float value;
+    memcpy(&value, buf, sizeof(value));
+    fprintf(f, "r%.16g %s", value, (const char *) vcd_name);
 }
 
 /**********************************************************************************************/
@@ -1309,7 +1508,8 @@ void vcd_float_trace::write(FILE* f)
 class vcd_double_trace : public vcd_trace {
 public:
     vcd_double_trace(const double& object, const sc_string& _name, const sc_string& _vcd_name);
-    void write(FILE* f);
+    int capture(char* buf);
+    void write_captured(FILE* f, const char* buf);
     bool changed();
 
 protected:    
@@ -1330,10 +1530,18 @@ bool vcd_double_trace::changed()
     return object != old_value;
 }
 
-void vcd_double_trace::write(FILE* f)
+int vcd_double_trace::capture(char* buf)
 {
-    fprintf(f, "r%.16g %s", object, (const char *) vcd_name);
+    memcpy(buf, &object, sizeof(object));
     old_value = object;
+    return sizeof(object);
+}
+
+void vcd_double_trace::write_captured(FILE* f, const char* buf)
+{
+    double value;
+    memcpy(&value, buf, sizeof(value));
+    fprintf(f, "r%.16g %s", value, (const char *) vcd_name);
 }
 
 
@@ -1342,7 +1550,8 @@ void vcd_double_trace::write(FILE* f)
 class vcd_enum_trace : public vcd_trace {
 public:
     vcd_enum_trace(const unsigned& _object, const sc_string& _name, const sc_string& _vcd_name, const char** enum_literals);
-    void write(FILE* f);
+    int capture(char* buf);
+    void write_captured(FILE* f, const char* buf);
     bool changed();
 
 protected:
@@ -1384,29 +1593,34 @@ bool vcd_enum_trace::changed()
     return object != old_value;
 }
 
-void vcd_enum_trace::write(FILE* f)
+int vcd_enum_trace::capture(char* buf)
+{
+    memcpy(buf, &object, sizeof(object));
+    old_value = object;
+    return sizeof(object);
+}
+
+void vcd_enum_trace::write_captured(FILE* f, const char* buf)
 {
+    unsigned value;
     char rawdata[1000];
     char compdata[1000];
     int bitindex;
 
+    memcpy(&value, buf, sizeof(value));
+
     // Check for overflow
-    if ((object & mask) != object) {
+    if ((value & mask) != value) {
         for (bitindex = 0; bitindex < bit_width; bitindex++){
             rawdata[bitindex] = 'x';
         }
+        rawdata[bitindex] = '\0';
+        compose_data_line(rawdata, compdata);
     }
     else{
-        unsigned bit_mask = 1 << (bit_width-1);
-        for (bitindex = 0; bitindex < bit_width; bitindex++) {
-            rawdata[bitindex] = (object & bit_mask)? '1' : '0';
-            bit_mask = bit_mask >> 1;
-        }
+        compose_uint_line(value, compdata);
     }
-    rawdata[bitindex] = '\0';
-    compose_data_line(rawdata, compdata);
     fputs(compdata, f);
-    old_value = object;
 }
 
 
@@ -1427,6 +1641,11 @@ vcd_trace_file::vcd_trace_file(const char *name)
     }
     trace_delta_cycles = false; // Make this the default
     initialized = false;
+    async = false;
+    pipe = 0;
+    history = 0;
+    recording = false;
+    window_time_units_low = window_time_units_high = 0;
     vcd_name_index = 0;
 
     //default timestep = 1 sec
@@ -1492,26 +1711,55 @@ void vcd_trace_file::initialize()
 
     fputs("$enddefinitions  $end\n\n", fp);
 
-    double inittime = sc_simulation_time();
-    sprintf(buf,
-            "All initial values are dumped below at time "
-            "%g sec = %g timescale units.",
-            inittime, inittime/timescale_unit
-            );
-    write_comment(buf);
-
-    double_to_special_int64(inittime/timescale_unit,
-                            &previous_time_units_high,
-                            &previous_time_units_low );
-
+    ticks_to_special_int64(sc_ticks_to_units(sc_time_stamp_ticks(), timescale_unit),
+                           &previous_time_units_high,
+                           &previous_time_units_low );
+
+    if (keeps_history() && !triggered()) {
+        // Keep the initial values for the start of the history, which
+        // is written when the trigger fires
+        sprintf(buf,
+                "Tracing starts at the trigger, preceded by the last "
+                "%d cycles with changes.",
+                trigger_depth());
+        write_comment(buf);
+
+        for (i = 0; i < traces.size(); i++) {
+            vcd_trace* t = traces[i];
+            char* p = new char[3 * sizeof(int) + t->bit_width + 9];
+            int rec[3] = { VCD_REC_VALUE, i, t->capture(p + 3 * sizeof(int)) };
+            memcpy(p, rec, sizeof(rec));
+            window_values.push_back(p);
+        }
+        window_time_units_high = previous_time_units_high;
+        window_time_units_low = previous_time_units_low;
+        history = new sc_trace_history(trigger_depth(), drop_records, this);
+        recording = true;
+    }
+    else {
+        double inittime = sc_simulation_time();
+        sprintf(buf,
+                "All initial values are dumped below at time "
+                "%g sec = %g timescale units.",
+                inittime, inittime/timescale_unit
+                );
+        write_comment(buf);
+
+        // Tracing may start at a trigger or a restored checkpoint,
+        // later than time 0
+        print_vcd_time(fp, previous_time_units_high, previous_time_units_low);
+        fputs("$dumpvars\n",fp);
+        for (i = 0; i < traces.size(); i++) {
+            vcd_trace* t = traces[i];
+            t->write(fp);
+            fputc('\n', fp);
+        }
+        fputs("$end\n\n", fp);
+    }
 
-    fputs("$dumpvars\n",fp);
-    for (i = 0; i < traces.size(); i++) {
-        vcd_trace* t = traces[i];
-        t->write(fp);
-        fputc('\n', fp);
+    if (async) {
+        pipe = new sc_trace_pipe(write_records, this);
     }
-    fputs("$end\n\n", fp);
 }
 
 
@@ -1555,6 +1803,15 @@ void vcd_trace_file::sc_set_vcd_time_unit(int exponent10_seconds)
     timescale_set_by_user = true;
 }
 
+void vcd_trace_file::set_async(bool flag)
+{
+    if(initialized){
+        vcd_put_error_message("VCD trace mode cannot be changed once tracing has begun.", false);
+        return;
+    }
+    async = flag;
+}
+
 void vcd_trace_file::trace(const bool& object, const sc_string& name)
 {
     if(initialized)  
@@ -1564,7 +1821,7 @@ void vcd_trace_file::trace(const bool& object, const sc_string& name)
 
     sc_string temp_vcd_name;
     create_vcd_name(&temp_vcd_name);
-    traces.push_back(new vcd_bool_trace(object, name, temp_vcd_name));
+    add_trace(new vcd_bool_trace(object, name, temp_vcd_name));
 }
 
 void vcd_trace_file::trace(const sc_bool_vector& object, const sc_string& name)
@@ -1575,7 +1832,7 @@ void vcd_trace_file::trace(const sc_bool_vector& object, const sc_string& name)
 
     sc_string temp_vcd_name;
     create_vcd_name(&temp_vcd_name);
-    traces.push_back(new vcd_bool_vector_trace(object, name, temp_vcd_name));
+    add_trace(new vcd_bool_vector_trace(object, name, temp_vcd_name));
 }
 
 
@@ -1587,7 +1844,7 @@ void vcd_trace_file::trace(const sc_logic& object, const sc_string& name)
 
     sc_string temp_vcd_name;
     create_vcd_name(&temp_vcd_name);
-    traces.push_back(new vcd_sc_logic_trace(object, name, temp_vcd_name));
+    add_trace(new vcd_sc_logic_trace(object, name, temp_vcd_name));
 }
 
 void vcd_trace_file::trace(const sc_logic_vector& object, const sc_string& name)
@@ -1598,7 +1855,7 @@ void vcd_trace_file::trace(const sc_logic_vector& object, const sc_string& name)
 
     sc_string temp_vcd_name;
     create_vcd_name(&temp_vcd_name);
-    traces.push_back(new vcd_sc_logic_vector_trace(object,name, temp_vcd_name));
+    add_trace(new vcd_sc_logic_vector_trace(object,name, temp_vcd_name));
 }
 
 void vcd_trace_file::trace(const unsigned& object, const sc_string& name, int _width)
@@ -1609,7 +1866,7 @@ void vcd_trace_file::trace(const unsigned& object, const sc_string& name, int _w
 
     sc_string temp_vcd_name;
     create_vcd_name(&temp_vcd_name);
-    traces.push_back(new vcd_unsigned_int_trace(object, name, temp_vcd_name, _width));
+    add_trace(new vcd_unsigned_int_trace(object, name, temp_vcd_name, _width));
 }
 
 void vcd_trace_file::trace(const unsigned char& object, const sc_string& name, int _width)
@@ -1620,7 +1877,7 @@ void vcd_trace_file::trace(const unsigned char& object, const sc_string& name, i
 
     sc_string temp_vcd_name;
     create_vcd_name(&temp_vcd_name);
-    traces.push_back(new vcd_unsigned_char_trace(object, name, temp_vcd_name, _width));
+    add_trace(new vcd_unsigned_char_trace(object, name, temp_vcd_name, _width));
 }
 
 void vcd_trace_file::trace(const unsigned short& object, const sc_string& name, int _width)
@@ -1631,7 +1888,7 @@ void vcd_trace_file::trace(const unsigned short& object, const sc_string& name,
 
     sc_string temp_vcd_name;
     create_vcd_name(&temp_vcd_name);
-    traces.push_back(new vcd_unsigned_short_trace(object, name, temp_vcd_name, _width));
+    add_trace(new vcd_unsigned_short_trace(object, name, temp_vcd_name, _width));
 }
 
 void vcd_trace_file::trace(const unsigned long& object, const sc_string& name, int _width)
@@ -1642,7 +1899,7 @@ void vcd_trace_file::trace(const unsigned long& object, const sc_string& name, i
 
     sc_string temp_vcd_name;
     create_vcd_name(&temp_vcd_name);
-    traces.push_back(new vcd_unsigned_long_trace(object, name, temp_vcd_name, _width));
+    add_trace(new vcd_unsigned_long_trace(object, name, temp_vcd_name, _width));
 }
 
 void vcd_trace_file::trace(const int& object, const sc_string& name, int _width)
@@ -1653,7 +1910,7 @@ void vcd_trace_file::trace(const int& object, const sc_string& name, int _width)
 
     sc_string temp_vcd_name;
     create_vcd_name(&temp_vcd_name);
-    traces.push_back(new vcd_signed_int_trace(object, name, temp_vcd_name, _width));
+    add_trace(new vcd_signed_int_trace(object, name, temp_vcd_name, _width));
 }
 
 void vcd_trace_file::trace(const char& object, const sc_string& name, int _width)
@@ -1664,7 +1921,7 @@ void vcd_trace_file::trace(const char& object, const sc_string& name, int _width
 
     sc_string temp_vcd_name;
     create_vcd_name(&temp_vcd_name);
-    traces.push_back(new vcd_signed_char_trace(object, name, temp_vcd_name, _width));
+    add_trace(new vcd_signed_char_trace(object, name, temp_vcd_name, _width));
 }
 
 void vcd_trace_file::trace(const short& object, const sc_string& name, int _width)
@@ -1675,7 +1932,7 @@ void vcd_trace_file::trace(const short& object, const sc_string& name, int _widt
 
     sc_string temp_vcd_name;
     create_vcd_name(&temp_vcd_name);
-    traces.push_back(new vcd_signed_short_trace(object, name, temp_vcd_name, _width));
+    add_trace(new vcd_signed_short_trace(object, name, temp_vcd_name, _width));
 }
 
 void vcd_trace_file::trace(const long& object, const sc_string& name, int _width)
@@ -1686,7 +1943,7 @@ void vcd_trace_file::trace(const long& object, const sc_string& name, int _width
 
     sc_string temp_vcd_name;
     create_vcd_name(&temp_vcd_name);
-    traces.push_back(new vcd_signed_long_trace(object, name, temp_vcd_name, _width));
+    add_trace(new vcd_signed_long_trace(object, name, temp_vcd_name, _width));
 }
 
 void vcd_trace_file::trace(const float& object, const sc_string& name)
@@ -1697,7 +1954,7 @@ void vcd_trace_file::trace(const float& object, const sc_string& name)
 
     sc_string temp_vcd_name;
     create_vcd_name(&temp_vcd_name);
-    traces.push_back(new vcd_float_trace(object, name, temp_vcd_name));
+    add_trace(new vcd_float_trace(object, name, temp_vcd_name));
 }
 
 void vcd_trace_file::trace(const double& object, const sc_string& name)
@@ -1708,7 +1965,7 @@ void vcd_trace_file::trace(const double& object, const sc_string& name)
 
     sc_string temp_vcd_name;
     create_vcd_name(&temp_vcd_name);
-    traces.push_back(new vcd_double_trace(object, name, temp_vcd_name));
+    add_trace(new vcd_double_trace(object, name, temp_vcd_name));
 }
 
 void vcd_trace_file::trace(const sc_unsigned& object, const sc_string& name)
@@ -1719,7 +1976,7 @@ void vcd_trace_file::trace(const sc_unsigned& object, const sc_string& name)
 
     sc_string temp_vcd_name;
     create_vcd_name(&temp_vcd_name);
-    traces.push_back(new vcd_sc_unsigned_trace(object, name, temp_vcd_name));
+    add_trace(new vcd_sc_unsigned_trace(object, name, temp_vcd_name));
 }
 
 void vcd_trace_file::trace(const sc_signed& object, const sc_string& name)
@@ -1730,7 +1987,7 @@ void vcd_trace_file::trace(const sc_signed& object, const sc_string& name)
 
     sc_string temp_vcd_name;
     create_vcd_name(&temp_vcd_name);
-    traces.push_back(new vcd_sc_signed_trace(object, name, temp_vcd_name));
+    add_trace(new vcd_sc_signed_trace(object, name, temp_vcd_name));
 }
 
 void vcd_trace_file::trace(const sc_uint_base& object, const sc_string& name)
@@ -1741,7 +1998,7 @@ void vcd_trace_file::trace(const sc_uint_base& object, const sc_string& name)
 
     sc_string temp_vcd_name;
     create_vcd_name(&temp_vcd_name);
-    traces.push_back(new vcd_sc_uint_base_trace(object, name, temp_vcd_name));
+    add_trace(new vcd_sc_uint_base_trace(object, name, temp_vcd_name));
 }
 
 void vcd_trace_file::trace(const sc_int_base& object, const sc_string& name)
@@ -1752,7 +2009,7 @@ void vcd_trace_file::trace(const sc_int_base& object, const sc_string& name)
 
     sc_string temp_vcd_name;
     create_vcd_name(&temp_vcd_name);
-    traces.push_back(new vcd_sc_int_base_trace(object, name, temp_vcd_name));
+    add_trace(new vcd_sc_int_base_trace(object, name, temp_vcd_name));
 }
 
 
@@ -1769,7 +2026,7 @@ vcd_trace_file::trace( const tp& object, const sc_string& name )              \
                                                                               \
     sc_string temp_vcd_name;                                                  \
     create_vcd_name( &temp_vcd_name );                                        \
-    traces.push_back( new vcd_ ## tp ## _trace( object,                       \
+    add_trace( new vcd_ ## tp ## _trace( object,                       \
 						name,                         \
 						temp_vcd_name ) );            \
 }
@@ -1792,7 +2049,7 @@ void vcd_trace_file::trace(const unsigned& object, const sc_string& name, const
 
     sc_string temp_vcd_name;
     create_vcd_name(&temp_vcd_name);
-    traces.push_back(new vcd_enum_trace(object, name, temp_vcd_name, enum_literals));
+    add_trace(new vcd_enum_trace(object, name, temp_vcd_name, enum_literals));
 }
 
 void vcd_trace_file::trace(const sc_signal_bool_vector& object, const sc_string& name)
@@ -1803,7 +2060,7 @@ void vcd_trace_file::trace(const sc_signal_bool_vector& object, const sc_string&
 
     sc_string temp_vcd_name;
     create_vcd_name(&temp_vcd_name);
-    traces.push_back(new vcd_bool_vector_trace((const sc_bool_vector&) object, name, temp_vcd_name));
+    add_trace(new vcd_bool_vector_trace((const sc_bool_vector&) object, name, temp_vcd_name));
 }
 
 void vcd_trace_file::trace(const sc_signal_logic_vector& object, const sc_string& name)
@@ -1814,7 +2071,7 @@ void vcd_trace_file::trace(const sc_signal_logic_vector& object, const sc_string
 
     sc_string temp_vcd_name;
     create_vcd_name(&temp_vcd_name);
-    traces.push_back(new vcd_sc_logic_vector_trace((const sc_logic_vector&) object, name, temp_vcd_name));
+    add_trace(new vcd_sc_logic_vector_trace((const sc_logic_vector&) object, name, temp_vcd_name));
 }
 
 void vcd_trace_file::trace(const sc_signal_resolved& object, const sc_string& name)
@@ -1825,7 +2082,7 @@ void vcd_trace_file::trace(const sc_signal_resolved& object, const sc_string& na
 
     sc_string temp_vcd_name;
     create_vcd_name(&temp_vcd_name);
-    traces.push_back(new vcd_sc_logic_trace((const sc_logic&) *(object.get_data_ptr()), name, temp_vcd_name));
+    add_trace(new vcd_sc_logic_trace((const sc_logic&) *(object.get_data_ptr()), name, temp_vcd_name));
 }
 
 void vcd_trace_file::trace(const sc_signal_resolved_vector& object, const sc_string& name)
@@ -1836,11 +2093,23 @@ void vcd_trace_file::trace(const sc_signal_resolved_vector& object, const sc_str
 
     sc_string temp_vcd_name;
     create_vcd_name(&temp_vcd_name);
-    traces.push_back(new vcd_sc_logic_vector_trace((const sc_logic_vector&) object, name, temp_vcd_name));
+    add_trace(new vcd_sc_logic_vector_trace((const sc_logic_vector&) object, name, temp_vcd_name));
 }
 
 void vcd_trace_file::write_comment(const sc_string& comment)
 {
+    // Comments made before the trigger are not kept
+    if (recording)
+        return;
+
+    if (pipe) {
+        sc_string text = sc_string("$comment\n") + comment + "\n$end\n\n";
+        int rec[2] = { VCD_REC_TEXT, text.length() };
+        pipe->put(rec, sizeof(rec));
+        pipe->put((const char *) text, rec[1]);
+        return;
+    }
+
     //no newline in comments allowed, as some viewers may crash
     fputs("$comment\n", fp);
     fputs((const char *) comment, fp);
@@ -1867,14 +2136,19 @@ void vcd_trace_file::cycle(bool this_is_a_delta_cycle)
     // Check for initialization
     if (!initialized) {
         initialize();
+        clear_dirty();
         initialized = true;
         return;
     };
 
+    // The trigger has fired; the history goes first
+    if (history && triggered())
+        release_history();
+
 
-    double now_units = sc_simulation_time() / timescale_unit;
+    sc_ticks now_units = sc_ticks_to_units(sc_time_stamp_ticks(), timescale_unit);
     unsigned now_units_high, now_units_low;
-    double_to_special_int64(now_units, &now_units_high, &now_units_low );
+    ticks_to_special_int64(now_units, &now_units_high, &now_units_low );
 
     bool now_later_than_previous_time = false;
     if( now_units_low > previous_time_units_low 
@@ -1956,29 +2230,50 @@ void vcd_trace_file::cycle(bool this_is_a_delta_cycle)
     // Now do the actual printing 
     bool time_printed = false;
     vcd_trace* const* const l_traces = traces.raw_data();
-    for (int i = 0; i < traces.size(); i++) {
-        vcd_trace* t = l_traces[i];
-        if(t->changed()){
-            if(time_printed == false){
-                char buf[200];
-                if(this_time_units_high){
-                    sprintf(buf, "#%u%09u", this_time_units_high, this_time_units_low);
+    int n_check;
+    sc_trace_watch* const* const to_check = traces_to_check(n_check);
+    if (pipe || recording) {
+        // Only capture the values here; the writer thread prints them,
+        // or they wait in the history for the trigger
+        for (int k = 0; k < n_check; k++) {
+            int i = to_check[k]->index;
+            vcd_trace* t = l_traces[i];
+            if(t->changed()){
+                if(time_printed == false){
+                    if (recording)
+                        history->begin_cycle();
+                    unsigned rec[3] = { VCD_REC_TIME, this_time_units_high, this_time_units_low };
+                    put_record(rec, sizeof(rec));
+                    time_printed = true;
                 }
-                else{ 
-                    sprintf(buf, "#%u", this_time_units_low);
+                char* p = reserve_record(3 * sizeof(int) + t->bit_width + 9);
+                int rec[3] = { VCD_REC_VALUE, i, t->capture(p + 3 * sizeof(int)) };
+                memcpy(p, rec, sizeof(rec));
+                commit_record(sizeof(rec) + rec[2]);
+            }
+        }
+        if(time_printed){
+            int rec = VCD_REC_END;
+            put_record(&rec, sizeof(rec));
+        }
+    }
+    else {
+        for (int k = 0; k < n_check; k++) {
+            vcd_trace* t = l_traces[to_check[k]->index];
+            if(t->changed()){
+                if(time_printed == false){
+                    print_vcd_time(fp, this_time_units_high, this_time_units_low);
+                    time_printed = true;
                 }
-                fputs(buf, fp);
+
+                // Write the variable
+                t->write(fp);
                 fputc('\n', fp);
-                time_printed = true;
             }
-
-	    // Write the variable
-            t->write(fp);
-            fputc('\n', fp);
         }
+        // Put another newline after all values are printed
+        if(time_printed) fputc('\n', fp);
     }
-    // Put another newline after all values are printed
-    if(time_printed) fputc('\n', fp);
 
     if(time_printed){
         // We update previous_time_units only when we print time because
@@ -1990,6 +2285,108 @@ void vcd_trace_file::cycle(bool this_is_a_delta_cycle)
 }
 
 
+bool vcd_trace_file::keeps_history() const
+{
+    return trigger_depth() > 0;
+}
+
+char* vcd_trace_file::reserve_record(int n)
+{
+    return recording ? history->reserve(n) : pipe->reserve(n);
+}
+
+void vcd_trace_file::commit_record(int n)
+{
+    if (recording)
+        history->commit(n);
+    else
+        pipe->commit(n);
+}
+
+void vcd_trace_file::put_record(const void* data, int n)
+{
+    if (recording)
+        history->put(data, n);
+    else
+        pipe->put(data, n);
+}
+
+void vcd_trace_file::drop_records(void* arg, const char* data, int len)
+{
+    vcd_trace_file* tf = (vcd_trace_file*) arg;
+    const char* const end = data + len;
+    int rec[3];
+
+    while (data < end) {
+        int n = vcd_record_size(data);
+        if (n <= 0)
+            break;
+        memcpy(rec, data, sizeof(int));
+        switch (rec[0]) {
+        case VCD_REC_TIME:
+            memcpy(rec, data, 3 * sizeof(int));
+            tf->window_time_units_high = (unsigned) rec[1];
+            tf->window_time_units_low = (unsigned) rec[2];
+            break;
+        case VCD_REC_VALUE:
+            memcpy(rec, data, 3 * sizeof(int));
+            memcpy(tf->window_values[rec[1]], data, n);
+            break;
+        default:
+            // VCD_REC_END and VCD_REC_TEXT carry no value
+            break;
+        }
+        data += n;
+    }
+}
+
+// Writes the values at the start of the history, then its cycles
+void vcd_trace_file::release_history()
+{
+    int i;
+    char buf[100];
+    recording = false;
+
+    unsigned time_rec[3] = { VCD_REC_TIME, window_time_units_high, window_time_units_low };
+    replay_records(this, (const char*) time_rec, sizeof(time_rec));
+    replay_records(this, buf, vcd_text_record(buf, "$dumpvars\n"));
+    for (i = 0; i < traces.size(); i++) {
+        replay_records(this, window_values[i], vcd_record_size(window_values[i]));
+        delete[] window_values[i];
+    }
+    window_values.erase_all();
+    replay_records(this, buf, vcd_text_record(buf, "$end\n\n"));
+
+    history->replay(replay_records, this);
+    delete history;
+    history = 0;
+}
+
+void vcd_trace_file::replay_records(void* arg, const char* data, int len)
+{
+    vcd_trace_file* tf = (vcd_trace_file*) arg;
+    if (tf->pipe) {
+        // A cycle may be larger than a page of the pipe
+        const char* const end = data + len;
+        while (data < end) {
+            int n = vcd_record_size(data);
+            if (n <= 0)
+                break;
+            tf->pipe->put(data, n);
+            data += n;
+        }
+    }
+    else {
+        write_records(tf, data, len);
+    }
+}
+
+void vcd_trace_file::add_trace(vcd_trace* t)
+{
+    traces.push_back(t);
+    trace_added();
+}
+
 void vcd_trace_file::create_vcd_name(sc_string* p_destination)
 {
     const char first_type_used = 'a';
@@ -2013,9 +2410,54 @@ void vcd_trace_file::create_vcd_name(sc_string* p_destination)
     vcd_name_index++;
 }
 
+void vcd_trace_file::write_records(void* arg, const char* data, int len)
+{
+    vcd_trace_file* tf = (vcd_trace_file*) arg;
+    FILE* f = tf->fp;
+    const char* const end = data + len;
+    int rec[3];
+
+    while (data < end) {
+        memcpy(rec, data, sizeof(int));
+        switch (rec[0]) {
+        case VCD_REC_TIME:
+            memcpy(rec, data, 3 * sizeof(int));
+            print_vcd_time(f, (unsigned) rec[1], (unsigned) rec[2]);
+            data += 3 * sizeof(int);
+            break;
+        case VCD_REC_VALUE:
+            memcpy(rec, data, 3 * sizeof(int));
+            data += 3 * sizeof(int);
+            tf->traces[rec[1]]->write_captured(f, data);
+            fputc('\n', f);
+            data += rec[2];
+            break;
+        case VCD_REC_END:
+            // Put another newline after all values are printed
+            fputc('\n', f);
+            data += sizeof(int);
+            break;
+        case VCD_REC_TEXT:
+            memcpy(rec, data, 2 * sizeof(int));
+            data += 2 * sizeof(int);
+            fwrite(data, 1, rec[1], f);
+            data += rec[1];
+            break;
+        default:
+            assert(false);
+            return;
+        }
+    }
+}
+
 vcd_trace_file::~vcd_trace_file()
 {
     int i;
+    // Let the writer thread finish before the traces go away
+    delete pipe;
+    delete history;
+    for (i = 0; i < window_values.size(); i++)
+        delete[] window_values[i];
     for (i = 0; i < traces.size(); i++) {
         vcd_trace* t = traces[i];
         delete t;
@@ -2057,6 +2499,21 @@ map_sc_logic_state_to_vcd_state(char in_char)
 }
 
 
+static void
+print_vcd_time(FILE* f, unsigned units_high, unsigned units_low)
+{
+    char buf[200];
+    if(units_high){
+        sprintf(buf, "#%u%09u", units_high, units_low);
+    }
+    else{ 
+        sprintf(buf, "#%u", units_low);
+    }
+    fputs(buf, f);
+    fputc('\n', f);
+}
+
+
 static void
 vcd_put_error_message(const char* msg, bool just_warning)
 {
@@ -55,12 +55,19 @@
 #include "sc_vector.h"
 
 class vcd_trace;  // defined in vcd_trace.cc
+class sc_trace_pipe;
+class sc_trace_history;
 
 
 class vcd_trace_file : public sc_trace_file {
 public:
     void sc_set_vcd_time_unit(int exponent10_seconds); // -7 -> 100ns
 
+    // If flag is true, the simulation only records the changed values,
+    // and a background thread formats them and writes the file.  Must
+    // be called before tracing begins.
+    void set_async(bool flag);
+
     // Create a Vcd trace file.
     // `Name' forms the base of the name to which `.vcd' is added.
     vcd_trace_file(const char *name);
@@ -165,12 +172,28 @@ protected:
 
     // Write trace info for cycle.
      void cycle(bool delta_cycle);
+
+    // Keep the cycles before the trigger if a depth was given with it
+     bool keeps_history() const;
     
 private:
     // Initialize the tracing
     void initialize();
     // Create VCD names for each variable
     void create_vcd_name(sc_string* p_destination);
+    // Add a trace to the traces
+    void add_trace(vcd_trace* t);
+    // Write the records of the asynchronous mode; runs on the writer thread
+    static void write_records(void* arg, const char* data, int len);
+    // Append a record for the writer thread, or to the history
+    char* reserve_record(int n);
+    void commit_record(int n);
+    void put_record(const void* data, int n);
+    // Fold a cycle that falls out of the history into window_values
+    static void drop_records(void* arg, const char* data, int len);
+    // Write out the history once the trigger has fired
+    void release_history();
+    static void replay_records(void* arg, const char* data, int len);
     
     // Array to store the variables traced
     sc_pvector<vcd_trace*> traces;
@@ -181,6 +204,14 @@ private:
     bool timescale_set_by_user; // = 1 means set by user
     bool trace_delta_cycles;    // = 1 means trace the delta cycles
     bool initialized;           // = 1 means initialized
+    bool async;                 // = 1 means use a writer thread
+
+    sc_trace_pipe* pipe;        // to the writer thread, once initialized
+
+    sc_trace_history* history;  // of the cycles before the trigger
+    bool recording;             // = 1 means the records go to the history
+    sc_pvector<char*> window_values;  // captured values at the start of the history
+    unsigned window_time_units_low, window_time_units_high;
 
     unsigned vcd_name_index;    // Number of variables traced
 
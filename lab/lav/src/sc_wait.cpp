@@ -76,12 +76,19 @@ enum sc_lambda_rator_e
 class sc_lambda;
 class sc_lambda_rand;
 class sc_lambda_ptr;
+class sc_lambda_compiler;
+struct sc_lambda_code;
+class sc_sync_process;
 
 class sc_lambda
 {
 	friend class sc_lambda_ptr;
 	friend class sc_lambda_rand;
 	friend class sc_port_manager;
+	friend class sc_lambda_compiler;
+	friend class sc_signal_base;
+	friend class sc_sync_process;
+	friend void sc_lambda_notify(sc_lambda_watch* watchers);
 
 #ifdef SC_LAMBDA_H
 
@@ -606,6 +613,9 @@ public: // private: // (changed)
 	sc_lambda(sc_lambda_rator_e op,
 		sc_lambda_rand* o1 = 0, sc_lambda_rand* o2 = 0);
 private:
+	// Evaluates the expression tree itself
+	bool tree_eval() const;
+
 	// Evaluates the expression as an int
 	int int_eval() const;
 
@@ -635,12 +645,30 @@ private:
 	void replace_ports(void(*fn)(sc_port_manager*, sc_lambda_rand*),
 		sc_port_manager* m);
 
+	// Flattens the tree into `code' and subscribes to the operand
+	// signals; leaves `code' null if the tree cannot be compiled.
+	void compile() const;
+	void discard_code() const;
+	bool run_code() const;
+
+	// Called when `sig' is destroyed
+	static void forget_signal(const sc_signal_base* sig);
+
 private:
 	sc_lambda_rator_e rator_ty;
 	sc_lambda_rand* op1;
 	sc_lambda_rand* op2;
 	int ref_count;              // reference count
 
+	mutable sc_lambda_code* code;   // compiled form, or 0
+	mutable bool compiled;          // compile() has been tried
+	mutable bool dirty;             // an operand has been updated
+	mutable bool value;             // result of the last run_code()
+
+	// The processes to recheck when an operand changes; see
+	// sc_sync_process::wait_on_lambdas()
+	mutable sc_pvector<sc_sync_process*> waiters;
+
 private:
 	sc_lambda();
 	static sc_lambda dummy_lambda;
@@ -654,6 +682,7 @@ class sc_lambda_ptr
 	friend class sc_lambda;
 	friend class sc_lambda_rand;
 	friend class sc_port_manager;
+	friend class sc_lambda_compiler;
 
 #ifdef SC_LAMBDA_H
 
@@ -1253,6 +1282,7 @@ class sc_lambda_rand
 {
 	friend class sc_lambda;
 	friend class sc_port_manager;
+	friend class sc_lambda_compiler;
 
 public:
 	static void* operator new(size_t sz){ return sc_mempool::allocate(sz); }
@@ -2377,7 +2407,17 @@ sc_lambda_rand*   o2)
 #include "sc_process_int.h"
 #include "sc_simcontext_int.h"
 #if 1
-void
+static inline sc_wait_awaiter
+sc_wait_result( sc_process_b* co_proc, bool co_sync, bool co_halt )
+{
+	sc_wait_awaiter w;
+	w.co_proc = co_proc;
+	w.co_sync = co_sync;
+	w.co_halt = co_halt;
+	return w;
+}
+
+sc_wait_awaiter
 halt(sc_simcontext* simc)
 {
 	const sc_curr_proc_info* cpi = simc->get_curr_proc_info();
@@ -2385,6 +2425,10 @@ halt(sc_simcontext* simc)
 	sc_sync_process_handle handle = (sc_sync_process_handle)cpi->process_handle;
 	handle->wait_cycles = 1;
 	handle->wait_state = sc_sync_process::WAIT_CLOCK;
+	if (handle->co != 0) {
+		/* Stackless: the sc_halt is thrown on resumption */
+		return sc_wait_result(handle, true, true);
+	}
 #ifndef WIN32
 	context_switch(sc_sync_process_yieldhelp, handle, 0, handle->next_qt());
 #else
@@ -2393,7 +2437,7 @@ halt(sc_simcontext* simc)
 	throw sc_halt();
 }
 
-void
+sc_wait_awaiter
 wait(sc_simcontext* simc)
 {
 	const sc_curr_proc_info* cpi = simc->get_curr_proc_info();
@@ -2402,6 +2446,9 @@ wait(sc_simcontext* simc)
 								sc_sync_process_handle handle = (sc_sync_process_handle)cpi->process_handle;
 								handle->wait_cycles = 1;
 								handle->wait_state = sc_sync_process::WAIT_CLOCK;
+								if (handle->co != 0) {
+									return sc_wait_result(handle, true, false);
+								}
 #ifndef WIN32
 								context_switch(sc_sync_process_yieldhelp, handle, 0, handle->next_qt());
 #else
@@ -2420,6 +2467,10 @@ wait(sc_simcontext* simc)
 
 	case SC_CURR_PROC_APROC: {
 								 sc_aproc_process_handle handle = (sc_aproc_process_handle)cpi->process_handle;
+								 if (handle->co != 0) {
+									 handle->set_in_updateq(false);
+									 return sc_wait_result(handle, false, false);
+								 }
 #ifndef WIN32
 								 qt_t* nqt = simc->next_aproc_qt();
 								 handle->set_in_updateq(false);
@@ -2438,9 +2489,10 @@ wait(sc_simcontext* simc)
 		cerr << "SystemC warning: Calling wait() in an SC_METHOD has no effect. Use wait() for SC_THREADs and SC_CTHREADs only." << endl;
 		break;
 	}
+	return sc_wait_result(0, false, false);
 }
 
-void
+sc_wait_awaiter
 wait(int n, sc_simcontext* simc)
 {
 	const sc_curr_proc_info* cpi = simc->get_curr_proc_info();
@@ -2449,6 +2501,9 @@ wait(int n, sc_simcontext* simc)
 								sc_sync_process_handle handle = (sc_sync_process_handle)cpi->process_handle;
 								handle->wait_cycles = n;
 								handle->wait_state = sc_sync_process::WAIT_CLOCK;
+								if (handle->co != 0) {
+									return sc_wait_result(handle, true, false);
+								}
 #ifndef WIN32
 								context_switch(sc_sync_process_yieldhelp, handle, 0, handle->next_qt());
 #else
@@ -2469,9 +2524,10 @@ wait(int n, sc_simcontext* simc)
 		cerr << "SystemC warning: wait(n) works only for SC_CTHREADs. For other process types, it has no effect." << endl;
 		break;
 	}
+	return sc_wait_result(0, false, false);
 }
 
-void
+sc_wait_awaiter
 wait_until(const sc_lambda_ptr& lambda, sc_simcontext* simc)
 {
 	const sc_curr_proc_info* cpi = simc->get_curr_proc_info();
@@ -2480,6 +2536,9 @@ wait_until(const sc_lambda_ptr& lambda, sc_simcontext* simc)
 								sc_sync_process_handle handle = (sc_sync_process_handle)cpi->process_handle;
 								handle->wait_lambda = lambda;
 								handle->wait_state = sc_sync_process::WAIT_LAMBDA;
+								if (handle->co != 0) {
+									return sc_wait_result(handle, true, false);
+								}
 
 #ifndef WIN32
 								context_switch(sc_sync_process_yieldhelp, handle, 0, handle->next_qt());
@@ -2502,6 +2561,7 @@ wait_until(const sc_lambda_ptr& lambda, sc_simcontext* simc)
 		cerr << "SystemC warning: wait_until() works only for SC_CTHREADs. For other process types, it has no effect; For them, you can use a do-while loop with wait() inside to get a similar effect." << endl;
 		break;
 	}
+	return sc_wait_result(0, false, false);
 }
 
 void
@@ -2514,7 +2574,7 @@ watching_before_simulation(const sc_lambda_ptr& lambda, sc_simcontext* simc)
 								sc_sync_process_handle handle = (sc_sync_process_handle)cpi->process_handle;
 								int wlevel = handle->watch_level;
 								assert(wlevel < SYSTEMC_MAX_WATCH_LEVEL);
-								handle->dwatchlists[wlevel]->push_back(new sc_lambda_ptr(lambda));
+								handle->dwatchlists[wlevel].push_back(new sc_lambda_ptr(lambda));
 								break;
 	}
 	default:
@@ -2532,7 +2592,7 @@ watching_during_simulation(const sc_lambda_ptr& lambda, sc_simcontext* simc)
 								sc_sync_process_handle handle = (sc_sync_process_handle)cpi->process_handle;
 								int wlevel = handle->watch_level;
 								assert(wlevel < SYSTEMC_MAX_WATCH_LEVEL);
-								handle->dwatchlists[wlevel]->push_back(new sc_lambda_ptr(lambda));
+								handle->dwatchlists[wlevel].push_back(new sc_lambda_ptr(lambda));
 								break;
 	}
 	default:
@@ -2577,7 +2637,7 @@ __watching_first(sc_sync_process_handle handle)
 void
 __sanitycheck_watchlists(sc_sync_process_handle handle)
 {
-	assert(handle->dwatchlists[handle->__watch_level()]->empty());
+	assert(handle->dwatchlists[handle->__watch_level()].size() == 0);
 }
 
 void
@@ -2591,48 +2651,70 @@ sc_simcontext* simc)
 }
 
 
+/* at_posedge() and at_negedge() wait twice, which a stackless process
+   cannot do from inside a callee */
+static bool
+sc_edge_wait_allowed(const char* fn, sc_simcontext* simc)
+{
+	const sc_curr_proc_info* cpi = simc->get_curr_proc_info();
+	if (SC_CURR_PROC_SYNC == cpi->kind &&
+		sc_co_helpers::is_stackless((sc_sync_process_handle)cpi->process_handle)) {
+		cerr << "SystemC error: " << fn << "() cannot be used in a stackless process; use co_await wait_until() instead." << endl;
+		return false;
+	}
+	return true;
+}
+
 void
 at_posedge(const sc_signal<sc_logic>& s, sc_simcontext* simc)
 {
+	if (!sc_edge_wait_allowed("at_posedge", simc))
+		return;
 	if (s.read() == '1') {
-		wait_until(s.delayed() == '0', simc);
-		wait_until(s.delayed() == '1', simc);
+		(void) wait_until(s.delayed() == '0', simc);
+		(void) wait_until(s.delayed() == '1', simc);
 	}
 	else {
-		wait_until(s.delayed() == '1', simc);
+		(void) wait_until(s.delayed() == '1', simc);
 	}
 }
 
 void at_posedge(const sc_signal_edgy& s, sc_simcontext* simc)
 {
+	if (!sc_edge_wait_allowed("at_posedge", simc))
+		return;
 	if (s.edgy_read()) {
-		wait_until(s.delayed() == 0);
-		wait_until(s.delayed());
+		(void) wait_until(s.delayed() == 0);
+		(void) wait_until(s.delayed());
 	}
 	else {
-		wait_until(s.delayed());
+		(void) wait_until(s.delayed());
 	}
 }
 
 void at_negedge(const sc_signal<sc_logic>& s, sc_simcontext* simc)
 {
+	if (!sc_edge_wait_allowed("at_negedge", simc))
+		return;
 	if (s.read() == '0') {
-		wait_until(s.delayed() == '1', simc);
-		wait_until(s.delayed() == '0', simc);
+		(void) wait_until(s.delayed() == '1', simc);
+		(void) wait_until(s.delayed() == '0', simc);
 	}
 	else {
-		wait_until(s.delayed() == '0', simc);
+		(void) wait_until(s.delayed() == '0', simc);
 	}
 }
 
 void at_negedge(const sc_signal_edgy& s, sc_simcontext* simc)
 {
+	if (!sc_edge_wait_allowed("at_negedge", simc))
+		return;
 	if (!s.edgy_read()) {
-		wait_until(s.delayed());
-		wait_until(s.delayed() == 0);
+		(void) wait_until(s.delayed());
+		(void) wait_until(s.delayed() == 0);
 	}
 	else {
-		wait_until(s.delayed() == 0);
+		(void) wait_until(s.delayed() == 0);
 	}
 }
 #endif
\ No newline at end of file
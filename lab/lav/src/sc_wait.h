@@ -40,31 +40,66 @@
 #ifndef SC_WAIT_H
 #define SC_WAIT_H
 
-extern void halt( sc_simcontext* = sc_get_curr_simcontext() );
+/* The wait functions return an awaitable, so that the body of a
+   stackless process (see sc_co_process.h) can say `co_await wait()'.
+   A stackful process has already waited by the time the function
+   returns, and simply ignores the result.
+
+   In a stackless process a wait() that is not co_awaited does not
+   wait at all, so where there are stackless processes the compiler
+   is asked to warn about a discarded result.  Stackful code can cast
+   the result to void, or define SC_WAIT_DISCARDABLE to turn the
+   warning off. */
+#if defined(SC_HAS_COROUTINES) && !defined(SC_WAIT_DISCARDABLE)
+#define SC_WAIT_NODISCARD [[nodiscard]]
+#else
+#define SC_WAIT_NODISCARD
+#endif
+
+struct SC_WAIT_NODISCARD sc_wait_awaiter {
+    sc_process_b* co_proc;   /* 0 unless called from a stackless process */
+    bool          co_sync;   /* co_proc is an sc_sync_process */
+    bool          co_halt;   /* the wait was a halt() */
+
+    bool await_ready() const { return co_proc == 0; }
+    template <class H> void await_suspend( H ) const { }
+    void await_resume() const;
+};
+
+extern void sc_co_wait_resume( const sc_wait_awaiter& );
 
-extern void wait( sc_simcontext* = sc_get_curr_simcontext() );
+inline void
+sc_wait_awaiter::await_resume() const
+{
+    if (co_proc != 0)
+        sc_co_wait_resume( *this );
+}
+
+extern sc_wait_awaiter halt( sc_simcontext* = sc_get_curr_simcontext() );
 
-inline void next( sc_simcontext* simc = sc_get_curr_simcontext() )
+extern sc_wait_awaiter wait( sc_simcontext* = sc_get_curr_simcontext() );
+
+inline sc_wait_awaiter next( sc_simcontext* simc = sc_get_curr_simcontext() )
 {
-    wait(simc);
+    return wait(simc);
 }
 
-extern void wait( int,
-                  sc_simcontext* = sc_get_curr_simcontext());
+extern sc_wait_awaiter wait( int,
+                             sc_simcontext* = sc_get_curr_simcontext());
 
-inline void next( int n,
-                  sc_simcontext* simc = sc_get_curr_simcontext() )
+inline sc_wait_awaiter next( int n,
+                             sc_simcontext* simc = sc_get_curr_simcontext() )
 {
-    wait(n, simc);
+    return wait(n, simc);
 }
 
-extern void wait_until( const sc_lambda_ptr&,
-                        sc_simcontext* = sc_get_curr_simcontext() );
+extern sc_wait_awaiter wait_until( const sc_lambda_ptr&,
+                                   sc_simcontext* = sc_get_curr_simcontext() );
 
-inline void wait_until( const sc_signal_edgy_deval& s,
-                       sc_simcontext* simc = sc_get_curr_simcontext() )
+inline sc_wait_awaiter wait_until( const sc_signal_edgy_deval& s,
+                                   sc_simcontext* simc = sc_get_curr_simcontext() )
 {
-    wait_until( sc_lambda_ptr(s), simc );
+    return wait_until( sc_lambda_ptr(s), simc );
 }
 
 extern void at_posedge( const sc_signal<sc_logic>&,
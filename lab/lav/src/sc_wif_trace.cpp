@@ -71,6 +71,7 @@
 #include "numeric_bit/numeric_bit.h"
 #include "sc_resolved.h"
 #include "sc_dump.h"
+#include "sc_trace_bits.h"
 
 static bool running_regression = false;
 
@@ -338,13 +339,11 @@ bool wif_sc_unsigned_trace::changed()
 
 void wif_sc_unsigned_trace::write(FILE* f)
 {
-    char buf[1000], *buf_ptr = buf;
+    char buf[1000];
+    digit_type digits[1000 / BITS_PER_DIGIT + 2];
 
-    int bitindex;
-    for(bitindex = object.length() - 1; bitindex >= 0; --bitindex) {
-        *buf_ptr++ = "01"[(object)[bitindex]];
-    }
-    *buf_ptr = '\0';
+    object.get_2c_digits(digits);
+    *sc_trace_put_bits(buf, digits, BITS_PER_DIGIT, object.length()) = '\0';
     fprintf(f, "assign %s \"%s\" ;\n", (const char *) wif_name, buf); 
     old_value = object;
 }
@@ -384,13 +383,11 @@ bool wif_sc_signed_trace::changed()
 
 void wif_sc_signed_trace::write(FILE* f)
 {
-    char buf[1000], *buf_ptr = buf;
+    char buf[1000];
+    digit_type digits[1000 / BITS_PER_DIGIT + 2];
 
-    int bitindex;
-    for(bitindex = object.length() - 1; bitindex >= 0; --bitindex) {
-        *buf_ptr++ = "01"[(object)[bitindex]];
-    }
-    *buf_ptr = '\0';
+    object.get_2c_digits(digits);
+    *sc_trace_put_bits(buf, digits, BITS_PER_DIGIT, object.length()) = '\0';
 
     fprintf(f, "assign %s \"%s\" ;\n", (const char *) wif_name, buf); 
     old_value = object;
@@ -430,13 +427,9 @@ bool wif_sc_uint_base_trace::changed()
 
 void wif_sc_uint_base_trace::write(FILE* f)
 {
-    char buf[1000], *buf_ptr = buf;
+    char buf[1000];
 
-    int bitindex;
-    for(bitindex = object.width - 1; bitindex >= 0; --bitindex) {
-        *buf_ptr++ = "01"[(object)[bitindex]];
-    }
-    *buf_ptr = '\0';
+    *sc_trace_put_bits(buf, (sc_trace_uint64) object.num, object.width) = '\0';
     fprintf(f, "assign %s \"%s\" ;\n", (const char *) wif_name, buf); 
     old_value = object;
 }
@@ -476,13 +469,9 @@ bool wif_sc_int_base_trace::changed()
 
 void wif_sc_int_base_trace::write(FILE* f)
 {
-    char buf[1000], *buf_ptr = buf;
+    char buf[1000];
 
-    int bitindex;
-    for(bitindex = object.width - 1; bitindex >= 0; --bitindex) {
-        *buf_ptr++ = "01"[(object)[bitindex]];
-    }
-    *buf_ptr = '\0';
+    *sc_trace_put_bits(buf, (sc_trace_uint64) object.num, object.width) = '\0';
 
     fprintf(f, "assign %s \"%s\" ;\n", (const char *) wif_name, buf); 
     old_value = object;
@@ -759,11 +748,8 @@ void wif_unsigned_int_trace::write(FILE* f)
         }
     }
     else{
-        unsigned bit_mask = 1 << (bit_width-1);
-        for (bitindex = 0; bitindex < bit_width; bitindex++) {
-            buf[bitindex] = (object & bit_mask)? '1' : '0';
-            bit_mask = bit_mask >> 1;
-        }
+        sc_trace_put_bits(buf, object, bit_width);
+        bitindex = bit_width;
     }
     buf[bitindex] = '\0';
     fprintf(f, "assign %s \"%s\" ;\n", (const char *) wif_name, buf); 
@@ -819,11 +805,8 @@ void wif_unsigned_short_trace::write(FILE* f)
         }
     }
     else{
-        unsigned bit_mask = 1 << (bit_width-1);
-        for (bitindex = 0; bitindex < bit_width; bitindex++) {
-            buf[bitindex] = (object & bit_mask)? '1' : '0';
-            bit_mask = bit_mask >> 1;
-        }
+        sc_trace_put_bits(buf, object, bit_width);
+        bitindex = bit_width;
     }
     buf[bitindex] = '\0';
     fprintf(f, "assign %s \"%s\" ;\n", (const char *) wif_name, buf); 
@@ -878,11 +861,8 @@ void wif_unsigned_char_trace::write(FILE* f)
         }
     }
     else{
-        unsigned bit_mask = 1 << (bit_width-1);
-        for (bitindex = 0; bitindex < bit_width; bitindex++) {
-            buf[bitindex] = (object & bit_mask)? '1' : '0';
-            bit_mask = bit_mask >> 1;
-        }
+        sc_trace_put_bits(buf, object, bit_width);
+        bitindex = bit_width;
     }
     buf[bitindex] = '\0';
     fprintf(f, "assign %s \"%s\" ;\n", (const char *) wif_name, buf); 
@@ -937,11 +917,8 @@ void wif_unsigned_long_trace::write(FILE* f)
         }
     }
     else{
-        unsigned bit_mask = 1 << (bit_width-1);
-        for (bitindex = 0; bitindex < bit_width; bitindex++) {
-            buf[bitindex] = (object & bit_mask)? '1' : '0';
-            bit_mask = bit_mask >> 1;
-        }
+        sc_trace_put_bits(buf, object, bit_width);
+        bitindex = bit_width;
     }
     buf[bitindex] = '\0';
     fprintf(f, "assign %s \"%s\" ;\n", (const char *) wif_name, buf); 
@@ -996,11 +973,8 @@ void wif_signed_int_trace::write(FILE* f)
         }
     }
     else{
-        unsigned bit_mask = 1 << (bit_width-1);
-        for (bitindex = 0; bitindex < bit_width; bitindex++) {
-            buf[bitindex] = (object & bit_mask)? '1' : '0';
-            bit_mask = bit_mask >> 1;
-        }
+        sc_trace_put_bits(buf, (unsigned) object, bit_width);
+        bitindex = bit_width;
     }
     buf[bitindex] = '\0';
     fprintf(f, "assign %s \"%s\" ;\n", (const char *) wif_name, buf); 
@@ -1055,11 +1029,8 @@ void wif_signed_short_trace::write(FILE* f)
         }
     }
     else{
-        unsigned bit_mask = 1 << (bit_width-1);
-        for (bitindex = 0; bitindex < bit_width; bitindex++) {
-            buf[bitindex] = (object & bit_mask)? '1' : '0';
-            bit_mask = bit_mask >> 1;
-        }
+        sc_trace_put_bits(buf, (unsigned short) object, bit_width);
+        bitindex = bit_width;
     }
     buf[bitindex] = '\0';
     fprintf(f, "assign %s \"%s\" ;\n", (const char *) wif_name, buf); 
@@ -1114,11 +1085,8 @@ void wif_signed_char_trace::write(FILE* f)
         }
     }
     else{
-        unsigned bit_mask = 1 << (bit_width-1);
-        for (bitindex = 0; bitindex < bit_width; bitindex++) {
-            buf[bitindex] = (object & bit_mask)? '1' : '0';
-            bit_mask = bit_mask >> 1;
-        }
+        sc_trace_put_bits(buf, (unsigned char) object, bit_width);
+        bitindex = bit_width;
     }
     buf[bitindex] = '\0';
     fprintf(f, "assign %s \"%s\" ;\n", (const char *) wif_name, buf); 
@@ -1173,11 +1141,8 @@ void wif_signed_long_trace::write(FILE* f)
         }
     }
     else{
-        unsigned bit_mask = 1 << (bit_width-1);
-        for (bitindex = 0; bitindex < bit_width; bitindex++) {
-            buf[bitindex] = (object & bit_mask)? '1' : '0';
-            bit_mask = bit_mask >> 1;
-        }
+        sc_trace_put_bits(buf, (unsigned long) object, bit_width);
+        bitindex = bit_width;
     }
     buf[bitindex] = '\0';
     fprintf(f, "assign %s \"%s\" ;\n", (const char *) wif_name, buf); 
@@ -1414,7 +1379,8 @@ void wif_trace_file::initialize()
     }
 
     double inittime = sc_simulation_time();
-    previous_time = inittime/timescale_unit;
+    sc_ticks init_units = sc_ticks_to_units(sc_time_stamp_ticks(), timescale_unit);
+    previous_time = (double) init_units;
 
     // Dump all values at initial time
     sprintf(buf,
@@ -1425,7 +1391,16 @@ void wif_trace_file::initialize()
             );
     write_comment(buf);
 
-    double_to_special_int64(inittime/timescale_unit, &previous_time_units_high, &previous_time_units_low );
+    ticks_to_special_int64(init_units, &previous_time_units_high, &previous_time_units_low );
+
+    // Times are relative to the previous one; tracing may start at a
+    // trigger or a restored checkpoint, later than time 0
+    if(previous_time_units_high){
+        fprintf(fp, "delta_time %u%09u ;\n", previous_time_units_high, previous_time_units_low);
+    }
+    else if(previous_time_units_low){
+        fprintf(fp, "delta_time %u ;\n", previous_time_units_low);
+    }
 
     for (i = 0; i < traces.size(); i++) {
         wif_trace* t = traces[i];
@@ -1482,7 +1457,7 @@ void wif_trace_file::trace(const bool& object, const sc_string& name)
 
     sc_string temp_wif_name;
     create_wif_name(&temp_wif_name);
-    traces.push_back(new wif_bool_trace(object, name, temp_wif_name));
+    add_trace(new wif_bool_trace(object, name, temp_wif_name));
 }
 
 void wif_trace_file::trace(const sc_bool_vector& object, const sc_string& name)
@@ -1493,7 +1468,7 @@ void wif_trace_file::trace(const sc_bool_vector& object, const sc_string& name)
 
     sc_string temp_wif_name;
     create_wif_name(&temp_wif_name);
-    traces.push_back(new wif_bool_vector_trace(object, name, temp_wif_name));
+    add_trace(new wif_bool_vector_trace(object, name, temp_wif_name));
 }
 
 
@@ -1505,7 +1480,7 @@ void wif_trace_file::trace(const sc_logic& object, const sc_string& name)
 
     sc_string temp_wif_name;
     create_wif_name(&temp_wif_name);
-    traces.push_back(new wif_sc_logic_trace(object, name, temp_wif_name));
+    add_trace(new wif_sc_logic_trace(object, name, temp_wif_name));
 }
 
 void wif_trace_file::trace(const sc_logic_vector& object, const sc_string& name)
@@ -1516,7 +1491,7 @@ void wif_trace_file::trace(const sc_logic_vector& object, const sc_string& name)
 
     sc_string temp_wif_name;
     create_wif_name(&temp_wif_name);
-    traces.push_back(new wif_sc_logic_vector_trace(object,name, temp_wif_name));
+    add_trace(new wif_sc_logic_vector_trace(object,name, temp_wif_name));
 }
 
 void wif_trace_file::trace(const unsigned& object, const sc_string& name, int _width)
@@ -1527,7 +1502,7 @@ void wif_trace_file::trace(const unsigned& object, const sc_string& name, int _w
 
     sc_string temp_wif_name;
     create_wif_name(&temp_wif_name);
-    traces.push_back(new wif_unsigned_int_trace(object, name, temp_wif_name, _width));
+    add_trace(new wif_unsigned_int_trace(object, name, temp_wif_name, _width));
 }
 
 void wif_trace_file::trace(const unsigned char& object, const sc_string& name, int _width)
@@ -1538,7 +1513,7 @@ void wif_trace_file::trace(const unsigned char& object, const sc_string& name, i
 
     sc_string temp_wif_name;
     create_wif_name(&temp_wif_name);
-    traces.push_back(new wif_unsigned_char_trace(object, name, temp_wif_name, _width));
+    add_trace(new wif_unsigned_char_trace(object, name, temp_wif_name, _width));
 }
 
 void wif_trace_file::trace(const unsigned short& object, const sc_string& name, int _width)
@@ -1549,7 +1524,7 @@ void wif_trace_file::trace(const unsigned short& object, const sc_string& name,
 
     sc_string temp_wif_name;
     create_wif_name(&temp_wif_name);
-    traces.push_back(new wif_unsigned_short_trace(object, name, temp_wif_name, _width));
+    add_trace(new wif_unsigned_short_trace(object, name, temp_wif_name, _width));
 }
 
 void wif_trace_file::trace(const unsigned long& object, const sc_string& name, int _width)
@@ -1560,7 +1535,7 @@ void wif_trace_file::trace(const unsigned long& object, const sc_string& name, i
 
     sc_string temp_wif_name;
     create_wif_name(&temp_wif_name);
-    traces.push_back(new wif_unsigned_long_trace(object, name, temp_wif_name, _width));
+    add_trace(new wif_unsigned_long_trace(object, name, temp_wif_name, _width));
 }
 
 void wif_trace_file::trace(const int& object, const sc_string& name, int _width)
@@ -1571,7 +1546,7 @@ void wif_trace_file::trace(const int& object, const sc_string& name, int _width)
 
     sc_string temp_wif_name;
     create_wif_name(&temp_wif_name);
-    traces.push_back(new wif_signed_int_trace(object, name, temp_wif_name, _width));
+    add_trace(new wif_signed_int_trace(object, name, temp_wif_name, _width));
 }
 
 void wif_trace_file::trace(const char& object, const sc_string& name, int _width)
@@ -1582,7 +1557,7 @@ void wif_trace_file::trace(const char& object, const sc_string& name, int _width
 
     sc_string temp_wif_name;
     create_wif_name(&temp_wif_name);
-    traces.push_back(new wif_signed_char_trace(object, name, temp_wif_name, _width));
+    add_trace(new wif_signed_char_trace(object, name, temp_wif_name, _width));
 }
 
 void wif_trace_file::trace(const short& object, const sc_string& name, int _width)
@@ -1593,7 +1568,7 @@ void wif_trace_file::trace(const short& object, const sc_string& name, int _widt
 
     sc_string temp_wif_name;
     create_wif_name(&temp_wif_name);
-    traces.push_back(new wif_signed_short_trace(object, name, temp_wif_name, _width));
+    add_trace(new wif_signed_short_trace(object, name, temp_wif_name, _width));
 }
 
 void wif_trace_file::trace(const long& object, const sc_string& name, int _width)
@@ -1604,7 +1579,7 @@ void wif_trace_file::trace(const long& object, const sc_string& name, int _width
 
     sc_string temp_wif_name;
     create_wif_name(&temp_wif_name);
-    traces.push_back(new wif_signed_long_trace(object, name, temp_wif_name, _width));
+    add_trace(new wif_signed_long_trace(object, name, temp_wif_name, _width));
 }
 
 void wif_trace_file::trace(const float& object, const sc_string& name)
@@ -1615,7 +1590,7 @@ void wif_trace_file::trace(const float& object, const sc_string& name)
 
     sc_string temp_wif_name;
     create_wif_name(&temp_wif_name);
-    traces.push_back(new wif_float_trace(object, name, temp_wif_name));
+    add_trace(new wif_float_trace(object, name, temp_wif_name));
 }
 
 void wif_trace_file::trace(const double& object, const sc_string& name)
@@ -1626,7 +1601,7 @@ void wif_trace_file::trace(const double& object, const sc_string& name)
 
     sc_string temp_wif_name;
     create_wif_name(&temp_wif_name);
-    traces.push_back(new wif_double_trace(object, name, temp_wif_name));
+    add_trace(new wif_double_trace(object, name, temp_wif_name));
 }
 
 void wif_trace_file::trace(const sc_unsigned& object, const sc_string& name)
@@ -1637,7 +1612,7 @@ void wif_trace_file::trace(const sc_unsigned& object, const sc_string& name)
 
     sc_string temp_wif_name;
     create_wif_name(&temp_wif_name);
-    traces.push_back(new wif_sc_unsigned_trace(object, name, temp_wif_name));
+    add_trace(new wif_sc_unsigned_trace(object, name, temp_wif_name));
 }
 
 void wif_trace_file::trace(const sc_signed& object, const sc_string& name)
@@ -1648,7 +1623,7 @@ void wif_trace_file::trace(const sc_signed& object, const sc_string& name)
 
     sc_string temp_wif_name;
     create_wif_name(&temp_wif_name);
-    traces.push_back(new wif_sc_signed_trace(object, name, temp_wif_name));
+    add_trace(new wif_sc_signed_trace(object, name, temp_wif_name));
 }
 
 void wif_trace_file::trace(const sc_int_base& object, const sc_string& name)
@@ -1659,7 +1634,7 @@ void wif_trace_file::trace(const sc_int_base& object, const sc_string& name)
 
     sc_string temp_wif_name;
     create_wif_name(&temp_wif_name);
-    traces.push_back(new wif_sc_int_base_trace(object, name, temp_wif_name));
+    add_trace(new wif_sc_int_base_trace(object, name, temp_wif_name));
 }
 
 void wif_trace_file::trace(const sc_uint_base& object, const sc_string& name)
@@ -1670,7 +1645,7 @@ void wif_trace_file::trace(const sc_uint_base& object, const sc_string& name)
 
     sc_string temp_wif_name;
     create_wif_name(&temp_wif_name);
-    traces.push_back(new wif_sc_uint_base_trace(object, name, temp_wif_name));
+    add_trace(new wif_sc_uint_base_trace(object, name, temp_wif_name));
 }
 
 
@@ -1687,7 +1662,7 @@ wif_trace_file::trace( const tp& object, const sc_string& name )              \
                                                                               \
     sc_string temp_wif_name;                                                  \
     create_wif_name( &temp_wif_name );                                        \
-    traces.push_back( new wif_ ## tp ## _trace( object,                       \
+    add_trace( new wif_ ## tp ## _trace( object,                       \
 						name,                         \
 						temp_wif_name ) );            \
 }
@@ -1710,7 +1685,7 @@ void wif_trace_file::trace(const unsigned& object, const sc_string& name, const
 
     sc_string temp_wif_name;
     create_wif_name(&temp_wif_name);
-    traces.push_back(new wif_enum_trace(object, name, temp_wif_name, enum_literals));
+    add_trace(new wif_enum_trace(object, name, temp_wif_name, enum_literals));
 }
 
 void wif_trace_file::trace(const sc_signal_bool_vector& object, const sc_string& name)
@@ -1721,7 +1696,7 @@ void wif_trace_file::trace(const sc_signal_bool_vector& object, const sc_string&
 
     sc_string temp_wif_name;
     create_wif_name(&temp_wif_name);
-    traces.push_back(new wif_bool_vector_trace((const sc_bool_vector&) object, name, temp_wif_name));
+    add_trace(new wif_bool_vector_trace((const sc_bool_vector&) object, name, temp_wif_name));
 }
 
 void wif_trace_file::trace(const sc_signal_logic_vector& object, const sc_string& name)
@@ -1732,7 +1707,7 @@ void wif_trace_file::trace(const sc_signal_logic_vector& object, const sc_string
 
     sc_string temp_wif_name;
     create_wif_name(&temp_wif_name);
-    traces.push_back(new wif_sc_logic_vector_trace((const sc_logic_vector&) object, name, temp_wif_name));
+    add_trace(new wif_sc_logic_vector_trace((const sc_logic_vector&) object, name, temp_wif_name));
 }
 
 void wif_trace_file::trace(const sc_signal_resolved& object, const sc_string& name)
@@ -1743,7 +1718,7 @@ void wif_trace_file::trace(const sc_signal_resolved& object, const sc_string& na
 
     sc_string temp_wif_name;
     create_wif_name(&temp_wif_name);
-    traces.push_back(new wif_sc_logic_trace((const sc_logic&) *(object.get_data_ptr()), name, temp_wif_name));
+    add_trace(new wif_sc_logic_trace((const sc_logic&) *(object.get_data_ptr()), name, temp_wif_name));
 }
 
 void wif_trace_file::trace(const sc_signal_resolved_vector& object, const sc_string& name)
@@ -1754,7 +1729,7 @@ void wif_trace_file::trace(const sc_signal_resolved_vector& object, const sc_str
 
     sc_string temp_wif_name;
     create_wif_name(&temp_wif_name);
-    traces.push_back(new wif_sc_logic_vector_trace((const sc_logic_vector&) object, name, temp_wif_name));
+    add_trace(new wif_sc_logic_vector_trace((const sc_logic_vector&) object, name, temp_wif_name));
 }
 
 void wif_trace_file::write_comment(const sc_string& comment)
@@ -1779,12 +1754,14 @@ void wif_trace_file::cycle(bool this_is_a_delta_cycle)
     // Check for initialization
     if (!initialized) {
         initialize();
+        clear_dirty();
         initialized = true;
         return;
     };
 
-    double now_units = sc_simulation_time() / timescale_unit;
-    double_to_special_int64(now_units, &now_units_high, &now_units_low );
+    sc_ticks now_ticks = sc_ticks_to_units(sc_time_stamp_ticks(), timescale_unit);
+    double now_units = (double) now_ticks;
+    ticks_to_special_int64(now_ticks, &now_units_high, &now_units_low );
 
     // Now do the real stuff
     unsigned delta_units_high, delta_units_low;
@@ -1796,8 +1773,10 @@ void wif_trace_file::cycle(bool this_is_a_delta_cycle)
     
     bool time_printed = false;
     wif_trace* const* const l_traces = traces.raw_data();
-    for (int i = 0; i < traces.size(); i++) {
-        wif_trace* t = l_traces[i];
+    int n_check;
+    sc_trace_watch* const* const to_check = traces_to_check(n_check);
+    for (int k = 0; k < n_check; k++) {
+        wif_trace* t = l_traces[to_check[k]->index];
         if(t->changed()){
             if(time_printed == false){
                 if(delta_units_high){
@@ -1825,6 +1804,12 @@ void wif_trace_file::cycle(bool this_is_a_delta_cycle)
     }
 }
 
+void wif_trace_file::add_trace(wif_trace* t)
+{
+    traces.push_back(t);
+    trace_added();
+}
+
 // Create a WIF name for a variable
 void wif_trace_file::create_wif_name(sc_string* ptr_to_str)
 {
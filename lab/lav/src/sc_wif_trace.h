@@ -178,6 +178,8 @@ private:
 
     // Create wif names for each variable
     void create_wif_name(sc_string* ptr_to_str);
+    // Add a trace to the traces
+    void add_trace(wif_trace* t);
     
     // Array to store the variables traced
     sc_pvector<wif_trace*> traces;
@@ -50,52 +50,46 @@ friend void sc_signal_write_d( sc_sync*, SIGREF, RV, int );
 
 #define D_TEMPL_SC_WRITE( TEMPL, SIGREF, RV ) \
 TEMPL inline void \
-sc_signal_write( sc_module* proc, SIGREF sig, RV nv ) \
+sc_signal_write( sc_module*, SIGREF sig, RV nv ) \
 { \
-    if (sig.xwrite(proc,nv)) (*(get_curr_submit()))(proc, &sig); \
+    sig.write(nv); \
 } \
 TEMPL inline void \
-sc_signal_write_d( sc_sync* proc, SIGREF sig, RV nv, int delay ) \
+sc_signal_write_d( sc_sync*, SIGREF sig, RV nv, int delay ) \
 { \
-    if (delay <= 0) \
-        sc_signal_write( proc, sig, nv ); \
-    else \
-        proc->clock_edge().submit_update_d(sig.xwrite_d(proc,nv),delay); \
+    sig.write_d(nv, delay); \
 } \
 TEMPL inline void \
 write( SIGREF sig, RV nv ) \
 { \
-    sc_signal_write( get_curr_proc(), sig, nv ); \
+    sig.write(nv); \
 } \
 TEMPL inline void \
 write_d( SIGREF sig, RV nv, int delay ) \
 { \
-    sc_signal_write_d( (sc_sync*) get_curr_proc(), sig, nv, delay ); \
+    sig.write_d(nv, delay); \
 }
 
 #define D_SC_WRITE( SIGREF, RV ) \
 inline void \
-sc_signal_write( sc_module* proc, SIGREF sig, RV nv ) \
+sc_signal_write( sc_module*, SIGREF sig, RV nv ) \
 { \
-    if (sig.xwrite(proc,nv)) (*(get_curr_submit()))(proc, &sig); \
+    sig.write(nv); \
 } \
 inline void \
-sc_signal_write_d( sc_sync* proc, SIGREF sig, RV nv, int delay ) \
+sc_signal_write_d( sc_sync*, SIGREF sig, RV nv, int delay ) \
 { \
-    if (delay <= 0) \
-        sc_signal_write( proc, sig, nv ); \
-    else \
-        proc->clock_edge().submit_update_d(sig.xwrite_d(proc,nv),delay); \
+    sig.write_d(nv, delay); \
 } \
 inline void \
 write( SIGREF sig, RV nv ) \
 { \
-    sc_signal_write( get_curr_proc(), sig, nv ); \
+    sig.write(nv); \
 } \
 inline void \
 write_d( SIGREF sig, RV nv, int delay ) \
 { \
-    sc_signal_write_d( (sc_sync*) get_curr_proc(), sig, nv, delay ); \
+    sig.write_d(nv, delay); \
 }
 
 #endif
@@ -76,7 +76,9 @@ using std::hex;
 #include "sc_sync.h"
 #include "sc_async.h"
 #include "sc_aproc.h"
+#include "sc_co_process.h"
 #include "sc_clock.h"
+#include "sc_signal_delay.h"
 #include "sc_simcontext.h"
 #include "sc_polarity.h"
 #include "sc_bool_vector.h"
@@ -92,6 +94,7 @@ using std::hex;
 #include "sc_vcd_trace.h"
 #include "sc_wif_trace.h"
 #include "sc_isdb_trace.h"
+#include "sc_scw_trace.h"
 #include "numeric_bit/numeric_bit.h"
 #include "sc_externs.h"
 #include "sc_port.h"
@@ -174,6 +177,16 @@ typedef sc_signal_bool_vector     signal_bool_vector;
 #define SC_THREAD(func)                SC_APROC(func)
 #define SC_METHOD(func)                SC_ASYNC(func)
 
+// Stackless flavours of SC_CTHREAD and SC_THREAD, whose bodies are
+// coroutines returning sc_co_task; see sc_co_process.h
+
+#ifdef SC_HAS_COROUTINES
+#define SC_CO_CTHREAD(func, clock_edge) \
+    declare_sc_co_sync_process(func ## _handle, #func, clock_edge, SC_CURRENT_USER_MODULE, func)
+#define SC_CO_THREAD(func) \
+    declare_sc_co_aproc_process(func ## _handle, #func, SC_CURRENT_USER_MODULE, func)
+#endif
+
 // MSVC6.0 for() scope bug
 #ifdef _MSC_VER
 #define for if(0);else for